@@ -50,6 +50,7 @@ namespace VDD
 
     std::string AsyncNode::debugPrefix;
     std::list<Optional<std::string>> AsyncNode::sDefaultColor;
+    std::list<Optional<AffinityGroup>> AsyncNode::sDefaultAffinityGroup;
 
     AsyncCallback& AsyncCallback::setLabel(std::string aLabel)
     {
@@ -65,6 +66,9 @@ namespace VDD
         if (sDefaultColor.size()) {
             mColor = sDefaultColor.front();
         }
+        if (sDefaultAffinityGroup.size()) {
+            mAffinityGroup = sDefaultAffinityGroup.front();
+        }
         mGraph.registerNode(this);
     }
 
@@ -103,6 +107,26 @@ namespace VDD
         mColor = aColor;
     }
 
+    void AsyncNode::pushDefaultAffinityGroup(Optional<AffinityGroup> aGroup)
+    {
+        sDefaultAffinityGroup.push_front(aGroup);
+    }
+
+    void AsyncNode::popDefaultAffinityGroup()
+    {
+        sDefaultAffinityGroup.pop_front();
+    }
+
+    Optional<AffinityGroup> AsyncNode::getAffinityGroup() const
+    {
+        return mAffinityGroup;
+    }
+
+    void AsyncNode::setAffinityGroup(Optional<AffinityGroup> aGroup)
+    {
+        mAffinityGroup = aGroup;
+    }
+
     void AsyncNode::graphStarted()
     {
         // nothing
@@ -56,6 +56,9 @@ namespace VDD {
 
     typedef unsigned int AsyncNodeId;
 
+    // Nodes with the same affinity group are run on the same NUMA node by ParallelGraph
+    typedef size_t AffinityGroup;
+
     /** @brief AsyncNode is the basic element in the graph. It can
      * produce output by calling its hasOutput, which passes the data
      * forward to functions registered with addCallback.
@@ -77,6 +80,20 @@ namespace VDD {
             }
         };
 
+        struct ScopeAffinityGroup
+        {
+            ScopeAffinityGroup(AffinityGroup aGroup)
+            {
+                AsyncNode::pushDefaultAffinityGroup(aGroup);
+            }
+            ScopeAffinityGroup(const ScopeAffinityGroup&) = delete;
+            void operator=(const ScopeAffinityGroup&) = delete;
+            ~ScopeAffinityGroup()
+            {
+                AsyncNode::popDefaultAffinityGroup();
+            }
+        };
+
         static std::string debugPrefix;
 
         AsyncNode(GraphBase&, std::string aName = "node");
@@ -95,6 +112,13 @@ namespace VDD {
         Optional<std::string> getColor() const;
         void setColor(Optional<std::string> aColor);
 
+        // For keeping related nodes (ie. a view or a tile set) on one NUMA node; nodes without a
+        // group can be run anywhere
+        static void pushDefaultAffinityGroup(Optional<AffinityGroup> aGroup);
+        static void popDefaultAffinityGroup();
+        Optional<AffinityGroup> getAffinityGroup() const;
+        void setAffinityGroup(Optional<AffinityGroup> aGroup);
+
         GraphBase& getGraph();
 
         /* Is this node busy or blocked, even though it's not running actively. Will not be called
@@ -128,6 +152,9 @@ namespace VDD {
         static std::list<Optional<std::string>> sDefaultColor;
         Optional<std::string> mColor;
 
+        static std::list<Optional<AffinityGroup>> sDefaultAffinityGroup;
+        Optional<AffinityGroup> mAffinityGroup;
+
         friend class GraphBase;
     };
 
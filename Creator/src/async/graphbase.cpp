@@ -396,6 +396,11 @@ namespace VDD
         return mSources;
     }
 
+    std::set<AsyncSource*> GraphBase::copySources() const
+    {
+        return mSources;
+    }
+
     AsyncCallback& connect(AsyncNode& aFrom, const std::string& aName, AsyncPushCallback aCallback, StreamFilter aStreamFilter)
     {
         GraphBase& graph = aFrom.getGraph();
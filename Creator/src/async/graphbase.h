@@ -106,6 +106,10 @@ namespace VDD {
         const AsyncNode* findNodeById(AsyncNodeId aNodeId) const;
         AsyncNode* findNodeById(AsyncNodeId aNodeId);
 
+        // Retrieve a copy of the currently registered sources; used for finding out which
+        // sources a particular part of the graph construction created
+        std::set<AsyncSource*> copySources() const;
+
         // Indicate that an error has been signaled (e.g. thrown)
         void setErrorSignaled();
 
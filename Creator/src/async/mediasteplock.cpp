@@ -150,6 +150,10 @@ namespace VDD
 
             workWhileMutexHeld();
         }
+        else if (aStreams.isEndOfStream() && mProcessors.at(aId).processor->mEosPending)
+        {
+            mProcessors.at(aId).processor->produceEOS();
+        }
     }
 
     void MediaStepLockState::workWhileMutexHeld()
@@ -285,6 +289,13 @@ namespace VDD
 
     void MediaStepLockProcessor::produceEOS()
     {
+        // An input that has not received anything yet (ie. its source was aborted before
+        // producing) has no known streams to end; end them once its own end-of-stream arrives
+        mEosPending = mKnownStreams.empty();
+        if (mEosPending)
+        {
+            return;
+        }
         std::vector<Data> eos;
         for (auto streamId : mKnownStreams)
         {
@@ -46,6 +46,7 @@ namespace VDD
         std::set<StreamId> mKnownStreams;
         std::set<StreamId> mActiveStreams;
         bool mEncounteredEndOfStream = false;
+        bool mEosPending = false;
 
         void setPaused(bool aPaused);
         void produceEOS();
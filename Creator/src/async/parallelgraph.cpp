@@ -27,6 +27,9 @@ namespace VDD
     ParallelGraph::ParallelGraph(const Config& aConfig)
         : mConfig(aConfig)
         , mThreadsExitedCount(0)
+        , mGroupsPlaced(aConfig.placement && aConfig.placement->numNodes() > 1 && !aConfig.singleThread)
+        , mWorkers(mGroupsPlaced ? aConfig.placement->numNodes() : 1u)
+        , mNodeAges(mGroupsPlaced ? 1u + aConfig.placement->numNodes() : 1u)
     {
         // nothing
     }
@@ -37,7 +40,7 @@ namespace VDD
         if (!mStopped)
         {
             mQuit = true;
-            mWorkAvailable.notify_all();
+            notifyAllWorkersWithWorkMutexHeld();
             lock.unlock();
 
             for (auto& thread : mThreads)
@@ -57,21 +60,40 @@ namespace VDD
     {
         try
         {
-            (void) aThreadId;
+            if (mConfig.placement)
+            {
+                mConfig.placement->applyToCurrentThread(aThreadId);
+            }
+            const size_t numaNode = mGroupsPlaced ? mConfig.placement->nodeOfThread(aThreadId) : 0u;
+            Workers& workers = mWorkers[numaNode];
+            auto hasWork = [&]{ return findWorkWithWorkMutexHeld(numaNode) != nullptr; };
+            // with placed groups other threads may still produce work for this thread after
+            // mQuit, so wait until no node is waiting or running
+            auto canQuit = [&]{ return mQuit && (!mGroupsPlaced || mNumWaiting == 0); };
             bool quit = false;
             // keep workLock at this level to remove the useless lock/unlock between loop iterations
             std::unique_lock<std::mutex> workLock(mWorkMutex);
             do
             {
-                mWorkAvailable.wait(workLock, [&]{ return mAborted || mQuit || mNodeAge.size(); });
+                while (!mAborted && !canQuit() && !hasWork())
+                {
+                    ++workers.numIdle;
+                    workers.workAvailable.wait(workLock);
+                    --workers.numIdle;
+                    if (workers.numWakeups)
+                    {
+                        --workers.numWakeups;
+                    }
+                }
 
                 // quit only if there's no work left or an abort has been issued
-                quit = (mNodeAge.size() == 0 && mQuit) || mAborted;
+                quit = (!hasWork() && canQuit()) || mAborted;
 
-                if (!quit)
+                if (!quit && hasWork())
                 {
                     // pick a node with oldest data to process
-                    auto nodeAgeIt = mNodeAge.begin();
+                    NodeAge* nodeAge = findWorkWithWorkMutexHeld(numaNode);
+                    auto nodeAgeIt = nodeAge->begin();
                     auto nodeIt = nodeAgeIt->second.begin();
                     auto node = *nodeIt;
                     auto& nodeInfo = *mNodeInfo[node];
@@ -84,9 +106,10 @@ namespace VDD
                     bool valid;
 
                     // retrieve iterators again, they might have changed during the unlock
-                    if (mNodeAge.size())
+                    nodeAge = findWorkWithWorkMutexHeld(numaNode);
+                    if (nodeAge)
                     {
-                        nodeAgeIt = mNodeAge.begin();
+                        nodeAgeIt = nodeAge->begin();
                         nodeIt = nodeAgeIt->second.begin();
                         valid = (*nodeIt)->getId() == node->getId();
                     }
@@ -104,7 +127,7 @@ namespace VDD
                         nodeAgeIt->second.erase(nodeIt);
                         if (nodeAgeIt->second.size() == 0)
                         {
-                            mNodeAge.erase(nodeAgeIt);
+                            nodeAge->erase(nodeAgeIt);
                         }
 
                         workLock.unlock();
@@ -158,7 +181,7 @@ namespace VDD
                             nodeInfo.runtime += t1 - t0;
 
                             // we don't update oldestEnqueuedData, because its value is not used until
-                            // the node is added back to mNodeAge.
+                            // the node is added back to mNodeAges.
 
                             std::list<AsyncNode*> wake = checkAndDecrementParentBlockedOutputs(nodeInfo);
 
@@ -210,6 +233,11 @@ namespace VDD
 
                             ++mReadySequence;
                             mWorkReady.notify_one();
+
+                            if (mGroupsPlaced && mQuit && mNumWaiting == 0)
+                            {
+                                notifyAllWorkersWithWorkMutexHeld();
+                            }
                         }
                         else
                         {
@@ -297,14 +325,24 @@ namespace VDD
         }
     }
 
+    ParallelGraph::NodeAge& ParallelGraph::nodeAgeOf(const NodeInfo& aNodeInfo)
+    {
+        return mNodeAges[aNodeInfo.numaNode ? 1u + *aNodeInfo.numaNode : 0u];
+    }
+
     void ParallelGraph::updateNodeAgeWithWorkMutexHeld(const AsyncNode* aNode, Index aIndex)
     {
         auto& nodeInfo = *mNodeInfo[aNode];
+        auto& nodeAge = nodeAgeOf(nodeInfo);
         auto oldIndex = nodeInfo.oldestEnqueuedData.load();
-        mNodeAge[oldIndex].erase(aNode);
-        if (mNodeAge[oldIndex].size() == 0)
+        auto nodeAgeIt = nodeAge.find(oldIndex);
+        if (nodeAgeIt != nodeAge.end())
         {
-            mNodeAge.erase(oldIndex);
+            nodeAgeIt->second.erase(aNode);
+            if (nodeAgeIt->second.size() == 0)
+            {
+                nodeAge.erase(nodeAgeIt);
+            }
         }
         nodeInfo.oldestEnqueuedData.store(aIndex);
     }
@@ -312,8 +350,59 @@ namespace VDD
     void ParallelGraph::wakeWithWorkMutexHeld(const AsyncNode* aNode)
     {
         auto& nodeInfo = *mNodeInfo[aNode];
-        mNodeAge[nodeInfo.oldestEnqueuedData.load()].insert(aNode);
-        mWorkAvailable.notify_one();
+        nodeAgeOf(nodeInfo)[nodeInfo.oldestEnqueuedData.load()].insert(aNode);
+        notifyWorkersWithWorkMutexHeld(nodeInfo.numaNode);
+    }
+
+    void ParallelGraph::notifyWorkersWithWorkMutexHeld(const Optional<size_t>& aNumaNode)
+    {
+        Workers* workers = nullptr;
+        if (aNumaNode)
+        {
+            workers = &mWorkers[*aNumaNode];
+        }
+        else
+        {
+            for (auto& candidate : mWorkers)
+            {
+                if (!workers || candidate.numIdle - candidate.numWakeups > workers->numIdle - workers->numWakeups)
+                {
+                    workers = &candidate;
+                }
+            }
+        }
+        // the threads that are not idle look for more work before they wait
+        if (workers->numIdle > workers->numWakeups)
+        {
+            ++workers->numWakeups;
+            workers->workAvailable.notify_one();
+        }
+    }
+
+    void ParallelGraph::notifyAllWorkersWithWorkMutexHeld()
+    {
+        for (auto& workers : mWorkers)
+        {
+            workers.numWakeups = workers.numIdle;
+            workers.workAvailable.notify_all();
+        }
+    }
+
+    ParallelGraph::NodeAge* ParallelGraph::findWorkWithWorkMutexHeld(size_t aNumaNode)
+    {
+        NodeAge* found = nullptr;
+        auto consider = [&](NodeAge& aNodeAge) {
+            if (aNodeAge.size() && (!found || aNodeAge.begin()->first < found->begin()->first))
+            {
+                found = &aNodeAge;
+            }
+        };
+        consider(mNodeAges[0]);
+        if (mGroupsPlaced)
+        {
+            consider(mNodeAges[1u + aNumaNode]);
+        }
+        return found;
     }
 
     void ParallelGraph::wakeWithWorkMutexHeld(const std::list<AsyncNode*>& wake)
@@ -365,6 +454,10 @@ namespace VDD
                 n->processor = processor;
             }
             n->isSource = !!dynamic_cast<AsyncSource*>(node);
+            if (mGroupsPlaced && node->getAffinityGroup())
+            {
+                n->numaNode = mConfig.placement->nodeOfGroup(*node->getAffinityGroup());
+            }
 
             mById.insert({ n->node->getId(), n.get() });
             mNodeInfo.emplace(std::make_pair(node, std::move(n)));
@@ -438,7 +531,14 @@ namespace VDD
 
         if (!mThreads.size())
         {
-            unsigned numberOfThreads = mConfig.singleThread ? 1u : std::max(1u, std::thread::hardware_concurrency());
+            // with a placement only the CPUs given to the graph are used; the work pool has the rest
+            unsigned numberOfThreads = mConfig.singleThread ? 1u
+                                       : mConfig.placement ? unsigned(std::max(size_t(1), mConfig.placement->numCpus()))
+                                       : std::max(1u, std::thread::hardware_concurrency());
+            if (mGroupsPlaced)
+            {
+                numberOfThreads = unsigned(mConfig.placement->threadCount(numberOfThreads));
+            }
             for (unsigned threadId = 0; threadId < numberOfThreads; ++threadId)
             {
                 mThreads.emplace_back([this, threadId]{ workerThread(threadId); });
@@ -577,7 +677,7 @@ namespace VDD
 
         std::unique_lock<std::mutex> workLock(mWorkMutex);
         mAborted = true;
-        mWorkAvailable.notify_all();
+        notifyAllWorkersWithWorkMutexHeld();
     }
 
     void ParallelGraph::performanceLogging()
@@ -701,6 +801,10 @@ namespace VDD
                << (nodeInfo.areOutputsBlocked() ? "O" : "o") << (nodeInfo.nodeHasWork() ? "W" : "w")
                << (nodeInfo.isNodeOverEmployed() ? "E" : "e")
                << (nodeInfo.setParentBlocked ? "P" : "p");
+            if (nodeInfo.numaNode)
+            {
+                st << "\n" << "numa:" << *nodeInfo.numaNode;
+            }
         }
 
         return st.str();
@@ -23,8 +23,10 @@
 #include <set>
 #include <map>
 #include <chrono>
+#include <vector>
 
 #include "common/optional.h"
+#include "concurrency/cpuaffinity.h"
 #include "graphbase.h"
 
 namespace VDD {
@@ -35,6 +37,10 @@ namespace VDD {
             bool enablePerformanceLogging;
             bool enableDebugDump;
             bool singleThread;
+
+            // If set, worker threads are bound to CPUs as it describes and nodes with an affinity
+            // group are run only by the threads on the NUMA node of that group
+            std::shared_ptr<const ThreadPlacement> placement;
         };
 
         ParallelGraph(const Config& config);
@@ -63,7 +69,7 @@ namespace VDD {
         void nodeHasInput(AsyncProcessor* aNode, const Streams& aStreams);
 
         // A node didn't have data before, but now it does, and this is its time index. Ensures the
-        // old data is purged from mNodeAge, however does not write new one because
+        // old data is purged from mNodeAges, however does not write new one because
         // wakeWithWorkMutexHeld is to called after this. (But wakeWithWorkMutexHeld can be called
         // without calling updateNodeAgeWithWorkMutexHeld if the Indxe doesn't need to be updated.)
         void updateNodeAgeWithWorkMutexHeld(const AsyncNode* aNode, Index aIndex);
@@ -86,14 +92,39 @@ namespace VDD {
         // protects numActiveNodes, setNodeInactive, getActiveNodes
         mutable std::mutex mActiveNodesMutex;
 
-        // protects mNodeAge, mExceptions, mNumWaiting, mReadySequence, mAborted
+        // protects mNodeAges, mWorkers, mExceptions, mNumWaiting, mReadySequence, mAborted
         std::mutex mWorkMutex;
-        std::condition_variable mWorkAvailable;
         std::condition_variable mWorkReady; // also signals new mExceptions entries
         std::list<std::pair<const AsyncNode*, std::exception_ptr>> mExceptions;
 
         void workerThread(unsigned aThreadId);
 
+        // Are nodes with an affinity group restricted to the threads of a single NUMA node?
+        bool mGroupsPlaced;
+
+        using NodeAge = std::map<Index, std::set<const AsyncNode*>>;
+
+        // Finds the queue in mNodeAges whose oldest data is the oldest of the ones the threads of
+        // the given NUMA node may run. Returns nullptr if there is no work for them.
+        NodeAge* findWorkWithWorkMutexHeld(size_t aNumaNode);
+
+        // The threads of a NUMA node; with mGroupsPlaced there is one per node, otherwise just one
+        struct Workers
+        {
+            // signalled with notify_one when a node these threads may run gets work
+            std::condition_variable workAvailable;
+            // threads waiting for workAvailable
+            size_t numIdle = 0;
+            // notifications sent to them and not yet received
+            size_t numWakeups = 0;
+        };
+        std::vector<Workers> mWorkers;
+
+        // Wakes up an idle thread of the given NUMA node, or of the node with the most idle threads
+        // if the work may be run anywhere
+        void notifyWorkersWithWorkMutexHeld(const Optional<size_t>& aNumaNode);
+        void notifyAllWorkersWithWorkMutexHeld();
+
         struct NodeInfo
         {
             enum State
@@ -166,6 +197,9 @@ namespace VDD {
             // number of outputs produced by node; for debugging
             std::atomic<size_t> numOutputs;
 
+            // NUMA node this node must be run on, if mGroupsPlaced and it has an affinity group
+            Optional<size_t> numaNode;
+
             bool areOutputsBlocked() const {
                 return numBlockedOutputs >= 1;
             }
@@ -186,9 +220,12 @@ namespace VDD {
         size_t mStepReadySequence = 0; // what was mReadySequence the last time we stepped? used to determine progress and throttle ::step.
         bool mAborted = false;
 
-        // The way to find work, with the node with oldest node. Do ensure that a node never ends up
-        // in this map more than once.
-        std::map<Index, std::set<const AsyncNode*>> mNodeAge;
+        // The way to find work, with the node with oldest node. The first queue has the nodes any
+        // thread may run, and with mGroupsPlaced it is followed by one for the nodes of each NUMA
+        // node. Do ensure that a node never ends up in these more than once.
+        std::vector<NodeAge> mNodeAges;
+
+        NodeAge& nodeAgeOf(const NodeInfo& aNodeInfo);
 
         // snapshot of node performance information
         struct NodePerfInfo
@@ -0,0 +1,316 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures how omafvd-style processing graphs scale with and without binding the worker threads to
+// CPUs and NUMA nodes (the "affinity" options of the controller).
+//
+// Without a configuration file the benchmark builds a synthetic graph: every view has a source
+// producing frame ticks and a chain of stages that allocate, filter and checksum large frame
+// buffers, like decoding, tiling and encoding would. Each view is in its own affinity group. Each
+// placement mode is run with the same input and must produce the same checksum.
+//
+// With a configuration file the real omafvd controller is run once for each placement mode; the
+// output files of the configuration are overwritten on every run.
+//
+// Usage: affinitybenchmark [views] [frames] [frame size in MiB]
+//        affinitybenchmark config.json [--key=value ...]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "async/parallelgraph.h"
+#include "concurrency/cpuaffinity.h"
+#include "controller/controllerops.h"
+#include "controller/omafvdcontroller.h"
+#include "log/consolelog.h"
+#include "processor/lazysequencesource.h"
+#include "processor/processor.h"
+#include "processor/sink.h"
+
+namespace
+{
+    using namespace VDD;
+
+    typedef std::chrono::steady_clock Clock;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    struct PlacementMode
+    {
+        const char* name;
+        bool pinThreads;
+        bool numa;
+    };
+
+    const PlacementMode cPlacementModes[] = {
+        {"none", false, false},
+        {"pin_threads", true, false},
+        {"numa", false, true},
+        {"pin_threads+numa", true, true},
+    };
+
+    Data makeData(std::vector<std::uint8_t>&& aBytes, Index aIndex)
+    {
+        CodedFrameMeta meta{};
+        meta.presIndex = aIndex;
+        meta.codingIndex = aIndex;
+        meta.presTime = FrameTime(std::int64_t(aIndex), 25);
+        meta.codingTime = meta.presTime;
+        meta.duration = FrameDuration(1, 25);
+        return Data(CPUDataVector({std::move(aBytes)}), Meta(meta));
+    }
+
+    // One step of the synthetic pipeline: turns the bytes of the input into new bytes
+    class Stage : public Processor
+    {
+    public:
+        struct Config
+        {
+            std::function<std::vector<std::uint8_t>(const std::uint8_t* aData, size_t aSize, Index aIndex)> transform;
+        };
+
+        Stage(Config aConfig) : mConfig(aConfig)
+        {
+        }
+
+        StorageType getPreferredStorageType() const override
+        {
+            return StorageType::CPU;
+        }
+
+        std::vector<Streams> process(const Streams& aStreams) override
+        {
+            const Data& data = aStreams.front();
+            if (data.getStorageType() == StorageType::EndOfStream)
+            {
+                return {aStreams};
+            }
+            const CPUDataReference& ref = data.getCPUDataReference();
+            Index index = data.getCommonFrameMeta().presIndex;
+            return {{makeData(mConfig.transform(static_cast<const std::uint8_t*>(ref.address[0]), ref.size[0], index),
+                              index)}};
+        }
+
+    private:
+        Config mConfig;
+    };
+
+    class ChecksumSink : public Sink
+    {
+    public:
+        struct Config
+        {
+            std::atomic<std::uint64_t>* checksum;
+        };
+
+        ChecksumSink(Config aConfig) : mConfig(aConfig)
+        {
+        }
+
+        StorageType getPreferredStorageType() const override
+        {
+            return StorageType::CPU;
+        }
+
+        void consume(const Streams& aStreams) override
+        {
+            const Data& data = aStreams.front();
+            if (data.getStorageType() != StorageType::EndOfStream)
+            {
+                std::uint64_t value;
+                std::memcpy(&value, data.getCPUDataReference().address[0], sizeof(value));
+                *mConfig.checksum += value;
+            }
+        }
+
+    private:
+        Config mConfig;
+    };
+
+    std::uint64_t fnv1a(const std::uint8_t* aData, size_t aSize)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (size_t n = 0; n < aSize; ++n)
+        {
+            hash = (hash ^ aData[n]) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    void buildView(ControllerOps& aOps, size_t aFrames, size_t aFrameSize, std::atomic<std::uint64_t>& aChecksum)
+    {
+        auto frames = std::make_shared<size_t>(0);
+        LazySequenceSource::Config sourceConfig{};
+        sourceConfig.nextSample = [frames, aFrames]() -> Optional<Data> {
+            if (*frames == aFrames)
+            {
+                return {};
+            }
+            Index index = (*frames)++;
+            return makeData({std::uint8_t(index)}, index);
+        };
+        auto source = aOps.makeForGraph<LazySequenceSource>("source", sourceConfig);
+
+        // "decode": allocate and fill the frame on the thread that runs this stage
+        auto decode = aOps.makeForGraph<Stage>("decode", Stage::Config{[aFrameSize](const std::uint8_t*, size_t, Index aIndex) {
+            std::vector<std::uint8_t> frame(aFrameSize);
+            for (size_t n = 0; n < aFrameSize; ++n)
+            {
+                frame[n] = std::uint8_t(n * 31 + aIndex);
+            }
+            return frame;
+        }});
+
+        // "tile": read the whole frame and write a new one of the same size
+        auto tile = aOps.makeForGraph<Stage>("tile", Stage::Config{[](const std::uint8_t* aData, size_t aSize, Index) {
+            std::vector<std::uint8_t> frame(aSize);
+            std::uint8_t previous = 0;
+            for (size_t n = 0; n < aSize; ++n)
+            {
+                previous = std::uint8_t((aData[n] ^ 0x5a) + previous);
+                frame[n] = previous;
+            }
+            return frame;
+        }});
+
+        // "encode": read the whole frame and produce a small result
+        auto encode = aOps.makeForGraph<Stage>("encode", Stage::Config{[](const std::uint8_t* aData, size_t aSize, Index) {
+            std::uint64_t hash = fnv1a(aData, aSize);
+            std::vector<std::uint8_t> result(sizeof(hash));
+            std::memcpy(result.data(), &hash, sizeof(hash));
+            return result;
+        }});
+
+        auto sink = aOps.makeForGraph<ChecksumSink>("checksum", ChecksumSink::Config{&aChecksum});
+
+        connect(*source, *decode);
+        connect(*decode, *tile);
+        connect(*tile, *encode);
+        connect(*encode, *sink);
+    }
+
+    int runSynthetic(size_t aViews, size_t aFrames, size_t aFrameSize)
+    {
+        auto topology = CpuTopology::detect();
+        std::cout << "CPUs: " << topology.numCpus() << ", NUMA nodes: " << topology.nodes.size() << std::endl;
+        std::cout << "views: " << aViews << ", frames: " << aFrames << ", frame size: " << aFrameSize << " bytes"
+                  << std::endl;
+
+        auto log = std::make_shared<ConsoleLog>();
+        log->setLogLevel(LogLevel::Error);
+
+        Optional<std::uint64_t> expectedChecksum;
+        int rc = 0;
+        for (const auto& mode : cPlacementModes)
+        {
+            auto placement = std::make_shared<ThreadPlacement>(ThreadPlacement::Config{mode.pinThreads, mode.numa},
+                                                               topology);
+            std::atomic<std::uint64_t> checksum(0);
+            double seconds;
+            {
+                ParallelGraph graph({false, false, false, placement->isActive() ? placement : nullptr});
+                ControllerOps ops(graph, log);
+                for (size_t view = 0; view < aViews; ++view)
+                {
+                    AsyncNode::ScopeAffinityGroup scopeAffinityGroup(view);
+                    buildView(ops, aFrames, aFrameSize, checksum);
+                }
+
+                auto start = Clock::now();
+                GraphErrors errors;
+                while (graph.step(errors))
+                {
+                    // keep going
+                }
+                graph.stop();
+                seconds = secondsSince(start);
+                if (errors.size())
+                {
+                    std::cerr << mode.name << ": " << errors.front().message << std::endl;
+                    rc = 1;
+                }
+            }
+
+            bool ok = !expectedChecksum || *expectedChecksum == checksum.load();
+            expectedChecksum = checksum.load();
+            std::cout << mode.name << (placement->isActive() ? "" : " (no-op)") << ": " << seconds << " s, "
+                      << double(aViews * aFrames) / seconds << " frames/s, "
+                      << double(aViews * aFrames * aFrameSize) / seconds / (1024.0 * 1024.0) << " MiB/s"
+                      << (ok ? "" : " CHECKSUM MISMATCH") << std::endl;
+            if (!ok)
+            {
+                rc = 1;
+            }
+        }
+        return rc;
+    }
+
+    int runOmafvd(int aArgc, char** aArgv)
+    {
+        int rc = 0;
+        for (const auto& mode : cPlacementModes)
+        {
+            ControllerBase::Config config{};
+            config.config = std::make_shared<VDD::Config>();
+            config.log = std::make_shared<ConsoleLog>();
+            config.log->setLogLevel(LogLevel::Error);
+            try
+            {
+                config.config->commandline({aArgv, aArgv + aArgc});
+                config.config->setKeyJsonValue("affinity.pin_threads", Json::Value(mode.pinThreads));
+                config.config->setKeyJsonValue("affinity.numa", Json::Value(mode.numa));
+
+                auto start = Clock::now();
+                OmafVDController controller(config);
+                controller.run();
+                double seconds = secondsSince(start);
+                auto errors = controller.moveErrors();
+                std::cout << mode.name << ": " << seconds << " s" << (errors.size() ? " (with errors)" : "")
+                          << std::endl;
+                for (auto& error : errors)
+                {
+                    std::cerr << error.message << std::endl;
+                    rc = 1;
+                }
+            }
+            catch (Exception& exn)
+            {
+                std::cerr << mode.name << ": " << exn.message() << std::endl;
+                rc = 1;
+            }
+        }
+        return rc;
+    }
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && !(argv[1][0] >= '0' && argv[1][0] <= '9'))
+    {
+        return runOmafvd(argc, argv);
+    }
+
+    size_t views = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    size_t frames = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    size_t megabytes = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 8;
+
+    return runSynthetic(views, frames, megabytes * 1024 * 1024);
+}
@@ -0,0 +1,146 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures the cost of logging from many threads at the same time, like the nodes of a processing
+// graph do, with the synchronous ConsoleLog and with AsyncLog writing to a ConsoleLog. It also
+// measures the cost of logging to a disabled level.
+//
+// Every thread uses its own Log::instance(), as processors do. The log lines go to the given file
+// (by default /dev/null); the results are written to the standard output, one line per mode.
+//
+// Usage: logbenchmark [threads] [lines per thread] [log output file]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "log/asynclog.h"
+#include "log/consolelog.h"
+
+namespace
+{
+    using namespace VDD;
+
+    typedef std::chrono::steady_clock Clock;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    // Log aLines lines from each of aThreads threads; returns the time it took from the threads
+    double logFromThreads(Log& aLog, LogLevel aLevel, size_t aThreads, size_t aLines)
+    {
+        std::vector<std::shared_ptr<Log>> logs;
+        for (size_t thread = 0; thread < aThreads; ++thread)
+        {
+            logs.push_back(aLog.instance());
+        }
+
+        std::atomic<size_t> ready(0);
+        std::atomic<bool> go(false);
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < aThreads; ++thread)
+        {
+            threads.emplace_back([&, thread] {
+                Log& log = *logs[thread];
+                ++ready;
+                while (!go)
+                {
+                    std::this_thread::yield();
+                }
+                for (size_t line = 0; line < aLines; ++line)
+                {
+                    log(aLevel) << "view " << thread << " frame " << line << " encoded in " << 1.25 * double(line % 7)
+                                << " ms" << std::endl;
+                }
+            });
+        }
+        while (ready != aThreads)
+        {
+            std::this_thread::yield();
+        }
+
+        auto start = Clock::now();
+        go = true;
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return secondsSince(start);
+    }
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+    size_t lines = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000;
+    const char* logFile = argc > 3 ? argv[3] : "/dev/null";
+    size_t total = threads * lines;
+
+    // the results go to the original standard output, the log lines to logFile
+    FILE* report = fdopen(dup(fileno(stdout)), "w");
+    if (!report || !std::freopen(logFile, "w", stdout))
+    {
+        std::cerr << "Cannot open " << logFile << std::endl;
+        return 1;
+    }
+
+    {
+        auto log = std::make_shared<ConsoleLog>();
+        log->setLogLevel(LogLevel::Info);
+        double seconds = logFromThreads(*log, LogLevel::Info, threads, lines);
+        std::fflush(stdout);
+        std::fprintf(report, "mode=sync threads=%zu lines=%zu seconds=%.3f lines_per_second=%.0f\n", threads, total,
+                     seconds, double(total) / seconds);
+    }
+
+    {
+        auto target = std::make_shared<ConsoleLog>();
+        target->setLogLevel(LogLevel::Info);
+        AsyncLog::Config config{};
+        config.target = target;
+        AsyncLog log(config);
+        auto start = Clock::now();
+        double producerSeconds = logFromThreads(log, LogLevel::Info, threads, lines);
+        log.flush();
+        std::fflush(stdout);
+        double seconds = secondsSince(start);
+        std::fprintf(report,
+                     "mode=async threads=%zu lines=%zu producer_seconds=%.3f seconds=%.3f "
+                     "producer_lines_per_second=%.0f lines_per_second=%.0f\n",
+                     threads, total, producerSeconds, seconds, double(total) / producerSeconds,
+                     double(total) / seconds);
+    }
+
+    {
+        auto log = std::make_shared<ConsoleLog>();
+        log->setLogLevel(LogLevel::Error);
+        double seconds = logFromThreads(*log, LogLevel::Debug, threads, lines);
+        std::fprintf(report, "mode=disabled threads=%zu lines=%zu seconds=%.3f lines_per_second=%.0f\n", threads,
+                     total, seconds, double(total) / seconds);
+    }
+
+    std::fclose(report);
+    return 0;
+}
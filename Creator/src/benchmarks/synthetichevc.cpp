@@ -0,0 +1,280 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "synthetichevc.h"
+
+#include "omaf/parser/bitstream.hpp"
+#include "omaf/parser/h265parser.hpp"
+
+namespace VDD
+{
+    namespace
+    {
+        const unsigned cLog2CtbSize = 6;
+        const unsigned cLog2MaxPocLsb = 8;
+
+        enum NalUnitType : unsigned
+        {
+            TrailR = 1,
+            IdrWRadl = 19,
+            Vps = 32,
+            Sps = 33,
+            Pps = 34
+        };
+
+        enum SliceType : unsigned
+        {
+            P = 1,
+            I = 2
+        };
+
+        void writeNalUnitHeader(Parser::BitStream& aBits, NalUnitType aType)
+        {
+            aBits.writeBits(0, 1);       // forbidden_zero_bit
+            aBits.writeBits(aType, 6);   // nal_unit_type
+            aBits.writeBits(0, 6);       // nuh_layer_id
+            aBits.writeBits(1, 3);       // nuh_temporal_id_plus1
+        }
+
+        void writeTrailingBits(Parser::BitStream& aBits)
+        {
+            aBits.writeBits(1, 1);
+            while (aBits.getBitOffset() != 0)
+            {
+                aBits.writeBits(0, 1);
+            }
+        }
+
+        // Main profile, level 5.1, single sub-layer
+        void writeProfileTierLevel(Parser::BitStream& aBits)
+        {
+            aBits.writeBits(0, 2);           // general_profile_space
+            aBits.writeBits(0, 1);           // general_tier_flag
+            aBits.writeBits(1, 5);           // general_profile_idc
+            aBits.writeBits(0x60000000, 32); // general_profile_compatibility_flag[1..2]
+            aBits.writeBits(1, 1);           // general_progressive_source_flag
+            aBits.writeBits(0, 1);           // general_interlaced_source_flag
+            aBits.writeBits(0, 1);           // general_non_packed_constraint_flag
+            aBits.writeBits(1, 1);           // general_frame_only_constraint_flag
+            aBits.writeBits(0, 22);          // general_reserved_zero_44bits
+            aBits.writeBits(0, 22);
+            aBits.writeBits(153, 8);         // general_level_idc
+        }
+
+        void appendNalUnit(std::vector<std::uint8_t>& aStream, Parser::BitStream& aBits)
+        {
+            H265Parser::convertFromRBSP(aBits.getStorage(), aStream);
+        }
+
+        void appendVps(std::vector<std::uint8_t>& aStream)
+        {
+            Parser::BitStream bits;
+            writeNalUnitHeader(bits, Vps);
+            bits.writeBits(0, 4);            // vps_video_parameter_set_id
+            bits.writeBits(1, 1);            // vps_base_layer_internal_flag
+            bits.writeBits(1, 1);            // vps_base_layer_available_flag
+            bits.writeBits(0, 6);            // vps_max_layers_minus1
+            bits.writeBits(0, 3);            // vps_max_sub_layers_minus1
+            bits.writeBits(1, 1);            // vps_temporal_id_nesting_flag
+            bits.writeBits(0xffff, 16);      // vps_reserved_0xffff_16bits
+            writeProfileTierLevel(bits);
+            bits.writeBits(1, 1);            // vps_sub_layer_ordering_info_present_flag
+            bits.writeExpGolombCode(1);      // vps_max_dec_pic_buffering_minus1
+            bits.writeExpGolombCode(0);      // vps_max_num_reorder_pics
+            bits.writeExpGolombCode(0);      // vps_max_latency_increase_plus1
+            bits.writeBits(0, 6);            // vps_max_layer_id
+            bits.writeExpGolombCode(0);      // vps_num_layer_sets_minus1
+            bits.writeBits(0, 1);            // vps_timing_info_present_flag
+            bits.writeBits(0, 1);            // vps_extension_flag
+            writeTrailingBits(bits);
+            appendNalUnit(aStream, bits);
+        }
+
+        void appendSps(std::vector<std::uint8_t>& aStream, const SyntheticHevcConfig& aConfig)
+        {
+            Parser::BitStream bits;
+            writeNalUnitHeader(bits, Sps);
+            bits.writeBits(0, 4);            // sps_video_parameter_set_id
+            bits.writeBits(0, 3);            // sps_max_sub_layers_minus1
+            bits.writeBits(1, 1);            // sps_temporal_id_nesting_flag
+            writeProfileTierLevel(bits);
+            bits.writeExpGolombCode(0);      // sps_seq_parameter_set_id
+            bits.writeExpGolombCode(1);      // chroma_format_idc: 4:2:0
+            bits.writeExpGolombCode(aConfig.tilesX * aConfig.tileSize);  // pic_width_in_luma_samples
+            bits.writeExpGolombCode(aConfig.tilesY * aConfig.tileSize);  // pic_height_in_luma_samples
+            bits.writeBits(0, 1);            // conformance_window_flag
+            bits.writeExpGolombCode(0);      // bit_depth_luma_minus8
+            bits.writeExpGolombCode(0);      // bit_depth_chroma_minus8
+            bits.writeExpGolombCode(cLog2MaxPocLsb - 4);  // log2_max_pic_order_cnt_lsb_minus4
+            bits.writeBits(1, 1);            // sps_sub_layer_ordering_info_present_flag
+            bits.writeExpGolombCode(1);      // sps_max_dec_pic_buffering_minus1
+            bits.writeExpGolombCode(0);      // sps_max_num_reorder_pics
+            bits.writeExpGolombCode(0);      // sps_max_latency_increase_plus1
+            bits.writeExpGolombCode(0);      // log2_min_luma_coding_block_size_minus3
+            bits.writeExpGolombCode(cLog2CtbSize - 3);  // log2_diff_max_min_luma_coding_block_size
+            bits.writeExpGolombCode(0);      // log2_min_luma_transform_block_size_minus2
+            bits.writeExpGolombCode(3);      // log2_diff_max_min_luma_transform_block_size
+            bits.writeExpGolombCode(0);      // max_transform_hierarchy_depth_inter
+            bits.writeExpGolombCode(0);      // max_transform_hierarchy_depth_intra
+            bits.writeBits(0, 1);            // scaling_list_enabled_flag
+            bits.writeBits(0, 1);            // amp_enabled_flag
+            bits.writeBits(0, 1);            // sample_adaptive_offset_enabled_flag
+            bits.writeBits(0, 1);            // pcm_enabled_flag
+            bits.writeExpGolombCode(1);      // num_short_term_ref_pic_sets
+            // st_ref_pic_set(0): the previous picture
+            bits.writeExpGolombCode(1);      // num_negative_pics
+            bits.writeExpGolombCode(0);      // num_positive_pics
+            bits.writeExpGolombCode(0);      // delta_poc_s0_minus1
+            bits.writeBits(1, 1);            // used_by_curr_pic_s0_flag
+            bits.writeBits(0, 1);            // long_term_ref_pics_present_flag
+            bits.writeBits(0, 1);            // sps_temporal_mvp_enabled_flag
+            bits.writeBits(0, 1);            // strong_intra_smoothing_enabled_flag
+            bits.writeBits(1, 1);            // vui_parameters_present_flag
+            // vui_parameters(): only the timing, which gives the frame rate
+            bits.writeBits(0, 1);            // aspect_ratio_info_present_flag
+            bits.writeBits(0, 1);            // overscan_info_present_flag
+            bits.writeBits(0, 1);            // video_signal_type_present_flag
+            bits.writeBits(0, 1);            // chroma_loc_info_present_flag
+            bits.writeBits(0, 1);            // neutral_chroma_indication_flag
+            bits.writeBits(0, 1);            // field_seq_flag
+            bits.writeBits(0, 1);            // frame_field_info_present_flag
+            bits.writeBits(0, 1);            // default_display_window_flag
+            bits.writeBits(1, 1);            // vui_timing_info_present_flag
+            bits.writeBits(1, 32);           // vui_num_units_in_tick
+            bits.writeBits(aConfig.frameRate, 32);  // vui_time_scale
+            bits.writeBits(0, 1);            // vui_poc_proportional_to_timing_flag
+            bits.writeBits(0, 1);            // vui_hrd_parameters_present_flag
+            bits.writeBits(0, 1);            // bitstream_restriction_flag
+            bits.writeBits(0, 1);            // sps_extension_present_flag
+            writeTrailingBits(bits);
+            appendNalUnit(aStream, bits);
+        }
+
+        void appendPps(std::vector<std::uint8_t>& aStream, const SyntheticHevcConfig& aConfig)
+        {
+            Parser::BitStream bits;
+            writeNalUnitHeader(bits, Pps);
+            bits.writeExpGolombCode(0);      // pps_pic_parameter_set_id
+            bits.writeExpGolombCode(0);      // pps_seq_parameter_set_id
+            bits.writeBits(0, 1);            // dependent_slice_segments_enabled_flag
+            bits.writeBits(0, 1);            // output_flag_present_flag
+            bits.writeBits(0, 3);            // num_extra_slice_header_bits
+            bits.writeBits(0, 1);            // sign_data_hiding_enabled_flag
+            bits.writeBits(0, 1);            // cabac_init_present_flag
+            bits.writeExpGolombCode(0);      // num_ref_idx_l0_default_active_minus1
+            bits.writeExpGolombCode(0);      // num_ref_idx_l1_default_active_minus1
+            bits.writeSignedExpGolombCode(0);  // init_qp_minus26
+            bits.writeBits(0, 1);            // constrained_intra_pred_flag
+            bits.writeBits(0, 1);            // transform_skip_enabled_flag
+            bits.writeBits(0, 1);            // cu_qp_delta_enabled_flag
+            bits.writeSignedExpGolombCode(0);  // pps_cb_qp_offset
+            bits.writeSignedExpGolombCode(0);  // pps_cr_qp_offset
+            bits.writeBits(0, 1);            // pps_slice_chroma_qp_offsets_present_flag
+            bits.writeBits(0, 1);            // weighted_pred_flag
+            bits.writeBits(0, 1);            // weighted_bipred_flag
+            bits.writeBits(0, 1);            // transquant_bypass_enabled_flag
+            bits.writeBits(1, 1);            // tiles_enabled_flag
+            bits.writeBits(0, 1);            // entropy_coding_sync_enabled_flag
+            bits.writeExpGolombCode(aConfig.tilesX - 1);  // num_tile_columns_minus1
+            bits.writeExpGolombCode(aConfig.tilesY - 1);  // num_tile_rows_minus1
+            bits.writeBits(1, 1);            // uniform_spacing_flag
+            bits.writeBits(0, 1);            // loop_filter_across_tiles_enabled_flag
+            bits.writeBits(0, 1);            // pps_loop_filter_across_slices_enabled_flag
+            bits.writeBits(0, 1);            // deblocking_filter_control_present_flag
+            bits.writeBits(0, 1);            // pps_scaling_list_data_present_flag
+            bits.writeBits(0, 1);            // lists_modification_present_flag
+            bits.writeExpGolombCode(0);      // log2_parallel_merge_level_minus2
+            bits.writeBits(0, 1);            // slice_segment_header_extension_present_flag
+            bits.writeBits(0, 1);            // pps_extension_present_flag
+            writeTrailingBits(bits);
+            appendNalUnit(aStream, bits);
+        }
+
+        unsigned ceilLog2(std::uint32_t aValue)
+        {
+            unsigned bits = 0;
+            while ((std::uint32_t(1) << bits) < aValue)
+            {
+                ++bits;
+            }
+            return bits;
+        }
+
+        void appendSlice(std::vector<std::uint8_t>& aStream, const SyntheticHevcConfig& aConfig,
+                         std::uint32_t aPocLsb, std::uint32_t aTileX, std::uint32_t aTileY)
+        {
+            const bool idr = aPocLsb == 0;
+            const std::uint32_t tileCtbs = aConfig.tileSize >> cLog2CtbSize;
+            const std::uint32_t picWidthInCtbs = aConfig.tilesX * tileCtbs;
+            const std::uint32_t picSizeInCtbs = picWidthInCtbs * aConfig.tilesY * tileCtbs;
+            const std::uint32_t address = aTileY * tileCtbs * picWidthInCtbs + aTileX * tileCtbs;
+
+            Parser::BitStream bits;
+            writeNalUnitHeader(bits, idr ? IdrWRadl : TrailR);
+            bits.writeBits(address == 0, 1);  // first_slice_segment_in_pic_flag
+            if (idr)
+            {
+                bits.writeBits(0, 1);        // no_output_of_prior_pics_flag
+            }
+            bits.writeExpGolombCode(0);      // slice_pic_parameter_set_id
+            if (address != 0)
+            {
+                bits.writeBits(address, ceilLog2(picSizeInCtbs));  // slice_segment_address
+            }
+            bits.writeExpGolombCode(idr ? I : P);  // slice_type
+            if (!idr)
+            {
+                bits.writeBits(aPocLsb, cLog2MaxPocLsb);  // slice_pic_order_cnt_lsb
+                bits.writeBits(1, 1);        // short_term_ref_pic_set_sps_flag
+                bits.writeBits(0, 1);        // num_ref_idx_active_override_flag
+                bits.writeExpGolombCode(0);  // five_minus_max_num_merge_cand
+            }
+            bits.writeSignedExpGolombCode(0);  // slice_qp_delta
+            bits.writeExpGolombCode(0);      // num_entry_point_offsets
+            writeTrailingBits(bits);         // byte_alignment()
+
+            // filler slice data; never zero, so it needs no emulation prevention
+            const std::uint32_t size = idr ? 4 * aConfig.tileBytes : aConfig.tileBytes;
+            const std::uint32_t seed = aPocLsb * 131 + aTileY * 17 + aTileX;
+            for (std::uint32_t i = 0; i < size; ++i)
+            {
+                bits.write8Bits(0x80 | ((seed + i * 37) & 0x7f));
+            }
+            appendNalUnit(aStream, bits);
+        }
+    }  // anonymous namespace
+
+    std::vector<std::uint8_t> makeSyntheticHevc(const SyntheticHevcConfig& aConfig)
+    {
+        std::vector<std::uint8_t> stream;
+        for (std::uint32_t frame = 0; frame < aConfig.frames; ++frame)
+        {
+            std::uint32_t pocLsb = frame % aConfig.gopLength;
+            if (pocLsb == 0)
+            {
+                appendVps(stream);
+                appendSps(stream, aConfig);
+                appendPps(stream, aConfig);
+            }
+            for (std::uint32_t tileY = 0; tileY < aConfig.tilesY; ++tileY)
+            {
+                for (std::uint32_t tileX = 0; tileX < aConfig.tilesX; ++tileX)
+                {
+                    appendSlice(stream, aConfig, pocLsb, tileX, tileY);
+                }
+            }
+        }
+        return stream;
+    }
+}  // namespace VDD
@@ -0,0 +1,40 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace VDD
+{
+    // A synthetic H.265 stream whose pictures are split into a uniform grid of tiles, one slice per
+    // tile, with an IDR picture every gopLength pictures and P pictures in between. The parameter
+    // sets and slice headers are real but the slice data is filler, so the stream can be parsed,
+    // split into tiles and segmented like an encoder output, but not decoded. The filler depends
+    // only on the picture and tile index, so the stream is the same on every run.
+    struct SyntheticHevcConfig
+    {
+        std::uint32_t tilesX = 6;
+        std::uint32_t tilesY = 4;
+        std::uint32_t tileSize = 256;     // tile width and height in luma samples; multiple of 64
+        std::uint32_t frames = 250;
+        std::uint32_t frameRate = 25;
+        std::uint32_t gopLength = 25;     // less than 256
+        std::uint32_t tileBytes = 2000;   // slice data per tile in P pictures; IDR pictures get 4x
+    };
+
+    // Returns the stream in byte stream format, with the parameter sets before each IDR picture
+    std::vector<std::uint8_t> makeSyntheticHevc(const SyntheticHevcConfig& aConfig);
+}  // namespace VDD
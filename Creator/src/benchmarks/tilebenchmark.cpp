@@ -0,0 +1,221 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures the tile path of omafvd with a synthetic tiled H.265 stream (see synthetichevc.h)
+// written into the work directory:
+//
+// - tileproducer: TileProducer::process splitting the pictures into subpictures, with the frames
+//   read into memory beforehand
+// - omafvd: the whole MultiQ DASH pipeline run by OmafVDController with the synthetic stream as
+//   both qualities of every view, which covers the H.265 loader, the ParallelGraph scheduling,
+//   the tiling and the segmenting; its output is written into the work directory
+//
+// The results are written one line per measurement as key=value pairs, including the
+// allocations made and the peak resident set size.
+//
+// Usage: tilebenchmark [frames] [tiles horizontally] [tiles vertically] [views] [work directory]
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "benchmarkreport.hpp"
+#include "controller/omafvdcontroller.h"
+#include "log/consolelog.h"
+#include "medialoader/h265loader.h"
+#include "omaf/tileproducer.h"
+#include "synthetichevc.h"
+
+namespace
+{
+    using namespace VDD;
+
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint32_t cGopLength = 25;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    int runTileProducer(const std::string& aFilename, const SyntheticHevcConfig& aConfig)
+    {
+        H265Source::Config sourceConfig{};
+        sourceConfig.filename = aFilename;
+        sourceConfig.gopLength = int(cGopLength);
+        sourceConfig.videoNalStartCodes = true;  // like omafvd, as TileProducer parses byte streams
+        H265Source source(sourceConfig);
+        std::vector<Streams> frames;
+        bool end = false;
+        while (!end)
+        {
+            for (auto& streams : source.produce())
+            {
+                end = end || streams.isEndOfStream();
+                frames.push_back(streams);
+            }
+        }
+
+        TileProducer::Config config{};
+        config.quality = 1;
+        config.extractorMode = CREATE_EXTRACTOR;
+        config.projection.projection = OmafProjectionType::Equirectangular;
+        config.videoMode = VideoInputMode::Mono;
+        config.tileCount = aConfig.tilesX * aConfig.tilesY;
+        config.resetExtractorLevelIDCTo51 = false;
+        for (std::uint32_t tile = 0; tile < config.tileCount; ++tile)
+        {
+            OmafTileSetConfiguration tileConfig;
+            tileConfig.trackId = TrackId(tile + 1);
+            tileConfig.trackGroupId = TrackGroupId(tile + 1);
+            tileConfig.label = std::to_string(tile + 1);
+            tileConfig.streamId = StreamId(tile + 1);
+            tileConfig.tileIndex = TileIndex(tile);
+            config.tileConfig.push_back(tileConfig);
+        }
+        TileProducer tileProducer(config);
+
+        size_t inputBytes = 0;
+        size_t outputFrames = 0;
+        auto usage = getResourceUsage();
+        auto start = Clock::now();
+        for (const auto& streams : frames)
+        {
+            if (!streams.isEndOfStream())
+            {
+                inputBytes += streams.front().getCPUDataReference().size[0];
+            }
+            for (const auto& output : tileProducer.process(streams))
+            {
+                outputFrames += output.isEndOfStream() ? 0 : 1;
+            }
+        }
+        double seconds = secondsSince(start);
+
+        size_t pictures = frames.size() - 1;
+        std::cout << "benchmark=tileproducer frames=" << pictures << " tiles=" << config.tileCount
+                  << " seconds=" << seconds
+                  << " frames_per_second=" << double(pictures) / seconds
+                  << " mib_per_second=" << double(inputBytes) / seconds / (1024.0 * 1024.0) << " "
+                  << formatResourceUsage(usage) << std::endl;
+        return outputFrames == pictures ? 0 : 1;
+    }
+
+    int runOmafvd(const std::string& aDirectory, const std::string& aFilename, size_t aFrames, size_t aViews)
+    {
+        Json::Value video(Json::objectValue);
+        video["bg"]["filename"] = aFilename;
+        video["bg"]["quality"] = 5;
+        video["bg"]["gop_length"] = cGopLength;
+        video["fg"]["filename"] = aFilename;
+        video["fg"]["quality"] = 1;
+        video["fg"]["gop_length"] = cGopLength;
+
+        Json::Value root(Json::objectValue);
+        root["video"]["common"]["projection"] = "equirectangular";
+        root["video"]["common"]["output_mode"] = "MultiQ";
+        for (size_t view = 0; view < aViews; ++view)
+        {
+            Json::Value viewConfig(Json::objectValue);
+            viewConfig["id"] = Json::UInt(view);
+            viewConfig["video"] = video;
+            root["views"].append(viewConfig);
+        }
+        root["dash"]["output_directory_base"] = aDirectory + "/";
+        root["dash"]["output_name_base"] = "tilebenchmark";
+        root["dash"]["media"]["segment_name"]["video"] = "$Name$.video.$Segment$.mp4";
+        root["dash"]["media"]["segment_name"]["base"] = "$Name$.base.$Segment$.mp4";
+
+        ControllerBase::Config config{};
+        config.config = std::make_shared<VDD::Config>();
+        config.log = std::make_shared<ConsoleLog>();
+        config.log->setLogLevel(LogLevel::Error);
+        int rc = 0;
+        try
+        {
+            for (const auto& key : root.getMemberNames())
+            {
+                config.config->setKeyJsonValue(key, root[key]);
+            }
+
+            auto usage = getResourceUsage();
+            auto start = Clock::now();
+            OmafVDController controller(config);
+            controller.run();
+            double seconds = secondsSince(start);
+            for (auto& error : controller.moveErrors())
+            {
+                std::cerr << error.message << std::endl;
+                rc = 1;
+            }
+            std::cout << "benchmark=omafvd views=" << aViews << " frames=" << aFrames << " seconds=" << seconds
+                      << " frames_per_second=" << double(aViews * aFrames) / seconds << " "
+                      << formatResourceUsage(usage) << std::endl;
+        }
+        catch (Exception& exn)
+        {
+            std::cerr << "omafvd: " << exn.message() << std::endl;
+            rc = 1;
+        }
+        return rc;
+    }
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    installAllocationCounter();
+
+    SyntheticHevcConfig hevcConfig{};
+    hevcConfig.frames = argc > 1 ? std::uint32_t(std::strtoul(argv[1], nullptr, 10)) : 250;
+    hevcConfig.tilesX = argc > 2 ? std::uint32_t(std::strtoul(argv[2], nullptr, 10)) : 6;
+    hevcConfig.tilesY = argc > 3 ? std::uint32_t(std::strtoul(argv[3], nullptr, 10)) : 4;
+    hevcConfig.gopLength = cGopLength;
+    size_t views = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 2;
+    std::string directory = argc > 5 ? argv[5] : ".";
+    if (hevcConfig.frames == 0 || hevcConfig.tilesX == 0 || hevcConfig.tilesY == 0 || views == 0)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [frames] [tiles horizontally] [tiles vertically] [views] [work directory]" << std::endl;
+        return 1;
+    }
+
+    std::string filename = directory + "/tilebenchmark.h265";
+    {
+        std::vector<std::uint8_t> stream = makeSyntheticHevc(hevcConfig);
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(stream.data()), std::streamsize(stream.size()));
+        if (!file)
+        {
+            std::cerr << "Failed to write " << filename << std::endl;
+            return 1;
+        }
+    }
+
+    int rc = 0;
+    try
+    {
+        rc = runTileProducer(filename, hevcConfig);
+    }
+    catch (Exception& exn)
+    {
+        std::cerr << "tileproducer: " << exn.message() << std::endl;
+        rc = 1;
+    }
+    return runOmafvd(directory, filename, hevcConfig.frames, views) || rc;
+}
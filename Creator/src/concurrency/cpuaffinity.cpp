@@ -0,0 +1,264 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "cpuaffinity.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace VDD
+{
+    namespace
+    {
+#if defined(__linux__)
+        // Parses the kernel cpulist format, ie. "0-3,8-11"
+        CpuSet parseCpuList(const std::string& aList)
+        {
+            CpuSet cpus;
+            size_t pos = 0;
+            while (pos < aList.size())
+            {
+                size_t end = aList.find(',', pos);
+                if (end == std::string::npos)
+                {
+                    end = aList.size();
+                }
+                std::string range = aList.substr(pos, end - pos);
+                size_t dash = range.find('-');
+                if (range.size() && range[0] >= '0' && range[0] <= '9')
+                {
+                    unsigned first = unsigned(std::strtoul(range.c_str(), nullptr, 10));
+                    unsigned last = dash == std::string::npos
+                                        ? first
+                                        : unsigned(std::strtoul(range.c_str() + dash + 1, nullptr, 10));
+                    for (unsigned cpu = first; cpu <= last; ++cpu)
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+                pos = end + 1;
+            }
+            return cpus;
+        }
+
+        CpuSet processCpus()
+        {
+            CpuSet cpus;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            {
+                for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &set))
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+            return cpus;
+        }
+
+        std::vector<CpuSet> numaNodeCpus(const CpuSet& aAllowed)
+        {
+            std::vector<std::pair<unsigned, CpuSet>> nodes;
+            const std::string base = "/sys/devices/system/node";
+            if (DIR* dir = opendir(base.c_str()))
+            {
+                while (struct dirent* entry = readdir(dir))
+                {
+                    std::string name = entry->d_name;
+                    if (name.size() > 4 && name.substr(0, 4) == "node" &&
+                        name.find_first_not_of("0123456789", 4) == std::string::npos)
+                    {
+                        std::ifstream file(base + "/" + name + "/cpulist");
+                        std::string list;
+                        if (file && std::getline(file, list))
+                        {
+                            CpuSet cpus;
+                            for (unsigned cpu : parseCpuList(list))
+                            {
+                                if (std::find(aAllowed.begin(), aAllowed.end(), cpu) != aAllowed.end())
+                                {
+                                    cpus.push_back(cpu);
+                                }
+                            }
+                            if (cpus.size())
+                            {
+                                nodes.push_back({unsigned(std::stoul(name.substr(4))), cpus});
+                            }
+                        }
+                    }
+                }
+                closedir(dir);
+            }
+            std::sort(nodes.begin(), nodes.end());
+            std::vector<CpuSet> result;
+            for (auto& node : nodes)
+            {
+                result.push_back(std::move(node.second));
+            }
+            return result;
+        }
+#endif
+    }  // anonymous namespace
+
+    size_t CpuTopology::numCpus() const
+    {
+        size_t count = 0;
+        for (auto& node : nodes)
+        {
+            count += node.size();
+        }
+        return count;
+    }
+
+    std::pair<CpuTopology, CpuTopology> CpuTopology::split(size_t aCount) const
+    {
+        std::pair<CpuTopology, CpuTopology> topologies;
+        for (auto& cpus : nodes)
+        {
+            if (cpus.size() > 1)
+            {
+                size_t kept = cpus.size() - std::min(std::max(aCount, size_t(1)), cpus.size() - 1);
+                topologies.first.nodes.push_back(CpuSet(cpus.begin(), cpus.begin() + std::ptrdiff_t(kept)));
+                topologies.second.nodes.push_back(CpuSet(cpus.begin() + std::ptrdiff_t(kept), cpus.end()));
+            }
+            else
+            {
+                topologies.first.nodes.push_back(cpus);
+                topologies.second.nodes.push_back(cpus);
+            }
+        }
+        return topologies;
+    }
+
+    CpuTopology CpuTopology::detect()
+    {
+        CpuTopology topology;
+#if defined(__linux__)
+        CpuSet allowed = processCpus();
+        topology.nodes = numaNodeCpus(allowed);
+        if (topology.nodes.empty() && allowed.size())
+        {
+            topology.nodes.push_back(allowed);
+        }
+#endif
+        if (topology.nodes.empty())
+        {
+            CpuSet cpus;
+            for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+            topology.nodes.push_back(cpus);
+        }
+        return topology;
+    }
+
+    bool setCurrentThreadAffinity(const CpuSet& aCpus)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (unsigned cpu : aCpus)
+        {
+            if (cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void) aCpus;
+        return false;
+#endif
+    }
+
+    ThreadPlacement::ThreadPlacement(Config aConfig, CpuTopology aTopology)
+        : mConfig(aConfig)
+        , mTopology(aTopology)
+        , mNumaActive(aConfig.numa && aTopology.nodes.size() > 1)
+    {
+        // nothing
+    }
+
+    bool ThreadPlacement::isActive() const
+    {
+        return mConfig.pinThreads || mNumaActive;
+    }
+
+    size_t ThreadPlacement::numNodes() const
+    {
+        return mNumaActive ? mTopology.nodes.size() : 1u;
+    }
+
+    size_t ThreadPlacement::numCpus() const
+    {
+        return mTopology.numCpus();
+    }
+
+    size_t ThreadPlacement::nodeOfThread(size_t aThreadIndex) const
+    {
+        return aThreadIndex % numNodes();
+    }
+
+    size_t ThreadPlacement::nodeOfGroup(size_t aGroup) const
+    {
+        return aGroup % numNodes();
+    }
+
+    size_t ThreadPlacement::threadCount(size_t aRequested) const
+    {
+        return std::max(aRequested, numNodes());
+    }
+
+    void ThreadPlacement::applyToCurrentThread(size_t aThreadIndex) const
+    {
+        if (mNumaActive)
+        {
+            const CpuSet& cpus = mTopology.nodes[nodeOfThread(aThreadIndex)];
+            if (mConfig.pinThreads)
+            {
+                setCurrentThreadAffinity({cpus[(aThreadIndex / numNodes()) % cpus.size()]});
+            }
+            else
+            {
+                setCurrentThreadAffinity(cpus);
+            }
+        }
+        else if (mConfig.pinThreads)
+        {
+            size_t index = aThreadIndex % mTopology.numCpus();
+            for (auto& cpus : mTopology.nodes)
+            {
+                if (index < cpus.size())
+                {
+                    setCurrentThreadAffinity({cpus[index]});
+                    break;
+                }
+                index -= cpus.size();
+            }
+        }
+    }
+}
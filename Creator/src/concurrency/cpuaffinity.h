@@ -0,0 +1,91 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace VDD
+{
+    using CpuSet = std::vector<unsigned>;
+
+    // The CPUs available to this process, grouped by their NUMA node
+    struct CpuTopology
+    {
+        // CPUs of each NUMA node that has at least one CPU available to the process. There is
+        // always at least one entry, so machines without NUMA information look like a single node.
+        std::vector<CpuSet> nodes;
+
+        size_t numCpus() const;
+
+        // Splits the CPUs of each node in two: the last aCount (at least one) CPUs of the node go
+        // to the second topology and the rest to the first, though the first one keeps at least
+        // one. A node with a single CPU is in both.
+        std::pair<CpuTopology, CpuTopology> split(size_t aCount) const;
+
+        // Reads the topology from /sys/devices/system/node on Linux; elsewhere returns a single node
+        // with std::thread::hardware_concurrency() CPUs
+        static CpuTopology detect();
+    };
+
+    // Binds the calling thread to the given CPUs. Returns false if this is not supported on this
+    // platform or the operation fails; in that case the thread is left as it was.
+    bool setCurrentThreadAffinity(const CpuSet& aCpus);
+
+    // Decides where worker threads and groups of work (see AsyncNode::ScopeAffinityGroup) are run.
+    // Threads are spread over the NUMA nodes in round-robin order, so thread n runs on node
+    // n % numNodes(). On Linux memory is allocated by default from the node of the CPU that first
+    // touches it, so buffers produced by a pinned thread end up local to that node.
+    class ThreadPlacement
+    {
+    public:
+        struct Config
+        {
+            // Pin each thread to a single CPU
+            bool pinThreads = false;
+
+            // Keep threads, and the groups assigned to them, on a single NUMA node each
+            bool numa = false;
+        };
+
+        ThreadPlacement(Config aConfig, CpuTopology aTopology = CpuTopology::detect());
+
+        // Does placing threads do anything at all? False if nothing was enabled, or if only NUMA
+        // placement was enabled and the machine has a single node.
+        bool isActive() const;
+
+        // Number of NUMA nodes work is distributed to; 1 if NUMA placement is not in effect
+        size_t numNodes() const;
+
+        // Number of CPUs threads are placed on
+        size_t numCpus() const;
+
+        size_t nodeOfThread(size_t aThreadIndex) const;
+
+        size_t nodeOfGroup(size_t aGroup) const;
+
+        // Adjusts a thread count so that each node gets at least one thread
+        size_t threadCount(size_t aRequested) const;
+
+        // Call from the thread itself as the first thing it does
+        void applyToCurrentThread(size_t aThreadIndex) const;
+
+    private:
+        const Config mConfig;
+        const CpuTopology mTopology;
+        const bool mNumaActive;
+    };
+}
@@ -19,6 +19,7 @@ namespace VDD
     struct ThreadedWorkPool::Thread
     {
         std::thread thread;
+        size_t index;
     };
 
     Job::Job() = default;
@@ -30,15 +31,18 @@ namespace VDD
     {
         for (size_t n = 0; n < mConfig.numThreads; ++n)
         {
-            mThreads.push_back(Thread { std::thread() });
+            mThreads.push_back(Thread { std::thread(), n });
             Thread* thread = &mThreads.back();
             thread->thread = std::thread([this,thread](){ run(thread); });
         }
     }
 
-    void ThreadedWorkPool::run(ThreadedWorkPool::Thread*)
+    void ThreadedWorkPool::run(ThreadedWorkPool::Thread* aThread)
     {
-        /* the Thread* is not actually (currently) used here.. */
+        if (mConfig.placement)
+        {
+            mConfig.placement->applyToCurrentThread(aThread->index);
+        }
         bool exit = false;
         while (!exit) {
             std::unique_ptr<Job> job;
@@ -22,6 +22,7 @@
 #include <thread>
 
 #include "common/exceptions.h"
+#include "cpuaffinity.h"
 
 namespace VDD
 {
@@ -47,6 +48,9 @@ namespace VDD
 
             // Number of threads to use for executing the jobs.
             size_t numThreads;
+
+            // If set, threads are bound to CPUs as it describes
+            std::shared_ptr<const ThreadPlacement> placement;
         };
 
         ThreadedWorkPool(Config aConfig);
@@ -48,6 +48,11 @@ namespace VDD
     FrameDuration timescaleForSamples(const std::vector<Sample>& aSamples,
                                       Optional<FrameTime::value> aGopDenominator);
 
+    /** @brief Find an optimal time scale for the given distinct denominators; the same result
+        timescaleForSamples gives for samples with these presentation time denominators */
+    template <typename Container>
+    FrameDuration timescaleForDenominators(const Container& aDenominators);
+
     struct SegmentDurations
     {
         StreamSegmenter::Segmenter::Duration segmentDuration;
@@ -53,6 +53,25 @@ namespace VDD
         }  // namespace
     }  // namespace PipelineModeDefs
 
+    namespace
+    {
+        // The graph threads and the work pool threads are placed on disjoint CPUs of each NUMA
+        // node, so the threads pinned by one never compete for a CPU with the ones of the other
+        std::shared_ptr<ThreadPlacement> makeThreadPlacement(const Config& aConfig, bool aForWorkPool)
+        {
+            ThreadPlacement::Config placementConfig{
+                optionWithDefault(aConfig.root(), "affinity.pin_threads", readBool, false),
+                optionWithDefault(aConfig.root(), "affinity.numa", readBool, false)};
+            CpuTopology topology = CpuTopology::detect();
+            // by default a quarter of the CPUs of each node runs the work pool
+            size_t workPoolCpus = optionWithDefault(aConfig.root(), "affinity.work_pool_cpus", readUInt,
+                                                    unsigned(std::max(size_t(1), topology.nodes.front().size() / 4)));
+            auto topologies = topology.split(workPoolCpus);
+            return std::make_shared<ThreadPlacement>(placementConfig,
+                                                     aForWorkPool ? topologies.second : topologies.first);
+        }
+    }  // namespace
+
     std::string nameOfPipelineMode(PipelineMode aOutput)
     {
         return PipelineModeDefs::kPipelineModeTypeToName.at(aOutput);
@@ -74,14 +93,22 @@ namespace VDD
         : mConfig(aConfig.config)
         , mLog(aConfig.log ? aConfig.log : std::shared_ptr<Log>(new ConsoleLog()))
         , mParallel(optionWithDefault(mConfig->root(), "parallel", readBool, true))
+        , mThreadPlacement(makeThreadPlacement(*mConfig, false))
+        , mWorkPoolPlacement(makeThreadPlacement(*mConfig, true))
+        , mAffinityPerTileSet(optionWithDefault(mConfig->root(), "affinity.tile_sets", readBool, false))
         , mGraph(mParallel
                  ? static_cast<GraphBase*>(new ParallelGraph({
                                                optionWithDefault(mConfig->root(), "debug.parallel.perf", readBool, false),
                                                optionWithDefault(mConfig->root(), "debug.dump", readBool, false),
                                                optionWithDefault(mConfig->root(), "debug.parallel.singlethread", readBool, false),
+                                               mThreadPlacement->isActive() ? mThreadPlacement : nullptr,
                                            }))
                  : static_cast<GraphBase*>(new SequentialGraph()))
-        , mWorkPool(ThreadedWorkPool::Config { 2, mParallel ? std::max(1u, std::thread::hardware_concurrency()) : 0u })
+        , mWorkPool(ThreadedWorkPool::Config { 2,
+                                               !mParallel ? 0u
+                                               : mWorkPoolPlacement->isActive() ? mWorkPoolPlacement->numCpus()
+                                               : std::max(1u, std::thread::hardware_concurrency()),
+                                               mWorkPoolPlacement->isActive() ? mWorkPoolPlacement : nullptr })
         , mDotFile(VDD::readOptional(readString)((*mConfig).tryTraverse(mConfig->root(), configPathOfString("debug.dot"))))
         , mOps(new ControllerOps(*mGraph, mLog))
         , mDash((*mConfig)["dash"] ? std::make_unique<DashOmaf>(mLog, (*mConfig)["dash"], *mOps) : std::unique_ptr<DashOmaf>())
@@ -112,6 +139,11 @@ namespace VDD
         }
     }
 
+    AffinityGroup ControllerBase::newAffinityGroup()
+    {
+        return mNextAffinityGroup++;
+    }
+
     StreamId ControllerBase::newExtractorAdaptationSetIt()
     {
         if (mDash) {
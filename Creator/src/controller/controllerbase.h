@@ -76,6 +76,10 @@ namespace VDD
         StreamId newExtractorAdaptationSetIt(); // Gives a nice number like 1000, 2000, etc
         TrackId newTrackId();
 
+        /** A new group for AsyncNode::ScopeAffinityGroup; nodes in one group stay on the same NUMA
+            node when "affinity.numa" is enabled */
+        AffinityGroup newAffinityGroup();
+
         /** Retrieve Dash durations; useful for determining ie. GOP length. */
         SegmentDurations getDashDurations() const;
 
@@ -102,6 +106,10 @@ namespace VDD
         std::shared_ptr<Log> mLog;
 
         bool mParallel;
+        std::shared_ptr<ThreadPlacement> mThreadPlacement;  // for the graph
+        std::shared_ptr<ThreadPlacement> mWorkPoolPlacement;
+        bool mAffinityPerTileSet; // otherwise per view
+        AffinityGroup mNextAffinityGroup = 0;
         std::unique_ptr<GraphBase> mGraph;
         ThreadedWorkPool mWorkPool;
         Optional<std::string> mDotFile;
@@ -112,6 +112,8 @@ namespace VDD
             assert(false);
         }
         config.gopLength = readOptional(readInt)(aMP4LoaderConfig["gop_length"]);
+        config.ingestThreads = readOptional(readUInt)(aMP4LoaderConfig["ingest_threads"]);
+        config.indexCacheDir = readOptional(readFilename)(aMP4LoaderConfig["index_cache_dir"]);
         return config;
     }
 
@@ -81,6 +81,7 @@ namespace VDD
         , mBaseDirectory(optionWithDefault(mDashConfig, "output_directory_base", readString, ""))
         , mDashProfile(optionWithDefault(mDashConfig, "profile", readDashProfile, DashProfile::Live))
         , mOutputMode(optionWithDefault(mDashConfig, "output_mode", readOutputMode, OutputMode::OMAFV1))
+        , mOnDemandSinglePass(optionWithDefault(mDashConfig, "on_demand_single_pass", readBool, false))
     {
         if (mCompactNumbering)
         {
@@ -91,6 +92,19 @@ namespace VDD
             mNextId = 1000;
         }
         assert(mDashConfig);
+
+        std::uint32_t ioThreads = optionWithDefault(mDashConfig, "io.threads", readUint32, 0u);
+        if (ioThreads > 0)
+        {
+            SegmentWriter::Config writerConfig{};
+            writerConfig.threads = ioThreads;
+            writerConfig.queueLength =
+                optionWithDefault(mDashConfig, "io.queue_length", readUint32, 16u);
+            writerConfig.preallocate =
+                optionWithDefault(mDashConfig, "io.preallocate", readBool, false);
+            writerConfig.direct = optionWithDefault(mDashConfig, "io.direct", readBool, false);
+            mWriter = std::make_shared<SegmentWriter>(writerConfig);
+        }
     }
 
     std::string Dash::getBaseName() const
@@ -119,6 +133,11 @@ namespace VDD
         if (!segmentSaverSignals.count(aDashOutput.segmenterName))
         {
             SegmentSaverSignal signal;
+            if (mCheckpoint)
+            {
+                // the segments before the restart are not produced again
+                signal.segmentsTotalDuration = mCheckpoint->getSkippedDuration();
+            }
             CombineNode::Config config{};
             config.labelPrefix = "SegmentSaverHook";
             signal.combineSignals = Utils::make_unique<CombineNode>(mOps.getGraph(), config);
@@ -198,4 +217,47 @@ namespace VDD
     {
         return "1";
     }
+
+    void Dash::setShard(size_t aIndex)
+    {
+        mShardIndex = aIndex;
+    }
+
+    std::string Dash::shardFilename(const std::string& aFilename) const
+    {
+        if (!mShardIndex)
+        {
+            return aFilename;
+        }
+        std::string suffix = ".shard" + std::to_string(*mShardIndex);
+        auto dot = aFilename.rfind('.');
+        auto slash = aFilename.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        {
+            return aFilename + suffix;
+        }
+        return aFilename.substr(0, dot) + suffix + aFilename.substr(dot);
+    }
+
+    void Dash::setupCheckpoint(const ConfigValue& aRootConfig)
+    {
+        if (auto filename = readOptional(readString)(mDashConfig["checkpoint"]))
+        {
+            std::string config = aRootConfig.singleLineRepresentation();
+            SegmentCheckpoint::Config checkpointConfig{};
+            checkpointConfig.filename =
+                shardFilename(Utils::joinPathComponents(getBaseDirectory(), *filename));
+            checkpointConfig.configHash = SegmentCheckpoint::hash(config.data(), config.size());
+            mCheckpoint = std::make_shared<SegmentCheckpoint>(checkpointConfig);
+        }
+    }
+
+    Optional<FrameTime> Dash::getRestartSeekTime() const
+    {
+        if (!mCheckpoint)
+        {
+            return {};
+        }
+        return mCheckpoint->getVideoSeekTime();
+    }
 }  // namespace VDD
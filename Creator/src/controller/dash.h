@@ -165,6 +165,21 @@ namespace VDD
         /** @brief Retrieve current Dash profile */
         DashProfile getProfile() const;
 
+        /** @brief If the "checkpoint" option names a journal file, opens it so that an
+         * interrupted run of the same configuration (aRootConfig) resumes from its first
+         * missing segment, and segments already saved are not written again. */
+        void setupCheckpoint(const ConfigValue& aRootConfig);
+
+        /** @brief When resuming, the presentation time the video sources can start from; see
+         * SegmentCheckpoint::getVideoSeekTime */
+        Optional<FrameTime> getRestartSeekTime() const;
+
+        /** @brief Mark this process as shard aIndex of a sharded run. The MPD and the checkpoint
+         * journal then get a ".shard<index>" suffix, so the shards don't overwrite each other's
+         * files and omafmpdmerge can combine the partial MPDs. Must be called before
+         * setupCheckpoint and DashOmaf::setupMpd. */
+        void setShard(size_t aIndex);
+
         /** @breif Returns the (fixed) default period id; goes away when we're going to support multiple periods */
         std::string getDefaultPeriodId() const;
 
@@ -213,6 +228,21 @@ namespace VDD
         DashProfile mDashProfile = DashProfile::Live;
 
         OutputMode mOutputMode = OutputMode::None;
+
+        // Write on-demand files front to back without seeking (see SingleFileSave::Config)
+        bool mOnDemandSinglePass = false;
+
+        // Shared by all segment Save nodes; set by setupCheckpoint
+        std::shared_ptr<SegmentCheckpoint> mCheckpoint;
+
+        // Shared by all segment Save and SingleFileSave nodes if the "io.threads" option is set
+        std::shared_ptr<SegmentWriter> mWriter;
+
+        // Set by setShard
+        Optional<size_t> mShardIndex;
+
+        /** @brief Insert the shard suffix (if any) before the extension of aFilename */
+        std::string shardFilename(const std::string& aFilename) const;
     };
 
 }
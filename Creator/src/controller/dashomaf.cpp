@@ -94,7 +94,7 @@ namespace VDD
                 throw ConfigValueInvalid("Missing name for the MPD or the output name in general", mDashConfig["mpd"]);
             }
 
-            mMpdFilename = Utils::joinPathComponents(getBaseDirectory(), mMpdFilename);
+            mMpdFilename = shardFilename(Utils::joinPathComponents(getBaseDirectory(), mMpdFilename));
 
             Utils::ensurePathForFilename(mMpdFilename);
 
@@ -1040,6 +1040,8 @@ namespace VDD
                 config.fileTemplate = Utils::joinPathComponents(
                     getBaseDirectory(), Utils::replace(templ, "$Segment$", "init"));
                 config.disable = aMetaConfig.disableMediaOutput;
+                config.checkpoint = mCheckpoint;
+                config.writer = mWriter;
                 c.segmentInitSaverConfig = config;
             }
             break;
@@ -1056,6 +1058,8 @@ namespace VDD
                                            aOutput.getClass() == PipelineClass::IndexSegment;
             // note that sidx are generated for index segments by MoofCombine
             config.expectSegmentIndex = true;
+            config.singlePass = mOnDemandSinglePass;
+            config.writer = mWriter;
             c.singleFileSaverConfig = config;
 
             break;
@@ -1070,6 +1074,7 @@ namespace VDD
             {}                       // dts cts offset
         };
 
+        Optional<SegmentRestart> restart;
         switch (mDashProfile)
         {
         case DashProfile::Live:
@@ -1078,7 +1083,15 @@ namespace VDD
             config.fileTemplate = Utils::joinPathComponents(
                 getBaseDirectory(), Utils::replace(templ, "$Segment$", "$Number$"));
             config.disable = aMetaConfig.disableMediaOutput;
+            config.checkpoint = mCheckpoint;
+            config.writer = mWriter;
             c.segmenterAndSaverConfig.segmentSaverConfig = config;
+            if (mCheckpoint)
+            {
+                mCheckpoint->addRepresentation(
+                    config.fileTemplate, aOutput.getMediaType() == StreamSegmenter::MediaType::Video);
+                restart = mCheckpoint->getRestart(config.fileTemplate);
+            }
             break;
         }
         case DashProfile::OnDemand:
@@ -1106,6 +1119,7 @@ namespace VDD
         // ensure that the first frame of each segment is infact an IDR frame (or throw ExpectedIDRFrame if not)
         c.segmenterAndSaverConfig.segmenterConfig.checkIDR = true;
         c.segmenterAndSaverConfig.segmenterConfig.sidx = mDashProfile == DashProfile::OnDemand;
+        c.segmenterAndSaverConfig.segmenterConfig.restart = restart;
 
         WriteSegmentHeader writeSegmentHeader;
         switch (getOutputMode())
@@ -38,9 +38,15 @@ namespace VDD
         // Set the GOP length explicitly; used with H265
         Optional<int> gopLength;
 
+        // Memory-map H265 input and assemble this many GOPs in parallel; used with H265
+        Optional<unsigned> ingestThreads;
+
+        // Directory for caching the sample tables of the file between runs; used with MP4
+        Optional<std::string> indexCacheDir;
+
         MP4Loader::Config getMP4LoaderConfig() const
         {
-            return MP4Loader::Config{filename, initFilename, startNumber};
+            return MP4Loader::Config{filename, initFilename, startNumber, indexCacheDir};
         }
 
         H265Loader::Config getH265LoaderConfig() const
@@ -53,7 +59,7 @@ namespace VDD
             {
                 throw ConfigValueReadError("H265 does not use init file name");
             }
-            return H265Loader::Config{filename, gopLength, startNumber};
+            return H265Loader::Config{filename, gopLength, startNumber, ingestThreads};
         }
 
         std::unique_ptr<MediaLoader> makeMediaLoader(bool aVideoNalStartCodes) const;
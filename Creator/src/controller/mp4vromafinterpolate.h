@@ -14,6 +14,8 @@
  */
 #pragma once
 
+#include <list>
+
 #include "config/config.h"
 #include "reader/mp4vrfiledatatypes.h"
 
@@ -43,6 +45,36 @@ namespace VDD
     template <typename AugmentedSample>
         void validateTimedMetadata(const std::vector<AugmentedSample>& aSamples);
 
+    /** @brief Produces the interpolated samples one at a time, so the whole interpolated track
+        never needs to be held in memory. performSampleInterpolation collects its output. */
+    template <typename Sample>
+    class SampleInterpolator
+    {
+    public:
+        SampleInterpolator(std::vector<InterpolatedSample<Sample>> aSamples,
+                           Optional<StreamSegmenter::Segmenter::Duration> aForceFrameInterval);
+
+        /** @brief Returns the next interpolated sample, or an empty Optional after the last
+            one */
+        Optional<InterpolatedSample<Sample>> next();
+
+    private:
+        // Advances over the input until mPending has at least one sample or input ends
+        void fillPending();
+
+        void pushSplitSample(FrameDuration aDurationLeft, InterpolatedSample<Sample>& aSample);
+
+        std::vector<InterpolatedSample<Sample>> mSamples;
+        Optional<StreamSegmenter::Segmenter::Duration> mForceFrameInterval;
+        StreamSegmenter::Segmenter::Duration mTimeInSegment;
+
+        size_t mIndex = 0u;
+        // Set while walking the interpolation range between mSamples[mIndex] and the next one
+        Optional<FrameTime> mInterpolationTime;
+
+        std::list<InterpolatedSample<Sample>> mPending;
+    };
+
     template <typename Sample>
     std::vector<InterpolatedSample<Sample>> performSampleInterpolation(
         const std::vector<InterpolatedSample<Sample>>& aSamples,
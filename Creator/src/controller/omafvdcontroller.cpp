@@ -207,6 +207,8 @@ namespace VDD
     OmafVDController::OmafVDController(Config aConfig)
         : ControllerBase(aConfig)
         , mParseOnly(optionWithDefault(mConfig->root(), "debug.parse_only", readBool, false))
+        , mShardIndex(optionWithDefault(mConfig->root(), "shard.index", readUint32, 0u))
+        , mShardCount(optionWithDefault(mConfig->root(), "shard.count", readUint32, 1u))
     {
         if ((*mConfig)["mp4"] && (*mConfig)["dash"])
         {
@@ -221,6 +223,26 @@ namespace VDD
             mMP4VRConfig->fileMeta = mFileMeta;
         }
 
+        if (mShardCount == 0 || mShardIndex >= mShardCount)
+        {
+            throw ConfigValueInvalid("Shard index must be less than shard count",
+                                     mConfig->root()["shard"]);
+        }
+        if (mShardCount > 1)
+        {
+            if (!mDash)
+            {
+                throw ConfigValueInvalid("Sharding is only supported for DASH output",
+                                         mConfig->root()["shard"]);
+            }
+            mDash->setShard(mShardIndex);
+        }
+
+        if (mDash)
+        {
+            mDash->setupCheckpoint(mConfig->root());
+        }
+
         // toplevel video-setting can be overridden by individal view settings
         ConfigValue videoConfig = (*mConfig)["video"];
 
@@ -252,15 +274,25 @@ namespace VDD
                     videoConfig.markBranchVisited();
                     viewConfig["video"].merge(videoConfig, fillBlanksJsonMergeStrategy);
                 }
-                mViews.emplace_back(*this, *mGraph, ControllerOps(*mOps, config), viewConfig, mLog,
-                                    viewpointId, ViewpointGroupId(0u));
+                auto sourcesBefore = mGraph->copySources();
+                {
+                    AsyncNode::ScopeAffinityGroup scopeAffinityGroup(newAffinityGroup());
+                    mViews.emplace_back(*this, *mGraph, ControllerOps(*mOps, config), viewConfig,
+                                        mLog, viewpointId, ViewpointGroupId(0u));
+                }
+                assignViewSourcesToShard(mViews.size() - 1, sourcesBefore);
                 ++viewpointId;
             }
         }
         else
         {
-            mViews.emplace_back(*this, *mGraph, *mOps, mConfig->root(), mLog, ViewId(0u),
-                                ViewpointGroupId(0u));
+            auto sourcesBefore = mGraph->copySources();
+            {
+                AsyncNode::ScopeAffinityGroup scopeAffinityGroup(newAffinityGroup());
+                mViews.emplace_back(*this, *mGraph, *mOps, mConfig->root(), mLog, ViewId(0u),
+                                    ViewpointGroupId(0u));
+            }
+            assignViewSourcesToShard(0u, sourcesBefore);
         }
 
         makeEntityGroups();
@@ -307,6 +339,14 @@ namespace VDD
     {
         AsyncNode::ScopeColored scopeColored("green");
 
+        // Each tile set gets its own group when requested, otherwise it stays in the group of its
+        // view
+        std::unique_ptr<AsyncNode::ScopeAffinityGroup> scopeAffinityGroup;
+        if (mAffinityPerTileSet && aPipelineBuildInfo && aPipelineBuildInfo->streamId)
+        {
+            scopeAffinityGroup.reset(new AsyncNode::ScopeAffinityGroup(newAffinityGroup()));
+        }
+
         PipelineInfo sourcePipelineInfo{};
         sourcePipelineInfo.source = aSources[aPipelineOutput].first;
 
@@ -1123,8 +1163,7 @@ namespace VDD
 
             TmdTrackContext tmdTrackContext {};
             auto source = createSourceForTimedMetadataTrack(tmdTrackContext, *mOps, decl);
-            FrameDuration timescale =
-                timescaleForSamples(createSamplesForTimedMetadataTrack(tmdTrackContext, decl), {});
+            FrameDuration timescale = timescaleForTimedMetadataTrack(decl);
 
 
             if (mDash)
@@ -1181,6 +1220,40 @@ namespace VDD
         }
     }
 
+    void OmafVDController::assignViewSourcesToShard(size_t aViewIndex,
+                                                    const std::set<AsyncSource*>& aSourcesBefore)
+    {
+        bool otherShard = aViewIndex % mShardCount != mShardIndex;
+        for (AsyncSource* source : mGraph->copySources())
+        {
+            if (!aSourcesBefore.count(source))
+            {
+                mViewSources.insert(source);
+                if (otherShard)
+                {
+                    mOtherShardSources.insert(source);
+                }
+            }
+        }
+    }
+
+    void OmafVDController::abortOtherShards()
+    {
+        size_t numAborted = 0u;
+        for (AsyncSource* source : mGraph->copySources())
+        {
+            // sources not created by any view (ie. the global timed metadata) belong to shard 0
+            if (mOtherShardSources.count(source) ||
+                (mShardIndex != 0u && !mViewSources.count(source)))
+            {
+                source->abort();
+                ++numAborted;
+            }
+        }
+        mLog->log(Info) << "Shard " << mShardIndex << "/" << mShardCount << ": skipping "
+                        << numAborted << " sources belonging to other shards" << std::endl;
+    }
+
     void OmafVDController::writeDot()
     {
         if (mDotFile)
@@ -1213,6 +1286,11 @@ namespace VDD
         {
             bool keepWorking = true;
 
+            if (mShardCount > 1)
+            {
+                abortOtherShards();
+            }
+
             std::chrono::time_point<std::chrono::steady_clock> prevDotDumpTime =
                 std::chrono::steady_clock::now();
 
@@ -18,6 +18,7 @@
 #include <functional>
 #include <map>
 #include <mutex>
+#include <set>
 #include <tuple>
 #include <ctime>
 
@@ -204,11 +205,27 @@ namespace VDD
 
         void makeTimedMetadata();
 
+        /** @brief Record the sources created while constructing the view at aViewIndex (those
+         * not in aSourcesBefore). With "shard": { "index": i, "count": n } views are processed
+         * round-robin, so view k is handled by the process having index k % n. */
+        void assignViewSourcesToShard(size_t aViewIndex,
+                                      const std::set<AsyncSource*>& aSourcesBefore);
+
+        /** @brief Abort the sources of views handled by other shards, so that only the segments
+         * and the partial MPD of this shard's views are produced */
+        void abortOtherShards();
+
     private:
         GraphErrors mErrors;
 
         bool mParseOnly; // only parse the config, don't run the graph
 
+        // Every shard builds the full graph so that all ids match, but runs only its own sources
+        size_t mShardIndex;
+        size_t mShardCount;
+        std::set<AsyncSource*> mViewSources;
+        std::set<AsyncSource*> mOtherShardSources;
+
         Optional<MP4VRWriter::Config> mMP4VRConfig;
         MP4VROutputs mMP4VROutputs;
         std::list<std::function<void(void)>> mPostponedOperations;
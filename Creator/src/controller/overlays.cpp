@@ -24,8 +24,8 @@
 #include "mp4vromafinterpolate.h"
 #include "mp4vromafreaders.h"
 #include "mp4vrwriter.h"
+#include "processor/lazysequencesource.h"
 #include "processor/metamodifyprocessor.h"
-#include "processor/sequencesource.h"
 #include "segmenter/tagtrackidprocessor.h"
 
 namespace VDD
@@ -93,43 +93,62 @@ namespace VDD
         }
 
         template <typename AugmentedSample>
-        std::vector<Data> convertTimedMetaToData(
-            const std::vector<AugmentedSample> aTimed, CodedFormat aCodedFormat,
+        using AugmentedSampleType = decltype(AugmentedSample::sample);
+
+        /** @brief Returns a function that interpolates and converts the samples one at a time,
+         * for LazySequenceSource; it returns an empty Optional after the last sample */
+        template <typename AugmentedSample>
+        std::function<Optional<Data>()> timedMetaDataGenerator(
+            const std::vector<AugmentedSample>& aTimed, CodedFormat aCodedFormat,
             std::shared_ptr<StreamSegmenter::Segmenter::SampleEntry> aSampleEntry,
             Optional<StreamSegmenter::Segmenter::Duration> aForceFrameInterval)
         {
-            std::vector<Data> datas;
-
-            Index presIndex{};
-            CodingIndex codingIndex{};
-
-            for (auto& sample : performSampleInterpolation(aTimed, aForceFrameInterval))
-            {
-                auto bytes = sample.sample.toBytes();
+            auto interpolator = std::make_shared<SampleInterpolator<AugmentedSampleType<AugmentedSample>>>(
+                aTimed, aForceFrameInterval);
+            auto index = std::make_shared<std::uint64_t>(0u);
+            return [interpolator, index, aCodedFormat, aSampleEntry]() -> Optional<Data> {
+                auto sample = interpolator->next();
+                if (!sample)
+                {
+                    return {};
+                }
+                auto bytes = sample->sample.toBytes();
                 std::vector<uint8_t> bytesVec{bytes.begin(), bytes.end()};
                 CPUDataVector dataVec{{std::move(bytesVec)}};
                 CodedFrameMeta codedFrameMeta{};
-                codedFrameMeta.presIndex = presIndex;
-                codedFrameMeta.codingIndex = codingIndex;
+                codedFrameMeta.presIndex = Index(*index);
+                codedFrameMeta.codingIndex = CodingIndex(*index);
                 codedFrameMeta.type = FrameType::IDR;
                 codedFrameMeta.format = aCodedFormat;
-                codedFrameMeta.codingTime = sample.time;
-                codedFrameMeta.presTime = sample.time;
-                codedFrameMeta.duration = sample.duration;
+                codedFrameMeta.codingTime = sample->time;
+                codedFrameMeta.presTime = sample->time;
+                codedFrameMeta.duration = sample->duration;
                 codedFrameMeta.inCodingOrder = true;
                 Meta meta(codedFrameMeta);
                 if (aSampleEntry)
                 {
                     meta.attachTag(SampleEntryTag(aSampleEntry));
                 }
-                Data data(dataVec, meta);
-                datas.push_back(data);
+                ++*index;
+                return Data(dataVec, meta);
+            };
+        }
 
-                ++presIndex;
-                ++codingIndex;
+        /** @brief The presentation time denominators of the interpolated samples, computed
+         * without keeping the samples; empty if there are none */
+        template <typename AugmentedSample>
+        std::set<FrameTime::value> timedMetaDenominators(
+            const std::vector<AugmentedSample>& aTimed,
+            Optional<StreamSegmenter::Segmenter::Duration> aForceFrameInterval)
+        {
+            std::set<FrameTime::value> denominators;
+            SampleInterpolator<AugmentedSampleType<AugmentedSample>> interpolator(aTimed,
+                                                                                aForceFrameInterval);
+            while (auto sample = interpolator.next())
+            {
+                denominators.insert(sample->time.minimize().den);
             }
-
-            return datas;
+            return denominators;
         }
     }  // namespace
 
@@ -474,8 +493,6 @@ namespace VDD
         OverlayMetaTrackInfo metaInfo;
         PipelineOutput output{PipelineOutputTimedMetadata::TimedMetadata};
 
-        SequenceSource::Config sequenceConfig{};
-
         Optional<StreamSegmenter::Segmenter::Duration> forceFrameInterval;
         if (aDashInfo)
         {
@@ -485,14 +502,13 @@ namespace VDD
                 StreamSegmenter::Segmenter::Duration(segmentDurations.subsegmentsPerSegment, 1);
         }
 
-        sequenceConfig.samples =
-            convertTimedMetaToData(aSamples, aCodedFormat, aSampleEntry, forceFrameInterval);
+        std::set<FrameTime::value> denominators = timedMetaDenominators(aSamples, forceFrameInterval);
 
-        if (sequenceConfig.samples.size())
+        if (denominators.size())
         {
-            FrameDuration timescale = timescaleForSamples(
-                sequenceConfig.samples,
+            denominators.insert(
                 static_cast<FrameTime::value>(aVideoTrackInfo.gopInfo.duration.minimize().den));
+            FrameDuration timescale = timescaleForDenominators(denominators);
 
             std::map<std::string, std::set<TrackId>> trefs;
             if (aVideoTrackInfo.overlayMediaTrackIds.size())
@@ -510,7 +526,10 @@ namespace VDD
                 metaInfo.mp4vrSink = mp4vrSink;
             }
 
-            AsyncNode* source = aOps.makeForGraph<SequenceSource>("TMD for OMAF", sequenceConfig);
+            LazySequenceSource::Config sequenceConfig{};
+            sequenceConfig.nextSample =
+                timedMetaDataGenerator(aSamples, aCodedFormat, aSampleEntry, forceFrameInterval);
+            AsyncNode* source = aOps.makeForGraph<LazySequenceSource>("TMD for OMAF", sequenceConfig);
 
             if (aDashInfo && aDashInfo->dash)
             {
@@ -24,7 +24,7 @@
 #include "config/config.h"
 #include "omaf/omafviewingorientation.h"
 #include "processor/staticmetadatagenerator.h"
-#include "processor/sequencesource.h"
+#include "processor/lazysequencesource.h"
 #include "segmenter/tagtrackidprocessor.h"
 
 namespace VDD
@@ -381,35 +381,82 @@ namespace VDD
         return Data(contents, meta);
     }
 
-    template <typename Declaration>
-    void createSamplesForType(const TmdTrackContext& aTmdTrackContext, const Declaration* aTimedMetadata, std::vector<Data>& aSamples)
+    namespace
     {
-        if (aTimedMetadata)
+        template <typename Declaration>
+        using DeclarationSample =
+            decltype(std::remove_reference<decltype(Declaration::samples)>::type::value_type::sample);
+
+        template <typename Declaration>
+        std::function<Optional<Data>()> sampleGeneratorForType(
+            const TmdTrackContext& aTmdTrackContext, const Declaration& aTimedMetadata)
+        {
+            auto interpolator =
+                std::make_shared<SampleInterpolator<DeclarationSample<Declaration>>>(
+                    aTimedMetadata.samples, Optional<StreamSegmenter::Segmenter::Duration>{});
+            auto index = std::make_shared<size_t>(0u);
+            auto config = aTimedMetadata.config;
+            return [aTmdTrackContext, interpolator, index, config]() -> Optional<Data> {
+                auto sample = interpolator->next();
+                if (!sample)
+                {
+                    return {};
+                }
+                assert(sample->duration.num > 0);
+                return dataOfTimedMetadataSample<Declaration>(aTmdTrackContext, config,
+                                                              Index((*index)++), *sample);
+            };
+        }
+
+        template <typename Declaration>
+        void timeDenominatorsForType(const Declaration* aTimedMetadata,
+                                     std::set<FrameTime::value>& aDenominators)
         {
-            auto interpolated = performSampleInterpolation(aTimedMetadata->samples, {});
-            for (size_t index = 0; index < interpolated.size(); ++index)
+            if (aTimedMetadata)
             {
-                auto& sample = interpolated[index];
-                assert(sample.duration.num > 0);
-                auto data = dataOfTimedMetadataSample<Declaration>(
-                    aTmdTrackContext, aTimedMetadata->config, Index(index), sample);
-                aSamples.push_back(data);
+                SampleInterpolator<DeclarationSample<Declaration>> interpolator(
+                    aTimedMetadata->samples, {});
+                while (auto sample = interpolator.next())
+                {
+                    aDenominators.insert(sample->time.minimize().den);
+                }
             }
         }
-    }
+    }  // namespace
 
-    std::vector<Data> createSamplesForTimedMetadataTrack(
+    std::function<Optional<Data>()> sampleGeneratorForTimedMetadataTrack(
         const TmdTrackContext& aTmdTrackContext, const TimedMetadataDeclaration& aTimedMetadata)
     {
-        std::vector<Data> samples;
+        switch (aTimedMetadata.getKey())
+        {
+        case TimedMetadataType::Rcvp:
+            return sampleGeneratorForType(aTmdTrackContext,
+                                          aTimedMetadata.at<TimedMetadataType::Rcvp>());
+        case TimedMetadataType::Invp:
+            return sampleGeneratorForType(aTmdTrackContext,
+                                          aTimedMetadata.at<TimedMetadataType::Invp>());
+        case TimedMetadataType::Dyol:
+            return sampleGeneratorForType(aTmdTrackContext,
+                                          aTimedMetadata.at<TimedMetadataType::Dyol>());
+        case TimedMetadataType::Dyvp:
+            return sampleGeneratorForType(aTmdTrackContext,
+                                          aTimedMetadata.at<TimedMetadataType::Dyvp>());
+        }
+        assert(false);
+        return {};
+    }
+
+    FrameDuration timescaleForTimedMetadataTrack(const TimedMetadataDeclaration& aTimedMetadata)
+    {
+        std::set<FrameTime::value> denominators;
 
         // Only one of these does proper work, others skip
-        createSamplesForType(aTmdTrackContext, aTimedMetadata.atPtr<TimedMetadataType::Rcvp>(), samples);
-        createSamplesForType(aTmdTrackContext, aTimedMetadata.atPtr<TimedMetadataType::Invp>(), samples);
-        createSamplesForType(aTmdTrackContext, aTimedMetadata.atPtr<TimedMetadataType::Dyol>(), samples);
-        createSamplesForType(aTmdTrackContext, aTimedMetadata.atPtr<TimedMetadataType::Dyvp>(), samples);
+        timeDenominatorsForType(aTimedMetadata.atPtr<TimedMetadataType::Rcvp>(), denominators);
+        timeDenominatorsForType(aTimedMetadata.atPtr<TimedMetadataType::Invp>(), denominators);
+        timeDenominatorsForType(aTimedMetadata.atPtr<TimedMetadataType::Dyol>(), denominators);
+        timeDenominatorsForType(aTimedMetadata.atPtr<TimedMetadataType::Dyvp>(), denominators);
 
-        return samples;
+        return timescaleForDenominators(denominators);
     }
 
     AsyncNode* createSourceForTimedMetadataTrack(const TmdTrackContext& aTmdTrackContext,
@@ -441,8 +488,8 @@ namespace VDD
         };
         }
 
-        SequenceSource::Config config{};
-        config.samples = createSamplesForTimedMetadataTrack(aTmdTrackContext, aTimedMetadata);
-        return aOps.makeForGraph<SequenceSource>(label, config);
+        LazySequenceSource::Config config{};
+        config.nextSample = sampleGeneratorForTimedMetadataTrack(aTmdTrackContext, aTimedMetadata);
+        return aOps.makeForGraph<LazySequenceSource>(label, config);
     }
 }
@@ -14,6 +14,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <list>
 #include <string>
 
@@ -189,9 +190,16 @@ namespace VDD
     {
     };
 
-    std::vector<Data> createSamplesForTimedMetadataTrack(
+    /** @brief Returns a function that interpolates and produces the samples of the track one at
+     * a time; it returns an empty Optional after the last sample */
+    std::function<Optional<Data>()> sampleGeneratorForTimedMetadataTrack(
         const TmdTrackContext& aSampleContext, const TimedMetadataDeclaration& aTimedMetadata);
 
+    /** @brief The timescale timescaleForSamples would give for the samples of the track,
+     * computed without keeping the samples */
+    FrameDuration timescaleForTimedMetadataTrack(const TimedMetadataDeclaration& aTimedMetadata);
+
+    /** @brief Creates a source that produces the samples of the track on demand */
     AsyncNode* createSourceForTimedMetadataTrack(const TmdTrackContext& aSampleContext,
                                                  ControllerOps& aOps,
                                                  const TimedMetadataDeclaration& aTimedMetadata);
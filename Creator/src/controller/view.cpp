@@ -1391,7 +1391,7 @@ namespace VDD
         // only mono input (and output) is supported, framepacked is not supported
 
         MediaInputConfig mediaInputConfig = *aInput.mInputConfig;
-        auto getSource = [&] {
+        auto getSource = [&](Optional<FrameTime> aStartTime) {
             auto mediaLoader = mediaInputConfig.makeMediaLoader(
                 true);  // bytestream format, as h265parser expects it
             auto videoTracks = mediaLoader->getTracksByFormat({CodedFormat::H265});
@@ -1406,17 +1406,26 @@ namespace VDD
                 sourceConfig.frameLimit = size_t(*aInput.frameLimit);
             }
             sourceConfig.overrideFrameDuration = mOverrideFrameDuration;
+            sourceConfig.startTime = aStartTime;
             return mediaLoader->sourceForTrack(*videoTracks.begin(), sourceConfig);
         };
 
         {
             // this is consumed by the call getMediaAdaptationIds;
-            auto durationSource = getSource();
+            auto durationSource = getSource({});
             aInput.duration = getMediaDurationConsumingSource(*durationSource);
         }
 
+        // when resuming an interrupted DASH run, start from the first missing segment; the
+        // segmenters drop whatever is still produced before it
+        Optional<FrameTime> startTime;
+        if (mController.getDash() && mController.getMP4VROutputs().empty())
+        {
+            startTime = mController.getDash()->getRestartSeekTime();
+        }
+
         auto mediaSource = mOps.wrapForGraph(
-            std::string("\"") + aInput.mInputConfig->filename + "\"", getSource());
+            std::string("\"") + aInput.mInputConfig->filename + "\"", getSource(startTime));
 
         auto limited = mOps.configureForGraph(mVideoStepLock->get());
         connect(*mediaSource, *limited);
@@ -18,31 +18,36 @@
 #include "controllerparsers.h"
 #include "dashomaf.h"
 #include "mp4vromafreaders.h"
-#include "processor/sequencesource.h"
+#include "processor/lazysequencesource.h"
 #include "processor/tagprocessor.h"
 #include "view.h"
 
 namespace VDD
 {
     namespace {
-        std::vector<Data> convertDyvpTimedMetaToData(
+        /** @brief Returns a function that converts the samples one at a time, for
+         * LazySequenceSource; it returns an empty Optional after the last sample */
+        std::function<Optional<Data>()> dyvpTimedMetaDataGenerator(
             const ViewpointMedia& aDyvp, CodedFormat aCodedFormat,
             std::shared_ptr<StreamSegmenter::Segmenter::SampleEntry> aSampleEntry)
         {
-            std::vector<Data> datas;
             assert(aDyvp.samples);
-
-            Index presIndex{};
-            CodingIndex codingIndex{};
-
-            for (auto& sample : *aDyvp.samples)
-            {
-                auto bytes = ISOBMFF::isobmffToBytes(sample.sample, aDyvp.viewpointInfo.getDyvpSampleEntry());
+            // the generator may run after aDyvp is gone; only the parsed samples are kept, not the Data
+            auto samples = std::make_shared<std::vector<AugmentedDyvpSample>>(*aDyvp.samples);
+            auto dyvpSampleEntry = aDyvp.viewpointInfo.getDyvpSampleEntry();
+            auto index = std::make_shared<size_t>(0u);
+            return [samples, dyvpSampleEntry, index, aCodedFormat, aSampleEntry]() -> Optional<Data> {
+                if (*index == samples->size())
+                {
+                    return {};
+                }
+                auto& sample = (*samples)[*index];
+                auto bytes = ISOBMFF::isobmffToBytes(sample.sample, dyvpSampleEntry);
                 std::vector<uint8_t> bytesVec{bytes.begin(), bytes.end()};
                 CPUDataVector dataVec{{std::move(bytesVec)}};
                 CodedFrameMeta codedFrameMeta{};
-                codedFrameMeta.presIndex = presIndex;
-                codedFrameMeta.codingIndex = codingIndex;
+                codedFrameMeta.presIndex = Index(*index);
+                codedFrameMeta.codingIndex = CodingIndex(*index);
                 codedFrameMeta.type = FrameType::IDR;
                 codedFrameMeta.format = aCodedFormat;
                 codedFrameMeta.codingTime = sample.time;
@@ -54,14 +59,9 @@ namespace VDD
                 {
                     meta.attachTag(SampleEntryTag(aSampleEntry));
                 }
-                Data data(dataVec, meta);
-                datas.push_back(data);
-
-                ++presIndex;
-                ++codingIndex;
-            }
-
-            return datas;
+                ++*index;
+                return Data(dataVec, meta);
+            };
         }
 
         StreamSegmenter::MPDTree::Omaf2Viewpoint omaf2ViewpointOfDynamicViewpointSampleEntry(
@@ -121,17 +121,22 @@ namespace VDD
         {
             if (aMedia.samples)
             {
-                SequenceSource::Config sequenceConfig{};
                 auto sampleEntry =
                     std::make_shared<StreamSegmenter::Segmenter::DynamicViewpointSampleEntry>();
                 sampleEntry->dynamicViewpointSampleEntry = aMedia.viewpointInfo.getDyvpSampleEntry();
-                sequenceConfig.samples =
-                    convertDyvpTimedMetaToData(aMedia, CodedFormat::TimedMetadataDyvp, sampleEntry);
 
-                AsyncSource* tmd =
-                    aOps.makeForGraph<SequenceSource>("dyvp TMD for OMAF", sequenceConfig);
+                std::set<FrameTime::value> denominators;
+                for (auto& sample : *aMedia.samples)
+                {
+                    denominators.insert(sample.time.minimize().den);
+                }
+                FrameDuration timescale = timescaleForDenominators(denominators);
 
-                FrameDuration timescale = timescaleForSamples(sequenceConfig.samples, {});
+                LazySequenceSource::Config sequenceConfig{};
+                sequenceConfig.nextSample =
+                    dyvpTimedMetaDataGenerator(aMedia, CodedFormat::TimedMetadataDyvp, sampleEntry);
+                AsyncSource* tmd =
+                    aOps.makeForGraph<LazySequenceSource>("dyvp TMD for OMAF", sequenceConfig);
 
                 return Optional<ConvertedSamples>({tmd, timescale});
             }
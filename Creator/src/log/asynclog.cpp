@@ -0,0 +1,302 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "asynclog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace VDD
+{
+    namespace
+    {
+        struct Record
+        {
+            LogLevel level;
+            // keeps its capacity between uses, so steady-state logging does not allocate
+            std::string text;
+        };
+
+        // Single producer, single consumer ring of records. The producer is the thread owning the
+        // ring, the consumer is the writer thread.
+        struct Ring
+        {
+            Ring(size_t aCapacity)
+                : records(aCapacity)
+            {
+                // nothing
+            }
+
+            std::vector<Record> records;
+            alignas(64) std::atomic<size_t> head{0};  // next record to fill; written by the producer
+            alignas(64) std::atomic<size_t> tail{0};  // next record to write; written by the writer
+            std::atomic<bool> threadExited{false};
+        };
+
+        std::atomic<std::uint64_t> gNextWriterId{0};
+
+        // The rings of the current thread, one per AsyncLog writer it has logged to
+        struct ThreadRings
+        {
+            std::vector<std::pair<std::uint64_t, std::shared_ptr<Ring>>> rings;
+
+            ~ThreadRings()
+            {
+                for (auto& ring : rings)
+                {
+                    ring.second->threadExited = true;
+                }
+            }
+        };
+
+        thread_local ThreadRings tThreadRings;
+
+        size_t roundUpToPowerOfTwo(size_t aValue)
+        {
+            size_t value = 1;
+            while (value < aValue)
+            {
+                value *= 2;
+            }
+            return value;
+        }
+    }  // anonymous namespace
+
+    class AsyncLog::Writer
+    {
+    public:
+        Writer(std::shared_ptr<Log> aTarget, size_t aRingCapacity)
+            : mId(gNextWriterId++)
+            , mTarget(aTarget)
+            , mRingCapacity(roundUpToPowerOfTwo(std::max<size_t>(aRingCapacity, 2)))
+            , mThread([this] { run(); })
+        {
+            // nothing
+        }
+
+        ~Writer()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mStop = true;
+            }
+            mWake.notify_one();
+            mThread.join();
+
+            std::unique_lock<std::mutex> lock(mRingsMutex);
+            mRings.clear();
+        }
+
+        void write(LogLevel aLevel, const std::string& aText)
+        {
+            Ring& ring = ringOfThisThread();
+            const size_t mask = ring.records.size() - 1;
+            size_t head = ring.head.load(std::memory_order_relaxed);
+            while (head - ring.tail.load(std::memory_order_acquire) == ring.records.size())
+            {
+                wake();
+                std::this_thread::yield();
+            }
+            Record& record = ring.records[head & mask];
+            record.level = aLevel;
+            record.text.assign(aText);
+            ring.head.store(head + 1, std::memory_order_release);
+
+            if (aLevel <= Error)
+            {
+                wake();
+            }
+        }
+
+        void flush()
+        {
+            std::vector<std::pair<std::shared_ptr<Ring>, size_t>> heads;
+            {
+                std::unique_lock<std::mutex> lock(mRingsMutex);
+                for (auto& ring : mRings)
+                {
+                    heads.push_back(std::make_pair(ring, ring->head.load(std::memory_order_acquire)));
+                }
+            }
+            wake();
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mDrained.wait(lock, [&] {
+                for (auto& ringHead : heads)
+                {
+                    if (ringHead.first->tail.load(std::memory_order_acquire) < ringHead.second)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            });
+        }
+
+    private:
+        const std::uint64_t mId;
+        std::shared_ptr<Log> mTarget;
+        const size_t mRingCapacity;
+
+        std::mutex mRingsMutex;
+        std::vector<std::shared_ptr<Ring>> mRings;
+        std::atomic<size_t> mRingsVersion{0};
+
+        std::mutex mMutex;
+        std::condition_variable mWake;
+        std::condition_variable mDrained;
+        bool mWakeRequested = false;
+        bool mStop = false;
+
+        std::thread mThread;
+
+        void wake()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWakeRequested = true;
+            }
+            mWake.notify_one();
+        }
+
+        Ring& ringOfThisThread()
+        {
+            for (auto& ring : tThreadRings.rings)
+            {
+                if (ring.first == mId)
+                {
+                    return *ring.second;
+                }
+            }
+
+            // forget the rings of writers that no longer exist
+            auto& rings = tThreadRings.rings;
+            rings.erase(std::remove_if(rings.begin(), rings.end(),
+                                       [](const std::pair<std::uint64_t, std::shared_ptr<Ring>>& aRing) {
+                                           return aRing.second.use_count() == 1;
+                                       }),
+                        rings.end());
+
+            auto ring = std::make_shared<Ring>(mRingCapacity);
+            {
+                std::unique_lock<std::mutex> lock(mRingsMutex);
+                mRings.push_back(ring);
+                ++mRingsVersion;
+            }
+            rings.push_back(std::make_pair(mId, ring));
+            return *ring;
+        }
+
+        // Write out pending records; returns the number of records written
+        size_t drain(std::vector<std::shared_ptr<Ring>>& aRings, size_t& aRingsVersion)
+        {
+            if (aRingsVersion != mRingsVersion.load())
+            {
+                std::unique_lock<std::mutex> lock(mRingsMutex);
+                // forget the rings of exited threads once they have been written out
+                mRings.erase(std::remove_if(mRings.begin(), mRings.end(),
+                                            [](const std::shared_ptr<Ring>& aRing) {
+                                                return aRing->threadExited &&
+                                                       aRing->tail.load() == aRing->head.load();
+                                            }),
+                             mRings.end());
+                aRings        = mRings;
+                aRingsVersion = mRingsVersion.load();
+            }
+
+            size_t written = 0;
+            bool exitedThreads = false;
+            for (auto& ring : aRings)
+            {
+                const size_t mask = ring->records.size() - 1;
+                size_t tail = ring->tail.load(std::memory_order_relaxed);
+                size_t head = ring->head.load(std::memory_order_acquire);
+                for (; tail != head; ++tail)
+                {
+                    const Record& record = ring->records[tail & mask];
+                    mTarget->writeLine(record.level, record.text);
+                    ring->tail.store(tail + 1, std::memory_order_release);
+                    ++written;
+                }
+                exitedThreads = exitedThreads || ring->threadExited;
+            }
+            if (exitedThreads)
+            {
+                ++mRingsVersion;
+            }
+            return written;
+        }
+
+        void run()
+        {
+            std::vector<std::shared_ptr<Ring>> rings;
+            size_t ringsVersion = ~size_t(0);
+            while (true)
+            {
+                size_t written = drain(rings, ringsVersion);
+
+                std::unique_lock<std::mutex> lock(mMutex);
+                mDrained.notify_all();
+                if (written == 0)
+                {
+                    if (mStop)
+                    {
+                        break;
+                    }
+                    mWake.wait_for(lock, std::chrono::milliseconds(10), [&] { return mWakeRequested || mStop; });
+                    mWakeRequested = false;
+                }
+            }
+        }
+    };
+
+    AsyncLog::AsyncLog(const Config& aConfig)
+        : mWriter(std::make_shared<Writer>(aConfig.target, aConfig.ringCapacity))
+    {
+        setLogLevel(aConfig.target->getLogLevel());
+        aConfig.target->setLogLevel(LogLevel::Debug);
+    }
+
+    AsyncLog::AsyncLog(std::shared_ptr<Writer> aWriter)
+        : mWriter(aWriter)
+    {
+        // nothing
+    }
+
+    AsyncLog::~AsyncLog() = default;
+
+    void AsyncLog::flush()
+    {
+        mWriter->flush();
+    }
+
+    void AsyncLog::writeLineImpl(LogLevel aLevel, const std::string& aMessage)
+    {
+        mWriter->write(aLevel, aMessage);
+    }
+
+    AsyncLog* AsyncLog::sharedClone()
+    {
+        AsyncLog* instance = new AsyncLog(mWriter);
+        instance->setLogLevel(getLogLevel());
+        return instance;
+    }
+}
@@ -0,0 +1,61 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <memory>
+
+#include "log.h"
+
+namespace VDD
+{
+    /** A Log that hands complete lines over to a single background thread, which writes them to a
+     * target Log (for example ConsoleLog). Each producing thread appends its records to its own
+     * lock-free ring, so threads logging at the same time neither contend with each other nor wait
+     * for the output; prefixing and writing the lines is done by the background thread.
+     *
+     * Instances made with instance() share the background thread. Records of one thread are
+     * written in the order they were logged. Assert and Error lines wake up the writer right away;
+     * others are picked up within a few milliseconds. */
+    class AsyncLog : public Log
+    {
+    public:
+        struct Config
+        {
+            // Receives the lines. It is only accessed from the background thread, and its log level
+            // is raised to Debug as filtering is done by AsyncLog. AsyncLog starts with its level.
+            std::shared_ptr<Log> target;
+
+            // Number of lines a thread can have pending before it waits for the writer
+            size_t ringCapacity = 4096;
+        };
+
+        AsyncLog(const Config& aConfig);
+        ~AsyncLog() override;
+
+        /** Wait until the lines logged so far by any thread have been written to the target */
+        void flush();
+
+    protected:
+        void writeLineImpl(LogLevel, const std::string&) override;
+        AsyncLog* sharedClone() override;
+
+    private:
+        class Writer;
+
+        AsyncLog(std::shared_ptr<Writer> aWriter);
+
+        std::shared_ptr<Writer> mWriter;
+    };
+}
@@ -56,11 +56,16 @@ namespace VDD
 
     LogStream& Log::log(LogLevel aLevel)
     {
-        if (!mLogStreams.count(aLevel))
+        auto it = mLogStreams.find(aLevel);
+        if (it == mLogStreams.end())
         {
-            mLogStreams.insert(std::make_pair(aLevel, Utils::make_unique<LogStream>(aLevel, *this)));
+            it = mLogStreams.insert(std::make_pair(aLevel, Utils::make_unique<LogStream>(aLevel, *this))).first;
         }
-        return *mLogStreams.at(aLevel);
+        LogStream& stream = *it->second;
+        // Output to a stream in a failed state is skipped without formatting it, so logging to a
+        // disabled level costs next to nothing
+        stream.clear(aLevel <= mLogLevel ? std::ios::goodbit : std::ios::badbit);
+        return stream;
     }
 
     std::shared_ptr<Log> Log::instance()
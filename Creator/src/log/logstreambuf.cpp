@@ -14,6 +14,8 @@
  */
 #include "logstreambuf.h"
 
+#include <cstring>
+
 #include "logstream.h"
 
 namespace VDD
@@ -43,6 +45,25 @@ namespace VDD
         return 0;
     }
 
+    std::streamsize LogStreamBuf::xsputn(const char* aData, std::streamsize aCount)
+    {
+        const char* end = aData + aCount;
+        while (aData != end)
+        {
+            auto newline = static_cast<const char*>(std::memchr(aData, '\n', size_t(end - aData)));
+            if (!newline)
+            {
+                mLineBuffer.append(aData, end);
+                break;
+            }
+            mLineBuffer.append(aData, newline);
+            mLogStream.writeLine(mLineBuffer);
+            mLineBuffer.clear();
+            aData = newline + 1;
+        }
+        return aCount;
+    }
+
     LogStreamBuf::~LogStreamBuf()
     {
         if (mLineBuffer.size())
@@ -29,6 +29,8 @@ namespace VDD
 
         int overflow(int ch) override;
 
+        std::streamsize xsputn(const char* aData, std::streamsize aCount) override;
+
         int sync() override;
 
     private:
@@ -19,6 +19,7 @@
 #include "h265loader.h"
 #include "common/utils.h"
 #include "omaf/parser/h265parser.hpp"
+#include "omaf/parser/h265parametersets.hpp"
 #include "h265segmentedinputstream.h"
 #include "h265stdistream.h"
 
@@ -94,14 +95,10 @@ namespace VDD
 
     bool getH265Tiles(const Data& aData, size_t& aTilesX, size_t& aTilesY)
     {
-        H265::PictureParameterSet pps;
-        std::vector<uint8_t> nalUnitRBSP;
-        H265Parser::convertToRBSP(aData.getCodedFrameMeta().decoderConfig.at(ConfigType::PPS), nalUnitRBSP, true);
-        Parser::BitStream bitstr(nalUnitRBSP);
-        H265::NalUnitHeader naluHeader;
-        H265Parser::parseNalUnitHeader(bitstr, naluHeader);
-
-        H265Parser::parsePPS(bitstr, pps);
+        const H265::PictureParameterSet& pps =
+            H265ParameterSetRegistry::instance()
+                .getPps(aData.getCodedFrameMeta().decoderConfig.at(ConfigType::PPS))
+                ->pps;
         if (pps.mTilesEnabledFlag)
         {
             aTilesX = static_cast<size_t>(pps.mNumTileColumnsMinus1) + 1;
@@ -116,14 +113,10 @@ namespace VDD
 
     void getH265CtuSize(const Data& aData, int& aCtuSize)
     {
-        H265::SequenceParameterSet sps;
-        std::vector<uint8_t> nalUnitRBSP;
-        H265Parser::convertToRBSP(aData.getCodedFrameMeta().decoderConfig.at(ConfigType::SPS), nalUnitRBSP, true);
-        Parser::BitStream bitstr(nalUnitRBSP);
-        H265::NalUnitHeader naluHeader;
-        H265Parser::parseNalUnitHeader(bitstr, naluHeader);
-
-        H265Parser::parseSPS(bitstr, sps);
+        const H265::SequenceParameterSet& sps =
+            H265ParameterSetRegistry::instance()
+                .getSps(aData.getCodedFrameMeta().decoderConfig.at(ConfigType::SPS))
+                ->sps;
 
         aCtuSize = (int)pow(2, (sps.mLog2MinLumaCodingBlockSizeMinus3 + 3) + (sps.mLog2DiffMaxMinLumaCodingBlockSize));
     }
@@ -135,6 +128,14 @@ namespace VDD
         {
             mH265Stream = aConfig.inputStream;
         }
+        else if (aConfig.ingestThreads)
+        {
+            H265MappedInput::Config mappedConfig;
+            mappedConfig.filename = mConfig.filename;
+            mappedConfig.videoNalStartCodes = mConfig.videoNalStartCodes;
+            mappedConfig.threads = mConfig.ingestThreads;
+            mMappedInput = Utils::make_unique<H265MappedInput>(mappedConfig);
+        }
         else
         {
             mStream.open(mConfig.filename.c_str(), std::ios::binary);
@@ -286,10 +287,64 @@ namespace VDD
         return mConfig.frameLimit && mCodingIndex >= Index(*mConfig.frameLimit);
     }
 
+    bool H265Source::fetchMappedFrames()
+    {
+        if (mMappedFrames.empty())
+        {
+            H265MappedInput::Gop gop;
+            if (mMappedInput->nextGop(gop))
+            {
+                // the picture order count starts over at an IDR picture; see produceDirect
+                if (gop.continuesPoc)
+                {
+                    mMappedLargestPoc = std::max(gop.largestPoc, mMappedLargestPoc);
+                }
+                else
+                {
+                    if (mMappedGopFound)
+                    {
+                        mState.pocOffset += mMappedLargestPoc + 1;
+                    }
+                    mMappedLargestPoc = gop.largestPoc;
+                }
+                mMappedGopFound = true;
+                std::move(gop.frames.begin(), gop.frames.end(), std::back_inserter(mMappedFrames));
+            }
+        }
+        return !mMappedFrames.empty();
+    }
+
+    void H265Source::produceFromMappedInput(std::vector<Streams>& aStreams)
+    {
+        if (!frameLimitEncountered() && fetchMappedFrames())
+        {
+            H265MappedInput::Frame& frame = mMappedFrames.front();
+            const H265MappedInput::Parameters& parameters = *frame.parameters;
+            mState.data = std::move(frame.data);
+            mState.poc = frame.poc;
+            mState.hasRAP = frame.hasRAP;
+            mState.decoderConfig = parameters.decoderConfig;
+            mMeta.width = parameters.width;
+            mMeta.height = parameters.height;
+            mFrameDuration = parameters.frameDuration;
+            mMappedFrames.pop_front();
+            aStreams.push_back(Streams({makeFrame()}));
+        }
+
+        if (frameLimitEncountered() || !fetchMappedFrames())
+        {
+            mFinished = true;
+        }
+    }
+
     std::vector<Streams> H265Source::produceDirect()
     {
         std::vector<Streams> streams;
-        if (!mFinished)
+        if (mMappedInput && !mFinished)
+        {
+            produceFromMappedInput(streams);
+        }
+        else if (!mFinished)
         {
             std::vector<uint8_t> currNalUnitData;
             std::vector<uint8_t> rbsp;
@@ -456,15 +511,39 @@ namespace VDD
     std::vector<Streams> H265Source::produce()
     {
         std::vector<Streams> streams;
-        if (mFirstFrameQueue.size())
-        {
-            streams = std::move(mFirstFrameQueue);
-            mFirstFrameQueue.clear();
-        }
-        else
+        do
         {
-            streams = produceDirect();
-        }
+            if (mFirstFrameQueue.size())
+            {
+                streams = std::move(mFirstFrameQueue);
+                mFirstFrameQueue.clear();
+            }
+            else
+            {
+                streams = produceDirect();
+            }
+
+            if (mConfig.startTime && !mStartFound)
+            {
+                // the stream needs to be parsed up to the start anyway, but the frames before it
+                // are not passed on
+                std::vector<Streams> started;
+                for (auto& frame : streams)
+                {
+                    if (!mStartFound && !frame.isEndOfStream())
+                    {
+                        const CodedFrameMeta& meta = frame.front().getCodedFrameMeta();
+                        mStartFound =
+                            meta.type == FrameType::IDR && meta.presTime >= *mConfig.startTime;
+                    }
+                    if (mStartFound || frame.isEndOfStream())
+                    {
+                        started.push_back(std::move(frame));
+                    }
+                }
+                streams = std::move(started);
+            }
+        } while (streams.empty());
         return streams;
     }
 
@@ -583,6 +662,7 @@ namespace VDD
             config.filename = mConfig.filename;
             config.frameDuration = aSourceConfig.overrideFrameDuration;
             config.frameLimit = aSourceConfig.frameLimit;
+            config.startTime = aSourceConfig.startTime;
             config.videoNalStartCodes = mVideoNalStartCodes;
             config.gopLength = mConfig.gopLength;
             if (mConfig.filename.find("$Number$") != std::string::npos)
@@ -591,6 +671,10 @@ namespace VDD
                     mConfig.filename, mConfig.startNumber ? *mConfig.startNumber : 1u);
                 config.inputStream = opener->getInputStream(opener);
             }
+            else if (mConfig.ingestThreads)
+            {
+                config.ingestThreads = *mConfig.ingestThreads;
+            }
             return Utils::make_unique<H265Source>(config);
         }
         else
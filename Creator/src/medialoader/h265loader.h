@@ -14,6 +14,7 @@
  */
 #pragma once
 
+#include <deque>
 #include <fstream>
 #include <list>
 #include <map>
@@ -21,6 +22,7 @@
 #include <functional>
 
 #include "medialoader.h"
+#include "h265mappedinput.h"
 
 #include "common/optional.h"
 #include "common/exceptions.h"
@@ -61,6 +63,10 @@ namespace VDD
             Optional<int> gopLength;  // used for checking that the GOP indeed is the given number,
                                       // as well as implementing getGOPLength
             Optional<size_t> frameLimit;
+            Optional<FrameTime> startTime;  // see MediaLoader::SourceConfig
+            // If non-zero, filename is memory-mapped and the frames of this many GOPs are
+            // assembled in parallel. Not used with inputStream.
+            size_t ingestThreads = 0;
         };
 
         H265Source(Config aConfig);
@@ -99,6 +105,12 @@ namespace VDD
         Config mConfig;
         std::ifstream mStream; // valid only if Config.inputStream is not provided
         std::shared_ptr<H265InputStream> mH265Stream;
+        std::unique_ptr<H265MappedInput> mMappedInput; // used instead of mH265Stream if set
+
+        // frames of the GOP retrieved from mMappedInput that are not yet produced
+        std::deque<H265MappedInput::Frame> mMappedFrames;
+        bool mMappedGopFound = false;
+        int mMappedLargestPoc = 0;
 
         // the first frame is here ready to be .produced. This is used so that the meta data
         // available from the first frame may be accessed without calling produce
@@ -115,6 +127,7 @@ namespace VDD
 
         bool mFirstFrameFound = false;
         bool mFinished = false;
+        bool mStartFound = false;  // the frame at Config::startTime has been produced
         FrameTime mCodingTime;
         Optional<FrameDuration> mFrameDuration;
         Index mCodingIndex = 0;
@@ -144,6 +157,8 @@ namespace VDD
         Data makeFrame();
         void acquireMeta() const;
         std::vector<Streams> produceDirect();
+        void produceFromMappedInput(std::vector<Streams>& aStreams);
+        bool fetchMappedFrames();
         void produceToQueue();
         bool frameLimitEncountered() const;
     };
@@ -157,6 +172,7 @@ namespace VDD
                                    // loading multiple segments
             Optional<int> gopLength;         // required got getGopLength(); enforced
             Optional<unsigned> startNumber;  // this is the initial number; if missing, it is 1
+            Optional<unsigned> ingestThreads; // see H265Source::Config; not used for segmented input
         };
 
         H265Loader(Config aConfig, bool aVideoNalStartCodes = false);
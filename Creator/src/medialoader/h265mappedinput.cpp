@@ -0,0 +1,516 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "h265mappedinput.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/utils.h"
+#include "h265loader.h"
+#include "omaf/parser/h265parser.hpp"
+
+namespace VDD
+{
+    namespace
+    {
+        // Slice headers are first parsed from this many bytes of the NAL unit; the complete
+        // NAL unit is used only if the header turns out to be longer
+        const size_t kSliceHeaderPrefixLength = 1024;
+
+        bool isIdrPicture(H265::H265NalUnitType aType)
+        {
+            // ITU-T H.265 v3 (04/2015) definition 3.62
+            return aType == H265::H265NalUnitType::CODED_SLICE_IDR_W_RADL ||
+                   aType == H265::H265NalUnitType::CODED_SLICE_IDR_N_LP;
+        }
+
+        // The other IRAP pictures, definition 3.69; the reader doesn't reset the picture order
+        // count at them
+        bool isCraOrBlaPicture(H265::H265NalUnitType aType)
+        {
+            return aType == H265::H265NalUnitType::CODED_SLICE_BLA_W_LP ||
+                   aType == H265::H265NalUnitType::CODED_SLICE_BLA_W_RADL ||
+                   aType == H265::H265NalUnitType::CODED_SLICE_BLA_N_LP ||
+                   aType == H265::H265NalUnitType::CODED_SLICE_CRA;
+        }
+
+        // PicOrderCntMsb of a picture, equation 8-1 of ITU-T H.265 v3 (04/2015)
+        int picOrderCntMsb(unsigned int aPicOrderCntLsb, int aMaxPicOrderCntLsb,
+                           unsigned int aPrevPicOrderCntLsb, int aPrevPicOrderCntMsb)
+        {
+            int lsb = int(aPicOrderCntLsb);
+            int prevLsb = int(aPrevPicOrderCntLsb);
+            if (lsb < prevLsb && prevLsb - lsb >= aMaxPicOrderCntLsb / 2)
+            {
+                return aPrevPicOrderCntMsb + aMaxPicOrderCntLsb;
+            }
+            else if (lsb > prevLsb && lsb - prevLsb > aMaxPicOrderCntLsb / 2)
+            {
+                return aPrevPicOrderCntMsb - aMaxPicOrderCntLsb;
+            }
+            else
+            {
+                return aPrevPicOrderCntMsb;
+            }
+        }
+
+        template <typename Result>
+        class PackagedTaskJob : public Job
+        {
+        public:
+            PackagedTaskJob(std::packaged_task<Result()>&& aTask)
+                : mTask(std::move(aTask))
+            {
+                // nothing
+            }
+
+            void run() override
+            {
+                mTask();
+            }
+
+        private:
+            std::packaged_task<Result()> mTask;
+        };
+    }  // namespace
+
+    struct H265MappedInput::Mapping
+    {
+        const std::uint8_t* data = nullptr;
+        size_t size = 0u;
+
+#if defined(_WIN32)
+        std::vector<std::uint8_t> contents;
+
+        Mapping(const std::string& aFilename)
+        {
+            std::ifstream stream(aFilename.c_str(), std::ios::binary);
+            if (!stream)
+            {
+                throw H265LoaderError("Failed to open file", aFilename);
+            }
+            contents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            data = contents.data();
+            size = contents.size();
+        }
+#else
+        void* address = MAP_FAILED;
+
+        Mapping(const std::string& aFilename)
+        {
+            int fd = ::open(aFilename.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw H265LoaderError("Failed to open file", aFilename);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw H265LoaderError("Failed to determine file size", aFilename);
+            }
+            size = size_t(st.st_size);
+            if (size)
+            {
+                address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+            if (size && address == MAP_FAILED)
+            {
+                throw H265LoaderError("Failed to memory-map file", aFilename);
+            }
+            if (size)
+            {
+                ::madvise(address, size, MADV_SEQUENTIAL);
+                data = static_cast<const std::uint8_t*>(address);
+            }
+        }
+
+        ~Mapping()
+        {
+            if (address != MAP_FAILED)
+            {
+                ::munmap(address, size);
+            }
+        }
+#endif
+    };
+
+    H265MappedInput::H265MappedInput(Config aConfig)
+        : mConfig(aConfig)
+        , mMapping(Utils::make_unique<Mapping>(aConfig.filename))
+        , mParameters(std::make_shared<Parameters>())
+        , mWorkers(Utils::make_unique<ThreadedWorkPool>(ThreadedWorkPool::Config{
+              std::max(aConfig.threads, size_t(1)), std::max(aConfig.threads, size_t(1)), nullptr}))
+    {
+        mStartCode = findStartCode(0);
+    }
+
+    H265MappedInput::~H265MappedInput() = default;
+
+    size_t H265MappedInput::findStartCode(size_t aFrom) const
+    {
+        const std::uint8_t* data = mMapping->data;
+        size_t size = mMapping->size;
+        size_t offset = aFrom + 2;
+        while (offset < size)
+        {
+            auto found = static_cast<const std::uint8_t*>(std::memchr(data + offset, 1, size - offset));
+            if (!found)
+            {
+                break;
+            }
+            offset = size_t(found - data);
+            if (data[offset - 1] == 0 && data[offset - 2] == 0)
+            {
+                return offset;
+            }
+            ++offset;
+        }
+        return size;
+    }
+
+    void H265MappedInput::parseParameterSet(const Nal& aNal)
+    {
+        const std::uint8_t* data = mMapping->data;
+        std::vector<std::uint8_t> nalUnit(data + aNal.begin, data + aNal.end);
+        std::vector<std::uint8_t> rbsp;
+        H265Parser::convertToRBSP(nalUnit, rbsp);
+        Parser::BitStream bitstr(rbsp);
+        H265::NalUnitHeader naluHeader;
+        H265Parser::parseNalUnitHeader(bitstr, naluHeader);
+
+        // frames already scanned keep referring to the previous parameters
+        auto parameters = std::make_shared<Parameters>(*mParameters);
+        if (aNal.type == H265::H265NalUnitType::SPS)
+        {
+            H265::SequenceParameterSet sps;
+            H265Parser::parseSPS(bitstr, sps);
+            parameters->width = sps.mPicWidthInLumaSamples;
+            parameters->height = sps.mPicHeightInLumaSamples;
+            if (sps.mVuiParametersPresentFlag && sps.mVuiParameters.mVuiTimingInfoPresentFlag)
+            {
+                parameters->frameDuration = FrameDuration(sps.mVuiParameters.mVuiNumUnitsInTick,
+                                                          sps.mVuiParameters.mVuiTimeScale);
+            }
+            mSpss.push_back(sps);
+            mSpssForH265Parser.push_back(&*mSpss.rbegin());
+            parameters->decoderConfig[ConfigType::SPS] = std::move(nalUnit);
+        }
+        else if (aNal.type == H265::H265NalUnitType::PPS)
+        {
+            H265::PictureParameterSet pps;
+            H265Parser::parsePPS(bitstr, pps);
+            mPpss.push_back(pps);
+            mPpssForH265Parser.push_back(&*mPpss.rbegin());
+            parameters->decoderConfig[ConfigType::PPS] = std::move(nalUnit);
+        }
+        else
+        {
+            parameters->decoderConfig[ConfigType::VPS] = std::move(nalUnit);
+        }
+        mParameters = parameters;
+    }
+
+    void H265MappedInput::closeUnit(GopJob& aJob)
+    {
+        assert(aJob.units.size());
+        Unit& unit = aJob.units.back();
+        unit.nalEnd = aJob.nals.size();
+        unit.parameters = mParameters;
+    }
+
+    std::unique_ptr<H265MappedInput::GopJob> H265MappedInput::scanGop()
+    {
+        const std::uint8_t* data = mMapping->data;
+        size_t size = mMapping->size;
+
+        auto openUnit = [&]() {
+            if (!mJob)
+            {
+                mJob = Utils::make_unique<GopJob>();
+            }
+            mJob->units.push_back(Unit{mJob->nals.size(), mJob->nals.size(), nullptr});
+        };
+
+        auto finishJob = [&]() {
+            std::unique_ptr<GopJob> job = std::move(mJob);
+            closeUnit(*job);
+            job->spss = mSpssForH265Parser;
+            job->ppss = mPpssForH265Parser;
+            return job;
+        };
+
+        while (!mScanFinished && mStartCode + 1 < size)
+        {
+            // this NAL unit continues until the zeros of the next start code
+            Nal nal{};
+            nal.begin = mOffset;
+            nal.header = mStartCode + 1;
+            size_t next = findStartCode(nal.header);
+            nal.end = size;
+            if (next < size)
+            {
+                nal.end = next;
+                while (nal.end > nal.header && data[nal.end - 1] == 0)
+                {
+                    --nal.end;
+                }
+            }
+            nal.type = H265::H265NalUnitType((data[nal.header] >> 1) & 0x3f);
+            mOffset = nal.end;
+            mStartCode = next;
+
+            if (nal.type == H265::H265NalUnitType::SPS || nal.type == H265::H265NalUnitType::PPS ||
+                nal.type == H265::H265NalUnitType::VPS)
+            {
+                parseParameterSet(nal);
+            }
+            else if (nal.type == H265::H265NalUnitType::SUFFIX_SEI)
+            {
+                if (!mJob)
+                {
+                    openUnit();
+                }
+                mJob->nals.push_back(nal);
+            }
+            else if (H265Parser::isVclNaluType(nal.type))
+            {
+                if (nal.end < nal.header + 3)
+                {
+                    throw H265LoaderError("Truncated slice segment at offset " +
+                                              std::to_string(nal.begin),
+                                          mConfig.filename);
+                }
+                // first_slice_segment_in_pic_flag
+                nal.firstInPic = ((data[nal.header + 2] >> 7) & 1) != 0;
+
+                std::unique_ptr<GopJob> finished;
+                if (!mFirstFrameFound)
+                {
+                    mFirstFrameFound = nal.firstInPic;
+                    if (!mJob)
+                    {
+                        openUnit();
+                    }
+                }
+                else if (nal.firstInPic)
+                {
+                    // the previous picture is now complete; an IRAP picture starts a new GOP, and
+                    // an overlong GOP is cut
+                    if (isIdrPicture(nal.type) || isCraOrBlaPicture(nal.type) ||
+                        mJob->units.size() >= std::max(mConfig.maxGopFrames, size_t(1)))
+                    {
+                        finished = finishJob();
+                    }
+                    else
+                    {
+                        closeUnit(*mJob);
+                    }
+                    openUnit();
+                }
+                if (nal.firstInPic && mJob->units.size() == 1u)
+                {
+                    mJob->startsAtIdr = isIdrPicture(nal.type);
+                    mJob->startsAtIrap = isCraOrBlaPicture(nal.type);
+                }
+                mJob->nals.push_back(nal);
+                if (finished)
+                {
+                    return finished;
+                }
+            }
+        }
+
+        mScanFinished = true;
+        if (mJob && mJob->units.size())
+        {
+            return finishJob();
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    H265MappedInput::AssembledGop H265MappedInput::assemble(const std::uint8_t* aData,
+                                                            bool aVideoNalStartCodes,
+                                                            std::shared_ptr<const GopJob> aJob,
+                                                            PocState aPocState)
+    {
+        AssembledGop assembled;
+        Gop& gop = assembled.gop;
+        gop.frames.reserve(aJob->units.size());
+        gop.continuesPoc = !aJob->startsAtIdr;
+
+        unsigned int& prevPicOrderCntLsb = aPocState.prevPicOrderCntLsb;
+        int& prevPicOrderCntMsb = aPocState.prevPicOrderCntMsb;
+        bool firstPicture = true;
+        std::vector<std::uint8_t> nalUnit;
+        std::vector<std::uint8_t> rbsp;
+
+        auto decodePoc = [&](const Nal& aNal, size_t aLength) {
+            nalUnit.assign(aData + aNal.header, aData + aNal.header + aLength);
+            rbsp.clear();
+            H265Parser::convertToRBSP(nalUnit, rbsp, false);
+            Parser::BitStream bitstr(rbsp);
+            H265::NalUnitHeader naluHeader;
+            H265Parser::parseNalUnitHeader(bitstr, naluHeader);
+            H265::SliceHeader sliceHeader;
+            H265Parser::parseSliceHeader(bitstr, sliceHeader, aNal.type, aJob->spss, aJob->ppss);
+            if (firstPicture)
+            {
+                assembled.firstPicOrderCntLsb = sliceHeader.mSlicePicOrderCntLsb;
+                assembled.maxPicOrderCntLsb = 1 << (sliceHeader.mSps->mLog2MaxPicOrderCntLsbMinus4 + 4);
+            }
+            return H265Parser::decodePoc(sliceHeader, naluHeader, prevPicOrderCntLsb,
+                                         prevPicOrderCntMsb);
+        };
+
+        for (auto& unit : aJob->units)
+        {
+            Frame frame;
+            frame.parameters = unit.parameters;
+
+            size_t frameSize = 0u;
+            for (size_t index = unit.nalBegin; index < unit.nalEnd; ++index)
+            {
+                const Nal& nal = aJob->nals[index];
+                frameSize += aVideoNalStartCodes ? nal.end - nal.begin : 4 + nal.end - nal.header;
+            }
+            frame.data.reserve(frameSize);
+
+            Optional<int> poc;
+            for (size_t index = unit.nalBegin; index < unit.nalEnd; ++index)
+            {
+                const Nal& nal = aJob->nals[index];
+                if (aVideoNalStartCodes)
+                {
+                    frame.data.insert(frame.data.end(), aData + nal.begin, aData + nal.end);
+                }
+                else
+                {
+                    uint64_t size = nal.end - nal.header;
+                    for (size_t byte = 0; byte < 4; ++byte)
+                    {
+                        auto bitOffset = 24 - byte * 8;
+                        frame.data.push_back(uint8_t((size >> bitOffset) & 0xffu));
+                    }
+                    frame.data.insert(frame.data.end(), aData + nal.header, aData + nal.end);
+                }
+
+                if (H265Parser::isVclNaluType(nal.type))
+                {
+                    bool idr = isIdrPicture(nal.type);
+                    if (nal.firstInPic && idr)
+                    {
+                        prevPicOrderCntLsb = 0u;
+                        prevPicOrderCntMsb = 0;
+                        poc = 0;
+                        gop.largestPoc = 0;
+                    }
+                    else if (!idr)
+                    {
+                        size_t length = nal.end - nal.header;
+                        try
+                        {
+                            poc = decodePoc(nal, std::min(length, kSliceHeaderPrefixLength));
+                        }
+                        catch (std::out_of_range&)
+                        {
+                            // the slice header didn't fit in the prefix
+                            poc = decodePoc(nal, length);
+                        }
+                        gop.largestPoc = std::max(*poc, gop.largestPoc);
+                    }
+                    frame.hasRAP = frame.hasRAP || idr;
+                }
+            }
+            assert(poc);
+            frame.poc = poc ? *poc : 0;
+            gop.frames.push_back(std::move(frame));
+            firstPicture = false;
+        }
+        assembled.pocState = aPocState;
+        return assembled;
+    }
+
+    bool H265MappedInput::nextGop(Gop& aGop)
+    {
+        while (mPending.size() < std::max(mConfig.threads, size_t(1)))
+        {
+            std::shared_ptr<const GopJob> job = scanGop();
+            if (!job)
+            {
+                break;
+            }
+            PendingGop pending{job, {}};
+            if (job->startsAtIdr || job->startsAtIrap)
+            {
+                // the count starts over at an IDR picture; at a CRA or BLA picture it is shifted
+                // into place afterwards
+                std::packaged_task<AssembledGop()> task(std::bind(&H265MappedInput::assemble, mMapping->data,
+                                                                  mConfig.videoNalStartCodes, job,
+                                                                  PocState{}));
+                pending.assembled = task.get_future();
+                mWorkers->enqueue(Utils::make_unique<PackagedTaskJob<AssembledGop>>(std::move(task)));
+            }
+            mPending.push_back(std::move(pending));
+        }
+
+        if (mPending.empty())
+        {
+            return false;
+        }
+        else
+        {
+            PendingGop pending = std::move(mPending.front());
+            mPending.pop_front();
+            AssembledGop assembled =
+                pending.assembled.valid()
+                    ? pending.assembled.get()
+                    : assemble(mMapping->data, mConfig.videoNalStartCodes, pending.job, mPocState);
+            if (pending.job->startsAtIrap)
+            {
+                int shift = picOrderCntMsb(assembled.firstPicOrderCntLsb, assembled.maxPicOrderCntLsb,
+                                           mPocState.prevPicOrderCntLsb, mPocState.prevPicOrderCntMsb) -
+                            picOrderCntMsb(assembled.firstPicOrderCntLsb, assembled.maxPicOrderCntLsb, 0u, 0);
+                assembled.gop.largestPoc = 0;
+                for (auto& frame : assembled.gop.frames)
+                {
+                    frame.poc += shift;
+                    assembled.gop.largestPoc = std::max(frame.poc, assembled.gop.largestPoc);
+                }
+                assembled.pocState.prevPicOrderCntMsb += shift;
+            }
+            mPocState = assembled.pocState;
+            aGop = std::move(assembled.gop);
+            return true;
+        }
+    }
+}  // namespace VDD
@@ -0,0 +1,170 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/optional.h"
+#include "concurrency/threadedworkpool.h"
+#include "omaf/parser/h265datastructs.hpp"
+#include "processor/meta.h"
+
+namespace VDD
+{
+    /** Reads an H265 Annex B file through a memory mapping. The access units are located
+     * with a start code scan over the mapping, one GOP (starting at an IDR, CRA or BLA
+     * picture) at a time, and the frames of up to Config.threads GOPs are assembled in
+     * parallel by a pool of as many threads. GOPs are returned in stream order.
+     *
+     * The picture order counts of a GOP starting at a CRA or BLA picture continue from the
+     * previous GOP; they are assembled as if the count started over and shifted into place
+     * once the previous GOP is done. A GOP without such a picture within Config.maxGopFrames
+     * frames is cut there, and the pieces after the cut are assembled on the reading thread
+     * in order, as the byte-by-byte reader would.
+     *
+     * The frames are identical to the ones the byte-by-byte H265Source would produce: VCL and
+     * suffix SEI NAL units are copied with start codes or 4-byte sizes, and parameter sets
+     * are delivered as the decoder configuration in effect when the next picture starts. */
+    class H265MappedInput
+    {
+    public:
+        struct Config
+        {
+            std::string filename;
+            bool videoNalStartCodes = false;
+            size_t threads = 1;  // number of GOPs assembled concurrently
+            size_t maxGopFrames = 256u;  // longer GOPs are cut and assembled sequentially
+        };
+
+        // Stream state that applies to a frame; shared between frames while it doesn't change
+        struct Parameters
+        {
+            std::map<ConfigType, std::vector<std::uint8_t>> decoderConfig;
+            std::uint32_t width = 0u;
+            std::uint32_t height = 0u;
+            Optional<FrameDuration> frameDuration;
+        };
+
+        struct Frame
+        {
+            std::vector<std::uint8_t> data;
+            int poc = 0;  // before adjusting with the offset of the GOP
+            bool hasRAP = false;
+            std::shared_ptr<const Parameters> parameters;
+        };
+
+        struct Gop
+        {
+            std::vector<Frame> frames;
+            int largestPoc = 0;
+            // the GOP doesn't start with an IDR picture, so the picture order count continues
+            // from the previous GOP
+            bool continuesPoc = false;
+        };
+
+        H265MappedInput(Config aConfig);
+        ~H265MappedInput();
+
+        /** Retrieves the next GOP in stream order. Returns false at the end of the stream.
+         * Errors from the parallel assembly are rethrown here. */
+        bool nextGop(Gop& aGop);
+
+    private:
+        struct Mapping;
+        struct Nal
+        {
+            size_t begin;   // start of the NAL unit including its start code
+            size_t header;  // first byte after the start code
+            size_t end;
+            H265::H265NalUnitType type;
+            bool firstInPic;
+        };
+        struct Unit
+        {
+            size_t nalBegin;  // indices to GopJob::nals
+            size_t nalEnd;
+            std::shared_ptr<const Parameters> parameters;
+        };
+        struct GopJob
+        {
+            std::vector<Nal> nals;
+            std::vector<Unit> units;
+            std::list<H265::SequenceParameterSet*> spss;
+            std::list<H265::PictureParameterSet*> ppss;
+            // starts at an IDR picture, or at a CRA or BLA picture; false for the pieces of a
+            // GOP cut at Config.maxGopFrames
+            bool startsAtIdr = false;
+            bool startsAtIrap = false;
+        };
+        // Picture order count derivation state, ITU-T H.265 8.3.1
+        struct PocState
+        {
+            unsigned int prevPicOrderCntLsb = 0u;
+            int prevPicOrderCntMsb = 0;
+        };
+        struct AssembledGop
+        {
+            Gop gop;
+            PocState pocState;  // after the last picture
+            unsigned int firstPicOrderCntLsb = 0u;
+            int maxPicOrderCntLsb = 0;
+        };
+        struct PendingGop
+        {
+            std::shared_ptr<const GopJob> job;
+            // not valid for the jobs assembled on the reading thread
+            std::future<AssembledGop> assembled;
+        };
+
+        const Config mConfig;
+        std::unique_ptr<Mapping> mMapping;
+
+        // Scanning state
+        size_t mOffset = 0;     // offset of the next NAL unit to scan
+        size_t mStartCode = 0;  // offset of the final byte of its start code
+        bool mScanFinished = false;
+        bool mFirstFrameFound = false;
+        std::shared_ptr<Parameters> mParameters;
+        std::unique_ptr<GopJob> mJob;  // GOP being scanned
+        std::list<H265::SequenceParameterSet> mSpss;
+        std::list<H265::PictureParameterSet> mPpss;
+        std::list<H265::SequenceParameterSet*> mSpssForH265Parser;
+        std::list<H265::PictureParameterSet*> mPpssForH265Parser;
+
+        // True state after the GOPs returned so far
+        PocState mPocState;
+
+        // Declared after mMapping so the running jobs are finished before unmapping
+        std::unique_ptr<ThreadedWorkPool> mWorkers;
+        std::deque<PendingGop> mPending;
+
+        // Scans the next complete GOP, or the remainder of the stream; returns nullptr when
+        // there is nothing left
+        std::unique_ptr<GopJob> scanGop();
+        void closeUnit(GopJob& aJob);
+        void parseParameterSet(const Nal& aNal);
+        size_t findStartCode(size_t aFrom) const;
+
+        static AssembledGop assemble(const std::uint8_t* aData, bool aVideoNalStartCodes,
+                                     std::shared_ptr<const GopJob> aJob, PocState aPocState);
+    };
+}  // namespace VDD
@@ -100,6 +100,9 @@ namespace VDD
         {
             Optional<FrameDuration> overrideFrameDuration;
             Optional<size_t> frameLimit;
+            // If set, the frames before the first IDR frame presented at or after this time are
+            // skipped; the frames keep their times. The frame limit still counts from the start.
+            Optional<FrameTime> startTime;
         };
 
         static const SourceConfig defaultSourceConfig;
@@ -23,6 +23,7 @@
 #include "common/utils.h"
 #include "mp4loader.h"
 #include "omaf/parser/h265parser.hpp"
+#include "omaf/parser/h265parametersets.hpp"
 
 #include "mp4vrfilestreamgeneric.h"
 
@@ -466,14 +467,10 @@ namespace VDD
 
     bool MP4LoaderSource::getTiles(size_t& aTilesX, size_t& aTilesY)
     {
-        H265::PictureParameterSet pps;
-        std::vector<uint8_t> nalUnitRBSP;
-        H265Parser::convertToRBSP(mFrames.begin()->frameMeta.decoderConfig[ConfigType::PPS], nalUnitRBSP, true);
-        Parser::BitStream bitstr(nalUnitRBSP);
-        H265::NalUnitHeader naluHeader;
-        H265Parser::parseNalUnitHeader(bitstr, naluHeader);
-
-        H265Parser::parsePPS(bitstr, pps);
+        const H265::PictureParameterSet& pps =
+            H265ParameterSetRegistry::instance()
+                .getPps(mFrames.begin()->frameMeta.decoderConfig[ConfigType::PPS])
+                ->pps;
         if (pps.mTilesEnabledFlag)
         {
             aTilesX = static_cast<size_t>(pps.mNumTileColumnsMinus1) + 1;
@@ -488,14 +485,10 @@ namespace VDD
 
     void MP4LoaderSource::getCtuSize(int& aCtuSize)
     {
-        H265::SequenceParameterSet sps;
-        std::vector<uint8_t> nalUnitRBSP;
-        H265Parser::convertToRBSP(mFrames.begin()->frameMeta.decoderConfig[ConfigType::SPS], nalUnitRBSP, true);
-        Parser::BitStream bitstr(nalUnitRBSP);
-        H265::NalUnitHeader naluHeader;
-        H265Parser::parseNalUnitHeader(bitstr, naluHeader);
-
-        H265Parser::parseSPS(bitstr, sps);
+        const H265::SequenceParameterSet& sps =
+            H265ParameterSetRegistry::instance()
+                .getSps(mFrames.begin()->frameMeta.decoderConfig[ConfigType::SPS])
+                ->sps;
 
         aCtuSize = (int)pow(2, (sps.mLog2MinLumaCodingBlockSizeMinus3 + 3) + (sps.mLog2DiffMaxMinLumaCodingBlockSize));
     }
@@ -551,6 +544,10 @@ namespace VDD
 
         if (!aConfig.initFilename)
         {
+            if (aConfig.indexCacheDirectory)
+            {
+                mReader->setIndexCacheDirectory(aConfig.indexCacheDirectory->c_str());
+            }
             int32_t rc = mReader->initialize(aConfig.filename.c_str());
             checkAndThrow(rc);
         }
@@ -722,10 +719,35 @@ namespace VDD
             assert(frame.frameMeta.presTime >= frame.frameMeta.codingTime);
         }
 
+        size_t frameLimit = aSourceConfig.frameLimit ? *aSourceConfig.frameLimit : ~0u;
+        if (aSourceConfig.startTime && frames.size())
+        {
+            auto start = std::find_if(frames.begin(), frames.end(),
+                                      [&](const MP4LoaderFrameInfo& aFrame) {
+                                          return aFrame.frameMeta.type == FrameType::IDR &&
+                                                 aFrame.frameMeta.presTime >= *aSourceConfig.startTime;
+                                      });
+            size_t skipped = size_t(std::distance(frames.begin(), start));
+            if (skipped)
+            {
+                // only the first sample carries the decoder configuration
+                auto decoderConfig = std::move(frames.front().frameMeta.decoderConfig);
+                frames.erase(frames.begin(), start);
+                if (frames.size())
+                {
+                    frames.front().frameMeta.decoderConfig = std::move(decoderConfig);
+                }
+                if (frameLimit != ~0u)
+                {
+                    frameLimit -= std::min(frameLimit, skipped);
+                }
+            }
+        }
+
         return Utils::static_cast_unique_ptr<MediaSource>(
             std::unique_ptr<MP4LoaderSource>(new MP4LoaderSource(
                 mReader, aTrackId, trackInfo, std::move(frames), mVideoNalStartCodes,
-                aSourceConfig.frameLimit ? *aSourceConfig.frameLimit : ~0u, mSegmentKeeper)));
+                frameLimit, mSegmentKeeper)));
     }
 
     std::set<TrackId> MP4Loader::getTracksByFormat(std::set<CodedFormat> aFormats)
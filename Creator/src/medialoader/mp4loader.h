@@ -162,6 +162,7 @@ namespace VDD
             std::string filename; // if reading segmented input, this is the template
             Optional<std::string> initFilename; // if reading segmented input, this is the initialization segment
             Optional<unsigned> startNumber; // if reading segmented input, this is the initial number; if missing, it is 1
+            Optional<std::string> indexCacheDirectory; // if set, sample tables of non-segmented input are cached here
         };
 
         MP4Loader(Config aConfig, bool aVideoNalStartCodes = false);
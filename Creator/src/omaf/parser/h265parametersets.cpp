@@ -0,0 +1,121 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "h265parametersets.hpp"
+#include "bitstream.hpp"
+#include "h265parser.hpp"
+
+namespace
+{
+    void parse(const std::vector<std::uint8_t>& aNalUnit, H265ParameterSetRegistry::Sps& aEntry)
+    {
+        std::vector<uint8_t> nalUnitRBSP;
+        H265Parser::convertToRBSP(aNalUnit, nalUnitRBSP, true);
+        Parser::BitStream bitstr(nalUnitRBSP);
+        H265Parser::parseNalUnitHeader(bitstr, aEntry.naluHeader);
+        H265Parser::parseSPS(bitstr, aEntry.sps);
+    }
+
+    void parse(const std::vector<std::uint8_t>& aNalUnit, H265ParameterSetRegistry::Pps& aEntry)
+    {
+        std::vector<uint8_t> nalUnitRBSP;
+        H265Parser::convertToRBSP(aNalUnit, nalUnitRBSP, true);
+        Parser::BitStream bitstr(nalUnitRBSP);
+        H265Parser::parseNalUnitHeader(bitstr, aEntry.naluHeader);
+        H265Parser::parsePPS(bitstr, aEntry.pps);
+    }
+}
+
+H265ParameterSetRegistry& H265ParameterSetRegistry::instance()
+{
+    static H265ParameterSetRegistry registry;
+    return registry;
+}
+
+size_t H265ParameterSetRegistry::ContentHash::operator()(const std::vector<std::uint8_t>& aNalUnit) const noexcept
+{
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ull;
+    for (auto byte : aNalUnit)
+    {
+        hash = (hash ^ byte) * 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+template <typename Entry>
+std::shared_ptr<const Entry> H265ParameterSetRegistry::get(Entries<Entry>& aEntries,
+                                                           const std::vector<std::uint8_t>& aNalUnit)
+{
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        auto it = aEntries.find(aNalUnit);
+        if (it != aEntries.end())
+        {
+            return it->second;
+        }
+    }
+
+    // parse without holding the lock; if another thread got here first, its entry is kept
+    auto entry = std::make_shared<Entry>();
+    entry->nalUnit = aNalUnit;
+    parse(aNalUnit, *entry);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    return aEntries.insert(std::make_pair(aNalUnit, std::shared_ptr<const Entry>(entry))).first->second;
+}
+
+std::shared_ptr<const H265ParameterSetRegistry::Sps> H265ParameterSetRegistry::getSps(const std::vector<std::uint8_t>& aNalUnit)
+{
+    return get(mSpss, aNalUnit);
+}
+
+std::shared_ptr<const H265ParameterSetRegistry::Pps> H265ParameterSetRegistry::getPps(const std::vector<std::uint8_t>& aNalUnit)
+{
+    return get(mPpss, aNalUnit);
+}
+
+H265ParameterSetRegistry::NalUnit H265ParameterSetRegistry::rewritten(const void* aEntry, const std::string& aVariant,
+                                                                      const std::function<std::vector<std::uint8_t>()>& aRewrite)
+{
+    auto key = std::make_pair(aEntry, aVariant);
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        auto it = mRewritten.find(key);
+        if (it != mRewritten.end())
+        {
+            return it->second;
+        }
+    }
+
+    NalUnit nalUnit = std::make_shared<const std::vector<std::uint8_t>>(aRewrite());
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    return mRewritten.insert(std::make_pair(key, nalUnit)).first->second;
+}
+
+H265ParameterSetRegistry::NalUnit H265ParameterSetRegistry::getRewritten(
+    const std::shared_ptr<const Sps>& aSps, const std::string& aVariant,
+    const std::function<std::vector<std::uint8_t>(const Sps&)>& aRewrite)
+{
+    // entries live as long as the registry, so their addresses identify them
+    return rewritten(aSps.get(), aVariant, [&]() { return aRewrite(*aSps); });
+}
+
+H265ParameterSetRegistry::NalUnit H265ParameterSetRegistry::getRewritten(
+    const std::shared_ptr<const Pps>& aPps, const std::string& aVariant,
+    const std::function<std::vector<std::uint8_t>(const Pps&)>& aRewrite)
+{
+    return rewritten(aPps.get(), aVariant, [&]() { return aRewrite(*aPps); });
+}
@@ -0,0 +1,97 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#ifndef H265_PARAMETER_SETS_HPP
+#define H265_PARAMETER_SETS_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "h265datastructs.hpp"
+
+/** @brief Process-wide registry of parsed H.265 parameter sets.
+ *  @details Each distinct SPS or PPS NAL unit (in byte stream format, as stored in
+ *  CodedFrameMeta::decoderConfig) is parsed only once; lookups are keyed by a hash of the NAL
+ *  unit content. The parsed structures are immutable and shared between all users, so the
+ *  same parameter sets repeated in every frame of every input cost only a lookup.
+ *
+ *  Parameter sets rewritten from a registered one (e.g. for subpictures) are generated once
+ *  per distinct variant as well.
+ *
+ *  Entries are never removed: a stream only has a handful of distinct parameter sets. The
+ *  registry is thread safe.
+ */
+class H265ParameterSetRegistry
+{
+public:
+    struct Sps
+    {
+        std::vector<std::uint8_t> nalUnit;
+        H265::NalUnitHeader naluHeader;
+        H265::SequenceParameterSet sps;
+    };
+
+    struct Pps
+    {
+        std::vector<std::uint8_t> nalUnit;
+        H265::NalUnitHeader naluHeader;
+        H265::PictureParameterSet pps;
+    };
+
+    using NalUnit = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+    static H265ParameterSetRegistry& instance();
+
+    std::shared_ptr<const Sps> getSps(const std::vector<std::uint8_t>& aNalUnit);
+    std::shared_ptr<const Pps> getPps(const std::vector<std::uint8_t>& aNalUnit);
+
+    /** @brief Retrieve a NAL unit rewritten from a registered parameter set.
+     *  @details aRewrite is called only the first time the combination of the parameter set
+     *  and aVariant is seen, so aVariant must identify everything the rewrite depends on.
+     */
+    NalUnit getRewritten(const std::shared_ptr<const Sps>& aSps, const std::string& aVariant,
+                         const std::function<std::vector<std::uint8_t>(const Sps&)>& aRewrite);
+    NalUnit getRewritten(const std::shared_ptr<const Pps>& aPps, const std::string& aVariant,
+                         const std::function<std::vector<std::uint8_t>(const Pps&)>& aRewrite);
+
+private:
+    H265ParameterSetRegistry() = default;
+
+    struct ContentHash
+    {
+        size_t operator()(const std::vector<std::uint8_t>& aNalUnit) const noexcept;
+    };
+
+    template <typename Entry>
+    using Entries = std::unordered_map<std::vector<std::uint8_t>, std::shared_ptr<const Entry>, ContentHash>;
+
+    template <typename Entry>
+    std::shared_ptr<const Entry> get(Entries<Entry>& aEntries, const std::vector<std::uint8_t>& aNalUnit);
+
+    NalUnit rewritten(const void* aEntry, const std::string& aVariant,
+                      const std::function<std::vector<std::uint8_t>()>& aRewrite);
+
+    std::mutex mMutex;
+    Entries<Sps> mSpss;
+    Entries<Pps> mPpss;
+    std::map<std::pair<const void*, std::string>, NalUnit> mRewritten;
+};
+
+#endif
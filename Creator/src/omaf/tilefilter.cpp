@@ -14,6 +14,7 @@
  */
 #include "./tilefilter.h"
 #include "./parser/h265parser.hpp"
+#include "./parser/h265parametersets.hpp"
 #include "extractor.h"
 #include "omafproperties.h"
 #include <math.h>
@@ -130,23 +131,32 @@ namespace VDD {
 
     void TileFilter::prepareParamSets(const OmafTileSets& aTileConfig, const CodedFrameMeta& aInputMeta)
     {
-        mCbsSpsData.reserve(aTileConfig.size());
-        mCbsPpsData.reserve(aTileConfig.size());
-        
-        // store the original SPS/PPS
-        CbsSpsData spsList = mH265Parser->getSpsList();
-        for (CbsSpsData::iterator it = spsList.begin(); it != spsList.end(); ++it)
+        auto& registry = H265ParameterSetRegistry::instance();
+        auto originalSps = registry.getSps(mNonVclNals.mSpsNals);
+        auto originalPps = registry.getPps(mNonVclNals.mPpsNals);
+
+        // store the original SPS/PPS when they change; they are used for parsing the original slice headers
+        if (originalSps != mOriginalSps)
         {
-            H265::SequenceParameterSet* sps = new H265::SequenceParameterSet(**it);
-            mOriginalSpsData.push_back(sps);
+            mOriginalSpsData.push_back(new H265::SequenceParameterSet(originalSps->sps));
+            mOriginalSps = originalSps;
         }
-        unsigned int fullVideoPixelArea = mOriginalSpsData.front()->mPicWidthInLumaSamples * mOriginalSpsData.front()->mPicHeightInLumaSamples;
-        CbsPpsData ppsList = mH265Parser->getPpsList();
-        for (CbsPpsData::iterator it = ppsList.begin(); it != ppsList.end(); ++it)
+        if (originalPps != mOriginalPps)
         {
-            H265::PictureParameterSet* pps = new H265::PictureParameterSet(**it);
-            mOriginalPpsData.push_back(pps);
+            mOriginalPpsData.push_back(new H265::PictureParameterSet(originalPps->pps));
+            mOriginalPps = originalPps;
         }
+
+        if (mTileRegions.size())
+        {
+            // the subpictures are defined by the first parameter sets
+            return;
+        }
+
+        mCbsSpsData.reserve(aTileConfig.size());
+        mCbsPpsData.reserve(aTileConfig.size());
+
+        unsigned int fullVideoPixelArea = mOriginalSpsData.front()->mPicWidthInLumaSamples * mOriginalSpsData.front()->mPicHeightInLumaSamples;
         uint64_t ctuSize = (uint64_t)pow(2, (mOriginalSpsData.front()->mLog2MinLumaCodingBlockSizeMinus3 + 3) + (mOriginalSpsData.front()->mLog2DiffMaxMinLumaCodingBlockSize));
         unsigned int tileWidth = 0;
         unsigned int tileHeight = 0;
@@ -222,31 +232,15 @@ namespace VDD {
 
         for (size_t i = 0; i < aTileConfig.size(); i++)
         {
-            H265::NalUnitHeader naluHeader;
-            mH265Parser->parseNalUnit(mNonVclNals.mSpsNals, naluHeader);
-            spsList = mH265Parser->getSpsList();
-            // make copy of the objects in the list, since they will be overwritten in the next round of this loop
-            CbsSpsData spsListSubPicture;
-            for (CbsSpsData::iterator it = spsList.begin(); it != spsList.end(); ++it)
-            {
-                H265::SequenceParameterSet* sps = new H265::SequenceParameterSet(**it);
-                spsListSubPicture.push_back(sps);
-            }
+            // the parsed parameter sets are shared, so modify copies of them
+            CbsSpsData spsListSubPicture{ new H265::SequenceParameterSet(originalSps->sps) };
 
             spsListSubPicture.front()->mPicWidthInLumaSamples = (unsigned int)mTileRegions.at(aTileConfig.at(i).tileIndex.get()).width;
             spsListSubPicture.front()->mPicHeightInLumaSamples = (unsigned int)mTileRegions.at(aTileConfig.at(i).tileIndex.get()).height;
 
             mCbsSpsData.push_back(spsListSubPicture);
 
-            mH265Parser->parseNalUnit(mNonVclNals.mPpsNals, naluHeader);
-            ppsList = mH265Parser->getPpsList();
-            // make copy of the objects in the list, since they will be overwritten in the next round of this loop
-            CbsPpsData ppsListSubPicture;
-            for (CbsPpsData::iterator it = ppsList.begin(); it != ppsList.end(); ++it)
-            {
-                H265::PictureParameterSet* pps = new H265::PictureParameterSet(**it);
-                ppsListSubPicture.push_back(pps);
-            }
+            CbsPpsData ppsListSubPicture{ new H265::PictureParameterSet(originalPps->pps) };
             ppsListSubPicture.front()->mNumTileColumnsMinus1 = 0;
             ppsListSubPicture.front()->mNumTileRowsMinus1 = 0;
             // we are using 1 tile per subpicture, hence tiles are not really enabled
@@ -460,36 +454,18 @@ namespace VDD {
 
             if (aSps.size() > 0)
             {
-                Parser::BitStream bitstr;
-                // first write start code (4 bytes) + NAL unit header
-                for (uint8_t i = 0; i < 6; i++) 
-                {
-                    bitstr.write8Bits(mNonVclNals.mSpsNals.at(i));
-                }
-
-                // Adjust IDC level
-                auto sps = *aSps.front();
-                setSpsLevelIdc(sps, TileIDCLevel51);
-
-                // then encode the subpicture sps
-                mH265Parser->writeSPS(bitstr, sps, false);
-
-                codedMeta.decoderConfig.insert(std::pair<ConfigType, std::vector<uint8_t>>(ConfigType::SPS, { bitstr.getStorage() }));
-                bitstr.clear();
+                // subpicture sps with adjusted IDC level
+                codedMeta.decoderConfig.insert(std::pair<ConfigType, std::vector<uint8_t>>(
+                    ConfigType::SPS, subpictureSpsNal(mNonVclNals.mSpsNals,
+                                                      aSps.front()->mPicWidthInLumaSamples,
+                                                      aSps.front()->mPicHeightInLumaSamples,
+                                                      TileIDCLevel51)));
             }
             if (aPps.size() > 0)
             {
-                Parser::BitStream bitstr;
-                // first write start code (4 bytes) + NAL unit header
-                for (uint8_t i = 0; i < 6; i++) 
-                {
-                    bitstr.write8Bits(mNonVclNals.mPpsNals.at(i));
-                }
-                // then encode the subpicture pps
-                mH265Parser->writePPS(bitstr, *aPps.front(), false);
-
-                codedMeta.decoderConfig.insert(std::pair<ConfigType, std::vector<uint8_t>>(ConfigType::PPS, { bitstr.getStorage() }));
-                bitstr.clear();
+                // subpicture pps, as in aPps
+                codedMeta.decoderConfig.insert(std::pair<ConfigType, std::vector<uint8_t>>(
+                    ConfigType::PPS, subpicturePpsNal(mNonVclNals.mPpsNals)));
             }
             if (mNonVclNals.mVpsNals.size() > 0)
             {
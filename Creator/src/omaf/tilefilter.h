@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "parser/h265parser.hpp"
+#include "parser/h265parametersets.hpp"
 #include "tileconfig.h"
 #include "controller/videoinput.h"
 
@@ -94,6 +95,9 @@ namespace VDD {
         // Original ones (full-size)
         CbsSpsData mOriginalSpsData;
         CbsPpsData mOriginalPpsData;
+        // The latest ones added to the lists above
+        std::shared_ptr<const H265ParameterSetRegistry::Sps> mOriginalSps;
+        std::shared_ptr<const H265ParameterSetRegistry::Pps> mOriginalPps;
         // Processed ones, one for each subpicture
         std::vector<CbsSpsData> mCbsSpsData;
         std::vector<CbsPpsData> mCbsPpsData;
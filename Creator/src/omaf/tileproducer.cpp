@@ -58,7 +58,7 @@ namespace VDD {
         else
         {
             CodedFrameMeta inputMeta = aStreams.front().getCodedFrameMeta();
-            if (!inputMeta.decoderConfig.empty())
+            if (!inputMeta.decoderConfig.empty() && inputMeta.decoderConfig != mDecoderConfig)
             {
                 const auto& cfg = inputMeta.decoderConfig;
                 for (ConfigType configType : std::list<ConfigType>{ ConfigType::VPS, ConfigType::SPS, ConfigType::PPS })
@@ -75,6 +75,7 @@ namespace VDD {
                         }
                     }
                 }
+                mDecoderConfig = inputMeta.decoderConfig;
             }
             H265MemoryInputStream input(reinterpret_cast<const uint8_t*>(aStreams.front().getCPUDataReference().address[0]), aStreams.front().getCPUDataReference().size[0]);
 
@@ -56,6 +56,9 @@ namespace VDD {
 
         size_t mAUIndex;
         int mTileCount;
+
+        // parameter sets last passed to mTileFilter; usually repeated in every frame
+        std::map<ConfigType, std::vector<std::uint8_t>> mDecoderConfig;
     };
 
     class WrongTileFilterConfigurationException : public Exception
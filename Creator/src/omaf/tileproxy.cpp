@@ -65,6 +65,14 @@ namespace VDD {
                         mExtractorFinished = true;
                     }
                 }
+                else if (!mExtractorFinished && mExtractorCache.empty() &&
+                         mFinishedTileStreams.size() == mTileStreamIds.size())
+                {
+                    // the inputs ended without producing a single frame (ie. they were aborted
+                    // right away), so no extractor is going to arrive either
+                    createEoS(mTiles);
+                    mExtractorFinished = true;
+                }
 
                 mTiles.push_back({data});
             }
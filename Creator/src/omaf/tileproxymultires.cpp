@@ -18,6 +18,7 @@
 #include "processor/data.h"
 #include "log/logstream.h"
 #include "./tilefilter.h"
+#include "./parser/h265parametersets.hpp"
 
 
 namespace VDD {
@@ -75,13 +76,7 @@ namespace VDD {
             if (cFirstMeta.decoderConfig[ConfigType::SPS].size())
             {
                 std::vector<uint8_t> origSps = cFirstMeta.decoderConfig[ConfigType::SPS];
-                std::vector<uint8_t> nalUnitRBSP;
-                mH265Parser->convertToRBSP(origSps, nalUnitRBSP, true);
-                Parser::BitStream bitstr(nalUnitRBSP);
-                H265::NalUnitHeader naluHeader;
-                mH265Parser->parseNalUnitHeader(bitstr, naluHeader);
-
-                mH265Parser->parseSPS(bitstr, mTileMergingConfig.extractorSPS);
+                mTileMergingConfig.extractorSPS = H265ParameterSetRegistry::instance().getSps(origSps)->sps;
                 mTileMergingConfig.extractorSPS.mPicHeightInLumaSamples = mTileMergingConfig.packedHeight;
                 mTileMergingConfig.extractorSPS.mPicWidthInLumaSamples = mTileMergingConfig.packedWidth;
                 mTileMergingConfig.extractorSPS.mVuiParametersPresentFlag = 0;//??
@@ -106,13 +101,7 @@ namespace VDD {
 
                 uint64_t ctuSize = pow(2, (mTileMergingConfig.extractorSPS.mLog2MinLumaCodingBlockSizeMinus3 + 3) + (mTileMergingConfig.extractorSPS.mLog2DiffMaxMinLumaCodingBlockSize));
 
-                std::vector<uint8_t> nalUnitRBSP;
-                mH265Parser->convertToRBSP(origPps, nalUnitRBSP, true);
-                Parser::BitStream bitstr(nalUnitRBSP);
-                H265::NalUnitHeader naluHeader;
-                mH265Parser->parseNalUnitHeader(bitstr, naluHeader);
-
-                mH265Parser->parsePPS(bitstr, mTileMergingConfig.extractorPPS);
+                mTileMergingConfig.extractorPPS = H265ParameterSetRegistry::instance().getPps(origPps)->pps;
                 mTileMergingConfig.extractorPPS.mNumTileColumnsMinus1 = mTileMergingConfig.grid.columnWidths.size() - 1;
                 mTileMergingConfig.extractorPPS.mNumTileRowsMinus1 = mTileMergingConfig.grid.rowHeights.size() - 1;
                 mTileMergingConfig.extractorPPS.mUniformSpacingFlag = 0;
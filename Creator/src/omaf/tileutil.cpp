@@ -12,7 +12,10 @@
  * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
  * written consent of Nokia.
  */
+#include <string>
+
 #include "parser/h265parser.hpp"
+#include "parser/h265parametersets.hpp"
 
 namespace VDD
 {
@@ -31,24 +34,74 @@ namespace VDD
 
     std::vector<uint8_t> spsNalWithLevelIdc(const std::vector<uint8_t>& aSpsNal, unsigned aLevel)
     {
-        std::vector<uint8_t> customSps;
+        auto& registry = H265ParameterSetRegistry::instance();
+        return *registry.getRewritten(
+            registry.getSps(aSpsNal), "level " + std::to_string(aLevel),
+            [&](const H265ParameterSetRegistry::Sps& aParsed) {
+                std::vector<uint8_t> customSps;
+
+                H265::SequenceParameterSet sps = aParsed.sps;
+                setSpsLevelIdc(sps, aLevel);
+
+                Parser::BitStream bitstrOut;
+                H265Parser::writeNalUnitHeader(bitstrOut, aParsed.naluHeader);
+                H265Parser::writeSPS(bitstrOut, sps, true);
+                auto customSpsRbsp = bitstrOut.getStorage();
+                H265Parser::convertFromRBSP(customSpsRbsp, customSps);
+
+                return customSps;
+            });
+    }
+
+    std::vector<uint8_t> subpictureSpsNal(const std::vector<uint8_t>& aSpsNal, uint32_t aWidth,
+                                          uint32_t aHeight, unsigned aLevel)
+    {
+        auto& registry = H265ParameterSetRegistry::instance();
+        return *registry.getRewritten(
+            registry.getSps(aSpsNal),
+            "subpicture " + std::to_string(aWidth) + "x" + std::to_string(aHeight) + " level " +
+                std::to_string(aLevel),
+            [&](const H265ParameterSetRegistry::Sps& aParsed) {
+                Parser::BitStream bitstr;
+                // first write start code (4 bytes) + NAL unit header
+                for (uint8_t i = 0; i < 6; i++)
+                {
+                    bitstr.write8Bits(aParsed.nalUnit.at(i));
+                }
 
-        std::vector<uint8_t> rbsp;
-        H265::NalUnitHeader nalUnitHeader;
-        H265Parser::convertToRBSP(aSpsNal, rbsp, true);
-        Parser::BitStream bitstrIn(rbsp);
-        H265::SequenceParameterSet sps;
-        H265Parser::parseNalUnitHeader(bitstrIn, nalUnitHeader);
-        H265Parser::parseSPS(bitstrIn, sps);
+                H265::SequenceParameterSet sps = aParsed.sps;
+                sps.mPicWidthInLumaSamples = aWidth;
+                sps.mPicHeightInLumaSamples = aHeight;
+                setSpsLevelIdc(sps, aLevel);
 
-        setSpsLevelIdc(sps, aLevel);
+                // then encode the subpicture sps
+                H265Parser::writeSPS(bitstr, sps, false);
+                return bitstr.getStorage();
+            });
+    }
+
+    std::vector<uint8_t> subpicturePpsNal(const std::vector<uint8_t>& aPpsNal)
+    {
+        auto& registry = H265ParameterSetRegistry::instance();
+        return *registry.getRewritten(
+            registry.getPps(aPpsNal), "subpicture",
+            [&](const H265ParameterSetRegistry::Pps& aParsed) {
+                Parser::BitStream bitstr;
+                // first write start code (4 bytes) + NAL unit header
+                for (uint8_t i = 0; i < 6; i++)
+                {
+                    bitstr.write8Bits(aParsed.nalUnit.at(i));
+                }
 
-        Parser::BitStream bitstrOut;
-        H265Parser::writeNalUnitHeader(bitstrOut, nalUnitHeader);
-        H265Parser::writeSPS(bitstrOut, sps, true);
-        auto customSpsRbsp = bitstrOut.getStorage();
-        H265Parser::convertFromRBSP(customSpsRbsp, customSps);
+                // we are using 1 tile per subpicture, hence tiles are not really enabled
+                H265::PictureParameterSet pps = aParsed.pps;
+                pps.mNumTileColumnsMinus1 = 0;
+                pps.mNumTileRowsMinus1 = 0;
+                pps.mTilesEnabledFlag = 0;
 
-        return customSps;
+                // then encode the subpicture pps
+                H265Parser::writePPS(bitstr, pps, false);
+                return bitstr.getStorage();
+            });
     }
 }  // namespace VDD
@@ -24,4 +24,10 @@ namespace VDD
     void setSpsLevelIdc(H265::SequenceParameterSet& aSps, unsigned aLevel);
 
     std::vector<uint8_t> spsNalWithLevelIdc(const std::vector<uint8_t>& aSpsNal, unsigned aLevel);
+
+    /* SPS and PPS for a subpicture consisting of a single tile of the picture of aSpsNal/aPpsNal.
+     * Generated once for each distinct input and then reused from H265ParameterSetRegistry */
+    std::vector<uint8_t> subpictureSpsNal(const std::vector<uint8_t>& aSpsNal, uint32_t aWidth,
+                                          uint32_t aHeight, unsigned aLevel);
+    std::vector<uint8_t> subpicturePpsNal(const std::vector<uint8_t>& aPpsNal);
 }  // namespace VDD
@@ -0,0 +1,48 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "lazysequencesource.h"
+
+namespace VDD
+{
+    LazySequenceSource::LazySequenceSource(const Config& aConfig)
+        : mConfig(aConfig)
+    {
+        // nothing
+    }
+
+    LazySequenceSource::~LazySequenceSource() = default;
+
+    std::vector<Streams> LazySequenceSource::produce()
+    {
+        std::vector<Streams> streams;
+        Optional<Data> sample;
+        if (!mFinished && !isAborted())
+        {
+            sample = mConfig.nextSample();
+        }
+        if (sample)
+        {
+            streams.push_back({*sample});
+        }
+        else
+        {
+            mFinished = true;
+            // release whatever state the generator holds
+            mConfig.nextSample = {};
+            streams.push_back({Data(EndOfStream())});
+        }
+        return streams;
+    }
+}  // namespace VDD
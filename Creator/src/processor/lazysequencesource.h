@@ -0,0 +1,43 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <functional>
+
+#include "processor/source.h"
+
+namespace VDD
+{
+    /** @brief Like SequenceSource, but the samples are produced on demand by a callback instead
+     * of being held in memory for the whole stream. */
+    class LazySequenceSource : public Source
+    {
+    public:
+        struct Config
+        {
+            // Returns the next sample or an empty Optional when there are no more samples
+            std::function<Optional<Data>()> nextSample;
+        };
+
+        LazySequenceSource(const Config& aConfig);
+        ~LazySequenceSource();
+
+        std::vector<Streams> produce() override;
+
+    private:
+        Config mConfig;
+        bool mFinished = false;
+    };
+}  // namespace VDD
@@ -33,7 +33,10 @@ namespace VDD
         return ">~4GB segment, unsupported (" + std::to_string(mSize) + " bytes)";
     }
 
-    MoofCombine::MoofCombine(Config aConfig) : mConfig(aConfig)
+    MoofCombine::MoofCombine(Config aConfig)
+        : mConfig(aConfig)
+        , mSidxBuilder(0,     // aReferenceId
+                       1000)  // aReserveTotal
     {
         // nothing
     }
@@ -125,7 +128,7 @@ namespace VDD
             // SegmentInfoTag is mandatory for generateSidx to work
             auto segmentInfo = aStreams[0].getMeta().findTag<SegmentInfoTag>()->get();
             if (wasFirst) {
-                mEarliestPresentationTime = segmentInfo.firstPresentationTime;
+                mSidxBuilder.setEarliestPresentationTime(segmentInfo.firstPresentationTime);
             }
             StreamSegmenter::SidxReference sidxRef {};
             sidxRef.referenceType = 0;
@@ -134,18 +137,11 @@ namespace VDD
             sidxRef.startsWithSAP = true;
             sidxRef.sapType = 1;
             sidxRef.sapDeltaTime = {0, 1};
-            mSidxReferences.push_back(sidxRef);
+            mSidxBuilder.addReference(sidxRef);
             std::vector<std::uint8_t> content; // includes ftyp header
-            content.reserve(32);
-            std::vector<char> sidx =              // comment to force nicer formatting.
-                StreamSegmenter::generateSidx(0,  // aReferenceId
-                                              mEarliestPresentationTime,
-                                              0,  // aFirstOffset
-                                              mSidxReferences,
-                                              1000  // aReserveTotal
-                );
+            content.reserve(header.size() + mSidxBuilder.getSize());
             std::copy(header.begin(), header.end(), std::back_inserter(content));
-            std::copy(sidx.begin(), sidx.end(), std::back_inserter(content));
+            mSidxBuilder.write(content);
 
             streams.add(
                 Data(CPUDataVector{{std::move(content)}},
@@ -17,6 +17,7 @@
 #include "common/exceptions.h"
 #include "processor/processor.h"
 #include "segmenter/segmenter.h"
+#include "segmenter/sidxbuilder.h"
 
 namespace VDD
 {
@@ -72,7 +73,6 @@ namespace VDD
         Config mConfig;
         bool mFirst = true;
 
-        StreamSegmenter::FrameTime mEarliestPresentationTime;
-        std::vector<StreamSegmenter::SidxReference> mSidxReferences;
+        SidxBuilder mSidxBuilder;
     };
 }
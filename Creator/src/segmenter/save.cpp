@@ -15,7 +15,9 @@
 #include <fstream>
 
 #include "save.h"
+#include "segmenter.h"
 #include "common/utils.h"
+#include "log/log.h"
 
 namespace VDD
 {
@@ -97,6 +99,15 @@ namespace VDD
         }
         sUsedTemplates[aConfig.fileTemplate] = sUsedTemplateIndex;
         sUsedTemplateIndex += 1;
+
+        if (mConfig.checkpoint)
+        {
+            if (auto restart = mConfig.checkpoint->getRestart(mConfig.fileTemplate))
+            {
+                // the segmenter drops the segments before the restart
+                mSequenceId = std::uint32_t(restart->number);
+            }
+        }
     }
 
     Save::~Save()
@@ -127,15 +138,9 @@ namespace VDD
                 throw FileNameTemplate::InvalidTemplate(
                     "Template resulted in overwriting file just written");
             }
-            Utils::ensurePathForFilename(name);
             mPrevName = name;
-            std::ofstream stream(name, std::ios::binary);
-
-            if (!stream)
-            {
-                throw CannotOpenFile(name);
-            }
 
+            std::vector<std::pair<const char*, std::streamsize>> pieces;
             for (auto& frame: streams)
             {
                 switch (frame.getStorageType())
@@ -147,8 +152,8 @@ namespace VDD
                     for (size_t n = 0; n < frags.data.size(); ++n)
                     {
                         auto& data = dynamic_cast<const CPUDataReference&>(*frags.data[n]);
-                        stream.write(reinterpret_cast<const char*>(data.address[0]),
-                                     std::streamsize(data.size[0]));
+                        pieces.push_back({reinterpret_cast<const char*>(data.address[0]),
+                                          std::streamsize(data.size[0])});
                     }
                 }
                 break;
@@ -157,8 +162,8 @@ namespace VDD
                 {
                     const CPUDataReference& data = frame.getCPUDataReference();
 
-                    stream.write(reinterpret_cast<const char*>(data.address[0]),
-                                 std::streamsize(data.size[0]));
+                    pieces.push_back({reinterpret_cast<const char*>(data.address[0]),
+                                      std::streamsize(data.size[0])});
                 }
                 break;
 
@@ -166,20 +171,102 @@ namespace VDD
                     assert(0);  // not supported
                 }
             }
+
+            auto sequenceId = mSequenceId;
             ++mSequenceId;
 
+            std::uint64_t size = 0;
+            std::uint64_t hash = SegmentCheckpoint::cHashInit;
+            Optional<SegmentCheckpoint::Timing> timing;
+            if (mConfig.checkpoint)
+            {
+                for (auto& piece : pieces)
+                {
+                    size += std::uint64_t(piece.second);
+                    hash = SegmentCheckpoint::hash(piece.first, size_t(piece.second), hash);
+                }
+                for (auto& frame : streams)
+                {
+                    if (auto segmentInfoTag = frame.getMeta().findTag<SegmentInfoTag>())
+                    {
+                        const SegmentInfo& segmentInfo = segmentInfoTag->get();
+                        timing = SegmentCheckpoint::Timing{segmentInfo.firstPresentationTime,
+                                                           segmentInfo.segmentDuration,
+                                                           segmentInfo.nextSequenceId};
+                    }
+                }
+                if (mConfig.checkpoint->isComplete(mConfig.fileTemplate, sequenceId.get(), name,
+                                                   size, hash))
+                {
+                    log(LogLevel::Info) << "Save " << name << " already complete, skipping"
+                                        << std::endl;
+                    return { { Data() } };
+                }
+            }
+
+            if (mConfig.writer)
+            {
+                auto file = mConfig.writer->open(name);
+                mConfig.writer->write(file, 0, std::vector<Data>(streams.begin(), streams.end()));
+                auto checkpoint = mConfig.checkpoint;
+                auto fileTemplate = mConfig.fileTemplate;
+                mConfig.writer->publish(file, [=] {
+                    if (checkpoint)
+                    {
+                        checkpoint->markComplete(fileTemplate, sequenceId.get(), size, hash,
+                                                 timing);
+                    }
+                });
+                mPending.push_back(file);
+                return collectFinished(false);
+            }
+
+            Utils::ensurePathForFilename(name);
+            std::ofstream stream(name, std::ios::binary);
+
+            if (!stream)
+            {
+                throw CannotOpenFile(name);
+            }
+
+            for (auto& piece : pieces)
+            {
+                stream.write(piece.first, piece.second);
+            }
+
             stream.close();
             if (!stream)
             {
                 throw CannotWriteException(name);
             }
 
+            if (mConfig.checkpoint)
+            {
+                mConfig.checkpoint->markComplete(mConfig.fileTemplate, sequenceId.get(), size,
+                                                 hash, timing);
+            }
+
             return { { Data() } };
         }
         else
         {
-            return { streams };
+            std::vector<Streams> result = collectFinished(true);
+            result.push_back(streams);
+            return result;
+        }
+    }
+
+    std::vector<Streams> Save::collectFinished(bool aWaitAll)
+    {
+        std::vector<Streams> result;
+        while (mPending.size() && (aWaitAll || mConfig.writer->isFinished(*mPending.front())))
+        {
+            // throws if the segment could not be written
+            mConfig.writer->wait(*mPending.front());
+            mPending.pop_front();
+            result.push_back({ Data() });
         }
+        return result;
     }
 
     std::string Save::getGraphVizDescription()
@@ -14,8 +14,13 @@
  */
 #pragma once
 
+#include <list>
+#include <memory>
+
 #include "processor/processor.h"
 #include "common/exceptions.h"
+#include "segmentcheckpoint.h"
+#include "segmentwriter.h"
 
 namespace VDD
 {
@@ -70,6 +75,16 @@ namespace VDD
              * that behavior.
              */
             bool disable;
+
+            /** @brief If set, segments already recorded in the checkpoint with identical
+             * contents are not written again, and written segments are recorded in it. When the
+             * run resumes an interrupted one, numbering continues from its restart segment. */
+            std::shared_ptr<SegmentCheckpoint> checkpoint;
+
+            /** @brief If set, segments are written in the background. The completion of each
+             * save is then signalled only after the segment has been published, and end of
+             * stream only after all segments have been published. */
+            std::shared_ptr<SegmentWriter> writer;
         };
 
         Save(Config aConfig);
@@ -90,6 +105,12 @@ namespace VDD
         Config mConfig;
         StreamSegmenter::Segmenter::SequenceId mSequenceId;
         std::string mPrevName;
+
+        // segments queued to mConfig.writer, in order
+        std::list<std::shared_ptr<SegmentWriter::File>> mPending;
+
+        // produce a completion signal for each finished segment at the front of mPending
+        std::vector<Streams> collectFinished(bool aWaitAll);
     };
 }
 
@@ -0,0 +1,309 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "segmentcheckpoint.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "common/exceptions.h"
+#include "common/utils.h"
+
+namespace VDD
+{
+    namespace
+    {
+        const std::string cJournalMagic = "omaf-segment-checkpoint 2";
+        const std::string cRepresentationTag = "representation";
+
+        template <typename T>
+        std::string toString(const StreamSegmenter::Rational<T>& aValue)
+        {
+            return std::to_string(aValue.num) + "/" + std::to_string(aValue.den);
+        }
+
+        template <typename T>
+        StreamSegmenter::Rational<T> parseRational(const std::string& aValue)
+        {
+            auto slash = aValue.find('/');
+            if (slash == std::string::npos)
+            {
+                throw std::invalid_argument(aValue);
+            }
+            StreamSegmenter::Rational<T> value;
+            value.num = T(std::stoll(aValue.substr(0, slash)));
+            value.den = T(std::stoll(aValue.substr(slash + 1)));
+            if (value.den == 0)
+            {
+                throw std::invalid_argument(aValue);
+            }
+            return value;
+        }
+    }
+
+    SegmentCheckpoint::SegmentCheckpoint(const Config& aConfig) : mConfig(aConfig)
+    {
+        bool resume = load();
+        Utils::ensurePathForFilename(mConfig.filename);
+        mJournal.open(mConfig.filename,
+                      std::ios::out | std::ios::binary | (resume ? std::ios::app : std::ios::trunc));
+        if (!mJournal)
+        {
+            throw CannotOpenFile(mConfig.filename);
+        }
+        if (resume && mTornTail)
+        {
+            // terminate the torn line so the next entry starts on its own line
+            mJournal << "\n";
+        }
+        if (!resume)
+        {
+            mJournal << cJournalMagic << " " << std::hex << mConfig.configHash << std::dec << "\n";
+            mJournal.flush();
+        }
+        else
+        {
+            findRestart();
+        }
+    }
+
+    SegmentCheckpoint::~SegmentCheckpoint() = default;
+
+    bool SegmentCheckpoint::load()
+    {
+        std::ifstream journal(mConfig.filename, std::ios::binary);
+        if (!journal)
+        {
+            return false;
+        }
+
+        std::string line;
+        std::ostringstream expectedHeader;
+        expectedHeader << cJournalMagic << " " << std::hex << mConfig.configHash;
+        if (!std::getline(journal, line) || line != expectedHeader.str())
+        {
+            // different configuration (or not a journal at all): start over
+            return false;
+        }
+
+        // template \t number \t size \t hash [\t first presentation time \t duration \t next
+        // sequence id], or representation \t template \t video|other; a torn last line from a
+        // crash is ignored
+        while (std::getline(journal, line))
+        {
+            mTornTail = journal.eof();
+            auto fields = Utils::split(line, '\t');
+            if (fields.size() == 3 && fields.front() == cRepresentationTag)
+            {
+                auto field = ++fields.begin();
+                std::string templ = *field++;
+                mRepresentations[templ] = *field == "video";
+                continue;
+            }
+            if (fields.size() != 4 && fields.size() != 7)
+            {
+                continue;
+            }
+            try
+            {
+                auto field = fields.begin();
+                std::string templ = *field++;
+                std::uint64_t number = std::stoull(*field++);
+                Entry entry{};
+                entry.size = std::stoull(*field++);
+                entry.hash = std::stoull(*field++, nullptr, 16);
+                if (field != fields.end())
+                {
+                    Timing timing{};
+                    timing.firstPresentationTime = parseRational<std::int64_t>(*field++);
+                    timing.duration = parseRational<std::uint64_t>(*field++);
+                    timing.nextSequenceId = std::uint32_t(std::stoul(*field++));
+                    entry.timing = timing;
+                }
+                mEntries[{templ, number}] = entry;
+            }
+            catch (std::logic_error&)
+            {
+                // torn line
+            }
+        }
+        return true;
+    }
+
+    void SegmentCheckpoint::findRestart()
+    {
+        if (mRepresentations.empty())
+        {
+            return;
+        }
+
+        // the first segment missing from any representation
+        std::uint64_t number = std::numeric_limits<std::uint64_t>::max();
+        for (auto& representation : mRepresentations)
+        {
+            std::uint64_t next = 1;
+            for (auto it = mEntries.find({representation.first, next});
+                 it != mEntries.end() && it->second.timing;
+                 it = mEntries.find({representation.first, next}))
+            {
+                ++next;
+            }
+            number = std::min(number, next);
+        }
+        if (number <= 1)
+        {
+            return;
+        }
+
+        for (auto& representation : mRepresentations)
+        {
+            const Timing& first = *mEntries.at({representation.first, 1}).timing;
+            const Timing& last = *mEntries.at({representation.first, number - 1}).timing;
+            RepresentationRestart restart{};
+            restart.restart.number = number;
+            restart.restart.time =
+                last.firstPresentationTime + last.duration.cast<StreamSegmenter::FrameTime>();
+            restart.restart.sequenceId = last.nextSequenceId;
+            restart.isVideo = representation.second;
+            restart.uniform = true;
+            for (std::uint64_t index = 2; index < number; ++index)
+            {
+                restart.uniform = restart.uniform &&
+                                  mEntries.at({representation.first, index}).timing->duration ==
+                                      first.duration;
+            }
+            mRestarts[representation.first] = restart;
+            mSkippedDuration = std::max(mSkippedDuration,
+                                        (restart.restart.time - first.firstPresentationTime)
+                                            .cast<StreamSegmenter::FrameDuration>());
+        }
+        mRestartNumber = number;
+    }
+
+    bool SegmentCheckpoint::isComplete(const std::string& aTemplate, std::uint64_t aNumber,
+                                       const std::string& aFilename, std::uint64_t aSize,
+                                       std::uint64_t aHash) const
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            auto it = mEntries.find({aTemplate, aNumber});
+            if (it == mEntries.end() || it->second.size != aSize || it->second.hash != aHash)
+            {
+                return false;
+            }
+        }
+
+        std::ifstream file(aFilename, std::ios::binary | std::ios::ate);
+        if (!file || std::uint64_t(file.tellg()) != aSize)
+        {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        ++mSkippedCount;
+        return true;
+    }
+
+    void SegmentCheckpoint::markComplete(const std::string& aTemplate, std::uint64_t aNumber,
+                                         std::uint64_t aSize, std::uint64_t aHash,
+                                         const Optional<Timing>& aTiming)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        Entry& entry = mEntries[{aTemplate, aNumber}];
+        if (entry.size == aSize && entry.hash == aHash && bool(entry.timing) == bool(aTiming))
+        {
+            return;
+        }
+        entry.size = aSize;
+        entry.hash = aHash;
+        entry.timing = aTiming;
+        mJournal << aTemplate << "\t" << aNumber << "\t" << aSize << "\t" << std::hex << aHash
+                 << std::dec;
+        if (aTiming)
+        {
+            mJournal << "\t" << toString(aTiming->firstPresentationTime) << "\t"
+                     << toString(aTiming->duration) << "\t" << aTiming->nextSequenceId.get();
+        }
+        mJournal << "\n";
+        // flush per entry, so a crash loses at most the segment being written
+        mJournal.flush();
+    }
+
+    void SegmentCheckpoint::addRepresentation(const std::string& aTemplate, bool aIsVideo)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mRepresentations.count(aTemplate))
+        {
+            return;
+        }
+        mRepresentations[aTemplate] = aIsVideo;
+        mJournal << cRepresentationTag << "\t" << aTemplate << "\t"
+                 << (aIsVideo ? "video" : "other") << "\n";
+        mJournal.flush();
+    }
+
+    Optional<SegmentRestart> SegmentCheckpoint::getRestart(const std::string& aTemplate) const
+    {
+        auto restart = mRestarts.find(aTemplate);
+        if (restart == mRestarts.end())
+        {
+            return {};
+        }
+        return restart->second.restart;
+    }
+
+    Optional<StreamSegmenter::FrameTime> SegmentCheckpoint::getVideoSeekTime() const
+    {
+        Optional<StreamSegmenter::FrameTime> time;
+        for (auto& representation : mRestarts)
+        {
+            const RepresentationRestart& restart = representation.second;
+            if (!restart.isVideo)
+            {
+                continue;
+            }
+            if (!restart.uniform || (time && *time != restart.restart.time))
+            {
+                return {};
+            }
+            time = restart.restart.time;
+        }
+        return time;
+    }
+
+    StreamSegmenter::FrameDuration SegmentCheckpoint::getSkippedDuration() const
+    {
+        return mSkippedDuration;
+    }
+
+    size_t SegmentCheckpoint::getSkippedCount() const
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        return mSkippedCount;
+    }
+
+    std::uint64_t SegmentCheckpoint::hash(const void* aData, size_t aSize, std::uint64_t aHash)
+    {
+        auto bytes = static_cast<const unsigned char*>(aData);
+        for (size_t index = 0; index < aSize; ++index)
+        {
+            aHash ^= bytes[index];
+            aHash *= 1099511628211ull;
+        }
+        return aHash;
+    }
+}  // namespace VDD
@@ -0,0 +1,140 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <streamsegmenter/segmenterapi.hpp>
+
+#include "common/optional.h"
+
+namespace VDD
+{
+    /** @brief Where a resumed run continues a representation: its first segment that was not
+     * saved by the interrupted run */
+    struct SegmentRestart
+    {
+        std::uint64_t number;
+        StreamSegmenter::FrameTime time;  // presentation time of the segment
+        StreamSegmenter::Segmenter::SequenceId sequenceId;  // its first fragment sequence number
+    };
+
+    /** @brief Journal of segments that have been completely saved, so an interrupted run can
+     * be restarted from the first missing segment.
+     *
+     * Each entry records the file name template (ie. the representation), the segment number,
+     * and the size and content hash of the saved segment; for media segments also their timing.
+     * Entries are appended to the journal only after the segment file has been closed
+     * successfully. The journal header holds a hash of the configuration; if it does not match,
+     * the old journal is discarded.
+     *
+     * The media segment templates of the run are registered in the journal as well. The restart
+     * segment is the first one missing from any of them, as the segmenters are combined for the
+     * MPD segment by segment. It is determined once, from the journal of the interrupted run.
+     *
+     * Thread safe; a single instance is shared by all Save nodes.
+     */
+    class SegmentCheckpoint
+    {
+    public:
+        struct Config
+        {
+            std::string filename;
+            std::uint64_t configHash;
+        };
+
+        /** @brief Timing of a saved media segment, from its SegmentInfo */
+        struct Timing
+        {
+            StreamSegmenter::FrameTime firstPresentationTime;
+            StreamSegmenter::FrameDuration duration;
+            StreamSegmenter::Segmenter::SequenceId nextSequenceId;
+        };
+
+        SegmentCheckpoint(const Config& aConfig);
+        ~SegmentCheckpoint();
+
+        /** @brief Is this segment recorded with the same content, and does the file on disk
+         * still have the recorded size? */
+        bool isComplete(const std::string& aTemplate, std::uint64_t aNumber,
+                        const std::string& aFilename, std::uint64_t aSize,
+                        std::uint64_t aHash) const;
+
+        /** @brief Record the segment as completely saved */
+        void markComplete(const std::string& aTemplate, std::uint64_t aNumber,
+                          std::uint64_t aSize, std::uint64_t aHash,
+                          const Optional<Timing>& aTiming);
+
+        /** @brief Register the media segment template of a representation */
+        void addRepresentation(const std::string& aTemplate, bool aIsVideo);
+
+        /** @brief Where the representation continues; not set if the run starts over */
+        Optional<SegmentRestart> getRestart(const std::string& aTemplate) const;
+
+        /** @brief The presentation time the video sources can seek to. Set only if every video
+         * representation restarts at this time and all their earlier segments have the same
+         * duration, so segmenting from there gives the same segment boundaries. */
+        Optional<StreamSegmenter::FrameTime> getVideoSeekTime() const;
+
+        /** @brief The longest duration of segments that are not produced again */
+        StreamSegmenter::FrameDuration getSkippedDuration() const;
+
+        /** @brief Number of segments found complete with isComplete */
+        size_t getSkippedCount() const;
+
+        /** @brief 64-bit FNV-1a; pass the previous result as aHash to hash in pieces */
+        static std::uint64_t hash(const void* aData, size_t aSize,
+                                  std::uint64_t aHash = cHashInit);
+
+        static const std::uint64_t cHashInit = 14695981039346656037ull;
+
+    private:
+        struct Entry
+        {
+            std::uint64_t size;
+            std::uint64_t hash;
+            Optional<Timing> timing;
+        };
+
+        using Key = std::pair<std::string, std::uint64_t>;
+
+        const Config mConfig;
+        mutable std::mutex mMutex;
+        std::map<Key, Entry> mEntries;
+        std::map<std::string, bool> mRepresentations;  // template -> is video
+        std::ofstream mJournal;
+        mutable size_t mSkippedCount = 0;
+        bool mTornTail = false;  // the journal did not end in a newline
+
+        struct RepresentationRestart
+        {
+            SegmentRestart restart;
+            bool isVideo;
+            bool uniform;  // the segments before the restart have the same duration
+        };
+
+        // Determined by findRestart from the loaded journal; don't change afterwards
+        std::uint64_t mRestartNumber = 1;
+        std::map<std::string, RepresentationRestart> mRestarts;
+        StreamSegmenter::FrameDuration mSkippedDuration;
+
+        bool load();
+        void findRestart();
+    };
+}  // namespace VDD
@@ -465,8 +465,29 @@ namespace VDD
         {
             for (StreamSegmenter::Segmenter::Segments& subsegments : segments)
             {
+                if (mConfig.restart && subsegments.size() &&
+                    subsegments.front().t0 < mConfig.restart->time)
+                {
+                    // saved by the interrupted run
+                    mFirstSegment = false;
+                    continue;
+                }
+
                 for (StreamSegmenter::Segmenter::Segment& segment : subsegments)
                 {
+                    if (mConfig.restart)
+                    {
+                        // continue the numbering of the interrupted run, whether the input was
+                        // seeked to the restart or not
+                        if (!mSequenceIdOffset)
+                        {
+                            mSequenceIdOffset = std::int64_t(mConfig.restart->sequenceId.get()) -
+                                                std::int64_t(segment.sequenceId.get());
+                        }
+                        segment.sequenceId = std::uint32_t(
+                            std::int64_t(segment.sequenceId.get()) + *mSequenceIdOffset);
+                    }
+
                     // sequences in sync
                     if (mAcquireNextImdaId)
                     {
@@ -503,7 +524,8 @@ namespace VDD
                                  Meta()
                                      .attachTag(SegmentInfoTag(SegmentInfo{
                                          {0, 1},  // firstPresentationTime
-                                         {0, 1}   // segmentDuration
+                                         {0, 1},  // segmentDuration
+                                         {}       // nextSequenceId
                                      }))
                                      .attachTag(SegmentRoleTag(SegmentRole::TrackRunSegment)),
                                  cTrackRunStreamId));
@@ -594,6 +616,9 @@ namespace VDD
             {
                 segmentInfo.segmentDuration += seg.duration;
             };
+            segmentInfo.nextSequenceId =
+                aSegment.back().sequenceId.get() +
+                (mAcquireNextImdaId ? mAcquireNextImdaId->sequenceStep.get() : 1u);
         };
 
         if (mConfig.sidx)
@@ -752,8 +777,7 @@ namespace VDD
                     sampleConstruct++;
                     // now we have a full extractor: either just a sample constructor, or inline+sample constructor pair
                     extractorData.samples.push_back(outputExtractor);
-                    const StreamSegmenter::FrameData& nal = extractorData.toFrameData();
-                    extractorNALUnits.insert(extractorNALUnits.end(), nal.begin(), nal.end());
+                    extractorData.appendTo(extractorNALUnits);
                 }
             }
         }
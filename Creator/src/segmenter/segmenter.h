@@ -28,6 +28,7 @@
 #include "processor/meta.h"
 #include "processor/processor.h"
 #include "log/log.h"
+#include "segmentcheckpoint.h"
 #include "segmentercommon.h"
 
 namespace VDD
@@ -91,6 +92,8 @@ namespace VDD
     {
         FrameTime firstPresentationTime;
         FrameDuration segmentDuration;
+        // fragment sequence number of the segment following this one
+        StreamSegmenter::Segmenter::SequenceId nextSequenceId;
     };
 
     using SegmentInfoTag = ValueTag<SegmentInfo>;
@@ -189,6 +192,11 @@ namespace VDD
 
             // What to stick in front of frame segments
             Optional<SegmentHeader> frameSegmentHeader;
+
+            // If set, the run resumes an interrupted one: segments starting before the restart
+            // have already been saved and are dropped, and the fragment sequence numbers
+            // continue from the restart segment
+            Optional<SegmentRestart> restart;
         };
 
         static const StreamId cSingleStreamId;
@@ -267,6 +275,9 @@ namespace VDD
 
         bool mFirstSegment = true;
 
+        // Added to the fragment sequence numbers when resuming; see Config::restart
+        Optional<std::int64_t> mSequenceIdOffset;
+
         /* Used for calculating the bitrate passed on as metadata to MPD writer */
         uint64_t mTotalNumberOfBits = 0ul;
 
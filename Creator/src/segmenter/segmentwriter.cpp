@@ -0,0 +1,464 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "segmentwriter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "common/utils.h"
+#include "save.h"  // for CannotWriteException
+
+namespace VDD
+{
+    namespace
+    {
+        const std::uint64_t kDirectAlignment = 4096;
+
+        struct Piece
+        {
+            const char* address;
+            size_t size;
+        };
+
+        std::vector<Piece> collectPieces(const std::vector<Data>& aData)
+        {
+            std::vector<Piece> pieces;
+            for (auto& data : aData)
+            {
+                switch (data.getStorageType())
+                {
+                case StorageType::Fragmented:
+                {
+                    for (auto& frag : data.getFragmentedDataReference().data)
+                    {
+                        auto& cpu = dynamic_cast<const CPUDataReference&>(*frag);
+                        pieces.push_back(
+                            {reinterpret_cast<const char*>(cpu.address[0]), cpu.size[0]});
+                    }
+                    break;
+                }
+                case StorageType::CPU:
+                {
+                    auto& cpu = data.getCPUDataReference();
+                    pieces.push_back({reinterpret_cast<const char*>(cpu.address[0]), cpu.size[0]});
+                    break;
+                }
+                default:
+                    assert(0);  // not supported
+                }
+            }
+            return pieces;
+        }
+    }  // namespace
+
+    class SegmentWriter::File
+    {
+    public:
+        File(const std::string& aFilename, size_t aWorker)
+            : filename(aFilename), tmpFilename(aFilename + ".tmp"), worker(aWorker)
+        {
+            // nothing
+        }
+
+        ~File()
+        {
+            close();
+        }
+
+        void close()
+        {
+#if !defined(_WIN32)
+            if (fd >= 0)
+            {
+                ::close(fd);
+                fd = -1;
+            }
+            if (directFd >= 0)
+            {
+                ::close(directFd);
+                directFd = -1;
+            }
+#endif
+        }
+
+        const std::string filename;
+        const std::string tmpFilename;
+        const size_t worker;
+
+#if defined(_WIN32)
+        std::fstream stream;
+#else
+        int fd = -1;
+        int directFd = -1;
+#endif
+        std::uint64_t size = 0;  // end of the furthest write
+
+        // protected by SegmentWriter::mMutex
+        size_t pending = 0;
+        bool published = false;
+        std::exception_ptr error;
+    };
+
+    SegmentWriter::SegmentWriter(Config aConfig) : mConfig(aConfig)
+    {
+        size_t threads = std::max(size_t(1), mConfig.threads);
+        for (size_t n = 0; n < threads; ++n)
+        {
+            mWorkers.push_back(std::unique_ptr<Worker>(new Worker()));
+        }
+        for (auto& worker : mWorkers)
+        {
+            Worker* w = worker.get();
+            worker->thread = std::thread([this, w] { run(*w); });
+        }
+    }
+
+    SegmentWriter::~SegmentWriter()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQuit = true;
+            for (auto& worker : mWorkers)
+            {
+                worker->queueChanged.notify_all();
+            }
+        }
+        for (auto& worker : mWorkers)
+        {
+            worker->thread.join();
+        }
+    }
+
+    std::shared_ptr<SegmentWriter::File> SegmentWriter::open(const std::string& aFilename)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        auto file = std::make_shared<File>(aFilename, mNextWorker);
+        mNextWorker = (mNextWorker + 1) % mWorkers.size();
+        return file;
+    }
+
+    void SegmentWriter::write(std::shared_ptr<File> aFile, std::uint64_t aOffset,
+                              std::vector<Data> aData)
+    {
+        enqueue({aFile, false, aOffset, std::move(aData), {}});
+    }
+
+    void SegmentWriter::publish(std::shared_ptr<File> aFile, std::function<void()> aOnPublished)
+    {
+        enqueue({aFile, true, 0, {}, aOnPublished});
+    }
+
+    bool SegmentWriter::isFinished(const File& aFile) const
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        return aFile.published || aFile.error;
+    }
+
+    void SegmentWriter::wait(const File& aFile) const
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mFileFinished.wait(lock, [&] { return aFile.pending == 0; });
+        if (aFile.error)
+        {
+            std::rethrow_exception(aFile.error);
+        }
+    }
+
+    std::uint64_t SegmentWriter::size(const Data& aData)
+    {
+        std::uint64_t size = 0;
+        for (auto& piece : collectPieces({aData}))
+        {
+            size += piece.size;
+        }
+        return size;
+    }
+
+    void SegmentWriter::enqueue(Operation&& aOperation)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        Worker& worker = *mWorkers[aOperation.file->worker];
+        worker.queueChanged.wait(lock,
+                                 [&] { return worker.queue.size() < mConfig.queueLength; });
+        ++aOperation.file->pending;
+        worker.queue.push_back(std::move(aOperation));
+        worker.queueChanged.notify_all();
+    }
+
+    void SegmentWriter::run(Worker& aWorker)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            aWorker.queueChanged.wait(lock, [&] { return mQuit || aWorker.queue.size(); });
+            if (aWorker.queue.empty())
+            {
+                // mQuit is set and everything has been written
+                break;
+            }
+            Operation operation = std::move(aWorker.queue.front());
+            aWorker.queue.pop_front();
+            aWorker.queueChanged.notify_all();
+
+            File& file = *operation.file;
+            bool failed = !!file.error;
+            lock.unlock();
+
+            std::exception_ptr error;
+            if (!failed)
+            {
+                try
+                {
+                    execute(operation);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                    file.close();
+                    std::remove(file.tmpFilename.c_str());
+                }
+            }
+            // release the data before the file is seen finished
+            operation.data.clear();
+
+            lock.lock();
+            if (error)
+            {
+                file.error = error;
+            }
+            --file.pending;
+            mFileFinished.notify_all();
+        }
+    }
+
+    void SegmentWriter::execute(Operation& aOperation)
+    {
+        if (aOperation.publish)
+        {
+            executePublish(*aOperation.file);
+            if (aOperation.onPublished)
+            {
+                aOperation.onPublished();
+            }
+            std::unique_lock<std::mutex> lock(mMutex);
+            aOperation.file->published = true;
+        }
+        else
+        {
+            executeWrite(*aOperation.file, aOperation.offset, aOperation.data);
+        }
+    }
+
+#if defined(_WIN32)
+    void SegmentWriter::executeWrite(File& aFile, std::uint64_t aOffset,
+                                     const std::vector<Data>& aData)
+    {
+        if (!aFile.stream.is_open())
+        {
+            Utils::ensurePathForFilename(aFile.filename);
+            aFile.stream.open(aFile.tmpFilename, std::ios::in | std::ios::out | std::ios::binary |
+                                                     std::ios::trunc);
+            if (!aFile.stream)
+            {
+                throw CannotOpenFile(aFile.tmpFilename);
+            }
+        }
+        aFile.stream.seekp(std::streamoff(aOffset));
+        for (auto& piece : collectPieces(aData))
+        {
+            aFile.stream.write(piece.address, std::streamsize(piece.size));
+        }
+        if (!aFile.stream)
+        {
+            throw CannotWriteException(aFile.tmpFilename);
+        }
+    }
+
+    void SegmentWriter::executePublish(File& aFile)
+    {
+        if (!aFile.stream.is_open())
+        {
+            executeWrite(aFile, 0, {});
+        }
+        aFile.stream.close();
+        if (!aFile.stream)
+        {
+            throw CannotWriteException(aFile.tmpFilename);
+        }
+        std::remove(aFile.filename.c_str());
+        if (std::rename(aFile.tmpFilename.c_str(), aFile.filename.c_str()) != 0)
+        {
+            throw CannotWriteException(aFile.filename);
+        }
+    }
+#else
+    void SegmentWriter::executeWrite(File& aFile, std::uint64_t aOffset,
+                                     const std::vector<Data>& aData)
+    {
+        if (aFile.fd < 0)
+        {
+            Utils::ensurePathForFilename(aFile.filename);
+            aFile.fd = ::open(aFile.tmpFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                              0666);
+            if (aFile.fd < 0)
+            {
+                throw CannotOpenFile(aFile.tmpFilename);
+            }
+        }
+
+        std::vector<Piece> pieces = collectPieces(aData);
+        std::uint64_t size = 0;
+        for (auto& piece : pieces)
+        {
+            size += piece.size;
+        }
+        if (size == 0)
+        {
+            return;
+        }
+        std::uint64_t end = aOffset + size;
+
+#if defined(__linux__)
+        if (mConfig.preallocate && end > aFile.size)
+        {
+            // not supported by all file systems; the write works regardless
+            (void)::fallocate(aFile.fd, 0, off_t(aOffset), off_t(size));
+        }
+
+        // O_DIRECT writes whole aligned blocks, so use it only when nothing follows the write
+        if (mConfig.direct && aOffset % kDirectAlignment == 0 && end >= aFile.size)
+        {
+            if (aFile.directFd < 0)
+            {
+                aFile.directFd = ::open(aFile.tmpFilename.c_str(), O_WRONLY | O_DIRECT | O_CLOEXEC);
+            }
+            if (aFile.directFd >= 0)
+            {
+                size_t alignedSize =
+                    size_t((size + kDirectAlignment - 1) / kDirectAlignment * kDirectAlignment);
+                void* buffer = nullptr;
+                if (::posix_memalign(&buffer, kDirectAlignment, alignedSize) == 0)
+                {
+                    std::unique_ptr<void, void (*)(void*)> bufferOwner(buffer, std::free);
+                    char* at = static_cast<char*>(buffer);
+                    for (auto& piece : pieces)
+                    {
+                        std::memcpy(at, piece.address, piece.size);
+                        at += piece.size;
+                    }
+                    std::memset(at, 0, alignedSize - size);
+                    size_t written = 0;
+                    while (written < alignedSize)
+                    {
+                        auto n = ::pwrite(aFile.directFd, static_cast<char*>(buffer) + written,
+                                          alignedSize - written, off_t(aOffset + written));
+                        if (n <= 0)
+                        {
+                            break;
+                        }
+                        written += size_t(n);
+                    }
+                    if (written == alignedSize)
+                    {
+                        // drop the padding of the last block
+                        if (::ftruncate(aFile.fd, off_t(end)) != 0)
+                        {
+                            throw CannotWriteException(aFile.tmpFilename);
+                        }
+                        aFile.size = end;
+                        return;
+                    }
+                }
+            }
+            // fall back to a normal write
+        }
+#endif
+
+        std::vector<iovec> iov;
+        iov.reserve(pieces.size());
+        for (auto& piece : pieces)
+        {
+            if (piece.size)
+            {
+                iov.push_back({const_cast<char*>(piece.address), piece.size});
+            }
+        }
+
+        const size_t maxIov = size_t(std::max(1L, ::sysconf(_SC_IOV_MAX)));
+        size_t first = 0;
+        std::uint64_t offset = aOffset;
+        while (first < iov.size())
+        {
+            int count = int(std::min(maxIov, iov.size() - first));
+            ssize_t n = ::pwritev(aFile.fd, &iov[first], count, off_t(offset));
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw CannotWriteException(aFile.tmpFilename);
+            }
+            offset += std::uint64_t(n);
+            // skip the pieces written completely and adjust a partially written one
+            size_t left = size_t(n);
+            while (first < iov.size() && left >= iov[first].iov_len)
+            {
+                left -= iov[first].iov_len;
+                ++first;
+            }
+            if (left)
+            {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+        aFile.size = std::max(aFile.size, end);
+    }
+
+    void SegmentWriter::executePublish(File& aFile)
+    {
+        if (aFile.fd < 0)
+        {
+            // nothing was written; still create the (empty) file
+            executeWrite(aFile, 0, {});
+        }
+        int fd = aFile.fd;
+        aFile.fd = -1;
+        aFile.close();
+        if (::close(fd) != 0)
+        {
+            throw CannotWriteException(aFile.tmpFilename);
+        }
+        if (std::rename(aFile.tmpFilename.c_str(), aFile.filename.c_str()) != 0)
+        {
+            throw CannotWriteException(aFile.filename);
+        }
+    }
+#endif
+}  // namespace VDD
@@ -0,0 +1,122 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "processor/data.h"
+
+namespace VDD
+{
+    /** @brief Background writer for segment files, so that the graph does not wait for storage.
+     *
+     * Each file is written to aFilename + ".tmp" and renamed to aFilename once it has been
+     * published, so a complete file appears atomically. All operations of a single file are
+     * executed in order by the same I/O thread; different files are spread over the threads.
+     *
+     * The queue of each thread is bounded: when it is full, write and publish block, which
+     * limits the amount of data kept alive for writing.
+     *
+     * Thread safe; a single instance is shared by all Save and SingleFileSave nodes.
+     */
+    class SegmentWriter
+    {
+    public:
+        struct Config
+        {
+            /** @brief Number of I/O threads */
+            size_t threads = 1;
+
+            /** @brief Maximum number of queued operations per thread */
+            size_t queueLength = 16;
+
+            /** @brief Reserve the space of each write with fallocate before writing */
+            bool preallocate = false;
+
+            /** @brief Write with O_DIRECT to bypass the page cache. Used only for writes that
+             * start at an aligned offset; the data is copied to an aligned buffer. */
+            bool direct = false;
+        };
+
+        class File;
+
+        SegmentWriter(Config aConfig);
+
+        /** @brief Finishes all queued operations before returning */
+        ~SegmentWriter();
+
+        /** @brief Create a handle for writing aFilename. Nothing is done with the file system
+         * until the first write is executed, which creates (or truncates) the temporary file. */
+        std::shared_ptr<File> open(const std::string& aFilename);
+
+        /** @brief Write aData (CPU or Fragmented data references) to aOffset of the file. The
+         * data is kept referenced until it has been written. */
+        void write(std::shared_ptr<File> aFile, std::uint64_t aOffset, std::vector<Data> aData);
+
+        /** @brief Close the file and rename it to its final name. aOnPublished is called by the
+         * I/O thread after a successful rename. */
+        void publish(std::shared_ptr<File> aFile, std::function<void()> aOnPublished = {});
+
+        /** @brief Has the file been published, or has an operation of it failed? */
+        bool isFinished(const File& aFile) const;
+
+        /** @brief Wait until all queued operations of the file are finished. Throws
+         * CannotOpenFile or CannotWriteException if any of them failed. */
+        void wait(const File& aFile) const;
+
+        /** @brief Number of bytes write would write for aData */
+        static std::uint64_t size(const Data& aData);
+
+    private:
+        struct Operation
+        {
+            std::shared_ptr<File> file;
+            bool publish;
+            std::uint64_t offset;
+            std::vector<Data> data;
+            std::function<void()> onPublished;
+        };
+
+        struct Worker
+        {
+            std::list<Operation> queue;
+            std::condition_variable queueChanged;
+            std::thread thread;
+        };
+
+        const Config mConfig;
+
+        mutable std::mutex mMutex;
+        mutable std::condition_variable mFileFinished;
+        std::vector<std::unique_ptr<Worker>> mWorkers;
+        size_t mNextWorker = 0;
+        bool mQuit = false;
+
+        void enqueue(Operation&& aOperation);
+        void run(Worker& aWorker);
+        void execute(Operation& aOperation);
+        void executeWrite(File& aFile, std::uint64_t aOffset, const std::vector<Data>& aData);
+        void executePublish(File& aFile);
+    };
+}  // namespace VDD
@@ -14,16 +14,22 @@
  */
 #include "sidxadjuster.h"
 
+#include <algorithm>
+
 #include <streamsegmenter/autosegmenter.hpp>
 #include <streamsegmenter/segmenterapi.hpp>
 #include <streamsegmenter/track.hpp>
 
 #include "segmenter.h"
+#include "sidxbuilder.h"
 
 namespace VDD
 {
     struct SidxAdjuster::Impl {
         std::vector<uint32_t> adjustments;
+        // number of adjustments already applied to the references of sidx
+        size_t numApplied = 0;
+        SidxBuilder sidx{0, Segmenter::cSidxSpaceReserve};
     };
 
     SidxAdjuster::SidxAdjuster(const Config& aConfig)
@@ -61,13 +67,23 @@ namespace VDD
             const CPUDataReference& tilesData = tilesMoofInput.getCPUDataReference();
             mImpl->adjustments.push_back(tilesData.size[0]);
 
+            // Only the references added since the previous segment are decoded from the extractor
+            // sidx; the earlier ones have already been adjusted in place.
             const CPUDataReference& sidxData = extractorSidxInput.getCPUDataReference();
-            auto sidxDataAddr = static_cast<const char*>(sidxData.address[0]);
-            auto newSidx = StreamSegmenter::patchSidxSegmentSizes(
-                sidxDataAddr, sidxDataAddr + sidxData.size[0], mImpl->adjustments,
-                Segmenter::cSidxSpaceReserve);
+            auto& sidx = mImpl->sidx;
+            sidx.addReferencesFrom(static_cast<const std::uint8_t*>(sidxData.address[0]), sidxData.size[0]);
+            for (; mImpl->numApplied < std::min(sidx.getReferenceCount(), mImpl->adjustments.size());
+                 ++mImpl->numApplied)
+            {
+                sidx.addReferencedSize(mImpl->numApplied, mImpl->adjustments[mImpl->numApplied]);
+            }
+
+            std::vector<std::uint8_t> newSidx;
+            newSidx.reserve(sidx.getSize());
+            sidx.write(newSidx);
 
-            std::vector<std::vector<std::uint8_t>> llData{{{newSidx.begin(), newSidx.end()}}};
+            std::vector<std::vector<std::uint8_t>> llData;
+            llData.push_back(std::move(newSidx));
             CPUDataVector data(std::move(llData));
             return {{Data(data, Meta().attachTag(SegmentRoleTag(SegmentRole::SegmentIndex)))}};
         }
@@ -0,0 +1,288 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "sidxbuilder.h"
+
+#include <cstring>
+#include <string>
+
+namespace VDD
+{
+    namespace
+    {
+        const std::size_t cReferenceSize = 12;
+        // size, type, version and flags, reference id, timescale, earliest presentation time,
+        // first offset, reserved and reference count
+        const std::size_t cHeaderSize = 4 + 4 + 4 + 4 + 4 + 8 + 8 + 2 + 2;
+
+        void put32(std::uint8_t* aDst, std::uint32_t aValue)
+        {
+            aDst[0] = std::uint8_t(aValue >> 24);
+            aDst[1] = std::uint8_t(aValue >> 16);
+            aDst[2] = std::uint8_t(aValue >> 8);
+            aDst[3] = std::uint8_t(aValue);
+        }
+
+        void put64(std::uint8_t* aDst, std::uint64_t aValue)
+        {
+            put32(aDst, std::uint32_t(aValue >> 32));
+            put32(aDst + 4, std::uint32_t(aValue));
+        }
+
+        std::uint32_t get32(const std::uint8_t* aSrc)
+        {
+            return (std::uint32_t(aSrc[0]) << 24) | (std::uint32_t(aSrc[1]) << 16) |
+                   (std::uint32_t(aSrc[2]) << 8) | std::uint32_t(aSrc[3]);
+        }
+
+        std::uint64_t get64(const std::uint8_t* aSrc)
+        {
+            return (std::uint64_t(get32(aSrc)) << 32) | get32(aSrc + 4);
+        }
+
+        const std::uint64_t cMaxDuration     = 0xffffffffu;
+        const std::uint64_t cMaxSapDeltaTime = 0x0fffffffu;
+
+        // aValue * aMul, which must not exceed aLimit
+        std::uint64_t scaled(std::uint64_t aValue, std::uint64_t aMul, std::uint64_t aLimit, const char* aField)
+        {
+            if (aValue && aMul > aLimit / aValue)
+            {
+                throw InvalidSegmentIndex(std::string(aField) + " does not fit in the sidx timescale");
+            }
+            return aValue * aMul;
+        }
+
+        // a duration in the timescale aTimescale, which must be a multiple of its denominator
+        std::uint64_t inTimescale(const StreamSegmenter::FrameDuration& aDuration, std::uint64_t aTimescale,
+                                  std::uint64_t aLimit, const char* aField)
+        {
+            return scaled(aDuration.num, aTimescale / aDuration.den, aLimit, aField);
+        }
+
+        // throw if rescaleReference would overflow a field of an encoded reference
+        void checkRescaleReference(const std::uint8_t* aReference, std::uint64_t aMul)
+        {
+            scaled(get32(aReference + 4), aMul, cMaxDuration, "subsegment_duration");
+            scaled(get32(aReference + 8) & 0x0fffffffu, aMul, cMaxSapDeltaTime, "SAP_delta_time");
+        }
+
+        // multiply subsegment_duration and SAP_delta_time of an encoded reference by aMul; checked
+        // beforehand with checkRescaleReference
+        void rescaleReference(std::uint8_t* aReference, std::uint64_t aMul)
+        {
+            put32(aReference + 4, std::uint32_t(get32(aReference + 4) * aMul));
+            std::uint32_t sap = get32(aReference + 8);
+            put32(aReference + 8, (sap & 0xf0000000u) | std::uint32_t((sap & 0x0fffffffu) * aMul));
+        }
+    }  // anonymous namespace
+
+    InvalidSegmentIndex::InvalidSegmentIndex(std::string aReason)
+        : Exception("InvalidSegmentIndex")
+        , mReason(aReason)
+    {
+        // nothing
+    }
+
+    std::string InvalidSegmentIndex::message() const
+    {
+        return "Invalid segment index: " + mReason;
+    }
+
+    SidxBuilder::SidxBuilder(std::uint32_t aReferenceId, std::size_t aReserveTotal)
+        : mReferenceId(aReferenceId)
+        , mReserveTotal(aReserveTotal)
+        , mEarliestPresentationTime(0, 1)
+    {
+        mReferences.reserve(aReserveTotal * cReferenceSize);
+    }
+
+    void SidxBuilder::useDenominator(std::uint64_t aDenominator)
+    {
+        std::uint64_t timescale = StreamSegmenter::lcm(mTimescale, aDenominator);
+        if (timescale != mTimescale)
+        {
+            if (timescale > 0xffffffffu)
+            {
+                throw InvalidSegmentIndex("timescale " + std::to_string(timescale) + " does not fit in 32 bits");
+            }
+            std::uint64_t mul = timescale / mTimescale;
+            // check all before changing any, so a failure leaves the builder as it was
+            for (std::size_t offset = 0; offset < mReferences.size(); offset += cReferenceSize)
+            {
+                checkRescaleReference(&mReferences[offset], mul);
+            }
+            for (std::size_t offset = 0; offset < mReferences.size(); offset += cReferenceSize)
+            {
+                rescaleReference(&mReferences[offset], mul);
+            }
+            mTimescale = timescale;
+        }
+    }
+
+    void SidxBuilder::setEarliestPresentationTime(StreamSegmenter::FrameTime aEarliestPresentationTime)
+    {
+        mEarliestPresentationTime = aEarliestPresentationTime;
+        useDenominator(std::uint64_t(aEarliestPresentationTime.den));
+    }
+
+    void SidxBuilder::setFirstOffset(std::uint64_t aFirstOffset)
+    {
+        mFirstOffset = aFirstOffset;
+    }
+
+    void SidxBuilder::addReference(const StreamSegmenter::SidxReference& aReference)
+    {
+        useDenominator(aReference.subsegmentDuration.den);
+        useDenominator(aReference.sapDeltaTime.den);
+
+        std::uint64_t duration =
+            inTimescale(aReference.subsegmentDuration, mTimescale, cMaxDuration, "subsegment_duration");
+        std::uint64_t sapDeltaTime =
+            inTimescale(aReference.sapDeltaTime, mTimescale, cMaxSapDeltaTime, "SAP_delta_time");
+
+        std::uint8_t encoded[cReferenceSize];
+        // bit (1) reference_type, unsigned int(31) referenced_size
+        put32(encoded, (aReference.referenceType ? 0x80000000u : 0u) | (aReference.referencedSize & 0x7fffffffu));
+        // unsigned int(32) subsegment_duration
+        put32(encoded + 4, std::uint32_t(duration));
+        // bit (1) starts_with_SAP, unsigned int(3) SAP_type, unsigned int(28) SAP_delta_time
+        put32(encoded + 8, (aReference.startsWithSAP ? 0x80000000u : 0u) |
+                               (std::uint32_t(aReference.sapType & 0x7u) << 28) | std::uint32_t(sapDeltaTime));
+        mReferences.insert(mReferences.end(), encoded, encoded + cReferenceSize);
+    }
+
+    void SidxBuilder::addReferencedSize(std::size_t aIndex, std::uint32_t aSize)
+    {
+        std::uint8_t* field = &mReferences.at(aIndex * cReferenceSize);
+        std::uint32_t value = get32(field);
+        put32(field, (value & 0x80000000u) | ((value + aSize) & 0x7fffffffu));
+    }
+
+    std::size_t SidxBuilder::getReferenceCount() const
+    {
+        return mReferences.size() / cReferenceSize;
+    }
+
+    std::size_t SidxBuilder::addReferencesFrom(const std::uint8_t* aSidx, std::size_t aSize)
+    {
+        if (aSize < cHeaderSize || std::memcmp(aSidx + 4, "sidx", 4) != 0)
+        {
+            throw InvalidSegmentIndex("not a sidx box");
+        }
+        if (aSidx[8] != 1)
+        {
+            throw InvalidSegmentIndex("only version 1 is supported");
+        }
+        std::size_t referenceCount = (std::size_t(aSidx[38]) << 8) | aSidx[39];
+        if (cHeaderSize + referenceCount * cReferenceSize > aSize)
+        {
+            throw InvalidSegmentIndex("truncated reference table");
+        }
+
+        std::uint32_t timescale = get32(aSidx + 16);
+        if (timescale == 0)
+        {
+            throw InvalidSegmentIndex("zero timescale");
+        }
+        std::size_t reserveBytes =
+            referenceCount < mReserveTotal ? (mReserveTotal - referenceCount) * cReferenceSize : 0u;
+
+        std::size_t existing = getReferenceCount();
+        // the references already taken are in the old timescale; move both them and the incoming ones
+        // to a common timescale
+        std::uint64_t commonTimescale = existing ? StreamSegmenter::lcm(mTimescale, std::uint64_t(timescale)) : timescale;
+        std::uint64_t mul             = commonTimescale / timescale;
+        if (mul != 1)
+        {
+            for (std::size_t index = existing; index < referenceCount; ++index)
+            {
+                checkRescaleReference(aSidx + cHeaderSize + index * cReferenceSize, mul);
+            }
+        }
+        if (existing)
+        {
+            useDenominator(timescale);
+        }
+        else
+        {
+            mTimescale = timescale;
+        }
+
+        mReferenceId              = get32(aSidx + 12);
+        mEarliestPresentationTime = StreamSegmenter::FrameTime(std::int64_t(get64(aSidx + 20)), timescale);
+        mFirstOffset              = get64(aSidx + 28) - reserveBytes;
+
+        if (referenceCount <= existing)
+        {
+            return 0;
+        }
+        mReferences.insert(mReferences.end(), aSidx + cHeaderSize + existing * cReferenceSize,
+                           aSidx + cHeaderSize + referenceCount * cReferenceSize);
+        if (mul != 1)
+        {
+            for (std::size_t offset = existing * cReferenceSize; offset < mReferences.size();
+                 offset += cReferenceSize)
+            {
+                rescaleReference(&mReferences[offset], mul);
+            }
+        }
+        return referenceCount - existing;
+    }
+
+    std::size_t SidxBuilder::getReserveBytes() const
+    {
+        std::size_t referenceCount = getReferenceCount();
+        return referenceCount < mReserveTotal ? (mReserveTotal - referenceCount) * cReferenceSize : 0u;
+    }
+
+    std::size_t SidxBuilder::getSize() const
+    {
+        return cHeaderSize + mReferences.size() + getReserveBytes();
+    }
+
+    void SidxBuilder::write(std::vector<std::uint8_t>& aOutput) const
+    {
+        std::size_t referenceCount = getReferenceCount();
+        std::size_t reserveBytes   = getReserveBytes();
+        std::size_t boxSize        = cHeaderSize + mReferences.size();
+
+        std::size_t begin = aOutput.size();
+        aOutput.resize(begin + boxSize + reserveBytes);
+        std::uint8_t* box = &aOutput[begin];
+
+        std::uint64_t earliest = std::uint64_t(mEarliestPresentationTime.num) *
+                                 (mTimescale / std::uint64_t(mEarliestPresentationTime.den));
+        put32(box, std::uint32_t(boxSize));
+        std::memcpy(box + 4, "sidx", 4);
+        put32(box + 8, 1u << 24);  // version 1, no flags
+        put32(box + 12, mReferenceId);
+        put32(box + 16, std::uint32_t(mTimescale));
+        put64(box + 20, earliest);
+        put64(box + 28, mFirstOffset + reserveBytes);
+        put32(box + 36, std::uint32_t(referenceCount & 0xffffu));  // reserved = 0, reference_count
+        if (mReferences.size())
+        {
+            std::memcpy(box + cHeaderSize, mReferences.data(), mReferences.size());
+        }
+
+        if (reserveBytes)
+        {
+            // the rest of the reserve is zero-filled by resize
+            std::uint8_t* free = box + boxSize;
+            put32(free, std::uint32_t(reserveBytes));
+            std::memcpy(free + 4, "free", 4);
+        }
+    }
+}
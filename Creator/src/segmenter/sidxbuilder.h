@@ -0,0 +1,92 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <streamsegmenter/segmenterapi.hpp>
+
+#include "common/exceptions.h"
+
+namespace VDD
+{
+    class InvalidSegmentIndex : public Exception
+    {
+    public:
+        InvalidSegmentIndex(std::string aReason);
+
+        std::string message() const override;
+
+    private:
+        std::string mReason;
+    };
+
+    /** Builds a version 1 'sidx' incrementally. Each reference is encoded once when its subsegment
+     * is produced, so emitting the up-to-date box only needs a fresh header in front of the
+     * already encoded reference table; nothing is reparsed or rebuilt from scratch.
+     *
+     * The timescale is the least common multiple of the denominators seen so far, which gives the
+     * same result as StreamSegmenter::generateSidx. If the timescale or a duration in it no longer
+     * fits its field, InvalidSegmentIndex is thrown and the builder is left unchanged. */
+    class SidxBuilder
+    {
+    public:
+        /** @param aReserveTotal the number of references to reserve space for with a trailing 'free'
+         * box, so the index can be rewritten in place as it grows */
+        SidxBuilder(std::uint32_t aReferenceId, std::size_t aReserveTotal);
+
+        void setEarliestPresentationTime(StreamSegmenter::FrameTime aEarliestPresentationTime);
+
+        void setFirstOffset(std::uint64_t aFirstOffset);
+
+        void addReference(const StreamSegmenter::SidxReference& aReference);
+
+        /** Grow the referenced size of the reference aIndex, e.g. when data is concatenated to its
+         * subsegment afterwards */
+        void addReferencedSize(std::size_t aIndex, std::uint32_t aSize);
+
+        std::size_t getReferenceCount() const;
+
+        /** Take the reference id, timescale, earliest presentation time and first offset from an
+         * encoded version 1 'sidx' written with the same space reserve, and append its references
+         * beyond the ones already added. Only the new references are decoded. If the timescale differs
+         * from the one of the references already added, all of them are moved to a common timescale.
+         *
+         * @return the number of references appended */
+        std::size_t addReferencesFrom(const std::uint8_t* aSidx, std::size_t aSize);
+
+        /** @return the number of bytes write appends */
+        std::size_t getSize() const;
+
+        /** Append the encoded 'sidx' box (and the 'free' box of the reserved space) to aOutput */
+        void write(std::vector<std::uint8_t>& aOutput) const;
+
+    private:
+        std::uint32_t mReferenceId;
+        std::size_t mReserveTotal;
+        std::uint64_t mTimescale = 1;
+        StreamSegmenter::FrameTime mEarliestPresentationTime;
+        std::uint64_t mFirstOffset = 0;
+
+        // references in their final big endian layout, 12 bytes each
+        std::vector<std::uint8_t> mReferences;
+
+        std::size_t getReserveBytes() const;
+
+        // switch to a timescale that is a multiple of the current one, rescaling the encoded durations
+        void useDenominator(std::uint64_t aDenominator);
+    };
+}
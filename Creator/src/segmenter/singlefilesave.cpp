@@ -15,6 +15,7 @@
 #include "singlefilesave.h"
 
 #include <array>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -102,6 +103,148 @@ namespace VDD
         }
     }
 
+    void SingleFileSave::writeDataAsync(const Data& aData, SegmentRole aRole)
+    {
+        if (!mFile)
+        {
+            mFile = mConfig.writer->open(mConfig.filename);
+        }
+
+        // segment indices are always written to the same offset, as in writeData
+        std::uint64_t offset = mWriteOffset;
+        if (aRole == SegmentRole::SegmentIndex)
+        {
+            if (!mSidxOffset)
+            {
+                mSidxOffset = mWriteOffset;
+            }
+            offset = *mSidxOffset;
+        }
+
+        std::uint64_t size = SegmentWriter::size(aData);
+        mConfig.writer->write(mFile, offset, {aData});
+        if (offset == mWriteOffset)
+        {
+            mWriteOffset += size;
+        }
+
+        log(LogLevel::Info) << "SingleFileSave " << getId() << " Queued " << to_string(aRole)
+                            << " to " << offset << " .. " << offset + size << " = " << size
+                            << std::endl;
+    }
+
+    std::string SingleFileSave::spillFilename() const
+    {
+        return mConfig.spillFilename.size() ? mConfig.spillFilename : mConfig.filename + ".spill";
+    }
+
+    void SingleFileSave::openSinglePassOutput()
+    {
+        if (!mOutput.is_open())
+        {
+            Utils::ensurePathForFilename(mConfig.filename);
+            // no std::ios::in: the output may be a pipe
+            mOutput.open(mConfig.filename, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!mOutput)
+            {
+                throw CannotOpenFile(mConfig.filename);
+            }
+        }
+    }
+
+    void SingleFileSave::writeSinglePass(std::list<Data>& aQueue, SegmentRole aRole)
+    {
+        openSinglePassOutput();
+
+        switch (aRole)
+        {
+        case SegmentRole::InitSegment:
+        {
+            for (auto& data : aQueue)
+            {
+                writeData(mOutput, data, aRole);
+            }
+            break;
+        }
+        case SegmentRole::SegmentIndex:
+        {
+            // each segment index replaces the previous one; only the last one is written
+            mLatestSegmentIndex = aQueue.back();
+            break;
+        }
+        case SegmentRole::TrackRunSegment:  // fall through
+        case SegmentRole::ImdaSegment:
+        {
+            if (!mConfig.expectSegmentIndex)
+            {
+                for (auto& data : aQueue)
+                {
+                    writeData(mOutput, data, aRole);
+                }
+                break;
+            }
+            if (!mSpill.is_open())
+            {
+                mSpill.open(spillFilename(), std::ios::in | std::ios::out | std::ios::binary |
+                                                 std::ios::trunc);
+                if (!mSpill)
+                {
+                    throw CannotOpenFile(spillFilename());
+                }
+            }
+            for (auto& data : aQueue)
+            {
+                writeData(mSpill, data, aRole);
+            }
+            if (!mSpill)
+            {
+                throw CannotWriteException(spillFilename());
+            }
+            break;
+        }
+        }
+        aQueue.clear();
+
+        if (!mOutput)
+        {
+            throw CannotWriteException(mConfig.filename);
+        }
+    }
+
+    void SingleFileSave::finishSinglePass()
+    {
+        if (mSinglePassFinished)
+        {
+            return;
+        }
+        mSinglePassFinished = true;
+
+        openSinglePassOutput();
+        if (mLatestSegmentIndex)
+        {
+            // this is the only segment index written, so writeData does not seek
+            writeData(mOutput, *mLatestSegmentIndex, SegmentRole::SegmentIndex);
+            mLatestSegmentIndex = {};
+        }
+        if (mSpill.is_open())
+        {
+            mSpill.flush();
+            mSpill.seekg(0);
+            std::vector<char> buffer(1 << 20);
+            while (mSpill.read(buffer.data(), std::streamsize(buffer.size())) || mSpill.gcount())
+            {
+                mOutput.write(buffer.data(), mSpill.gcount());
+            }
+            mSpill.close();
+            std::remove(spillFilename().c_str());
+        }
+        mOutput.close();
+        if (!mOutput)
+        {
+            throw CannotWriteException(mConfig.filename);
+        }
+    }
+
     std::vector<Streams> SingleFileSave::process(const Streams& aStreams)
     {
         size_t index = 0;
@@ -199,6 +342,22 @@ namespace VDD
                                 }
                             }
 
+                            if (mConfig.singlePass)
+                            {
+                                writeSinglePass(queue, role);
+                                continue;
+                            }
+
+                            if (mConfig.writer)
+                            {
+                                for (auto& data : queue)
+                                {
+                                    writeDataAsync(data, role);
+                                }
+                                queue.clear();
+                                continue;
+                            }
+
                             Utils::ensurePathForFilename(mConfig.filename);
                             stream.open(mConfig.filename,
                                         (std::ios::in | std::ios::out | std::ios::binary) |
@@ -229,6 +388,17 @@ namespace VDD
         }
         if (finished)
         {
+            if (mConfig.singlePass && !mConfig.disable)
+            {
+                finishSinglePass();
+            }
+            else if (mFile)
+            {
+                mConfig.writer->publish(mFile);
+                // throws if the file could not be written
+                mConfig.writer->wait(*mFile);
+                mFile.reset();
+            }
             return {{Data(EndOfStream())}};
         }
         else
@@ -14,8 +14,11 @@
  */
 #pragma once
 
+#include <fstream>
+
 #include "processor/processor.h"
 #include "segmenter/segmenter.h"
+#include "segmenter/segmentwriter.h"
 
 namespace VDD
 {
@@ -55,6 +58,22 @@ namespace VDD
 
             /** @brief if set, segment indexes are expected */
             bool expectSegmentIndex = true;
+
+            /** @brief if set, the output file is written strictly front to back: track runs and
+             * imdas are staged in spillFilename, only the latest segment index is kept, and at
+             * end of stream the segment index and the staged media are appended after the init
+             * segment. This allows writing to non-seekable outputs such as pipes. The result is
+             * byte-identical to the default mode.
+             */
+            bool singlePass = false;
+
+            /** @brief staging file for single pass mode; if empty, filename + ".spill" */
+            std::string spillFilename;
+
+            /** @brief if set (and not in single pass mode), the file is written in the
+             * background and appears under filename only once it is complete, at end of
+             * stream */
+            std::shared_ptr<SegmentWriter> writer;
         };
 
         SingleFileSave(Config aConfig);
@@ -85,6 +104,30 @@ namespace VDD
 
         void writeData(std::ostream& aStream, const Data& aData, SegmentRole aRole);
 
+        // same as writeData, but queues the data to mConfig.writer
+        void writeDataAsync(const Data& aData, SegmentRole aRole);
+
+        void openSinglePassOutput();
+
+        // single pass mode: handle one queue of data; writes or stages it
+        void writeSinglePass(std::list<Data>& aQueue, SegmentRole aRole);
+
+        // single pass mode: write the segment index and the staged media to the output
+        void finishSinglePass();
+
+        std::string spillFilename() const;
+
         bool mFirstWrite = true;
+
+        // single pass mode state
+        std::ofstream mOutput;
+        std::fstream mSpill;
+        Optional<Data> mLatestSegmentIndex;
+        bool mSinglePassFinished = false;
+
+        // background writing state
+        std::shared_ptr<SegmentWriter::File> mFile;
+        std::uint64_t mWriteOffset = 0;
+        Optional<std::uint64_t> mSidxOffset;
     };
 }
@@ -0,0 +1,371 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "buildinfo.h"
+#include "common/exceptions.h"
+#include "common/optional.h"
+
+// Combines the partial MPDs written by omafvd processes run with --shard.index=i --shard.count=n
+// into one MPD. Each shard builds the same graph, so adaptation set, representation and
+// preselection ids agree between the shards; the partials differ only by the adaptation sets
+// their views produced and by the presentation duration. The partials are our own MPD writer
+// output, so a light-weight scan of the elements directly under <Period> is sufficient.
+
+namespace
+{
+    class MergeError : public VDD::Exception
+    {
+    public:
+        MergeError(std::string aMessage) : VDD::Exception("MergeError"), mMessage(aMessage)
+        {
+        }
+
+        std::string message() const override
+        {
+            return mMessage;
+        }
+
+    private:
+        std::string mMessage;
+    };
+
+    void usage()
+    {
+        std::cout << "Usage: ./omafmpdmerge output.mpd foo.shard0.mpd foo.shard1.mpd .." << std::endl;
+    }
+
+    std::string readFile(const std::string& aFilename)
+    {
+        std::ifstream in(aFilename, std::ios::binary);
+        if (!in)
+        {
+            throw VDD::CannotOpenFile(aFilename);
+        }
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+
+    // Returns the position just past the '>' of the tag starting at aBegin, skipping quoted
+    // attribute values
+    size_t endOfTag(const std::string& aXml, size_t aBegin)
+    {
+        char quote = 0;
+        for (size_t pos = aBegin; pos < aXml.size(); ++pos)
+        {
+            char ch = aXml[pos];
+            if (quote)
+            {
+                if (ch == quote)
+                {
+                    quote = 0;
+                }
+            }
+            else if (ch == '"' || ch == '\'')
+            {
+                quote = ch;
+            }
+            else if (ch == '>')
+            {
+                return pos + 1;
+            }
+        }
+        throw MergeError("Unterminated tag");
+    }
+
+    VDD::Optional<std::string> attribute(const std::string& aTag, const std::string& aName)
+    {
+        std::string key = " " + aName + "=\"";
+        auto begin = aTag.find(key);
+        if (begin == std::string::npos)
+        {
+            return {};
+        }
+        begin += key.size();
+        auto end = aTag.find('"', begin);
+        return aTag.substr(begin, end - begin);
+    }
+
+    std::string withoutAttribute(std::string aTag, const std::string& aName)
+    {
+        std::string key = " " + aName + "=\"";
+        auto begin = aTag.find(key);
+        if (begin != std::string::npos)
+        {
+            auto end = aTag.find('"', begin + key.size());
+            aTag.erase(begin, end + 1 - begin);
+        }
+        return aTag;
+    }
+
+    // Parses the xs:duration values written by the MPD writer (PT[nH][nM]n[.nnn]S)
+    double parseDuration(const std::string& aDuration)
+    {
+        if (aDuration.compare(0, 2, "PT") != 0)
+        {
+            throw MergeError("Unsupported duration " + aDuration);
+        }
+        double seconds = 0.0;
+        std::istringstream in(aDuration.substr(2));
+        double value;
+        char unit;
+        while (in >> value >> unit)
+        {
+            seconds += value * (unit == 'H' ? 3600.0 : unit == 'M' ? 60.0 : 1.0);
+        }
+        return seconds;
+    }
+
+    struct Element
+    {
+        std::string name;
+        std::string indent;
+        std::string text;
+    };
+
+    struct PartialMpd
+    {
+        std::string filename;
+        std::string header;  // up to and including the <Period> start tag
+        std::string footer;  // starting from the </Period> end tag
+        std::list<Element> elements;
+        double duration = 0.0;
+    };
+
+    PartialMpd parsePartialMpd(const std::string& aFilename)
+    {
+        PartialMpd mpd;
+        mpd.filename = aFilename;
+        std::string xml = readFile(aFilename);
+
+        auto periodBegin = xml.find("<Period");
+        auto periodEnd = xml.find("</Period>");
+        if (periodBegin == std::string::npos || periodEnd == std::string::npos ||
+            xml.find("<Period", periodBegin + 1) != std::string::npos)
+        {
+            throw MergeError(aFilename + ": expected exactly one Period");
+        }
+        size_t bodyBegin = endOfTag(xml, periodBegin);
+        while (periodEnd > bodyBegin && xml[periodEnd - 1] != '\n')
+        {
+            --periodEnd;
+        }
+        mpd.header = xml.substr(0, bodyBegin);
+        mpd.footer = xml.substr(periodEnd);
+
+        if (auto duration =
+                attribute(xml.substr(xml.find("<MPD"), endOfTag(xml, xml.find("<MPD"))),
+                          "mediaPresentationDuration"))
+        {
+            mpd.duration = parseDuration(*duration);
+        }
+
+        size_t pos = bodyBegin;
+        while (true)
+        {
+            size_t lineBegin = pos;
+            pos = xml.find('<', pos);
+            if (pos == std::string::npos || pos >= periodEnd)
+            {
+                break;
+            }
+            Element element;
+            element.indent = xml.substr(lineBegin, pos - lineBegin);
+            element.indent.erase(0, element.indent.find_last_of('\n') + 1);
+            size_t nameEnd = xml.find_first_of(" />", pos + 1);
+            element.name = xml.substr(pos + 1, nameEnd - pos - 1);
+
+            size_t begin = pos;
+            int depth = 0;
+            do
+            {
+                size_t tagEnd = endOfTag(xml, pos);
+                if (xml[pos + 1] == '/')
+                {
+                    --depth;
+                }
+                else if (xml[tagEnd - 2] != '/')
+                {
+                    ++depth;
+                }
+                pos = tagEnd;
+                if (depth > 0)
+                {
+                    pos = xml.find('<', pos);
+                    if (pos == std::string::npos || pos > periodEnd)
+                    {
+                        throw MergeError(aFilename + ": unbalanced element " + element.name);
+                    }
+                }
+            } while (depth > 0);
+            element.text = xml.substr(begin, pos - begin);
+            mpd.elements.push_back(element);
+        }
+        return mpd;
+    }
+
+    std::string startTag(const Element& aElement)
+    {
+        return aElement.text.substr(0, endOfTag(aElement.text, 0));
+    }
+
+    std::string mergePartialMpds(const std::vector<PartialMpd>& aPartials)
+    {
+        // The header of the longest partial carries the durations of the merged presentation
+        const PartialMpd* longest = &aPartials.front();
+        for (const auto& partial : aPartials)
+        {
+            if (partial.duration > longest->duration)
+            {
+                longest = &partial;
+            }
+        }
+
+        auto withoutDurations = [](const std::string& aHeader) {
+            std::string header = aHeader;
+            auto periodBegin = header.find("<Period");
+            header = header.substr(0, periodBegin) +
+                     withoutAttribute(header.substr(periodBegin), "duration");
+            return withoutAttribute(header, "mediaPresentationDuration");
+        };
+
+        std::map<std::uint64_t, const Element*> adaptationSets;
+        std::map<std::string, std::uint64_t> representationIds;
+        std::list<const Element*> others;
+        std::set<std::string> seenOthers;
+
+        for (const auto& partial : aPartials)
+        {
+            if (withoutDurations(partial.header) != withoutDurations(longest->header) ||
+                partial.footer != longest->footer)
+            {
+                throw MergeError(partial.filename + " and " + longest->filename +
+                                 " are not shards of the same configuration");
+            }
+            for (const auto& element : partial.elements)
+            {
+                if (element.name != "AdaptationSet")
+                {
+                    if (seenOthers.insert(element.text).second)
+                    {
+                        others.push_back(&element);
+                    }
+                    continue;
+                }
+
+                auto idValue = attribute(startTag(element), "id");
+                if (!idValue)
+                {
+                    throw MergeError(partial.filename + ": AdaptationSet without id");
+                }
+                std::uint64_t id = std::stoull(*idValue);
+                auto existing = adaptationSets.find(id);
+                if (existing != adaptationSets.end())
+                {
+                    if (existing->second->text != element.text)
+                    {
+                        throw MergeError(partial.filename + ": conflicting AdaptationSet " +
+                                         *idValue);
+                    }
+                    continue;
+                }
+                adaptationSets[id] = &element;
+
+                size_t pos = 0;
+                while ((pos = element.text.find("<Representation ", pos)) != std::string::npos)
+                {
+                    auto representationId =
+                        attribute(element.text.substr(pos, endOfTag(element.text, pos) - pos), "id");
+                    if (representationId)
+                    {
+                        auto inserted = representationIds.insert({*representationId, id});
+                        if (!inserted.second)
+                        {
+                            throw MergeError(partial.filename + ": Representation " +
+                                             *representationId + " appears in AdaptationSets " +
+                                             std::to_string(inserted.first->second) + " and " +
+                                             *idValue);
+                        }
+                    }
+                    ++pos;
+                }
+            }
+        }
+
+        // Same order as DashOmaf::writeMpd: adaptation sets sorted by id, then entity groups
+        std::ostringstream out;
+        out << longest->header << "\n";
+        for (const auto& idElement : adaptationSets)
+        {
+            out << idElement.second->indent << idElement.second->text << "\n";
+        }
+        for (const auto* element : others)
+        {
+            out << element->indent << element->text << "\n";
+        }
+        out << longest->footer;
+        return out.str();
+    }
+}  // anonymous namespace
+
+int main(int ac, char** av)
+{
+    std::cout << "omafmpdmerge version " << BuildInfo::Version << " built at " << BuildInfo::Time << std::endl
+              << "Copyright (c) 2018 Nokia Corporation and/or its subsidiary(-ies). All rights reserved. " << std::endl << std::endl;
+
+    if (ac < 3)
+    {
+        usage();
+        return -1;
+    }
+
+    try
+    {
+        std::vector<PartialMpd> partials;
+        for (int argIndex = 2; argIndex < ac; ++argIndex)
+        {
+            partials.push_back(parsePartialMpd(av[argIndex]));
+        }
+
+        std::string merged = mergePartialMpds(partials);
+
+        std::ofstream out(av[1], std::ofstream::out | std::ofstream::binary);
+        if (!out)
+        {
+            throw VDD::CannotOpenFile(av[1]);
+        }
+        out << merged;
+    }
+    catch (VDD::CannotOpenFile& exn)
+    {
+        std::cerr << "Failed to open file: " << exn.message() << std::endl;
+        return 2;
+    }
+    catch (VDD::Exception& exn)
+    {
+        std::cerr << "Failed to merge: " << exn.message() << std::endl;
+        return 1;
+    }
+    return 0;
+}
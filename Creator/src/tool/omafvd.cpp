@@ -13,6 +13,7 @@
  * written consent of Nokia.
  */
 #include <iostream>
+#include <map>
 
 #include "commandline.h"
 
@@ -20,12 +21,19 @@
 #include "common/exceptions.h"
 #include "common/optional.h"
 #include "common/utils.h"
+#include "controller/configreader.h"
 #include "controller/omafvdcontroller.h"
+#include "log/asynclog.h"
 #include "log/consolelog.h"
 
 
 namespace
 {
+    const std::map<std::string, VDD::LogLevel> kNameToLogLevel{{"assert", VDD::LogLevel::Assert},
+                                                               {"error", VDD::LogLevel::Error},
+                                                               {"info", VDD::LogLevel::Info},
+                                                               {"debug", VDD::LogLevel::Debug}};
+
     void usage()
     {
         std::cout << "Usage: ./omafvd config.json" << std::endl;
@@ -117,6 +125,24 @@ int main(int ac, char** av)
     config.log->setLogLevel(VDD::LogLevel::Error);
 #endif
 
+    try
+    {
+        config.log->setLogLevel(VDD::optionWithDefault(config.config->root(), "log.level",
+                                                       VDD::readMapping("LogLevel", kNameToLogLevel),
+                                                       config.log->getLogLevel()));
+        if (VDD::optionWithDefault(config.config->root(), "log.async", VDD::readBool, false))
+        {
+            VDD::AsyncLog::Config asyncLogConfig{};
+            asyncLogConfig.target = config.log;
+            config.log = std::make_shared<VDD::AsyncLog>(asyncLogConfig);
+        }
+    }
+    catch (VDD::ConfigError& exn)
+    {
+        std::cerr << "Failed to read configuration: " << exn.message() << std::endl;
+        return 1;
+    }
+
     int rc = 0;
 
     enum { Initializing, Running } state = Initializing;
@@ -588,6 +588,40 @@ namespace MP4VR
          *  @return ErrorCode: NO_ERROR, INVALID_SEGMENT*/
         virtual int32_t parseSegmentIndex(StreamInterface* streamInterface,
                                           DynArray<SegmentInformation>& segmentIndex) = 0;
+
+        /** Get track information for the samples of one media segment.
+         *  Unlike getTrackInformations(), which covers every sample of every parsed segment, this returns only the
+         *  tracks that have samples in the given segment, and their sampleProperties contain only those samples.
+         *  This allows keeping track of the buffered samples with a constant cost per segment: call this after
+         *  parseSegment() to get the added samples, and before invalidateSegment() to get the samples that will be
+         *  removed.
+         *
+         *  @pre parseSegment() has been called successfully for the segment.
+         *  @param [in]  initSegmentId Initialization segment id the segment was parsed with.
+         *  @param [in]  segmentId     Segment id given to parseSegment().
+         *  @param [out] trackInfos    Track information limited to the samples of the segment.
+         *  @return ErrorCode: NO_ERROR, INVALID_SEGMENT or UNINITIALIZED */
+        virtual int32_t getSegmentTrackInformations(uint32_t initSegmentId,
+                                                    uint32_t segmentId,
+                                                    DynArray<TrackInformation>& trackInfos) const = 0;
+
+        /** Get display timestamp for each sample of a track within one media segment.
+         *  The segment counterpart of getTrackTimestamps(); see getSegmentTrackInformations().
+         *  @pre parseSegment() has been called successfully for the segment.
+         *  @param [in]  trackId    Track ID of a track.
+         *  @param [in]  segmentId  Segment id given to parseSegment().
+         *  @param [out] timestamps TimestampIDPair struct of <timestamp in milliseconds, sampleId> pair
+         *  @return ErrorCode: NO_ERROR, INVALID_CONTEXT_ID, INVALID_SEGMENT or UNINITIALIZED */
+        virtual int32_t getSegmentTrackTimestamps(uint32_t trackId,
+                                                  uint32_t segmentId,
+                                                  DynArray<TimestampIDPair>& timestamps) const = 0;
+
+        /** Set a directory where the expanded sample tables of non-fragmented files are cached between
+         *  initialize() calls. Call this before initialize(). A file whose 'moov' box, size and modification time
+         *  match a cached entry is initialized without rebuilding its sample tables; otherwise a new entry is written
+         *  after a successful initialize(). Caching is disabled by default and with nullptr or an empty string.
+         *  @param [in] directory Existing directory for the cache entries */
+        virtual void setIndexCacheDirectory(const char* directory) = 0;
     };
 }  // namespace MP4VR
 
@@ -591,6 +591,13 @@ namespace StreamSegmenter
             std::uint32_t dataLength;
 
             FrameData toFrameData() const;
+
+            /** @return Serialized size of the constructor in bytes */
+            std::size_t getSize() const;
+
+            /** @brief Serializes the constructor to aDst, which must have room for getSize() bytes
+             *  @return Pointer past the last written byte */
+            std::uint8_t* write(std::uint8_t* aDst) const;
         };
 
         /**
@@ -602,6 +609,13 @@ namespace StreamSegmenter
             std::vector<std::uint8_t> inlineData;
 
             FrameData toFrameData() const;
+
+            /** @return Serialized size of the constructor in bytes */
+            std::size_t getSize() const;
+
+            /** @brief Serializes the constructor to aDst, which must have room for getSize() bytes
+             *  @return Pointer past the last written byte */
+            std::uint8_t* write(std::uint8_t* aDst) const;
         };
 
         /**
@@ -614,6 +628,13 @@ namespace StreamSegmenter
             ISOBMFF::Optional<HevcExtractorInlineConstructor> inlineConstructor;
 
             FrameData toFrameData() const;
+
+            /** @return Serialized size of the constructors, including their constructor_type bytes */
+            std::size_t getSize() const;
+
+            /** @brief Serializes the constructors to aDst, which must have room for getSize() bytes
+             *  @return Pointer past the last written byte */
+            std::uint8_t* write(std::uint8_t* aDst) const;
         };
 
         /**
@@ -626,6 +647,13 @@ namespace StreamSegmenter
             std::vector<HevcExtractor> samples;
 
             FrameData toFrameData() const;
+
+            /** @return Serialized size of the length prefixed extractor NAL unit in bytes */
+            std::size_t getSize() const;
+
+            /** @brief Appends the length prefixed extractor NAL unit to aFrameData, growing it only once.
+             *  Equivalent to, but cheaper than, inserting the result of toFrameData(). */
+            void appendTo(FrameData& aFrameData) const;
         };
 
         struct OBSP
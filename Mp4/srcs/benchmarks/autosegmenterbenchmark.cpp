@@ -0,0 +1,206 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures the DASH segmenting path: how many frames per second AutoSegmenter takes in and hands out as segments,
+// and how many bytes per second Writer::writeSegment serializes from them. The input is a synthetic multi-track
+// stream with an IDR frame every GOP; the frame sizes and contents are derived from the frame index, so every run
+// produces the same segments. The digest of the written segments is printed so that runs can be compared.
+//
+// Usage: autosegmenterbenchmark [frames per track] [tracks] [gop length] [frames per segment]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "api/streamsegmenter/autosegmenter.hpp"
+#include "api/streamsegmenter/segmenterapi.hpp"
+#include "benchmarkreport.hpp"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint64_t kTimescale   = 1000;
+    const std::uint64_t kSampleTicks = 40;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    class SampleAcquire : public StreamSegmenter::AcquireFrameData
+    {
+    public:
+        SampleAcquire(size_t aSize, std::uint8_t aSeed)
+            : mSize(aSize)
+            , mSeed(aSeed)
+        {
+        }
+
+        size_t getSize() const override
+        {
+            return mSize;
+        }
+
+        StreamSegmenter::FrameData get() const override
+        {
+            StreamSegmenter::FrameData data(mSize);
+            for (size_t i = 0; i < mSize; ++i)
+            {
+                data[i] = std::uint8_t(mSeed + i * 31);
+            }
+            return data;
+        }
+
+        SampleAcquire* clone() const override
+        {
+            return new SampleAcquire(mSize, mSeed);
+        }
+
+    private:
+        size_t mSize;
+        std::uint8_t mSeed;
+    };
+
+    StreamSegmenter::TrackMeta makeTrackMeta(std::uint32_t aTrackId)
+    {
+        StreamSegmenter::TrackMeta trackMeta{};
+        trackMeta.trackId   = StreamSegmenter::TrackId(aTrackId);
+        trackMeta.timescale = StreamSegmenter::RatU64(1, kTimescale);
+        trackMeta.type      = StreamSegmenter::MediaType::Data;
+        return trackMeta;
+    }
+
+    // Intra frames are larger than the rest, like in coded video
+    StreamSegmenter::FrameProxy makeFrame(std::uint32_t aTrackId, std::uint32_t aIndex, std::uint32_t aGopLength)
+    {
+        bool idr = aIndex % aGopLength == 0;
+        StreamSegmenter::FrameInfo info;
+        info.cts      = {StreamSegmenter::FrameTime(std::int64_t(aIndex * kSampleTicks), kTimescale)};
+        info.duration = StreamSegmenter::FrameDuration(kSampleTicks, kTimescale);
+        info.isIDR    = idr;
+        info.sampleFlags.flagsAsUInt = idr ? 0x02000000u : 0x01010000u;
+        size_t size = (idr ? 20000 : 2000) + (aIndex * 7919 + aTrackId * 104729) % 3000;
+        return StreamSegmenter::FrameProxy(std::unique_ptr<StreamSegmenter::AcquireFrameData>(
+                                               new SampleAcquire(size, std::uint8_t(aIndex + aTrackId))),
+                                           info);
+    }
+
+    struct Digest
+    {
+        std::uint64_t value = 14695981039346656037ull;
+
+        void add(const std::string& aData)
+        {
+            for (char c : aData)
+            {
+                value ^= std::uint8_t(c);
+                value *= 1099511628211ull;
+            }
+        }
+    };
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    installAllocationCounter();
+
+    std::uint32_t frames           = argc > 1 ? std::uint32_t(std::strtoul(argv[1], nullptr, 10)) : 20000;
+    std::uint32_t tracks           = argc > 2 ? std::uint32_t(std::strtoul(argv[2], nullptr, 10)) : 8;
+    std::uint32_t gopLength        = argc > 3 ? std::uint32_t(std::strtoul(argv[3], nullptr, 10)) : 25;
+    std::uint32_t framesPerSegment = argc > 4 ? std::uint32_t(std::strtoul(argv[4], nullptr, 10)) : 25;
+    if (frames == 0 || tracks == 0 || gopLength == 0 || framesPerSegment == 0)
+    {
+        std::printf("Usage: %s [frames per track] [tracks] [gop length] [frames per segment]\n", argv[0]);
+        return 1;
+    }
+
+    StreamSegmenter::AutoSegmenterConfig config{};
+    config.checkIDR        = true;
+    config.segmentDuration = StreamSegmenter::Segmenter::Duration(framesPerSegment * kSampleTicks, kTimescale);
+    StreamSegmenter::AutoSegmenter autoSegmenter(config);
+    for (std::uint32_t trackId = 1; trackId <= tracks; ++trackId)
+    {
+        autoSegmenter.addTrack(makeTrackMeta(trackId));
+    }
+
+    // the frames are created beforehand so that only the segmenting is measured
+    std::list<std::pair<std::uint32_t, StreamSegmenter::FrameProxy>> input;
+    for (std::uint32_t i = 0; i < frames; ++i)
+    {
+        for (std::uint32_t trackId = 1; trackId <= tracks; ++trackId)
+        {
+            input.push_back(std::make_pair(trackId, makeFrame(trackId, i, gopLength)));
+        }
+    }
+
+    ResourceUsage start                  = getResourceUsage();
+    Clock::time_point segmentStart       = Clock::now();
+    std::list<StreamSegmenter::Segmenter::Segments> segments;
+    auto extract = [&]() {
+        std::list<StreamSegmenter::Segmenter::Segments> extracted = autoSegmenter.extractSegmentsWithSubsegments();
+        segments.splice(segments.end(), extracted);
+    };
+    for (auto& trackFrame : input)
+    {
+        if (autoSegmenter.feed(StreamSegmenter::TrackId(trackFrame.first), trackFrame.second) ==
+            StreamSegmenter::AutoSegmenter::Action::ExtractSegment)
+        {
+            extract();
+        }
+    }
+    for (std::uint32_t trackId = 1; trackId <= tracks; ++trackId)
+    {
+        autoSegmenter.feedEnd(StreamSegmenter::TrackId(trackId));
+    }
+    extract();
+    double segmentSeconds = secondsSince(segmentStart);
+
+    std::printf("frames_per_track=%u tracks=%u gop_length=%u frames_per_segment=%u\n", frames, tracks, gopLength,
+                framesPerSegment);
+    std::printf("segments=%llu\n", static_cast<unsigned long long>(segments.size()));
+    std::printf("segmenter_frames_per_sec=%.0f\n",
+                double(frames) * tracks / (segmentSeconds > 0 ? segmentSeconds : 1e-9));
+    printResourceUsage("segmenter_", start);
+
+    start = getResourceUsage();
+    StreamSegmenter::Writer* writer = StreamSegmenter::Writer::create();
+    std::uint64_t bytes             = 0;
+    Digest digest;
+    Clock::time_point writeStart = Clock::now();
+    for (const auto& subsegments : segments)
+    {
+        for (const auto& segment : subsegments)
+        {
+            std::ostringstream out;
+            writer->writeSegment(out, segment);
+            const std::string data = out.str();
+            bytes += data.size();
+            digest.add(data);
+        }
+    }
+    double writeSeconds = secondsSince(writeStart);
+    StreamSegmenter::Writer::destruct(writer);
+
+    std::printf("write_bytes=%llu\n", static_cast<unsigned long long>(bytes));
+    std::printf("write_mib_per_sec=%.1f\n", double(bytes) / (1024.0 * 1024.0) / (writeSeconds > 0 ? writeSeconds : 1e-9));
+    std::printf("write_digest=%016llx\n", static_cast<unsigned long long>(digest.value));
+    printResourceUsage("write_", start);
+    return segments.size() ? 0 : 2;
+}
@@ -0,0 +1,124 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "benchmarkreport.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "api/reader/mp4vrfileallocator.h"
+#include "api/reader/mp4vrfilereaderinterface.h"
+
+namespace
+{
+    std::atomic<std::uint64_t> gAllocations(0);
+    std::atomic<std::uint64_t> gAllocatedBytes(0);
+
+    void* countedAllocate(std::size_t aSize)
+    {
+        ++gAllocations;
+        gAllocatedBytes += aSize;
+        return std::malloc(aSize ? aSize : 1);
+    }
+
+    class CountingAllocator : public MP4VR::CustomAllocator
+    {
+    public:
+        void* allocate(size_t n, size_t size) override
+        {
+            return countedAllocate(n * size);
+        }
+
+        void deallocate(void* ptr) override
+        {
+            std::free(ptr);
+        }
+    };
+
+    CountingAllocator gCountingAllocator;
+}  // anonymous namespace
+
+void* operator new(std::size_t aSize)
+{
+    void* pointer = countedAllocate(aSize);
+    if (!pointer)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t aSize)
+{
+    return operator new(aSize);
+}
+
+void operator delete(void* aPointer) noexcept
+{
+    std::free(aPointer);
+}
+
+void operator delete[](void* aPointer) noexcept
+{
+    std::free(aPointer);
+}
+
+bool installAllocationCounter()
+{
+    return MP4VR::MP4VRFileReaderInterface::SetCustomAllocator(&gCountingAllocator) ==
+           MP4VR::MP4VRFileReaderInterface::OK;
+}
+
+ResourceUsage getResourceUsage()
+{
+    ResourceUsage usage{gAllocations.load(), gAllocatedBytes.load(), 0};
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage rusage;
+    if (getrusage(RUSAGE_SELF, &rusage) == 0)
+    {
+#if defined(__APPLE__)
+        usage.peakRssKiB = std::uint64_t(rusage.ru_maxrss) / 1024;  // bytes on macOS
+#else
+        usage.peakRssKiB = std::uint64_t(rusage.ru_maxrss);
+#endif
+    }
+#endif
+    return usage;
+}
+
+void printResourceUsage(const char* aPrefix, const ResourceUsage& aStart)
+{
+    ResourceUsage usage = getResourceUsage();
+    std::printf("%sallocations=%llu\n", aPrefix,
+                static_cast<unsigned long long>(usage.allocations - aStart.allocations));
+    std::printf("%sallocated_bytes=%llu\n", aPrefix,
+                static_cast<unsigned long long>(usage.allocatedBytes - aStart.allocatedBytes));
+    std::printf("%speak_rss_kib=%llu\n", aPrefix, static_cast<unsigned long long>(usage.peakRssKiB));
+}
+
+std::string formatResourceUsage(const ResourceUsage& aStart)
+{
+    ResourceUsage usage = getResourceUsage();
+    std::ostringstream st;
+    st << "allocations=" << usage.allocations - aStart.allocations
+       << " allocated_bytes=" << usage.allocatedBytes - aStart.allocatedBytes << " peak_rss_kib=" << usage.peakRssKiB;
+    return st.str();
+}
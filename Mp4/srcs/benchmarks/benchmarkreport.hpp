@@ -0,0 +1,44 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#ifndef BENCHMARKREPORT_HPP
+#define BENCHMARKREPORT_HPP
+
+#include <cstdint>
+#include <string>
+
+// Resource usage of the benchmark process so far. Linking benchmarkreport_static into a benchmark that uses these
+// functions replaces the global operator new and delete with counting versions; the allocations the library makes through its custom allocator
+// are counted once installAllocationCounter has been called.
+struct ResourceUsage
+{
+    std::uint64_t allocations;     // number of allocations made
+    std::uint64_t allocatedBytes;  // total size of the allocations made
+    std::uint64_t peakRssKiB;      // peak resident set size, 0 if not available on this platform
+};
+
+// Installs the counting custom allocator of the library; call first thing in main. Returns false if the library has
+// already allocated memory, in which case only operator new is counted.
+bool installAllocationCounter();
+
+ResourceUsage getResourceUsage();
+
+// Prints the allocations made since aStart and the peak resident set size as key=value lines, each key prefixed with
+// aPrefix
+void printResourceUsage(const char* aPrefix, const ResourceUsage& aStart);
+
+// Formats the same values as printResourceUsage on one line, as space separated key=value pairs
+std::string formatResourceUsage(const ResourceUsage& aStart);
+
+#endif  // BENCHMARKREPORT_HPP
@@ -0,0 +1,261 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures the throughput of a non-fragmented multi-track file through the library: how fast MovieWriter's
+// writeSegment writes it, how long MP4VRFileReaderInterface::initialize takes for it and how fast getTrackSampleData
+// reads every sample of it back. The sample sizes and contents are derived from the sample index, so every run
+// writes the same file; the samples read back are checked against the ones written.
+//
+// Usage: filethroughputbenchmark [samples per track] [tracks] [samples per chunk] [work directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/reader/mp4vrfilereaderinterface.h"
+#include "api/streamsegmenter/segmenterapi.hpp"
+#include "benchmarkreport.hpp"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint64_t kTimescale   = 1000;
+    const std::uint64_t kSampleTicks = 40;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    double perSecond(double aAmount, double aSeconds)
+    {
+        return aAmount / (aSeconds > 0 ? aSeconds : 1e-9);
+    }
+
+    size_t sampleSize(std::uint32_t aTrackId, std::uint32_t aIndex)
+    {
+        return (aIndex % 25 == 0 ? 20000 : 2000) + (aIndex * 7919 + aTrackId * 104729) % 3000;
+    }
+
+    std::uint8_t sampleByte(std::uint32_t aTrackId, std::uint32_t aIndex, size_t aOffset)
+    {
+        return std::uint8_t(aIndex + aTrackId + aOffset * 31);
+    }
+
+    class SampleAcquire : public StreamSegmenter::AcquireFrameData
+    {
+    public:
+        SampleAcquire(std::uint32_t aTrackId, std::uint32_t aIndex)
+            : mTrackId(aTrackId)
+            , mIndex(aIndex)
+        {
+        }
+
+        size_t getSize() const override
+        {
+            return sampleSize(mTrackId, mIndex);
+        }
+
+        StreamSegmenter::FrameData get() const override
+        {
+            StreamSegmenter::FrameData data(getSize());
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                data[i] = sampleByte(mTrackId, mIndex, i);
+            }
+            return data;
+        }
+
+        SampleAcquire* clone() const override
+        {
+            return new SampleAcquire(mTrackId, mIndex);
+        }
+
+    private:
+        std::uint32_t mTrackId;
+        std::uint32_t mIndex;
+    };
+
+    StreamSegmenter::TrackMeta makeTrackMeta(std::uint32_t aTrackId)
+    {
+        StreamSegmenter::TrackMeta trackMeta{};
+        trackMeta.trackId   = StreamSegmenter::TrackId(aTrackId);
+        trackMeta.timescale = StreamSegmenter::RatU64(1, kTimescale);
+        trackMeta.type      = StreamSegmenter::MediaType::Data;
+        return trackMeta;
+    }
+
+    // Writes aSamples samples per track, aSamplesPerChunk samples of each track per writeSegment call; returns the
+    // number of sample bytes written or 0 on failure
+    std::uint64_t writeMovie(const std::string& aFileName,
+                             std::uint32_t aSamples,
+                             std::uint32_t aTracks,
+                             std::uint32_t aSamplesPerChunk)
+    {
+        std::ofstream out(aFileName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            return 0;
+        }
+        StreamSegmenter::MovieWriter* writer = StreamSegmenter::MovieWriter::create(out);
+
+        StreamSegmenter::Segmenter::TrackDescriptions trackDescriptions;
+        for (std::uint32_t trackId = 1; trackId <= aTracks; ++trackId)
+        {
+            StreamSegmenter::Segmenter::MediaDescription mediaDescription{};
+            StreamSegmenter::Segmenter::URIMetadataSampleEntry sampleEntry;
+            sampleEntry.uri     = "urn:example:benchmark";
+            sampleEntry.version = StreamSegmenter::Segmenter::URIMetadataSampleEntry::Version0;
+            trackDescriptions.insert(std::make_pair(
+                StreamSegmenter::TrackId(trackId),
+                StreamSegmenter::Segmenter::TrackDescription(makeTrackMeta(trackId), mediaDescription, sampleEntry)));
+        }
+
+        StreamSegmenter::Segmenter::MovieDescription movieDescription{};
+        movieDescription.matrix   = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+        movieDescription.fileType = StreamSegmenter::BrandSpec{std::string("isom"), 512, {"isom"}};
+        writer->writeInitSegment(
+            StreamSegmenter::Segmenter::makeInitSegment(trackDescriptions, movieDescription, false));
+
+        std::uint64_t bytes = 0;
+        for (std::uint32_t first = 0; first < aSamples; first += aSamplesPerChunk)
+        {
+            std::uint32_t count = std::min(aSamplesPerChunk, aSamples - first);
+            StreamSegmenter::FrameTime t0(std::int64_t(first * kSampleTicks), kTimescale);
+
+            StreamSegmenter::Segmenter::Segment segment;
+            segment.sequenceId = StreamSegmenter::Segmenter::SequenceId(first / aSamplesPerChunk + 1);
+            segment.t0         = t0;
+            segment.duration   = StreamSegmenter::Segmenter::Duration(count * kSampleTicks, kTimescale);
+            for (std::uint32_t trackId = 1; trackId <= aTracks; ++trackId)
+            {
+                StreamSegmenter::Segmenter::TrackOfSegment trackOfSegment;
+                trackOfSegment.trackInfo.t0           = t0;
+                trackOfSegment.trackInfo.trackMeta    = makeTrackMeta(trackId);
+                trackOfSegment.trackInfo.dtsCtsOffset = StreamSegmenter::FrameTime(0, 1);
+                for (std::uint32_t i = first; i < first + count; ++i)
+                {
+                    StreamSegmenter::FrameInfo info;
+                    info.cts      = {StreamSegmenter::FrameTime(std::int64_t(i * kSampleTicks), kTimescale)};
+                    info.duration = StreamSegmenter::FrameDuration(kSampleTicks, kTimescale);
+                    info.isIDR    = i % 25 == 0;
+                    trackOfSegment.frames.push_back(StreamSegmenter::FrameProxy(
+                        std::unique_ptr<StreamSegmenter::AcquireFrameData>(new SampleAcquire(trackId, i)), info));
+                    bytes += sampleSize(trackId, i);
+                }
+                segment.tracks.insert(std::make_pair(StreamSegmenter::TrackId(trackId), std::move(trackOfSegment)));
+            }
+            writer->writeSegment(segment);
+        }
+
+        writer->finalize();
+        StreamSegmenter::MovieWriter::destruct(writer);
+        return out ? bytes : 0;
+    }
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    installAllocationCounter();
+
+    std::uint32_t samples         = argc > 1 ? std::uint32_t(std::strtoul(argv[1], nullptr, 10)) : 50000;
+    std::uint32_t tracks          = argc > 2 ? std::uint32_t(std::strtoul(argv[2], nullptr, 10)) : 4;
+    std::uint32_t samplesPerChunk = argc > 3 ? std::uint32_t(std::strtoul(argv[3], nullptr, 10)) : 25;
+    std::string directory         = argc > 4 ? argv[4] : ".";
+    if (samples == 0 || tracks == 0 || samplesPerChunk == 0)
+    {
+        std::printf("Usage: %s [samples per track] [tracks] [samples per chunk] [work directory]\n", argv[0]);
+        return 1;
+    }
+    std::printf("samples_per_track=%u tracks=%u samples_per_chunk=%u\n", samples, tracks, samplesPerChunk);
+
+    const std::string fileName = directory + "/filethroughputbenchmark.mp4";
+    ResourceUsage start        = getResourceUsage();
+    Clock::time_point begin    = Clock::now();
+    std::uint64_t bytes        = writeMovie(fileName, samples, tracks, samplesPerChunk);
+    double seconds             = secondsSince(begin);
+    if (bytes == 0)
+    {
+        std::printf("Failed to write %s\n", fileName.c_str());
+        return 1;
+    }
+    std::printf("write_samples_per_sec=%.0f\n", perSecond(double(samples) * tracks, seconds));
+    std::printf("write_mib_per_sec=%.1f\n", perSecond(double(bytes) / (1024.0 * 1024.0), seconds));
+    printResourceUsage("write_", start);
+
+    start                                   = getResourceUsage();
+    begin                                   = Clock::now();
+    MP4VR::MP4VRFileReaderInterface* reader = MP4VR::MP4VRFileReaderInterface::Create();
+    int32_t result                          = reader->initialize(fileName.c_str());
+    seconds                                 = secondsSince(begin);
+    MP4VR::DynArray<MP4VR::TrackInformation> trackInfos;
+    if (result != MP4VR::MP4VRFileReaderInterface::OK ||
+        reader->getTrackInformations(trackInfos) != MP4VR::MP4VRFileReaderInterface::OK)
+    {
+        std::printf("Failed to read %s\n", fileName.c_str());
+        MP4VR::MP4VRFileReaderInterface::Destroy(reader);
+        return 1;
+    }
+    std::printf("init_ms=%.1f\n", seconds * 1000.0);
+    printResourceUsage("init_", start);
+
+    start                     = getResourceUsage();
+    std::uint64_t readBytes   = 0;
+    std::uint64_t readSamples = 0;
+    std::uint64_t mismatches  = 0;
+    std::vector<char> buffer(64 * 1024);
+    begin = Clock::now();
+    for (const auto& trackInfo : trackInfos)
+    {
+        std::uint32_t index = 0;
+        for (const auto& sample : trackInfo.sampleProperties)
+        {
+            std::uint32_t size = std::uint32_t(buffer.size());
+            if (reader->getTrackSampleData(trackInfo.trackId, sample.sampleId, buffer.data(), size, false) !=
+                MP4VR::MP4VRFileReaderInterface::OK)
+            {
+                ++mismatches;
+                ++index;
+                continue;
+            }
+            // check the first and last byte; checking all of them would dominate the measurement
+            if (size != sampleSize(trackInfo.trackId, index) ||
+                std::uint8_t(buffer[0]) != sampleByte(trackInfo.trackId, index, 0) ||
+                std::uint8_t(buffer[size - 1]) != sampleByte(trackInfo.trackId, index, size - 1))
+            {
+                ++mismatches;
+            }
+            readBytes += size;
+            ++readSamples;
+            ++index;
+        }
+    }
+    seconds = secondsSince(begin);
+    MP4VR::MP4VRFileReaderInterface::Destroy(reader);
+
+    std::printf("read_samples_per_sec=%.0f\n", perSecond(double(readSamples), seconds));
+    std::printf("read_mib_per_sec=%.1f\n", perSecond(double(readBytes) / (1024.0 * 1024.0), seconds));
+    printResourceUsage("read_", start);
+    std::printf("sample_mismatches=%llu\n", static_cast<unsigned long long>(mismatches));
+
+    bool ok = mismatches == 0 && readSamples == std::uint64_t(samples) * tracks && readBytes == bytes;
+    return ok ? 0 : 2;
+}
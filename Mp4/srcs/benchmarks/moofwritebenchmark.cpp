@@ -0,0 +1,149 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures how many 'moof' and 'sidx' boxes per second the box serializers produce. The boxes are shaped like the ones
+// the stream segmenter writes: one track fragment per track with a 'trun' that has duration, size, flags and
+// composition time offset for every sample. Each box is also checked against its precomputed size.
+//
+// Usage: moofwritebenchmark [iterations] [tracks] [samples per track]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "benchmarkreport.hpp"
+#include "bitstream.hpp"
+#include "moviefragmentbox.hpp"
+#include "segmentindexbox.hpp"
+#include "trackfragmentbasemediadecodetimebox.hpp"
+#include "trackfragmentbox.hpp"
+#include "trackrunbox.hpp"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    void buildMoof(MovieFragmentBox& aMoof,
+                   Vector<MOVIEFRAGMENTS::SampleDefaults>& aSampleDefaults,
+                   std::uint32_t aSequence,
+                   std::uint32_t aSamplesPerTrack)
+    {
+        aMoof.getMovieFragmentHeaderBox().setSequenceNumber(aSequence);
+        for (const auto& defaults : aSampleDefaults)
+        {
+            auto traf = makeCustomUnique<TrackFragmentBox, TrackFragmentBox>(aSampleDefaults);
+            auto trun = makeCustomUnique<TrackRunBox, TrackRunBox>(
+                uint8_t(1), 0u | TrackRunBox::TrackRunFlags::DataOffsetPresent |
+                                TrackRunBox::TrackRunFlags::SampleDurationPresent |
+                                TrackRunBox::TrackRunFlags::SampleSizePresent |
+                                TrackRunBox::TrackRunFlags::SampleCompositionTimeOffsetsPresent |
+                                TrackRunBox::TrackRunFlags::SampleFlagsPresent);
+            auto tfdt = makeCustomUnique<TrackFragmentBaseMediaDecodeTimeBox, TrackFragmentBaseMediaDecodeTimeBox>();
+            tfdt->setBaseMediaDecodeTime(std::uint64_t(aSequence) * aSamplesPerTrack * 1000);
+            traf->getTrackFragmentHeaderBox().setTrackId(defaults.trackId);
+            traf->getTrackFragmentHeaderBox().setFlags(0 | TrackFragmentHeaderBox::DefaultBaseIsMoof);
+            trun->setDataOffset(1024);
+            for (std::uint32_t i = 0; i < aSamplesPerTrack; ++i)
+            {
+                TrackRunBox::SampleDetails s;
+                s.version1.sampleDuration              = 1000;
+                s.version1.sampleSize                  = 20000 + (i * 7919) % 50000;
+                s.version1.sampleFlags.flagsAsUInt     = i == 0 ? 0x02000000u : 0x01010000u;
+                s.version1.sampleCompositionTimeOffset = std::int32_t(i % 3) * 1000;
+                trun->addSampleDetails(s);
+            }
+            trun->setSampleCount(aSamplesPerTrack);
+            traf->setTrackFragmentDecodeTimeBox(std::move(tfdt));
+            traf->addTrackRunBox(std::move(trun));
+            aMoof.addTrackFragmentBox(std::move(traf));
+        }
+    }
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    installAllocationCounter();
+    ResourceUsage usageAtStart = getResourceUsage();
+
+    std::uint32_t iterations      = argc > 1 ? std::uint32_t(std::strtoul(argv[1], nullptr, 10)) : 20000;
+    std::uint32_t tracks          = argc > 2 ? std::uint32_t(std::strtoul(argv[2], nullptr, 10)) : 2;
+    std::uint32_t samplesPerTrack = argc > 3 ? std::uint32_t(std::strtoul(argv[3], nullptr, 10)) : 60;
+    if (iterations == 0 || tracks == 0)
+    {
+        std::printf("Usage: %s [iterations] [tracks] [samples per track]\n", argv[0]);
+        return 1;
+    }
+
+    Vector<MOVIEFRAGMENTS::SampleDefaults> sampleDefaults;
+    for (std::uint32_t trackId = 1; trackId <= tracks; ++trackId)
+    {
+        sampleDefaults.push_back(MOVIEFRAGMENTS::SampleDefaults{trackId, 1, 0, 0, {0}});
+    }
+
+    // the boxes are built once so that only the serialization is measured
+    MovieFragmentBox moof(sampleDefaults);
+    buildMoof(moof, sampleDefaults, 1, samplesPerTrack);
+
+    SegmentIndexBox sidx(1);
+    sidx.setReferenceId(1);
+    sidx.setTimescale(1000);
+    sidx.setSpaceReserve(samplesPerTrack + 8);
+    for (std::uint32_t i = 0; i < samplesPerTrack; ++i)
+    {
+        SegmentIndexBox::Reference reference{};
+        reference.referencedSize     = 100000 + i;
+        reference.subsegmentDuration = 1000;
+        reference.startsWithSAP      = true;
+        reference.sapType            = 1;
+        sidx.addReference(reference);
+    }
+
+    std::uint64_t bytes      = 0;
+    std::uint32_t mismatches = 0;
+
+    Clock::time_point start = Clock::now();
+    for (std::uint32_t i = 0; i < iterations; ++i)
+    {
+        BitStream bs;
+        moof.writeBox(bs);
+        mismatches += bs.getSize() != moof.calculateSize() ? 1u : 0u;
+        bytes += bs.getSize();
+    }
+    double moofSeconds = secondsSince(start);
+
+    start = Clock::now();
+    for (std::uint32_t i = 0; i < iterations; ++i)
+    {
+        BitStream bs;
+        sidx.writeBox(bs);
+        mismatches += bs.getSize() != sidx.calculateSize() + 12 * 8 ? 1u : 0u;
+        bytes += bs.getSize();
+    }
+    double sidxSeconds = secondsSince(start);
+
+    std::printf("iterations=%u tracks=%u samples_per_track=%u\n", iterations, tracks, samplesPerTrack);
+    std::printf("moof_bytes=%llu\n", static_cast<unsigned long long>(moof.calculateSize()));
+    std::printf("moof_per_sec=%.0f\n", iterations / (moofSeconds > 0 ? moofSeconds : 1e-9));
+    std::printf("sidx_per_sec=%.0f\n", iterations / (sidxSeconds > 0 ? sidxSeconds : 1e-9));
+    std::printf("size_mismatches=%u\n", mismatches);
+    std::printf("total_bytes=%llu\n", static_cast<unsigned long long>(bytes));
+    printResourceUsage("", usageAtStart);
+    return mismatches == 0 ? 0 : 2;
+}
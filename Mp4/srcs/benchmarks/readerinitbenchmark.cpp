@@ -0,0 +1,273 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures how long MP4VRFileReaderInterface::initialize takes for a large non-fragmented file with and without the
+// index cache. A synthetic file with the given number of samples per track is written with the movie writer into the
+// work directory, which is also used as the cache directory. The first cached run builds the cache entry, the rest
+// load it. The sample information of the cached and the uncached readers is compared to catch any difference.
+//
+// Usage: readerinitbenchmark [samples per track] [tracks] [runs] [work directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "api/reader/mp4vrfilereaderinterface.h"
+#include "api/streamsegmenter/segmenterapi.hpp"
+#include "benchmarkreport.hpp"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint64_t kTimescale       = 1000;
+    const std::uint64_t kSampleTicks     = 40;
+    const std::uint32_t kSamplesPerChunk = 25;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    class SampleAcquire : public StreamSegmenter::AcquireFrameData
+    {
+    public:
+        SampleAcquire(size_t aSize)
+            : mSize(aSize)
+        {
+        }
+
+        size_t getSize() const override
+        {
+            return mSize;
+        }
+
+        StreamSegmenter::FrameData get() const override
+        {
+            return StreamSegmenter::FrameData(mSize, std::uint8_t(0x55));
+        }
+
+        SampleAcquire* clone() const override
+        {
+            return new SampleAcquire(mSize);
+        }
+
+    private:
+        size_t mSize;
+    };
+
+    StreamSegmenter::TrackMeta makeTrackMeta(std::uint32_t aTrackId)
+    {
+        StreamSegmenter::TrackMeta trackMeta{};
+        trackMeta.trackId   = StreamSegmenter::TrackId(aTrackId);
+        trackMeta.timescale = StreamSegmenter::RatU64(1, kTimescale);
+        trackMeta.type      = StreamSegmenter::MediaType::Data;
+        return trackMeta;
+    }
+
+    // Writes aSamples samples per track in chunks of kSamplesPerChunk. Samples are reordered in groups of three so
+    // that the file gets a composition offset table, like video with B frames would.
+    bool writeMovie(const std::string& aFileName, std::uint32_t aSamples, std::uint32_t aTracks)
+    {
+        std::ofstream out(aFileName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            return false;
+        }
+        StreamSegmenter::MovieWriter* writer = StreamSegmenter::MovieWriter::create(out);
+
+        StreamSegmenter::Segmenter::TrackDescriptions trackDescriptions;
+        for (std::uint32_t trackId = 1; trackId <= aTracks; ++trackId)
+        {
+            StreamSegmenter::Segmenter::MediaDescription mediaDescription{};
+            StreamSegmenter::Segmenter::URIMetadataSampleEntry sampleEntry;
+            sampleEntry.uri     = "urn:example:benchmark";
+            sampleEntry.version = StreamSegmenter::Segmenter::URIMetadataSampleEntry::Version0;
+            trackDescriptions.insert(std::make_pair(
+                StreamSegmenter::TrackId(trackId),
+                StreamSegmenter::Segmenter::TrackDescription(makeTrackMeta(trackId), mediaDescription, sampleEntry)));
+        }
+
+        StreamSegmenter::Segmenter::MovieDescription movieDescription{};
+        movieDescription.matrix   = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+        movieDescription.fileType = StreamSegmenter::BrandSpec{std::string("isom"), 512, {"isom"}};
+        writer->writeInitSegment(
+            StreamSegmenter::Segmenter::makeInitSegment(trackDescriptions, movieDescription, false));
+
+        const std::uint32_t reorder[3] = {1, 3, 2};
+        for (std::uint32_t first = 0; first < aSamples; first += kSamplesPerChunk)
+        {
+            std::uint32_t count = std::min(kSamplesPerChunk, aSamples - first);
+            StreamSegmenter::FrameTime t0(std::int64_t(first * kSampleTicks), kTimescale);
+
+            StreamSegmenter::Segmenter::Segment segment;
+            segment.sequenceId = StreamSegmenter::Segmenter::SequenceId(first / kSamplesPerChunk + 1);
+            segment.t0         = t0;
+            segment.duration   = StreamSegmenter::Segmenter::Duration(count * kSampleTicks, kTimescale);
+            for (std::uint32_t trackId = 1; trackId <= aTracks; ++trackId)
+            {
+                StreamSegmenter::Segmenter::TrackOfSegment trackOfSegment;
+                trackOfSegment.trackInfo.t0           = t0;
+                trackOfSegment.trackInfo.trackMeta    = makeTrackMeta(trackId);
+                trackOfSegment.trackInfo.dtsCtsOffset = StreamSegmenter::FrameTime(0, 1);
+                for (std::uint32_t i = first; i < first + count; ++i)
+                {
+                    std::uint64_t slot = i / 3 * 3 + reorder[i % 3];
+                    StreamSegmenter::FrameInfo info;
+                    info.cts      = {StreamSegmenter::FrameTime(std::int64_t(slot * kSampleTicks), kTimescale)};
+                    info.duration = StreamSegmenter::FrameDuration(kSampleTicks, kTimescale);
+                    info.isIDR    = i % 30 == 0;
+                    trackOfSegment.frames.push_back(StreamSegmenter::FrameProxy(
+                        std::unique_ptr<StreamSegmenter::AcquireFrameData>(new SampleAcquire(16 + i % 7)), info));
+                }
+                segment.tracks.insert(std::make_pair(StreamSegmenter::TrackId(trackId), std::move(trackOfSegment)));
+            }
+            writer->writeSegment(segment);
+        }
+
+        writer->finalize();
+        StreamSegmenter::MovieWriter::destruct(writer);
+        return !!out;
+    }
+
+    struct Digest
+    {
+        std::uint64_t value = 14695981039346656037ull;
+
+        void add(std::uint64_t aValue)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                value ^= (aValue >> (i * 8)) & 0xff;
+                value *= 1099511628211ull;
+            }
+        }
+    };
+
+    // Initializes a reader and digests everything the sample tables affect; 0 on failure
+    std::uint64_t run(const std::string& aFileName, const char* aCacheDirectory, double& aInitSeconds)
+    {
+        MP4VR::MP4VRFileReaderInterface* reader = MP4VR::MP4VRFileReaderInterface::Create();
+        reader->setIndexCacheDirectory(aCacheDirectory);
+
+        Clock::time_point start = Clock::now();
+        int32_t result          = reader->initialize(aFileName.c_str());
+        aInitSeconds            = secondsSince(start);
+
+        Digest digest;
+        MP4VR::DynArray<MP4VR::TrackInformation> trackInfos;
+        if (result == MP4VR::MP4VRFileReaderInterface::OK &&
+            reader->getTrackInformations(trackInfos) == MP4VR::MP4VRFileReaderInterface::OK)
+        {
+            for (const auto& trackInfo : trackInfos)
+            {
+                digest.add(trackInfo.trackId);
+                digest.add(trackInfo.maxSampleSize);
+                for (const auto& sample : trackInfo.sampleProperties)
+                {
+                    std::uint64_t offset = 0;
+                    std::uint32_t length = 0;
+                    reader->getTrackSampleOffset(trackInfo.trackId, sample.sampleId, offset, length);
+                    digest.add(sample.sampleId);
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        digest.add(std::uint8_t(sample.sampleEntryType.value[i]));
+                    }
+                    digest.add(sample.sampleDescriptionIndex);
+                    digest.add(sample.sampleType);
+                    digest.add(sample.earliestTimestamp);
+                    digest.add(sample.sampleFlags.flagsAsUInt);
+                    digest.add(sample.sampleDurationTS);
+                    digest.add(sample.earliestTimestampTS);
+                    digest.add(offset);
+                    digest.add(length);
+                }
+
+                MP4VR::DynArray<MP4VR::TimestampIDPair> timestamps;
+                reader->getTrackTimestamps(trackInfo.trackId, timestamps);
+                for (const auto& timestamp : timestamps)
+                {
+                    digest.add(timestamp.timeStamp);
+                    digest.add(timestamp.itemId);
+                }
+                double duration = 0.0;
+                reader->getPlaybackDurationInSecs(trackInfo.trackId, duration);
+                digest.add(std::uint64_t(duration * 1000000.0));
+            }
+        }
+        else
+        {
+            digest.value = 0;
+        }
+
+        MP4VR::MP4VRFileReaderInterface::Destroy(reader);
+        return digest.value;
+    }
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    installAllocationCounter();
+    ResourceUsage usageAtStart = getResourceUsage();
+
+    std::uint32_t samples = argc > 1 ? std::uint32_t(std::strtoul(argv[1], nullptr, 10)) : 500000;
+    std::uint32_t tracks  = argc > 2 ? std::uint32_t(std::strtoul(argv[2], nullptr, 10)) : 2;
+    std::uint32_t runs    = argc > 3 ? std::uint32_t(std::strtoul(argv[3], nullptr, 10)) : 5;
+    std::string directory = argc > 4 ? argv[4] : ".";
+    if (samples == 0 || tracks == 0 || runs == 0)
+    {
+        std::printf("Usage: %s [samples per track] [tracks] [runs] [work directory]\n", argv[0]);
+        return 1;
+    }
+
+    const std::string fileName = directory + "/readerinitbenchmark.mp4";
+    if (!writeMovie(fileName, samples, tracks))
+    {
+        std::printf("Failed to write %s\n", fileName.c_str());
+        return 1;
+    }
+
+    double seconds         = 0.0;
+    double uncachedSeconds = 0.0;
+    std::uint64_t uncached = 0;
+    for (std::uint32_t i = 0; i < runs; ++i)
+    {
+        uncached = run(fileName, nullptr, seconds);
+        uncachedSeconds += seconds;
+    }
+
+    double coldSeconds = 0.0;
+    std::uint64_t cold = run(fileName, directory.c_str(), coldSeconds);
+    double warmSeconds = 0.0;
+    std::uint64_t warm = cold;
+    for (std::uint32_t i = 0; i < runs && warm == cold; ++i)
+    {
+        warm = run(fileName, directory.c_str(), seconds);
+        warmSeconds += seconds;
+    }
+
+    std::printf("samples_per_track=%u tracks=%u runs=%u\n", samples, tracks, runs);
+    std::printf("uncached_init_ms=%.1f\n", uncachedSeconds * 1000.0 / runs);
+    std::printf("cache_build_init_ms=%.1f\n", coldSeconds * 1000.0);
+    std::printf("cached_init_ms=%.1f\n", warmSeconds * 1000.0 / runs);
+    printResourceUsage("", usageAtStart);
+    bool ok = uncached != 0 && cold == uncached && warm == uncached;
+    std::printf("sample_information_matches=%s\n", ok ? "yes" : "no");
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,317 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures the per-segment cost of keeping track information up to date while media segments are appended to the
+// reader, the way a DASH client does it. Synthetic fragmented segments are written with the stream segmenter and fed
+// to the reader one by one. After each parseSegment the track information is refreshed either the full way
+// (getTrackInformations + getTrackTimestamps) or the incremental way (getSegmentTrackInformations +
+// getSegmentTrackTimestamps). The cost of the refresh is reported for the first and the last tenth of the run: with
+// the full refresh it grows with the number of buffered segments, with the incremental one it stays flat.
+//
+// Usage: segmentappendbenchmark [segments] [tracks] [samples per segment] [buffered segments, 0 = all]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "api/reader/mp4vrfilereaderinterface.h"
+#include "api/reader/mp4vrfilestreaminterface.h"
+#include "api/streamsegmenter/segmenterapi.hpp"
+#include "benchmarkreport.hpp"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint32_t kInitSegmentId = 0;
+    const std::uint64_t kTimescale     = 1000;
+    const std::uint64_t kSampleTicks   = 40;
+
+    double secondsSince(Clock::time_point aStart)
+    {
+        return std::chrono::duration<double>(Clock::now() - aStart).count();
+    }
+
+    class MemoryStream : public MP4VR::StreamInterface
+    {
+    public:
+        MemoryStream(std::string aData)
+            : mData(std::move(aData))
+            , mOffset(0)
+        {
+        }
+
+        offset_t read(char* aBuffer, offset_t aSize) override
+        {
+            offset_t available = static_cast<offset_t>(mData.size()) - mOffset;
+            offset_t count     = aSize < available ? aSize : available;
+            if (count <= 0)
+            {
+                return 0;
+            }
+            std::memcpy(aBuffer, mData.data() + mOffset, static_cast<size_t>(count));
+            mOffset += count;
+            return count;
+        }
+
+        bool absoluteSeek(offset_t aOffset) override
+        {
+            mOffset = aOffset;
+            return aOffset <= static_cast<offset_t>(mData.size());
+        }
+
+        offset_t tell() override
+        {
+            return mOffset;
+        }
+
+        offset_t size() override
+        {
+            return static_cast<offset_t>(mData.size());
+        }
+
+    private:
+        std::string mData;
+        offset_t mOffset;
+    };
+
+    class SampleAcquire : public StreamSegmenter::AcquireFrameData
+    {
+    public:
+        SampleAcquire(size_t aSize)
+            : mSize(aSize)
+        {
+        }
+
+        size_t getSize() const override
+        {
+            return mSize;
+        }
+
+        StreamSegmenter::FrameData get() const override
+        {
+            return StreamSegmenter::FrameData(mSize, std::uint8_t(0x55));
+        }
+
+        SampleAcquire* clone() const override
+        {
+            return new SampleAcquire(mSize);
+        }
+
+    private:
+        size_t mSize;
+    };
+
+    StreamSegmenter::TrackMeta makeTrackMeta(std::uint32_t aTrackId)
+    {
+        StreamSegmenter::TrackMeta trackMeta{};
+        trackMeta.trackId   = StreamSegmenter::TrackId(aTrackId);
+        trackMeta.timescale = StreamSegmenter::RatU64(1, kTimescale);
+        trackMeta.type      = StreamSegmenter::MediaType::Data;
+        return trackMeta;
+    }
+
+    std::string makeInitSegment(StreamSegmenter::Writer& aWriter, std::uint32_t aTracks)
+    {
+        StreamSegmenter::Segmenter::TrackDescriptions trackDescriptions;
+        for (std::uint32_t trackId = 1; trackId <= aTracks; ++trackId)
+        {
+            StreamSegmenter::Segmenter::MediaDescription mediaDescription{};
+            StreamSegmenter::Segmenter::URIMetadataSampleEntry sampleEntry;
+            sampleEntry.uri     = "urn:example:benchmark";
+            sampleEntry.version = StreamSegmenter::Segmenter::URIMetadataSampleEntry::Version0;
+            trackDescriptions.insert(std::make_pair(
+                StreamSegmenter::TrackId(trackId),
+                StreamSegmenter::Segmenter::TrackDescription(makeTrackMeta(trackId), mediaDescription, sampleEntry)));
+        }
+
+        StreamSegmenter::Segmenter::MovieDescription movieDescription{};
+        movieDescription.matrix   = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+        movieDescription.fileType = StreamSegmenter::BrandSpec{std::string("isom"), 512, {"isom", "iso6"}};
+
+        std::ostringstream out;
+        aWriter.writeInitSegment(out,
+                                 StreamSegmenter::Segmenter::makeInitSegment(trackDescriptions, movieDescription, true));
+        return out.str();
+    }
+
+    std::string makeSegment(StreamSegmenter::Writer& aWriter,
+                            std::uint32_t aTracks,
+                            std::uint32_t aSegmentIndex,
+                            std::uint32_t aSamplesPerSegment)
+    {
+        std::uint64_t startTicks = std::uint64_t(aSegmentIndex) * aSamplesPerSegment * kSampleTicks;
+        StreamSegmenter::FrameTime t0(std::int64_t(startTicks), kTimescale);
+
+        StreamSegmenter::Segmenter::Segment segment;
+        segment.sequenceId = StreamSegmenter::Segmenter::SequenceId(aSegmentIndex + 1);
+        segment.t0         = t0;
+        segment.duration   = StreamSegmenter::Segmenter::Duration(aSamplesPerSegment * kSampleTicks, kTimescale);
+        for (std::uint32_t trackId = 1; trackId <= aTracks; ++trackId)
+        {
+            StreamSegmenter::Segmenter::TrackOfSegment trackOfSegment;
+            trackOfSegment.trackInfo.t0           = t0;
+            trackOfSegment.trackInfo.trackMeta    = makeTrackMeta(trackId);
+            trackOfSegment.trackInfo.dtsCtsOffset = StreamSegmenter::FrameTime(0, 1);
+            for (std::uint32_t i = 0; i < aSamplesPerSegment; ++i)
+            {
+                StreamSegmenter::FrameInfo info;
+                info.cts      = {t0 + StreamSegmenter::FrameTime(std::int64_t(i * kSampleTicks), kTimescale)};
+                info.duration = StreamSegmenter::FrameDuration(kSampleTicks, kTimescale);
+                info.isIDR    = i == 0;
+                info.sampleFlags.flagsAsUInt = i == 0 ? 0x02000000u : 0x01010000u;
+                trackOfSegment.frames.push_back(StreamSegmenter::FrameProxy(
+                    std::unique_ptr<StreamSegmenter::AcquireFrameData>(new SampleAcquire(16 + i % 7)), info));
+            }
+            segment.tracks.insert(std::make_pair(StreamSegmenter::TrackId(trackId), std::move(trackOfSegment)));
+        }
+
+        std::ostringstream out;
+        aWriter.writeSegment(out, segment);
+        return out.str();
+    }
+
+    struct RunResult
+    {
+        bool ok;
+        double firstUsPerSegment;
+        double lastUsPerSegment;
+        std::uint64_t samplesSeen;
+    };
+
+    // Appends the segments to a fresh reader; aIncremental selects which track information API is used
+    RunResult run(const std::string& aInitSegment,
+                  const std::list<std::string>& aSegments,
+                  std::uint32_t aBuffered,
+                  bool aIncremental)
+    {
+        RunResult result{true, 0.0, 0.0, 0};
+        MP4VR::MP4VRFileReaderInterface* reader = MP4VR::MP4VRFileReaderInterface::Create();
+        MemoryStream initStream(aInitSegment);
+        if (reader->parseInitializationSegment(&initStream, kInitSegmentId) != MP4VR::MP4VRFileReaderInterface::OK)
+        {
+            MP4VR::MP4VRFileReaderInterface::Destroy(reader);
+            return RunResult{false, 0.0, 0.0, 0};
+        }
+
+        const std::uint32_t count  = static_cast<std::uint32_t>(aSegments.size());
+        const std::uint32_t window = count / 10 > 0 ? count / 10 : 1;
+        double firstSeconds        = 0.0;
+        double lastSeconds         = 0.0;
+
+        // the reader reads the sample data on demand, so the streams must stay alive until invalidated
+        std::list<std::unique_ptr<MemoryStream>> streams;
+        std::uint32_t segmentId = 1;
+        for (const auto& data : aSegments)
+        {
+            streams.push_back(std::unique_ptr<MemoryStream>(new MemoryStream(data)));
+            if (reader->parseSegment(streams.back().get(), kInitSegmentId, segmentId) !=
+                MP4VR::MP4VRFileReaderInterface::OK)
+            {
+                result.ok = false;
+                break;
+            }
+            if (aBuffered && streams.size() > aBuffered)
+            {
+                reader->invalidateSegment(kInitSegmentId, segmentId - aBuffered);
+                streams.pop_front();
+            }
+
+            Clock::time_point start = Clock::now();
+            MP4VR::DynArray<MP4VR::TrackInformation> trackInfos;
+            MP4VR::DynArray<MP4VR::TimestampIDPair> timestamps;
+            if (aIncremental)
+            {
+                reader->getSegmentTrackInformations(kInitSegmentId, segmentId, trackInfos);
+            }
+            else
+            {
+                reader->getTrackInformations(trackInfos);
+            }
+            for (const auto& trackInfo : trackInfos)
+            {
+                if (aIncremental)
+                {
+                    reader->getSegmentTrackTimestamps(trackInfo.trackId, segmentId, timestamps);
+                }
+                else
+                {
+                    reader->getTrackTimestamps(trackInfo.trackId, timestamps);
+                }
+                result.samplesSeen += trackInfo.sampleProperties.numElements + timestamps.numElements;
+            }
+            double seconds = secondsSince(start);
+
+            if (segmentId <= window)
+            {
+                firstSeconds += seconds;
+            }
+            if (segmentId > count - window)
+            {
+                lastSeconds += seconds;
+            }
+            ++segmentId;
+        }
+
+        MP4VR::MP4VRFileReaderInterface::Destroy(reader);
+        result.firstUsPerSegment = firstSeconds * 1e6 / window;
+        result.lastUsPerSegment  = lastSeconds * 1e6 / window;
+        return result;
+    }
+}  // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    installAllocationCounter();
+    ResourceUsage usageAtStart = getResourceUsage();
+
+    std::uint32_t segments          = argc > 1 ? std::uint32_t(std::strtoul(argv[1], nullptr, 10)) : 2000;
+    std::uint32_t tracks            = argc > 2 ? std::uint32_t(std::strtoul(argv[2], nullptr, 10)) : 2;
+    std::uint32_t samplesPerSegment = argc > 3 ? std::uint32_t(std::strtoul(argv[3], nullptr, 10)) : 25;
+    std::uint32_t buffered          = argc > 4 ? std::uint32_t(std::strtoul(argv[4], nullptr, 10)) : 0;
+    if (segments == 0 || tracks == 0 || samplesPerSegment == 0)
+    {
+        std::printf("Usage: %s [segments] [tracks] [samples per segment] [buffered segments, 0 = all]\n", argv[0]);
+        return 1;
+    }
+
+    StreamSegmenter::Writer* writer = StreamSegmenter::Writer::create();
+    std::string initSegment         = makeInitSegment(*writer, tracks);
+    std::list<std::string> mediaSegments;
+    for (std::uint32_t i = 0; i < segments; ++i)
+    {
+        mediaSegments.push_back(makeSegment(*writer, tracks, i, samplesPerSegment));
+    }
+    StreamSegmenter::Writer::destruct(writer);
+
+    RunResult full        = run(initSegment, mediaSegments, buffered, false);
+    RunResult incremental = run(initSegment, mediaSegments, buffered, true);
+
+    std::printf("segments=%u tracks=%u samples_per_segment=%u buffered=%u\n", segments, tracks, samplesPerSegment,
+                buffered);
+    std::printf("full_first_us_per_segment=%.1f\n", full.firstUsPerSegment);
+    std::printf("full_last_us_per_segment=%.1f\n", full.lastUsPerSegment);
+    std::printf("incremental_first_us_per_segment=%.1f\n", incremental.firstUsPerSegment);
+    std::printf("incremental_last_us_per_segment=%.1f\n", incremental.lastUsPerSegment);
+    std::printf("samples_seen full=%llu incremental=%llu\n", static_cast<unsigned long long>(full.samplesSeen),
+                static_cast<unsigned long long>(incremental.samplesSeen));
+    printResourceUsage("", usageAtStart);
+    return full.ok && incremental.ok ? 0 : 2;
+}
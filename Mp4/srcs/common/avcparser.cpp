@@ -157,7 +157,7 @@ bool parseSPS(BitStream& bitstr, SPSConfigValues& retSps)
                     }
                     else
                     {
-                        scaling_list( ScalingList8x8[ i − 6 ], 64, UseDefaultScalingMatrix8x8Flag[ i − 6 ] ) ; //
+                        scaling_list( ScalingList8x8[ i - 6 ], 64, UseDefaultScalingMatrix8x8Flag[ i - 6 ] ) ; //
                     }
                 }
             }
@@ -96,6 +96,11 @@ void Box::writeBoxHeader(ISOBMFF::BitStream& bitstr) const
     }
 }
 
+uint64_t Box::getBoxHeaderSize() const
+{
+    return (mLargeSize ? 16u : 8u) + (mType == "uuid" ? 16u : 0u);
+}
+
 void Box::updateSize(ISOBMFF::BitStream& bitstr) const
 {
     mSize = bitstr.getSize() - mStartLocation;
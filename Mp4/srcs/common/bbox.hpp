@@ -93,6 +93,9 @@ protected:
      *                        is appended. */
     void writeBoxHeader(ISOBMFF::BitStream& bitstr) const;
 
+    /** @return Byte size of the Box header written by writeBoxHeader() */
+    std::uint64_t getBoxHeaderSize() const;
+
     /** @brief Parses the Box header data structure as defined in ISOBMFF standard.
      * @param [in,out] bitstr A ISOBMFF::BitStream object that contains Box data stream. ISOBMFF::BitStream internal
      * pointers are updated accordingly. */
@@ -13,6 +13,7 @@
  * written consent of Nokia.
  */
 #include "bitstream.hpp"
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <stdexcept>
@@ -112,6 +113,15 @@ namespace ISOBMFF
         mStorage.clear();
     }
 
+    void BitStream::reserve(const std::uint64_t capacity)
+    {
+        // keep the growth geometric when boxes are reserved for one after another in the same bitstream
+        if (capacity > mStorage.capacity())
+        {
+            mStorage.reserve(std::max(static_cast<size_t>(capacity), 2 * mStorage.capacity()));
+        }
+    }
+
     void BitStream::skipBytes(const std::uint64_t x)
     {
         mByteOffset += x;
@@ -166,35 +176,33 @@ namespace ISOBMFF
 
     void BitStream::write16Bits(const std::uint16_t bits)
     {
-        mStorage.push_back(static_cast<uint8_t>((bits >> 8) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits) &0xff));
+        const std::uint8_t bytes[2] = {static_cast<uint8_t>((bits >> 8) & 0xff), static_cast<uint8_t>((bits) &0xff)};
+        mStorage.insert(mStorage.end(), bytes, bytes + sizeof(bytes));
     }
 
     void BitStream::write24Bits(const std::uint32_t bits)
     {
-        mStorage.push_back(static_cast<uint8_t>((bits >> 16) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 8) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits) &0xff));
+        const std::uint8_t bytes[3] = {static_cast<uint8_t>((bits >> 16) & 0xff),
+                                       static_cast<uint8_t>((bits >> 8) & 0xff), static_cast<uint8_t>((bits) &0xff)};
+        mStorage.insert(mStorage.end(), bytes, bytes + sizeof(bytes));
     }
 
     void BitStream::write32Bits(const std::uint32_t bits)
     {
-        mStorage.push_back(static_cast<uint8_t>((bits >> 24) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 16) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 8) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits) &0xff));
+        const std::uint8_t bytes[4] = {
+            static_cast<uint8_t>((bits >> 24) & 0xff), static_cast<uint8_t>((bits >> 16) & 0xff),
+            static_cast<uint8_t>((bits >> 8) & 0xff), static_cast<uint8_t>((bits) &0xff)};
+        mStorage.insert(mStorage.end(), bytes, bytes + sizeof(bytes));
     }
 
     void BitStream::write64Bits(const std::uint64_t bits)
     {
-        mStorage.push_back(static_cast<uint8_t>((bits >> 56) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 48) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 40) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 32) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 24) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 16) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits >> 8) & 0xff));
-        mStorage.push_back(static_cast<uint8_t>((bits) &0xff));
+        const std::uint8_t bytes[8] = {
+            static_cast<uint8_t>((bits >> 56) & 0xff), static_cast<uint8_t>((bits >> 48) & 0xff),
+            static_cast<uint8_t>((bits >> 40) & 0xff), static_cast<uint8_t>((bits >> 32) & 0xff),
+            static_cast<uint8_t>((bits >> 24) & 0xff), static_cast<uint8_t>((bits >> 16) & 0xff),
+            static_cast<uint8_t>((bits >> 8) & 0xff),  static_cast<uint8_t>((bits) &0xff)};
+        mStorage.insert(mStorage.end(), bytes, bytes + sizeof(bytes));
     }
 
     void BitStream::writeBits(std::uint64_t bits, std::uint32_t len)
@@ -61,6 +61,10 @@ namespace ISOBMFF
         ///@brief Clear the stored data in the bitstream
         void clear();
 
+        /** @brief Preallocates the data storage, so that writing up to the given total size does not reallocate
+         *  @param [in] capacity Total byte size of the bitstream data storage */
+        void reserve(std::uint64_t capacity);
+
         /** @brief Increments the byte offset pointer
          *  @param [in] x increment value in bytes */
         void skipBytes(std::uint64_t x);
@@ -71,25 +71,16 @@ void DecodePts::applyEmptyEdit(T& entry)
 template <typename T>
 void DecodePts::applyDwellEdit(T& entry)
 {
-    using PMapIt = PMap::iterator;
-
-    std::pair<PMapIt, PMapIt> bound;
-    bound = mMediaPtsTS.equal_range(entry.mMediaTime);
-
-    // If lower bound and upper bound point to the same entry in the map the
-    // previous sample in the map needs dwell.
-    if (bound.first->first == bound.second->first)
-    {
-        mMoviePtsTS.insert(std::make_pair(mMovieOffset, std::prev(bound.first)->second));
-        mMovieOffset += fromMovieToMediaTS(entry.mSegmentDuration);
-    }
-    // if the lower and upper bound points to different entries in the map then
-    // the first iterator points to the sample that needs dwell.
-    else
+    // The sample that needs dwell is the last one presented at or before the media time of the edit.
+    auto sample = std::upper_bound(mMediaPtsTS.cbegin(), mMediaPtsTS.cend(),
+                                   static_cast<PresentationTimeTS>(entry.mMediaTime),
+                                   [](PresentationTimeTS time, const PtsTable::value_type& pts) { return time < pts.first; });
+    if (sample != mMediaPtsTS.cbegin())
     {
-        mMoviePtsTS.insert(std::make_pair(mMovieOffset, bound.first->second));
-        mMovieOffset += fromMovieToMediaTS(entry.mSegmentDuration);
+        --sample;
     }
+    mMoviePtsTS.push_back(std::make_pair(static_cast<PresentationTimeTS>(mMovieOffset), sample->second));
+    mMovieOffset += fromMovieToMediaTS(entry.mSegmentDuration);
 }
 
 std::uint64_t DecodePts::lastSampleDuration() const
@@ -107,11 +98,7 @@ std::uint64_t DecodePts::lastSampleDuration() const
     }
     else
     {
-        const auto& sampleDeltas = mTimeToSampleBox->getSampleDeltas();
-        if (sampleDeltas.size())
-        {
-            lastSampleDuration = *sampleDeltas.rbegin();
-        }
+        lastSampleDuration = mTimeToSampleBox->getLastSampleDelta();
     }
     return lastSampleDuration;
 }
@@ -127,53 +114,96 @@ void DecodePts::applyShiftEdit(T& entry)
                                                    (fromMovieToMediaTS(entry.mSegmentDuration)));
     }
 
-    if (mMediaPtsTS.size())
+    if (mMediaPtsTS.empty())
     {
-        // this may end up being "negative", but hopefully we'll find enough samples in the loop to come back to
-        // "positive"
-        mMovieOffset += static_cast<std::uint64_t>(mMediaPtsTS.begin()->first + mMediaOffset - entry.mMediaTime);
+        return;
     }
 
-    for (auto it = mMediaPtsTS.cbegin(); it != mMediaPtsTS.cend(); ++it)
-    {
-        // Find those samples that is presented in this edit
-        if (it->first + mMediaOffset >= static_cast<std::int64_t>(entry.mMediaTime) &&
-            it->first + mMediaOffset < segmentEndTime)
-        {
-            // If the pts first sample of this edit does not exactly fall in the
-            // start of the edit, also include the previous sample and compute
-            // the time for which that sample is displayed.
-            if (it != mMediaPtsTS.cbegin() &&
-                std::prev(it)->first + mMediaOffset < static_cast<std::int64_t>(entry.mMediaTime) &&
-                it->first + mMediaOffset != static_cast<std::int64_t>(entry.mMediaTime))
-            {
-                mMoviePtsTS.insert(std::make_pair(mMovieOffset, std::prev(it)->second));
-                mMovieOffset += static_cast<std::uint64_t>(
-                    it->first - (std::prev(it)->first + (entry.mMediaTime - std::prev(it)->first)));
-            }
+    const std::int64_t mediaTime      = static_cast<std::int64_t>(entry.mMediaTime);
+    const PresentationTimeTS firstPts = mMediaPtsTS.front().first;
+    const PresentationTimeTS lastPts  = mMediaPtsTS.back().first;
+    const std::uint64_t lastDuration  = lastSampleDuration();
 
-            // Insert the rest of the samples into the movie edit
-            mMoviePtsTS.insert(std::make_pair(mMovieOffset, it->second));
-        }
+    // this may end up being "negative", but hopefully we'll find enough samples in the loop to come back to
+    // "positive"
+    mMovieOffset += static_cast<std::uint64_t>(firstPts + mMediaOffset - mediaTime);
+
+    // Find those samples that are presented in this edit; they form a contiguous range of the sorted table.
+    auto first = std::partition_point(mMediaPtsTS.cbegin(), mMediaPtsTS.cend(),
+                                      [&](const PtsTable::value_type& pts) { return pts.first + mMediaOffset < mediaTime; });
+    auto last  = std::partition_point(first, mMediaPtsTS.cend(), [&](const PtsTable::value_type& pts) {
+        return pts.first + mMediaOffset < segmentEndTime;
+    });
 
-        // If the next sample falls into the edit, update mMovieOffset with
-        // the difference of this sample and the next.
-        if (std::next(it) != mMediaPtsTS.cend())
+    // Within the edit the movie time of a sample advances with its media time.
+    std::uint64_t displayShift = 0;
+    if (first != last)
+    {
+        // If the pts first sample of this edit does not exactly fall in the
+        // start of the edit, also include the previous sample and compute
+        // the time for which that sample is displayed.
+        if (first != mMediaPtsTS.cbegin() && first->first + mMediaOffset != mediaTime)
         {
-            mMovieOffset += static_cast<std::uint64_t>(std::next(it)->first - it->first);
+            mMoviePtsTS.push_back(std::make_pair(
+                static_cast<PresentationTimeTS>(mMovieOffset + static_cast<std::uint64_t>(first->first - firstPts)),
+                std::prev(first)->second));
+            displayShift = static_cast<std::uint64_t>(first->first - mediaTime);
         }
-        else
+
+        // Insert the rest of the samples into the movie edit
+        mMoviePtsTS.reserve(mMoviePtsTS.size() + static_cast<std::size_t>(std::distance(first, last)));
+        for (auto it = first; it != last; ++it)
         {
-            mMovieOffset += lastSampleDuration();
+            mMoviePtsTS.push_back(std::make_pair(
+                static_cast<PresentationTimeTS>(mMovieOffset + displayShift +
+                                                static_cast<std::uint64_t>(it->first - firstPts)),
+                it->second));
         }
     }
 
-    if (mMediaPtsTS.size() && entry.mSegmentDuration != 0)
+    mMovieOffset += static_cast<std::uint64_t>(lastPts - firstPts) + lastDuration + displayShift;
+
+    if (entry.mSegmentDuration != 0)
     {
         // do corresponding fix at the end of the media
-        mMovieOffset -= static_cast<std::uint64_t>(mMediaPtsTS.rbegin()->first + mMediaOffset +
-                                                   static_cast<std::int64_t>(lastSampleDuration()) - segmentEndTime);
+        mMovieOffset -= static_cast<std::uint64_t>(lastPts + mMediaOffset + static_cast<std::int64_t>(lastDuration) -
+                                                   segmentEndTime);
+    }
+}
+
+void DecodePts::sortPtsTable(PtsTable& table)
+{
+    auto notBefore = [](const PtsTable::value_type& a, const PtsTable::value_type& b) { return a.first >= b.first; };
+    if (std::adjacent_find(table.begin(), table.end(), notBefore) != table.end())
+    {
+        std::stable_sort(table.begin(), table.end(),
+                         [](const PtsTable::value_type& a, const PtsTable::value_type& b) { return a.first < b.first; });
+        auto last = std::unique(table.begin(), table.end(),
+                                [](const PtsTable::value_type& a, const PtsTable::value_type& b) {
+                                    return a.first == b.first;
+                                });
+        table.erase(last, table.end());
+    }
+}
+
+void DecodePts::makeMediaPts(const Vector<std::uint64_t>& mediaDtsTS, const Vector<std::int32_t>* ptsDelta)
+{
+    mMediaPtsTS.clear();
+    mMediaPtsTS.reserve(mediaDtsTS.size());
+
+    // Link the presentation times to the sampleIds that are presented
+    SampleIndex sampleId = 0;
+    for (auto dts : mediaDtsTS)
+    {
+        PresentationTimeTS pts = static_cast<PresentationTimeTS>(dts);
+        if (ptsDelta != nullptr)
+        {
+            pts += (*ptsDelta)[static_cast<std::size_t>(sampleId)];
+        }
+        mMediaPtsTS.push_back(std::make_pair(pts, sampleId++));
     }
+
+    sortPtsTable(mMediaPtsTS);
 }
 
 void DecodePts::loadBox(const TimeToSampleBox* timeToSampleBox)
@@ -220,6 +250,7 @@ void DecodePts::applyEditList()
                 break;
             }
         }
+        sortPtsTable(mMoviePtsTS);
     }
 }
 
@@ -228,44 +259,30 @@ bool DecodePts::unravel()
     bool success = true;
 
     // First fetch the decode time stamps
-    Vector<std::uint32_t> mediaDtsTS;
-    mediaDtsTS = mTimeToSampleBox->getSampleTimes();
+    const Vector<std::uint64_t> mediaDtsTS = mTimeToSampleBox->getSampleTimes();
 
     // If composition offset box is present then add the deltas to the decode
-    // time stamps.
-    Vector<std::int64_t> mediaPtsTS;
+    // time stamps. Else the presentation time stamp is the decoding time stamp.
     if (mCompositionOffsetBox != nullptr)
     {
-        Vector<std::int32_t> ptsDelta;
-        ptsDelta = mCompositionOffsetBox->getSampleCompositionOffsets();
+        const Vector<std::int32_t> ptsDelta = mCompositionOffsetBox->getSampleCompositionOffsets();
 
         if (ptsDelta.size() == mediaDtsTS.size())
         {
-            std::transform(mediaDtsTS.begin(), mediaDtsTS.end(), ptsDelta.begin(), std::back_inserter(mediaPtsTS),
-                           [](std::uint64_t theMediaDts, std::int32_t thePtsDelta) {
-                               return std::uint64_t(std::int32_t(theMediaDts) + thePtsDelta);
-                           });
+            makeMediaPts(mediaDtsTS, &ptsDelta);
         }
         else
         {
             success = false;
         }
     }
-    // Else the presentation time stamp is the decoding time stamp
     else
     {
-        // This is done to convert a vector of one type to a vector of another type.
-        std::copy(mediaDtsTS.begin(), mediaDtsTS.end(), std::back_inserter(mediaPtsTS));
+        makeMediaPts(mediaDtsTS, nullptr);
     }
 
     if (success)
     {
-        std::uint64_t sampleId = 0;
-        for (auto pts : mediaPtsTS)
-        {
-            mMediaPtsTS.insert(std::make_pair(pts, sampleId++));
-        }
-
         if (mEditListBox != nullptr)
         {
             applyEditList();
@@ -276,8 +293,7 @@ bool DecodePts::unravel()
 
             if (mMoviePtsTS.size() > 0)
             {
-                auto last    = std::prev(mMoviePtsTS.end(), 1);
-                mMovieOffset = static_cast<std::uint64_t>(last->first) + lastSampleDuration();
+                mMovieOffset = static_cast<std::uint64_t>(mMoviePtsTS.back().first) + lastSampleDuration();
             }
             else
             {
@@ -292,8 +308,8 @@ bool DecodePts::unravel()
 void DecodePts::unravelTrackRun()
 {
     // First fetch the decode time stamps
-    Vector<std::uint32_t> mediaDts;
-    uint32_t time                     = 0;
+    Vector<std::uint64_t> mediaDts;
+    std::uint64_t time                = 0;
     bool processCompositionTimeOffset = false;
     Vector<std::int32_t> ptsDelta;
 
@@ -326,27 +342,7 @@ void DecodePts::unravelTrackRun()
         }
     }
 
-    Vector<std::int64_t> mediaPts;
-    mediaPts.reserve(mediaDts.size());
-    if (processCompositionTimeOffset)
-    {
-        std::transform(mediaDts.begin(), mediaDts.end(), ptsDelta.begin(), std::back_inserter(mediaPts),
-                       [](std::uint32_t theMediaDts, std::int32_t thePtsDelta) {
-                           return std::uint32_t(std::int32_t(theMediaDts) + thePtsDelta);
-                       });
-    }
-    else
-    {
-        std::copy(mediaDts.begin(), mediaDts.end(), std::back_inserter(mediaPts));
-    }
-
-    // Link the presentation times to the sampleIds that are presented
-    std::uint64_t sampleId = 0;
-    mMediaPtsTS.reserve(mMediaPtsTS.size() + mediaPts.size());
-    for (auto pts : mediaPts)
-    {
-        mMediaPtsTS.insert(std::make_pair(pts, sampleId++));
-    }
+    makeMediaPts(mediaDts, processCompositionTimeOffset ? &ptsDelta : nullptr);
 }
 
 void DecodePts::applyLocalTime(std::uint64_t ptsOffset)
@@ -358,15 +354,16 @@ void DecodePts::applyLocalTime(std::uint64_t ptsOffset)
     }
     else
     {
+        mMoviePtsTS.reserve(mMoviePtsTS.size() + mMediaPtsTS.size());
         for (const auto& entry : mMediaPtsTS)
         {
-            mMoviePtsTS.insert(std::make_pair(PresentationTimeTS(ptsOffset) + entry.first, entry.second));
+            mMoviePtsTS.push_back(std::make_pair(PresentationTimeTS(ptsOffset) + entry.first, entry.second));
         }
+        sortPtsTable(mMoviePtsTS);
 
         if (mMoviePtsTS.size() > 0)
         {
-            auto last    = std::prev(mMoviePtsTS.end(), 1);
-            mMovieOffset = static_cast<std::uint64_t>(last->first) + lastSampleDuration();
+            mMovieOffset = static_cast<std::uint64_t>(mMoviePtsTS.back().first) + lastSampleDuration();
         }
         else
         {
@@ -382,6 +379,7 @@ DecodePts::PMap DecodePts::getTime(const std::uint32_t timeScale) const
         throw RuntimeError("DecodePts::getTime: timeScale == 0");
     }
     PMap pMap;
+    pMap.reserve(mMoviePtsTS.size());
     for (const auto& entry : mMoviePtsTS)
     {
         pMap.insert(std::make_pair(((entry.first * 1000) / timeScale), entry.second));
@@ -392,9 +390,10 @@ DecodePts::PMap DecodePts::getTime(const std::uint32_t timeScale) const
 DecodePts::PMapTS DecodePts::getTimeTS() const
 {
     PMapTS pMapTS;
+    pMapTS.reserve(mMoviePtsTS.size());
     for (const auto& entry : mMoviePtsTS)
     {
-        pMapTS.insert(std::make_pair(entry.first, entry.second));
+        pMapTS.insert(entry);
     }
     return pMapTS;
 }
@@ -410,6 +409,7 @@ void DecodePts::getTimeTrackRun(const std::uint32_t timeScale, PMap& oldPMap) co
     {
         sampleIndexBase = oldPMap.rbegin()->second + 1;
     }
+    oldPMap.reserve(oldPMap.size() + mMoviePtsTS.size());
     for (const auto& entry : mMoviePtsTS)
     {
         oldPMap.insert(std::make_pair(((entry.first * 1000) / timeScale), sampleIndexBase + entry.second));
@@ -423,6 +423,7 @@ void DecodePts::getTimeTrackRunTS(PMapTS& oldPMapTS) const
     {
         sampleIndexBase = oldPMapTS.rbegin()->second + 1;
     }
+    oldPMapTS.reserve(oldPMapTS.size() + mMoviePtsTS.size());
     for (const auto& entry : mMoviePtsTS)
     {
         oldPMapTS.insert(std::make_pair(entry.first, sampleIndexBase + entry.second));
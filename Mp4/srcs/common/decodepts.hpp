@@ -123,8 +123,18 @@ private:
     std::uint64_t mMovieOffset;
     std::int64_t mMediaOffset = 0;  ///< keep track of the input offset, set from BaseMediaDecodeTime
 
-    PMapTS mMediaPtsTS;  ///< Media presentation timestamps
-    PMapTS mMoviePtsTS;  ///< Movie presentation timestamps after EditList has been applied
+    /** Presentation timestamps kept as a flat array sorted by time. Each time appears once and maps to the
+     *  first sample presented at that time, matching the semantics of PMapTS. */
+    typedef Vector<std::pair<PresentationTimeTS, SampleIndex>> PtsTable;
+
+    PtsTable mMediaPtsTS;  ///< Media presentation timestamps
+    PtsTable mMoviePtsTS;  ///< Movie presentation timestamps after EditList has been applied
+
+    /// Sort the table by time and drop later entries with a duplicate time; cheap if already in order
+    static void sortPtsTable(PtsTable& table);
+
+    /// Build mMediaPtsTS from decoding times and optional composition offsets of the same length
+    void makeMediaPts(const Vector<std::uint64_t>& mediaDtsTS, const Vector<std::int32_t>* ptsDelta);
 
     /// Determine the duration of the last sample; or 0 if no samples
     std::uint64_t lastSampleDuration() const;
@@ -73,8 +73,29 @@ MetaBox& MovieFragmentBox::addMetaBox()
     return *mMetaBox;
 }
 
+std::uint64_t MovieFragmentBox::calculateSize() const
+{
+    std::uint64_t size = getBoxHeaderSize() + mMovieFragmentHeaderBox.calculateSize();
+    for (const auto& trackFragmentBox : mTrackFragmentBoxes)
+    {
+        size += trackFragmentBox->calculateSize();
+    }
+    if (mMetaBox)
+    {
+        // MetaBox has no size calculation of its own, so serialize a copy of it; moofs seldom carry one
+        MetaBox metaBox(*mMetaBox);
+        BitStream metaBitstr;
+        metaBox.writeBox(metaBitstr);
+        size += metaBitstr.getSize();
+    }
+    return size;
+}
+
 void MovieFragmentBox::writeBox(BitStream& bitstr)
 {
+    // allocate once for the whole box instead of growing the storage while writing the samples
+    bitstr.reserve(bitstr.getSize() + calculateSize());
+
     writeBoxHeader(bitstr);
     mMovieFragmentHeaderBox.writeBox(bitstr);
     for (auto& trackFragmentBox : mTrackFragmentBoxes)
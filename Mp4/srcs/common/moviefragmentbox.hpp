@@ -59,6 +59,12 @@ public:
     /** @return Return the already existing metabox if any, or add one and return that */
     MetaBox& addMetaBox();
 
+    /**
+     * @brief Calculate the serialized size of the box without serializing it.
+     * @return Byte size of the box, including a contained MetaBox.
+     */
+    std::uint64_t calculateSize() const;
+
     /**
      * @brief Serialize box data to the ISOBMFF::BitStream.
      * @see Box::writeBox()
@@ -31,6 +31,11 @@ uint32_t MovieFragmentHeaderBox::getSequenceNumber() const
     return mSequenceNumber;
 }
 
+std::uint64_t MovieFragmentHeaderBox::calculateSize() const
+{
+    return getFullBoxHeaderSize() + 4;
+}
+
 void MovieFragmentHeaderBox::writeBox(BitStream& bitstr)
 {
     writeFullBoxHeader(bitstr);
@@ -37,6 +37,12 @@ public:
      *  @return uint32_t as specified in 8.8.5.1 of ISO/IEC 14496-12:2015(E)**/
     uint32_t getSequenceNumber() const;
 
+    /**
+     * @brief Calculate the serialized size of the box without serializing it.
+     * @return Byte size of the box as written by writeBox().
+     */
+    std::uint64_t calculateSize() const;
+
     /**
      * @brief Serialize box data to the ISOBMFF::BitStream.
      * @see Box::writeBox()
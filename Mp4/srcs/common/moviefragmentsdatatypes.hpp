@@ -49,14 +49,13 @@ namespace MOVIEFRAGMENTS
 
         static void write(ISOBMFF::BitStream& bitstr, const SampleFlags& r)
         {
-            bitstr.writeBits(r.flags.reserved, 4);
-            bitstr.writeBits(r.flags.is_leading, 2);
-            bitstr.writeBits(r.flags.sample_depends_on, 2);
-            bitstr.writeBits(r.flags.sample_is_depended_on, 2);
-            bitstr.writeBits(r.flags.sample_has_redundancy, 2);
-            bitstr.writeBits(r.flags.sample_padding_value, 3);
-            bitstr.writeBits(r.flags.sample_is_non_sync_sample, 1);
-            bitstr.writeBits(r.flags.sample_degradation_priority, 16);
+            // all the fields make up exactly one byte aligned 32-bit word
+            bitstr.write32Bits(uint32_t(r.flags.reserved) << 28 | uint32_t(r.flags.is_leading) << 26 |
+                               uint32_t(r.flags.sample_depends_on) << 24 | uint32_t(r.flags.sample_is_depended_on) << 22 |
+                               uint32_t(r.flags.sample_has_redundancy) << 20 |
+                               uint32_t(r.flags.sample_padding_value) << 17 |
+                               uint32_t(r.flags.sample_is_non_sync_sample) << 16 |
+                               uint32_t(r.flags.sample_degradation_priority));
         }
     };
 
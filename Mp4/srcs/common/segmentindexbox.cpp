@@ -89,6 +89,12 @@ Vector<SegmentIndexBox::Reference>& SegmentIndexBox::getReferences()
     return mReferences;
 }
 
+std::uint64_t SegmentIndexBox::calculateSize() const
+{
+    const std::uint64_t referenceSize = 3 * 4;
+    return getFullBoxHeaderSize() + 8 + (getVersion() == 0 ? 8 : 16) + 4 + mReferences.size() * referenceSize;
+}
+
 void SegmentIndexBox::writeBox(BitStream& bitstr)
 {
     const uint32_t referenceSize = 3 * 4;
@@ -96,6 +102,8 @@ void SegmentIndexBox::writeBox(BitStream& bitstr)
                                       ? static_cast<uint32_t>((mReserveTotal - mReferences.size()) * referenceSize)
                                       : 0u;
 
+    bitstr.reserve(bitstr.getSize() + calculateSize() + reserveBytes);
+
     writeFullBoxHeader(bitstr);
     bitstr.write32Bits(mReferenceID);
     bitstr.write32Bits(mTimescale);
@@ -118,12 +126,13 @@ void SegmentIndexBox::writeBox(BitStream& bitstr)
 
     for (uint32_t i = 0; i < mReferences.size(); i++)
     {
-        bitstr.writeBits(mReferences.at(i).referenceType ? uint64_t(1) : uint64_t(0), 1);  // bit (1) reference_type
-        bitstr.writeBits(uint64_t(0) | mReferences.at(i).referencedSize, 31);  // unsigned int(31) referenced_size
-        bitstr.write32Bits(mReferences.at(i).subsegmentDuration);              // unsigned int(32) subsegment_duration
-        bitstr.writeBits(mReferences.at(i).startsWithSAP ? uint64_t(1) : uint64_t(0), 1);  // bit (1) starts_with_SAP
-        bitstr.writeBits(uint64_t(0) | mReferences.at(i).sapType, 3);                      // unsigned int(3) SAP_type
-        bitstr.writeBits(uint64_t(0) | mReferences.at(i).sapDeltaTime, 28);  // unsigned int(28) SAP_delta_time
+        const Reference& reference = mReferences[i];
+        // bit (1) reference_type, unsigned int(31) referenced_size
+        bitstr.write32Bits((reference.referenceType ? 0x80000000u : 0u) | (reference.referencedSize & 0x7fffffffu));
+        bitstr.write32Bits(reference.subsegmentDuration);  // unsigned int(32) subsegment_duration
+        // bit (1) starts_with_SAP, unsigned int(3) SAP_type, unsigned int(28) SAP_delta_time
+        bitstr.write32Bits((reference.startsWithSAP ? 0x80000000u : 0u) | (uint32_t(reference.sapType & 0x7u) << 28) |
+                           (reference.sapDeltaTime & 0x0fffffffu));
     }
 
     updateSize(bitstr);
@@ -85,6 +85,12 @@ public:
     Vector<Reference> getReferences() const;
     Vector<Reference>& getReferences();
 
+    /**
+     * @brief Calculate the serialized size of the box without serializing it.
+     * @return Byte size of the box as written by writeBox(), excluding the reserve free box.
+     */
+    std::uint64_t calculateSize() const;
+
     /**
      * @brief Serialize box data to the ISOBMFF::BitStream.
      * @see Box::writeBox()
@@ -25,10 +25,17 @@ TimeToSampleBox::TimeToSampleBox()
 {
 }
 
-Vector<std::uint32_t> TimeToSampleBox::getSampleTimes() const
+Vector<std::uint64_t> TimeToSampleBox::getSampleTimes() const
 {
-    Vector<std::uint32_t> sampleTimes;
-    uint32_t time = 0;
+    std::size_t sampleCount = 0;
+    for (const auto& entry : mEntryVersion0)
+    {
+        sampleCount += entry.mSampleCount;
+    }
+
+    Vector<std::uint64_t> sampleTimes;
+    sampleTimes.reserve(sampleCount);
+    std::uint64_t time = 0;
     for (const auto& entry : mEntryVersion0)
     {
         for (unsigned int i = 0; i < entry.mSampleCount; ++i)
@@ -60,6 +67,18 @@ Vector<std::uint32_t> TimeToSampleBox::getSampleDeltas() const
     return sampleDeltas;
 }
 
+std::uint32_t TimeToSampleBox::getLastSampleDelta() const
+{
+    for (auto entry = mEntryVersion0.crbegin(); entry != mEntryVersion0.crend(); ++entry)
+    {
+        if (entry->mSampleCount)
+        {
+            return entry->mSampleDelta;
+        }
+    }
+    return 0;
+}
+
 std::uint32_t TimeToSampleBox::getSampleCount() const
 {
     std::uint64_t sampleCount = 0;
@@ -36,13 +36,17 @@ public:
     virtual ~TimeToSampleBox() = default;
 
     /** @brief Get sample timing information.
-     *  @returns vector of sample timing information. **/
-    Vector<std::uint32_t> getSampleTimes() const;
+     *  @returns vector of sample decoding times, accumulated in 64 bits. **/
+    Vector<std::uint64_t> getSampleTimes() const;
 
     /** @brief Get sample timing information as sample deltas.
      *  @returns vector of sample timing information as sample deltas. **/
     Vector<std::uint32_t> getSampleDeltas() const;
 
+    /** @brief Get the sample delta of the last sample without expanding the whole table.
+     *  @returns the delta of the last sample, or 0 if there are no samples **/
+    std::uint32_t getLastSampleDelta() const;
+
     /** @brief Get sample count without consuming potentially a lot of memory.
      *  @returns the number of samples **/
     std::uint32_t getSampleCount() const;
@@ -31,6 +31,11 @@ uint64_t TrackFragmentBaseMediaDecodeTimeBox::getBaseMediaDecodeTime() const
     return mBaseMediaDecodeTime;
 }
 
+std::uint64_t TrackFragmentBaseMediaDecodeTimeBox::calculateSize() const
+{
+    return getFullBoxHeaderSize() + (getVersion() == 0 ? 4 : 8);
+}
+
 void TrackFragmentBaseMediaDecodeTimeBox::writeBox(BitStream& bitstr)
 {
     writeFullBoxHeader(bitstr);
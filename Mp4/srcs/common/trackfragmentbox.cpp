@@ -55,6 +55,20 @@ TrackFragmentBaseMediaDecodeTimeBox* TrackFragmentBox::getTrackFragmentBaseMedia
     return mTrackFragmentDecodeTimeBox.get();
 }
 
+std::uint64_t TrackFragmentBox::calculateSize() const
+{
+    std::uint64_t size = getBoxHeaderSize() + mTrackFragmentHeaderBox.calculateSize();
+    if (mTrackFragmentDecodeTimeBox)
+    {
+        size += mTrackFragmentDecodeTimeBox->calculateSize();
+    }
+    for (const auto& trackRuns : mTrackRunBoxes)
+    {
+        size += trackRuns->calculateSize();
+    }
+    return size;
+}
+
 void TrackFragmentBox::writeBox(BitStream& bitstr)
 {
     writeBoxHeader(bitstr);
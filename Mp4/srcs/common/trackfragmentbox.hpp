@@ -53,6 +53,12 @@ public:
     /** @return Pointers to all contained TrackFragmentBaseMediaDecodeTimeBoxes. */
     TrackFragmentBaseMediaDecodeTimeBox* getTrackFragmentBaseMediaDecodeTimeBox();
 
+    /**
+     * @brief Calculate the serialized size of the box without serializing it.
+     * @return Byte size of the box as written by writeBox().
+     */
+    std::uint64_t calculateSize() const;
+
     /**
      * @brief Serialize box data to the ISOBMFF::BitStream.
      * @see Box::writeBox()
@@ -124,6 +124,18 @@ MOVIEFRAGMENTS::SampleFlags TrackFragmentHeaderBox::getDefaultSampleFlags() cons
     }
 }
 
+std::uint64_t TrackFragmentHeaderBox::calculateSize() const
+{
+    const std::uint32_t flags = getFlags();
+    std::uint64_t size        = getFullBoxHeaderSize() + 4;
+    size += (flags & TrackFragmentHeaderBox::BaseDataOffsetPresent) != 0 ? 8 : 0;
+    size += (flags & TrackFragmentHeaderBox::SampleDescriptionIndexPresent) != 0 ? 4 : 0;
+    size += (flags & TrackFragmentHeaderBox::DefaultSampleDurationPresent) != 0 ? 4 : 0;
+    size += (flags & TrackFragmentHeaderBox::DefaultSampleSizePresent) != 0 ? 4 : 0;
+    size += (flags & TrackFragmentHeaderBox::DefaultSampleFlagsPresent) != 0 ? 4 : 0;
+    return size;
+}
+
 void TrackFragmentHeaderBox::writeBox(BitStream& bitstr)
 {
     writeFullBoxHeader(bitstr);
@@ -89,6 +89,25 @@ void TrackRunBox::setSampleDefaults(MOVIEFRAGMENTS::SampleDefaults& sampleDefaul
     mSampleDefaults    = sampleDefaults;
 }
 
+std::uint64_t TrackRunBox::calculateSize() const
+{
+    const std::uint32_t flags = getFlags();
+    std::uint64_t size        = getFullBoxHeaderSize() + 4;
+    size += (flags & TrackRunFlags::DataOffsetPresent) != 0 ? 4 : 0;
+    size += (flags & TrackRunFlags::FirstSampleFlagsPresent) != 0 ? 4 : 0;
+
+    std::uint64_t sampleSize = 0;
+    sampleSize += (flags & TrackRunFlags::SampleDurationPresent) != 0 ? 4 : 0;
+    sampleSize += (flags & TrackRunFlags::SampleSizePresent) != 0 ? 4 : 0;
+    sampleSize += ((flags & TrackRunFlags::FirstSampleFlagsPresent) == 0 &&
+                   (flags & TrackRunFlags::SampleFlagsPresent) != 0)
+                      ? 4
+                      : 0;
+    sampleSize += (flags & TrackRunFlags::SampleCompositionTimeOffsetsPresent) != 0 ? 4 : 0;
+
+    return size + sampleSize * mSampleCount;
+}
+
 void TrackRunBox::writeBox(ISOBMFF::BitStream& bitstr)
 {
     writeFullBoxHeader(bitstr);
@@ -103,32 +122,36 @@ void TrackRunBox::writeBox(ISOBMFF::BitStream& bitstr)
         MOVIEFRAGMENTS::SampleFlags::write(bitstr, mFirstSampleFlags);
     }
 
+    const bool durationPresent = (getFlags() & TrackRunFlags::SampleDurationPresent) != 0;
+    const bool sizePresent     = (getFlags() & TrackRunFlags::SampleSizePresent) != 0;
+    const bool flagsPresent    = (getFlags() & TrackRunFlags::FirstSampleFlagsPresent) == 0 &&
+                              (getFlags() & TrackRunFlags::SampleFlagsPresent) != 0;
+    const bool compositionTimeOffsetPresent = (getFlags() & TrackRunFlags::SampleCompositionTimeOffsetsPresent) != 0;
+
     for (uint32_t i = 0; i < mSampleCount; i++)
     {
-        if ((getFlags() & TrackRunFlags::SampleDurationPresent) != 0)
+        const SampleDetails& details = mSampleDetails.at(i);
+        if (durationPresent)
         {
-            bitstr.write32Bits(mSampleDetails.at(i).version0.sampleDuration);
+            bitstr.write32Bits(details.version0.sampleDuration);
         }
-        if ((getFlags() & TrackRunFlags::SampleSizePresent) != 0)
+        if (sizePresent)
         {
-            bitstr.write32Bits(mSampleDetails.at(i).version0.sampleSize);
+            bitstr.write32Bits(details.version0.sampleSize);
         }
-        if ((getFlags() & TrackRunFlags::FirstSampleFlagsPresent) == 0)
+        if (flagsPresent)
         {
-            if ((getFlags() & TrackRunFlags::SampleFlagsPresent) != 0)
-            {
-                MOVIEFRAGMENTS::SampleFlags::write(bitstr, mSampleDetails.at(i).version0.sampleFlags);
-            }
+            MOVIEFRAGMENTS::SampleFlags::write(bitstr, details.version0.sampleFlags);
         }
-        if ((getFlags() & TrackRunFlags::SampleCompositionTimeOffsetsPresent) != 0)
+        if (compositionTimeOffsetPresent)
         {
             if (getVersion() == 0)
             {
-                bitstr.write32Bits(mSampleDetails.at(i).version0.sampleCompositionTimeOffset);
+                bitstr.write32Bits(details.version0.sampleCompositionTimeOffset);
             }
             else
             {
-                bitstr.write32Bits(static_cast<uint32_t>(mSampleDetails.at(i).version1.sampleCompositionTimeOffset));
+                bitstr.write32Bits(static_cast<uint32_t>(details.version1.sampleCompositionTimeOffset));
             }
         }
     }
@@ -97,6 +97,12 @@ public:
      *  @param [in] MOVIEFRAGMENTS::SampleDefaults sampleDefaults **/
     void setSampleDefaults(MOVIEFRAGMENTS::SampleDefaults& sampleDefaults);
 
+    /**
+     * @brief Calculate the serialized size of the box without serializing it.
+     * @return Byte size of the box as written by writeBox().
+     */
+    std::uint64_t calculateSize() const;
+
     /**
      * @brief Serialize box data to the ISOBMFF::BitStream.
      * @see Box::writeBox()
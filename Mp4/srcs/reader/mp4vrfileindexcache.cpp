@@ -0,0 +1,359 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "mp4vrfileindexcache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+namespace MP4VR
+{
+    namespace
+    {
+        // Bump whenever the layout below or the way SampleInfo is derived from the sample tables changes
+        const std::uint32_t kIndexCacheVersion = 1;
+        const char kIndexCacheMagic[8]        = {'M', 'P', '4', 'V', 'R', 'I', 'D', 'X'};
+        const std::uint32_t kByteOrderMark    = 0x01020304;
+
+        struct FileHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrderMark;
+            std::uint64_t fileSize;
+            std::int64_t modificationTime;
+            std::uint64_t moovHash;
+            std::uint64_t trackCount;
+        };
+
+        struct TrackHeader
+        {
+            std::uint32_t trackId;
+            std::uint32_t hasEditList;
+            std::int64_t durationTS;
+            std::uint64_t sampleCount;
+            std::uint64_t extraCompositionTimeCount;
+            std::uint64_t extraCompositionTimeTSCount;
+        };
+
+        // One fixed size record per sample, with the first composition time of the sample inline. Samples with more
+        // than one composition time (edit lists repeating media) keep the rest in two arrays that precede the records
+        // of the track, so the records can be streamed through a small buffer straight into the SampleInfoVector.
+        struct SampleRecord
+        {
+            std::uint64_t dataOffset;
+            std::uint64_t compositionTime;
+            std::uint64_t compositionTimeTS;
+            std::uint32_t sampleId;
+            std::uint32_t dataLength;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint32_t sampleDuration;
+            std::uint32_t sampleEntryType;
+            std::uint32_t sampleDescriptionIndex;
+            std::uint32_t sampleFlags;
+            std::uint32_t compositionTimes;
+            std::uint32_t compositionTimesTS;
+            std::uint8_t hasDataOffset;
+            std::uint8_t sampleType;
+            std::uint8_t reserved[6];
+        };
+        static_assert(sizeof(SampleRecord) == 72, "SampleRecord must not contain implicit padding");
+
+        const std::size_t kRecordsPerRead = 4096;
+
+        template <typename T>
+        bool readArray(std::ifstream& aIn, Vector<T>& aArray, std::uint64_t aCount, std::uint64_t& aRemaining)
+        {
+            if (aCount > aRemaining / sizeof(T))
+            {
+                return false;
+            }
+            aArray.resize(static_cast<std::size_t>(aCount));
+            if (aCount)
+            {
+                aIn.read(reinterpret_cast<char*>(aArray.data()), static_cast<std::streamsize>(aCount * sizeof(T)));
+            }
+            aRemaining -= aCount * sizeof(T);
+            return !!aIn;
+        }
+
+        template <typename T>
+        void writeArray(std::ofstream& aOut, const Vector<T>& aArray)
+        {
+            if (aArray.size())
+            {
+                aOut.write(reinterpret_cast<const char*>(aArray.data()),
+                           static_cast<std::streamsize>(aArray.size() * sizeof(T)));
+            }
+        }
+
+        // Appends the composition times of a record to aTimes: the inline one first, the rest from aExtra
+        bool joinCompositionTimes(SmallVector<std::uint64_t, 1>& aTimes,
+                                  std::uint64_t aFirst,
+                                  std::uint32_t aCount,
+                                  const Vector<std::uint64_t>& aExtra,
+                                  std::size_t& aExtraIndex)
+        {
+            if (aCount == 0)
+            {
+                return true;
+            }
+            if (aCount - 1 > aExtra.size() - aExtraIndex)
+            {
+                return false;
+            }
+            aTimes.push_back(aFirst);
+            for (std::uint32_t i = 1; i < aCount; ++i)
+            {
+                aTimes.push_back(aExtra[aExtraIndex++]);
+            }
+            return true;
+        }
+
+        // Returns the first of the composition times of a sample and appends the rest to aExtra, if given
+        template <typename Times>
+        std::uint64_t splitCompositionTimes(const Times& aTimes, Vector<std::uint64_t>* aExtra)
+        {
+            std::uint64_t first = 0;
+            bool isFirst        = true;
+            for (auto time : aTimes)
+            {
+                if (isFirst)
+                {
+                    first   = time;
+                    isFirst = false;
+                }
+                else if (aExtra)
+                {
+                    aExtra->push_back(time);
+                }
+            }
+            return first;
+        }
+    }  // anonymous namespace
+
+    std::uint64_t indexCacheHash(const std::uint8_t* data, std::size_t size)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    String indexCachePath(const String& aDirectory, const IndexCacheKey& aKey)
+    {
+        OStringStream path;
+        path << aDirectory;
+        if (aDirectory.size() && aDirectory.back() != '/' && aDirectory.back() != '\\')
+        {
+            path << '/';
+        }
+        path << std::hex << std::setfill('0') << std::setw(16) << aKey.moovHash << '-' << aKey.fileSize << ".mp4vridx";
+        return path.str();
+    }
+
+    bool loadIndexCache(const String& aPath, const IndexCacheKey& aKey, IndexCacheTracks& aTracks)
+    {
+        std::ifstream in(aPath.c_str(), std::ios::binary | std::ios::ate);
+        if (!in)
+        {
+            return false;
+        }
+        std::uint64_t remaining = static_cast<std::uint64_t>(in.tellg());
+        in.seekg(0);
+
+        FileHeader header;
+        if (remaining < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            return false;
+        }
+        remaining -= sizeof(header);
+        if (std::memcmp(header.magic, kIndexCacheMagic, sizeof(kIndexCacheMagic)) ||
+            header.version != kIndexCacheVersion || header.byteOrderMark != kByteOrderMark ||
+            header.fileSize != aKey.fileSize || header.modificationTime != aKey.modificationTime ||
+            header.moovHash != aKey.moovHash)
+        {
+            return false;
+        }
+
+        IndexCacheTracks tracks;
+        Vector<SampleRecord> records;
+        Vector<std::uint64_t> extraCompositionTimes;
+        Vector<std::uint64_t> extraCompositionTimesTS;
+        for (std::uint64_t trackIndex = 0; trackIndex < header.trackCount; ++trackIndex)
+        {
+            TrackHeader trackHeader;
+            if (remaining < sizeof(trackHeader) || !in.read(reinterpret_cast<char*>(&trackHeader), sizeof(trackHeader)))
+            {
+                return false;
+            }
+            remaining -= sizeof(trackHeader);
+            if (!readArray(in, extraCompositionTimes, trackHeader.extraCompositionTimeCount, remaining) ||
+                !readArray(in, extraCompositionTimesTS, trackHeader.extraCompositionTimeTSCount, remaining) ||
+                trackHeader.sampleCount > remaining / sizeof(SampleRecord))
+            {
+                return false;
+            }
+
+            IndexCacheTrack& track = tracks[ContextId(trackHeader.trackId)];
+            track.durationTS       = trackHeader.durationTS;
+            track.hasEditList      = !!trackHeader.hasEditList;
+            track.samples.reserve(static_cast<std::size_t>(trackHeader.sampleCount));
+
+            std::size_t extraIndex   = 0;
+            std::size_t extraTSIndex = 0;
+            for (std::uint64_t first = 0; first < trackHeader.sampleCount; first += kRecordsPerRead)
+            {
+                std::uint64_t count = std::min<std::uint64_t>(kRecordsPerRead, trackHeader.sampleCount - first);
+                if (!readArray(in, records, count, remaining))
+                {
+                    return false;
+                }
+                for (const auto& record : records)
+                {
+                    SampleInfo sample{};
+                    if (!joinCompositionTimes(sample.compositionTimes, record.compositionTime, record.compositionTimes,
+                                              extraCompositionTimes, extraIndex) ||
+                        !joinCompositionTimes(sample.compositionTimesTS, record.compositionTimeTS,
+                                              record.compositionTimesTS, extraCompositionTimesTS, extraTSIndex))
+                    {
+                        return false;
+                    }
+                    sample.sampleId = record.sampleId;
+                    if (record.hasDataOffset)
+                    {
+                        sample.dataOffset = record.dataOffset;
+                    }
+                    else
+                    {
+                        sample.dataOffset = {};
+                    }
+                    sample.dataLength              = record.dataLength;
+                    sample.width                   = record.width;
+                    sample.height                  = record.height;
+                    sample.sampleDuration          = record.sampleDuration;
+                    sample.sampleEntryType         = FourCCInt(record.sampleEntryType);
+                    sample.sampleDescriptionIndex  = record.sampleDescriptionIndex;
+                    sample.sampleType              = static_cast<SampleType>(record.sampleType);
+                    sample.sampleFlags.flagsAsUInt = record.sampleFlags;
+                    track.samples.push_back(sample);
+                }
+            }
+        }
+
+        aTracks = std::move(tracks);
+        return true;
+    }
+
+    bool storeIndexCache(const String& aPath, const IndexCacheKey& aKey, const Map<ContextId, TrackInfo>& aTrackInfos)
+    {
+        OStringStream temporaryPath;
+        temporaryPath << aPath << '.' << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+        const String temporary = temporaryPath.str();
+
+        {
+            std::ofstream out(temporary.c_str(), std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                return false;
+            }
+
+            FileHeader header{};
+            std::memcpy(header.magic, kIndexCacheMagic, sizeof(kIndexCacheMagic));
+            header.version          = kIndexCacheVersion;
+            header.byteOrderMark    = kByteOrderMark;
+            header.fileSize         = aKey.fileSize;
+            header.modificationTime = aKey.modificationTime;
+            header.moovHash         = aKey.moovHash;
+            header.trackCount       = aTrackInfos.size();
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            Vector<SampleRecord> records;
+            Vector<std::uint64_t> extraCompositionTimes;
+            Vector<std::uint64_t> extraCompositionTimesTS;
+            for (const auto& trackInfo : aTrackInfos)
+            {
+                const SampleInfoVector& samples = trackInfo.second.samples;
+                extraCompositionTimes.clear();
+                extraCompositionTimesTS.clear();
+                for (const auto& sample : samples)
+                {
+                    splitCompositionTimes(sample.compositionTimes, &extraCompositionTimes);
+                    splitCompositionTimes(sample.compositionTimesTS, &extraCompositionTimesTS);
+                }
+
+                TrackHeader trackHeader{};
+                trackHeader.trackId                     = trackInfo.first.get();
+                trackHeader.hasEditList                 = trackInfo.second.hasEditList ? 1 : 0;
+                trackHeader.durationTS                  = trackInfo.second.durationTS;
+                trackHeader.sampleCount                 = samples.size();
+                trackHeader.extraCompositionTimeCount   = extraCompositionTimes.size();
+                trackHeader.extraCompositionTimeTSCount = extraCompositionTimesTS.size();
+                out.write(reinterpret_cast<const char*>(&trackHeader), sizeof(trackHeader));
+                writeArray(out, extraCompositionTimes);
+                writeArray(out, extraCompositionTimesTS);
+
+                records.clear();
+                for (const auto& sample : samples)
+                {
+                    SampleRecord record{};
+                    record.dataOffset             = sample.dataOffset ? *sample.dataOffset : 0;
+                    record.hasDataOffset          = sample.dataOffset ? 1 : 0;
+                    record.compositionTime        = splitCompositionTimes(sample.compositionTimes, nullptr);
+                    record.compositionTimeTS      = splitCompositionTimes(sample.compositionTimesTS, nullptr);
+                    record.sampleId               = sample.sampleId;
+                    record.dataLength             = sample.dataLength;
+                    record.width                  = sample.width;
+                    record.height                 = sample.height;
+                    record.sampleDuration         = sample.sampleDuration;
+                    record.sampleEntryType        = sample.sampleEntryType.getUInt32();
+                    record.sampleDescriptionIndex = sample.sampleDescriptionIndex.get();
+                    record.sampleType             = static_cast<std::uint8_t>(sample.sampleType);
+                    record.sampleFlags            = sample.sampleFlags.flagsAsUInt;
+                    record.compositionTimes       = static_cast<std::uint32_t>(sample.compositionTimes.size());
+                    record.compositionTimesTS     = static_cast<std::uint32_t>(sample.compositionTimesTS.size());
+                    records.push_back(record);
+                    if (records.size() == kRecordsPerRead)
+                    {
+                        writeArray(out, records);
+                        records.clear();
+                    }
+                }
+                writeArray(out, records);
+            }
+
+            out.close();
+            if (!out)
+            {
+                std::remove(temporary.c_str());
+                return false;
+            }
+        }
+
+        if (std::rename(temporary.c_str(), aPath.c_str()) != 0)
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+}  // namespace MP4VR
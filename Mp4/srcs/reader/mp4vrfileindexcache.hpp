@@ -0,0 +1,63 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#ifndef MP4VRFILEINDEXCACHE_HPP_
+#define MP4VRFILEINDEXCACHE_HPP_
+
+#include "customallocator.hpp"
+#include "mp4vrfiledatatypesinternal.hpp"
+
+namespace MP4VR
+{
+    /**
+     * Identifies the file a cached index belongs to. The sample tables are derived from the 'moov' box alone, so its
+     * hash decides whether an entry can be used; the file size and modification time guard against reusing an entry
+     * for a file that has been rewritten in place.
+     */
+    struct IndexCacheKey
+    {
+        std::uint64_t fileSize        = 0;
+        std::int64_t modificationTime = 0;  ///< seconds since the epoch, or 0 when reading from a stream
+        std::uint64_t moovHash        = 0;
+    };
+
+    /** Expanded sample table of one track, as it is after the composition times have been applied */
+    struct IndexCacheTrack
+    {
+        DecodePts::PresentationTimeTS durationTS = 0;
+        bool hasEditList                         = false;
+        SampleInfoVector samples;
+    };
+
+    typedef Map<ContextId, IndexCacheTrack> IndexCacheTracks;
+
+    /** @return 64-bit FNV-1a hash of the given bytes */
+    std::uint64_t indexCacheHash(const std::uint8_t* data, std::size_t size);
+
+    /** @return Path of the cache entry for aKey inside aDirectory */
+    String indexCachePath(const String& aDirectory, const IndexCacheKey& aKey);
+
+    /**
+     * Load a cache entry written by storeIndexCache.
+     * @return true if the entry existed, had the current format version and matched aKey */
+    bool loadIndexCache(const String& aPath, const IndexCacheKey& aKey, IndexCacheTracks& aTracks);
+
+    /**
+     * Write the sample tables of the given tracks to aPath. The entry is first written to a temporary file and then
+     * renamed, so concurrent readers never see a partial entry.
+     * @return true on success */
+    bool storeIndexCache(const String& aPath, const IndexCacheKey& aKey, const Map<ContextId, TrackInfo>& aTrackInfos);
+}  // namespace MP4VR
+
+#endif /* MP4VRFILEINDEXCACHE_HPP_ */
@@ -309,6 +309,123 @@ namespace MP4VR
     }
 
 
+    void MP4VRFileReaderImpl::fillTrackInformation(InitSegmentId initSegmentId,
+                                                   ContextId trackId,
+                                                   const TrackProperties& trackProperties,
+                                                   TrackInformation& trackInfo) const
+    {
+        trackInfo.initSegmentId    = initSegmentId.get();
+        trackInfo.trackId          = toTrackId(std::make_pair(initSegmentId, trackId));
+        trackInfo.alternateGroupId = trackProperties.alternateGroupId;
+        trackInfo.features         = trackProperties.trackFeature.getFeatureMask();
+        trackInfo.vrFeatures       = trackProperties.trackFeature.getVRFeatureMask();
+        trackInfo.timeScale        = mInitSegmentPropertiesMap.at(initSegmentId).initTrackInfos.at(trackId).timeScale;
+        trackInfo.frameRate        = {};
+        String tempURI             = trackProperties.trackURI;
+        tempURI.push_back('\0');  // make sure URI is null terminated.
+        trackInfo.trackURI          = makeDynArray<char>(tempURI);
+        trackInfo.alternateTrackIds = makeDynArray<unsigned int>(trackProperties.alternateTrackIds);
+
+        trackInfo.referenceTrackIds = DynArray<TypeToTrackIDs>(trackProperties.referenceTrackIds.size());
+        size_t i                    = 0;
+        for (auto const& reference : trackProperties.referenceTrackIds)
+        {
+            trackInfo.referenceTrackIds[i].type = FourCC(reference.first.getUInt32());
+            trackInfo.referenceTrackIds[i].trackIds =
+                makeDynArrayMap(reference.second, [&](ContextId aContextId) {
+                    return toTrackId({initSegmentId, aContextId});
+                });
+            i++;
+        }
+
+        trackInfo.trackGroupIds = DynArray<TypeToTrackIDs>(trackProperties.trackGroupInfoMap.size());
+        i                       = 0;
+        for (auto const& group : trackProperties.trackGroupInfoMap)
+        {
+            trackInfo.trackGroupIds[i].type     = FourCC(group.first.getUInt32());
+            trackInfo.trackGroupIds[i].trackIds = makeDynArray<unsigned int>(group.second.ids);
+            i++;
+        }
+
+        trackInfo.maxSampleSize = 0;
+    }
+
+    size_t MP4VRFileReaderImpl::fillSegmentSampleInformation(const SegmentProperties& segment,
+                                                             ContextId trackId,
+                                                             TrackInformation& trackInfo,
+                                                             size_t sampleIndex) const
+    {
+        auto trackInfoIt = segment.trackInfos.find(trackId);
+        if (trackInfoIt == segment.trackInfos.end())
+        {
+            return sampleIndex;
+        }
+        auto& segTrackInfo = trackInfoIt->second;
+
+        if (segTrackInfo.hasTtyp)
+        {
+            auto& tBox                   = segTrackInfo.ttyp;
+            trackInfo.hasTypeInformation = true;
+
+            trackInfo.type.majorBrand   = tBox.getMajorBrand().c_str();
+            trackInfo.type.minorVersion = tBox.getMinorVersion();
+
+            Vector<FourCC> convertedCompatibleBrands;
+            for (auto& compatibleBrand : tBox.getCompatibleBrands())
+            {
+                convertedCompatibleBrands.push_back(FourCC(compatibleBrand.c_str()));
+            }
+            trackInfo.type.compatibleBrands = makeDynArray<FourCC>(convertedCompatibleBrands);
+        }
+        else
+        {
+            trackInfo.hasTypeInformation = false;
+        }
+
+        if (segTrackInfo.samples.size() > 0)
+        {
+            std::uint64_t sum{};
+            for (auto& sample : segTrackInfo.samples)
+            {
+                sum += static_cast<std::uint64_t>(sample.sampleDuration);
+            }
+            auto timeScale      = mInitSegmentPropertiesMap.at(segment.initSegmentId).initTrackInfos.at(trackId).timeScale;
+            trackInfo.frameRate = Rational{timeScale, sum / segTrackInfo.samples.size()};
+        }
+
+        size_t i = sampleIndex;
+        for (auto const& sample : segTrackInfo.samples)
+        {
+            SampleInformation& sampleInfo     = trackInfo.sampleProperties[i];
+            sampleInfo.sampleId               = ItemId(sample.sampleId).get();
+            sampleInfo.sampleEntryType        = FourCC(sample.sampleEntryType.getUInt32());
+            sampleInfo.sampleDescriptionIndex = sample.sampleDescriptionIndex.get();
+            sampleInfo.sampleType             = sample.sampleType;
+            sampleInfo.initSegmentId          = segment.initSegmentId.get();
+            sampleInfo.segmentId              = segment.segmentId.get();
+            if (sample.compositionTimes.size())
+            {
+                sampleInfo.earliestTimestamp   = sample.compositionTimes.at(0);
+                sampleInfo.earliestTimestampTS = sample.compositionTimesTS.at(0);
+            }
+            else
+            {
+                sampleInfo.earliestTimestamp   = 0;
+                sampleInfo.earliestTimestampTS = 0;
+            }
+            sampleInfo.sampleFlags.flagsAsUInt = sample.sampleFlags.flagsAsUInt;
+            sampleInfo.sampleDurationTS        = sample.sampleDuration;
+
+            unsigned int sampleSize = sample.dataLength;
+            if (sampleSize > trackInfo.maxSampleSize)
+            {
+                trackInfo.maxSampleSize = sampleSize;
+            }
+            i++;
+        }
+        return i;
+    }
+
     int32_t MP4VRFileReaderImpl::getTrackInformations(DynArray<TrackInformation>& trackInfos) const
     {
         if (isInitializedError())
@@ -324,7 +441,6 @@ namespace MP4VR
 
         trackInfos               = DynArray<TrackInformation>(totalSize);
         uint32_t outTrackIdxBase = 0;
-        size_t i                 = 0;
         for (auto const& initSegment : mInitSegmentPropertiesMap)
         {
             InitSegmentId initSegmentId = initSegment.first;
@@ -332,46 +448,8 @@ namespace MP4VR
 
             for (auto const& trackPropsKv : initSegment.second.trackProperties)
             {
-                ContextId trackId                      = trackPropsKv.first;
-                const TrackProperties& trackProperties = trackPropsKv.second;
-                //            const TrackInfo& trackInfo = trackInfosKv.second;
-                trackInfos.elements[outTrackIdx].initSegmentId = initSegmentId.get();
-                trackInfos.elements[outTrackIdx].trackId       = toTrackId(std::make_pair(initSegment.first, trackId));
-                trackInfos.elements[outTrackIdx].alternateGroupId = trackProperties.alternateGroupId;
-                trackInfos.elements[outTrackIdx].features         = trackProperties.trackFeature.getFeatureMask();
-                trackInfos.elements[outTrackIdx].vrFeatures       = trackProperties.trackFeature.getVRFeatureMask();
-                trackInfos.elements[outTrackIdx].timeScale =
-                    mInitSegmentPropertiesMap.at(initSegmentId).initTrackInfos.at(trackId).timeScale;
-                trackInfos.elements[outTrackIdx].frameRate = {};
-                String tempURI                             = trackProperties.trackURI;
-                tempURI.push_back('\0');  // make sure URI is null terminated.
-                trackInfos.elements[outTrackIdx].trackURI = makeDynArray<char>(tempURI);
-                trackInfos.elements[outTrackIdx].alternateTrackIds =
-                    makeDynArray<unsigned int>(trackProperties.alternateTrackIds);
-
-                trackInfos.elements[outTrackIdx].referenceTrackIds =
-                    DynArray<TypeToTrackIDs>(trackProperties.referenceTrackIds.size());
-                i = 0;
-                for (auto const& reference : trackProperties.referenceTrackIds)
-                {
-                    trackInfos.elements[outTrackIdx].referenceTrackIds[i].type = FourCC(reference.first.getUInt32());
-                    trackInfos.elements[outTrackIdx].referenceTrackIds[i].trackIds =
-                        makeDynArrayMap(reference.second, [&](ContextId aContextId) {
-                            return toTrackId({initSegment.first, aContextId});
-                        });
-                    i++;
-                }
-
-                trackInfos.elements[outTrackIdx].trackGroupIds =
-                    DynArray<TypeToTrackIDs>(trackProperties.trackGroupInfoMap.size());
-                i = 0;
-                for (auto const& group : trackProperties.trackGroupInfoMap)
-                {
-                    trackInfos.elements[outTrackIdx].trackGroupIds[i].type = FourCC(group.first.getUInt32());
-                    trackInfos.elements[outTrackIdx].trackGroupIds[i].trackIds =
-                        makeDynArray<unsigned int>(group.second.ids);
-                    i++;
-                }
+                fillTrackInformation(initSegmentId, trackPropsKv.first, trackPropsKv.second,
+                                     trackInfos.elements[outTrackIdx]);
                 outTrackIdx++;
             }
 
@@ -423,92 +501,71 @@ namespace MP4VR
                 outTrackIdx = outTrackIdxBase;
                 for (ContextId trackId : initSegTrackIds)
                 {
-                    auto trackInfoIt = segment.trackInfos.find(trackId);
-                    if (trackInfoIt != segment.trackInfos.end())
-                    {
-                        auto& trackInfo = trackInfoIt->second;
-                        i               = sampleOffset[outTrackIdx];
+                    sampleOffset[outTrackIdx] = fillSegmentSampleInformation(
+                        segment, trackId, trackInfos.elements[outTrackIdx], sampleOffset[outTrackIdx]);
+                    ++outTrackIdx;
+                }
+            }
 
-                        if (trackInfo.hasTtyp)
-                        {
-                            auto& tBox                                          = trackInfo.ttyp;
-                            trackInfos.elements[outTrackIdx].hasTypeInformation = true;
+            outTrackIdxBase += static_cast<uint32_t>(initSegment.second.initTrackInfos.size());
+        }
 
-                            trackInfos.elements[outTrackIdx].type.majorBrand   = tBox.getMajorBrand().c_str();
-                            trackInfos.elements[outTrackIdx].type.minorVersion = tBox.getMinorVersion();
+        // V2: fill in also the SampleInformation::segmentId
+        return ErrorCode::OK;
+    }
 
-                            Vector<FourCC> convertedCompatibleBrands;
-                            for (auto& compatibleBrand : tBox.getCompatibleBrands())
-                            {
-                                convertedCompatibleBrands.push_back(FourCC(compatibleBrand.c_str()));
-                            }
-                            trackInfos.elements[outTrackIdx].type.compatibleBrands =
-                                makeDynArray<FourCC>(convertedCompatibleBrands);
-                        }
-                        else
-                        {
-                            trackInfos.elements[outTrackIdx].hasTypeInformation = false;
-                        }
+    int32_t MP4VRFileReaderImpl::getSegmentTrackInformations(uint32_t initSegmentId,
+                                                             uint32_t segmentId,
+                                                             DynArray<TrackInformation>& trackInfos) const
+    {
+        if (isInitializedError())
+        {
+            return ErrorCode::UNINITIALIZED;
+        }
 
-                        if (trackInfo.samples.size() > 0)
-                        {
-                            std::uint64_t sum{};
-                            for (auto& sample : trackInfo.samples)
-                            {
-                                sum += static_cast<std::uint64_t>(sample.sampleDuration);
-                            }
-                            auto timeScale =
-                                mInitSegmentPropertiesMap.at(initSegmentId).initTrackInfos.at(trackId).timeScale;
-                            trackInfos.elements[outTrackIdx].frameRate =
-                                Rational{timeScale, sum / trackInfo.samples.size()};
-                        }
+        auto initSegmentIt = mInitSegmentPropertiesMap.find(initSegmentId);
+        if (initSegmentIt == mInitSegmentPropertiesMap.end())
+        {
+            return ErrorCode::INVALID_SEGMENT;
+        }
+        const InitSegmentProperties& initSegmentProperties = initSegmentIt->second;
 
-                        for (auto const& sample : trackInfo.samples)
-                        {
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].sampleId =
-                                ItemId(sample.sampleId).get();
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].sampleEntryType =
-                                FourCC(sample.sampleEntryType.getUInt32());
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].sampleDescriptionIndex =
-                                sample.sampleDescriptionIndex.get();
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].sampleType = sample.sampleType;
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].initSegmentId =
-                                segment.initSegmentId.get();
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].segmentId = segment.segmentId.get();
-                            if (sample.compositionTimes.size())
-                            {
-                                trackInfos.elements[outTrackIdx].sampleProperties[i].earliestTimestamp =
-                                    sample.compositionTimes.at(0);
-                                trackInfos.elements[outTrackIdx].sampleProperties[i].earliestTimestampTS =
-                                    sample.compositionTimesTS.at(0);
-                            }
-                            else
-                            {
-                                trackInfos.elements[outTrackIdx].sampleProperties[i].earliestTimestamp   = 0;
-                                trackInfos.elements[outTrackIdx].sampleProperties[i].earliestTimestampTS = 0;
-                            }
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].sampleFlags.flagsAsUInt =
-                                sample.sampleFlags.flagsAsUInt;
-                            trackInfos.elements[outTrackIdx].sampleProperties[i].sampleDurationTS =
-                                sample.sampleDuration;
+        auto segmentIt = initSegmentProperties.segmentPropertiesMap.find(segmentId);
+        if (segmentIt == initSegmentProperties.segmentPropertiesMap.end())
+        {
+            return ErrorCode::INVALID_SEGMENT;
+        }
+        const SegmentProperties& segment = segmentIt->second;
 
-                            unsigned int sampleSize = sample.dataLength;
-                            if (sampleSize > trackInfos.elements[outTrackIdx].maxSampleSize)
-                            {
-                                trackInfos.elements[outTrackIdx].maxSampleSize = sampleSize;
-                            }
-                            i++;
-                        }
-                        sampleOffset[outTrackIdx] = i;
-                    }
-                    ++outTrackIdx;
-                }
+        // only the tracks that have samples in this segment are reported
+        size_t trackCount = 0;
+        for (auto const& trackPropsKv : initSegmentProperties.trackProperties)
+        {
+            auto segTrackInfo = segment.trackInfos.find(trackPropsKv.first);
+            if (segTrackInfo != segment.trackInfos.end() && segTrackInfo->second.samples.size())
+            {
+                ++trackCount;
+            }
+        }
+
+        trackInfos          = DynArray<TrackInformation>(trackCount);
+        uint32_t outTrackIdx = 0;
+        for (auto const& trackPropsKv : initSegmentProperties.trackProperties)
+        {
+            ContextId trackId = trackPropsKv.first;
+            auto segTrackInfo = segment.trackInfos.find(trackId);
+            if (segTrackInfo == segment.trackInfos.end() || !segTrackInfo->second.samples.size())
+            {
+                continue;
             }
 
-            outTrackIdxBase += static_cast<uint32_t>(initSegment.second.initTrackInfos.size());
+            TrackInformation& trackInfo = trackInfos.elements[outTrackIdx];
+            fillTrackInformation(initSegmentIt->first, trackId, trackPropsKv.second, trackInfo);
+            trackInfo.sampleProperties = DynArray<SampleInformation>(segTrackInfo->second.samples.size());
+            fillSegmentSampleInformation(segment, trackId, trackInfo, 0);
+            ++outTrackIdx;
         }
 
-        // V2: fill in also the SampleInformation::segmentId
         return ErrorCode::OK;
     }
 
@@ -1549,6 +1606,63 @@ namespace MP4VR
         return ErrorCode::OK;
     }
 
+    int32_t MP4VRFileReaderImpl::getSegmentTrackTimestamps(uint32_t trackId,
+                                                           uint32_t segmentId,
+                                                           DynArray<TimestampIDPair>& timestamps) const
+    {
+        if (isInitializedError())
+        {
+            return ErrorCode::UNINITIALIZED;
+        }
+
+        InitSegmentTrackId initSegTrackId = ofTrackId(trackId);
+        InitSegmentId initSegmentId       = initSegTrackId.first;
+
+        ContextType contextType;
+        int error = getContextTypeError(initSegTrackId, contextType);
+        if (error)
+        {
+            return error;
+        }
+        if (contextType != ContextType::TRACK)
+        {
+            // meta contexts are not delivered in media segments
+            return ErrorCode::INVALID_CONTEXT_ID;
+        }
+
+        const auto& segmentPropertiesMap = mInitSegmentPropertiesMap.at(initSegmentId).segmentPropertiesMap;
+        auto segmentIt                   = segmentPropertiesMap.find(segmentId);
+        if (segmentIt == segmentPropertiesMap.end())
+        {
+            return ErrorCode::INVALID_SEGMENT;
+        }
+
+        WriteOnceMap<Timestamp, ItemId> timestampMap;
+        SegmentTrackId segTrackId = std::make_pair(segmentIt->first, initSegTrackId.second);
+        if (hasTrackInfo(initSegmentId, segTrackId))
+        {
+            for (const auto& sampleInfo : getTrackInfo(initSegmentId, segTrackId).samples)
+            {
+                for (auto compositionTime : sampleInfo.compositionTimes)
+                {
+                    timestampMap.insert(std::make_pair(compositionTime, sampleInfo.sampleId));
+                }
+            }
+        }
+
+        timestamps = DynArray<TimestampIDPair>(timestampMap.size());
+        uint32_t i = 0;
+        for (auto const& entry : timestampMap)
+        {
+            TimestampIDPair pair;
+            pair.timeStamp           = entry.first;
+            pair.itemId              = entry.second.get();
+            timestamps.elements[i++] = pair;
+        }
+
+        return ErrorCode::OK;
+    }
+
 
     int32_t MP4VRFileReaderImpl::getTimestampsOfSample(uint32_t trackId,
                                                        uint32_t itemIdApi,
@@ -15,6 +15,7 @@
 #include "mp4vrfilereaderimpl.hpp"
 
 #include <limits.h>
+#include <sys/stat.h>
 
 #include <algorithm>
 #include <bitset>
@@ -139,11 +140,19 @@ namespace MP4VR
         CUSTOM_DELETE(mp4vrinterface, MP4VRFileReaderInterface);
     }
 
+    void MP4VRFileReaderImpl::setIndexCacheDirectory(const char* directory)
+    {
+        mIndexCacheDirectory = directory ? directory : "";
+    }
+
     int32_t MP4VRFileReaderImpl::initialize(const char* fileName)
     {
         int32_t rc;
+        struct stat fileStatus;
+        mFileModificationTime = stat(fileName, &fileStatus) == 0 ? std::int64_t(fileStatus.st_mtime) : 0;
         mFileStream.reset(openFile(fileName));
-        rc = initialize(&*mFileStream);
+        rc                    = initialize(&*mFileStream);
+        mFileModificationTime = 0;
         if (rc != ErrorCode::OK)
         {
             mFileStream.reset();
@@ -190,6 +199,7 @@ namespace MP4VR
 
     MP4VRFileReaderImpl::MP4VRFileReaderImpl()
         : mState(State::UNINITIALIZED)
+        , mFileModificationTime(0)
     {
     }
 
@@ -1141,6 +1151,11 @@ namespace MP4VR
 
         bool ftypFound = false;
         bool moovFound = false;
+        bool moofFound = false;
+
+        // The index cache only covers files whose samples are all described in 'moov'
+        IndexCacheKey indexCacheKey;
+        bool indexCacheHit = false;
 
         int32_t error = ErrorCode::OK;
         if (io.stream->peekEof())
@@ -1219,6 +1234,18 @@ namespace MP4VR
                 iterateError = readBox(io, bitstream);
                 if (!*iterateError)
                 {
+                    mIndexCacheTracks.clear();
+                    if (mIndexCacheDirectory.size())
+                    {
+                        const Vector<std::uint8_t>& moovData = bitstream.getStorage();
+                        indexCacheKey.fileSize               = static_cast<std::uint64_t>(io.size);
+                        indexCacheKey.modificationTime       = mFileModificationTime;
+                        indexCacheKey.moovHash               = indexCacheHash(moovData.data(), moovData.size());
+
+                        const String path = indexCachePath(mIndexCacheDirectory, indexCacheKey);
+                        indexCacheHit     = loadIndexCache(path, indexCacheKey, mIndexCacheTracks);
+                    }
+
                     MovieBox moov;
                     moov.parseBox(bitstream);
                     mInitSegmentPropertiesMap[initSegmentId].moovProperties = extractMoovProperties(moov);
@@ -1229,10 +1256,13 @@ namespace MP4VR
                     mInitSegmentPropertiesMap[initSegmentId].movieTimeScale = moov.getMovieHeaderBox().getTimeScale();
                     addSegmentSequence(initSegmentId, segmentId, 0);
                     mMatrix = moov.getMovieHeaderBox().getMatrix();
+                    mIndexCacheTracks.clear();
                 }
             }
             else if (boxType == "moof")
             {
+                moofFound = true;
+
                 // we need to save moof start byte for possible trun dataoffset depending on its flags.
                 const StreamInterface::offset_t moofFirstByte = io.stream->tell();
 
@@ -1313,6 +1343,14 @@ namespace MP4VR
             io.stream->clear();
             mInitSegmentPropertiesMap[initSegmentId].fileFeature = getFileFeatures();
             mState                                               = State::READY;
+
+            if (mIndexCacheDirectory.size() && !indexCacheHit && !moofFound)
+            {
+                const SegmentProperties& segmentProperties =
+                    mInitSegmentPropertiesMap.at(initSegmentId).segmentPropertiesMap.at(segmentId);
+                storeIndexCache(indexCachePath(mIndexCacheDirectory, indexCacheKey), indexCacheKey,
+                                segmentProperties.trackInfos);
+            }
         }
         else
         {
@@ -1789,8 +1827,10 @@ namespace MP4VR
         for (auto trackBox : trackBoxes)
         {
             TrackProperties trackProperties;
+            auto cachedTrack  = mIndexCacheTracks.find(ContextId(trackBox->getTrackHeaderBox().getTrackID()));
+            const bool cached = cachedTrack != mIndexCacheTracks.end();
             std::pair<InitTrackInfo, TrackInfo> initAndTrackInfo =
-                extractTrackInfo(trackBox, moovBox.getMovieHeaderBox().getTimeScale());
+                extractTrackInfo(trackBox, moovBox.getMovieHeaderBox().getTimeScale(), !cached);
             InitTrackInfo& initTrackInfo = initAndTrackInfo.first;
             TrackInfo& trackInfo         = initAndTrackInfo.second;
 
@@ -1807,7 +1847,18 @@ namespace MP4VR
                 InitSegmentTrackId initSegTrackId = std::make_pair(initSegmentId, contextId);
                 SegmentTrackId segTrackId         = std::make_pair(segmentId, contextId);
 
-                trackInfo.samples           = makeSampleInfoVector(trackBox);
+                if (cached)
+                {
+                    // Composition times are already applied to the cached samples, so the presentation maps are
+                    // left empty and updateCompositionTimes passes the track by
+                    trackInfo.samples     = std::move(cachedTrack->second.samples);
+                    trackInfo.durationTS  = cachedTrack->second.durationTS;
+                    trackInfo.hasEditList = cachedTrack->second.hasEditList;
+                }
+                else
+                {
+                    trackInfo.samples = makeSampleInfoVector(trackBox);
+                }
                 auto& initSegmentProperties = mInitSegmentPropertiesMap.at(initSegmentId);
                 updateItemToParametersSetMap(
                     initSegmentProperties.segmentPropertiesMap[segmentId].itemToParameterSetMap, initSegTrackId,
@@ -2337,7 +2388,8 @@ namespace MP4VR
     }
 
     std::pair<InitTrackInfo, TrackInfo> MP4VRFileReaderImpl::extractTrackInfo(TrackBox* trackBox,
-                                                                              uint32_t movieTimescale) const
+                                                                              uint32_t movieTimescale,
+                                                                              bool extractTiming) const
     {
         InitTrackInfo initTrackInfo;
         TrackInfo trackInfo;
@@ -2384,25 +2436,28 @@ namespace MP4VR
 
         initTrackInfo.timeScale = mdhdBox.getTimeScale();  // The number of time units that pass in a second
 
-        std::shared_ptr<const EditBox> editBox = trackBox->getEditBox();
-        DecodePts decodePts;
-        decodePts.loadBox(&timeToSampleBox);
-        decodePts.loadBox(compositionOffsetBox.get());
-        if (editBox)
+        if (extractTiming)
         {
-            trackInfo.hasEditList          = true;
-            const EditListBox* editListBox = editBox->getEditListBox();
-            decodePts.loadBox(editListBox, movieTimescale, mdhdBox.getTimeScale());
-        }
-        if (!decodePts.unravel())
-        {
-            throw FileReaderException(ErrorCode::FILE_HEADER_ERROR);
-        }
+            std::shared_ptr<const EditBox> editBox = trackBox->getEditBox();
+            DecodePts decodePts;
+            decodePts.loadBox(&timeToSampleBox);
+            decodePts.loadBox(compositionOffsetBox.get());
+            if (editBox)
+            {
+                trackInfo.hasEditList          = true;
+                const EditListBox* editListBox = editBox->getEditListBox();
+                decodePts.loadBox(editListBox, movieTimescale, mdhdBox.getTimeScale());
+            }
+            if (!decodePts.unravel())
+            {
+                throw FileReaderException(ErrorCode::FILE_HEADER_ERROR);
+            }
 
-        // Always generate track duration regardless of the informatoin in the header
-        trackInfo.durationTS = DecodePts::PresentationTimeTS(decodePts.getSpan());
-        trackInfo.pMap       = decodePts.getTime(initTrackInfo.timeScale);
-        trackInfo.pMapTS     = decodePts.getTimeTS();
+            // Always generate track duration regardless of the informatoin in the header
+            trackInfo.durationTS = DecodePts::PresentationTimeTS(decodePts.getSpan());
+            trackInfo.pMap       = decodePts.getTime(initTrackInfo.timeScale);
+            trackInfo.pMapTS     = decodePts.getTimeTS();
+        }
 
         // Read track type if exists
         if (trackBox->getHasTrackTypeBox())
@@ -34,6 +34,7 @@
 #include "moviebox.hpp"
 #include "moviefragmentbox.hpp"
 #include "mp4vrfiledatatypesinternal.hpp"
+#include "mp4vrfileindexcache.hpp"
 #include "mp4vrfilesegment.hpp"
 #include "mp4vrfilestreamgeneric.hpp"
 #include "mp4vrfilestreaminternal.hpp"
@@ -116,6 +117,9 @@ namespace MP4VR
         };
 
     public:  // From MP4VRFileReaderInterface
+        /// @see MP4VRFileReaderInterface::setIndexCacheDirectory()
+        void setIndexCacheDirectory(const char* directory) override;
+
         /// @see MP4VRFileReaderInterface::initialize()
         int32_t initialize(const char* fileName) override;
 
@@ -148,6 +152,11 @@ namespace MP4VR
         /// @see MP4VRFileReaderInterface::getTrackProperties()
         int32_t getTrackInformations(DynArray<TrackInformation>& trackInfos) const override;
 
+        /// @see MP4VRFileReaderInterface::getSegmentTrackInformations()
+        int32_t getSegmentTrackInformations(uint32_t initSegmentId,
+                                            uint32_t segmentId,
+                                            DynArray<TrackInformation>& trackInfos) const override;
+
         /// @see MP4VRFileReaderInterface::getDisplayWidth()
         int32_t getDisplayWidth(uint32_t trackId, uint32_t& displayWidth) const override;
 
@@ -198,6 +207,11 @@ namespace MP4VR
         /// @see MP4VRFileReaderInterface::getItemTimestamps()
         int32_t getTrackTimestamps(uint32_t trackId, DynArray<TimestampIDPair>& timestamps) const override;
 
+        /// @see MP4VRFileReaderInterface::getSegmentTrackTimestamps()
+        int32_t getSegmentTrackTimestamps(uint32_t trackId,
+                                          uint32_t segmentId,
+                                          DynArray<TimestampIDPair>& timestamps) const override;
+
         /// @see MP4VRFileReaderInterface::getTimestampsOfItem()
         int32_t getTimestampsOfSample(uint32_t trackId, uint32_t itemId, DynArray<uint64_t>& timestamps) const override;
 
@@ -374,6 +388,10 @@ namespace MP4VR
         };
         Map<InitSegmentTrackId, ContextInfo> mContextInfoMap;
 
+        String mIndexCacheDirectory;         ///< Empty when the index cache is disabled
+        std::int64_t mFileModificationTime;  ///< Of the file given to initialize(const char*), otherwise 0
+        IndexCacheTracks mIndexCacheTracks;  ///< Sample tables loaded from the cache, consumed by fillTrackProperties
+
         friend class Segments;
         friend class ConstSegments;
 
@@ -400,6 +418,21 @@ namespace MP4VR
          * @return ErrorCode::INVALID_CONTEXT_ID or ErrorCode::NO_ERROR. */
         int getContextTypeError(const InitSegmentTrackId id, ContextType& contextType) const;
 
+        /** Fill the track level fields of TrackInformation (ids, features, references, groups) for a track of an
+         *  initialization segment. Sample information is left for fillSegmentSampleInformation(). */
+        void fillTrackInformation(InitSegmentId initSegmentId,
+                                  ContextId trackId,
+                                  const TrackProperties& trackProperties,
+                                  TrackInformation& trackInfo) const;
+
+        /** Write the samples a segment has for a track to trackInfo.sampleProperties, starting from sampleIndex.
+         *  sampleProperties must already be large enough. Updates also maxSampleSize, frameRate and type.
+         *  @return The index following the last written sample */
+        size_t fillSegmentSampleInformation(const SegmentProperties& segment,
+                                            ContextId trackId,
+                                            TrackInformation& trackInfo,
+                                            size_t sampleIndex) const;
+
         /** Parse input stream, fill mFileProperties and implementation internal data structures. */
         int32_t readStream(InitSegmentId initSegmentId, SegmentId segmentId);
 
@@ -725,8 +758,12 @@ namespace MP4VR
         /**
          * @brief Extract reader internal TrackInfo structure from TrackBox
          * @param [in] trackBox TrackBox to extract data from
+         * @param [in] extractTiming If false, the presentation maps and the duration are left for the caller to
+         *                           fill, as they are when the sample table comes from the index cache
          * @return Filled TrackInfo struct */
-        std::pair<InitTrackInfo, TrackInfo> extractTrackInfo(TrackBox* trackBox, uint32_t movieTimescale) const;
+        std::pair<InitTrackInfo, TrackInfo> extractTrackInfo(TrackBox* trackBox,
+                                                             uint32_t movieTimescale,
+                                                             bool extractTiming = true) const;
 
         /**
          * @brief Extract reader internal information about samples
@@ -95,7 +95,7 @@ namespace StreamSegmenter
 
             void flush(BitStream& aBs, std::ostream& aOut)
             {
-                auto data = aBs.getStorage();
+                const auto& data = aBs.getStorage();
                 aOut.write(reinterpret_cast<const char*>(&data[0]), std::streamsize(data.size()));
                 aBs.clear();
             }
@@ -299,7 +299,7 @@ namespace StreamSegmenter
 
             BitStream bs;
             moof.writeBox(bs);
-            auto data = bs.getStorage();
+            const auto& data = bs.getStorage();
             aOut.write(reinterpret_cast<const char*>(&data[0]), std::streamsize(data.size()));
         }
 
@@ -533,7 +533,7 @@ namespace StreamSegmenter
 
             aInitSegment.moov->movieBox->writeBox(stream);
 
-            auto data = stream.getStorage();
+            const auto& data = stream.getStorage();
             aOut.write(reinterpret_cast<const char*>(&data[0]), std::streamsize(data.size()));
         }
 
@@ -1022,72 +1022,143 @@ namespace StreamSegmenter
             return Utils::make_unique<SampleEntryBox>(Utils::static_cast_unique_ptr<::SampleEntryBox>(std::move(box)));
         }
 
+        namespace
+        {
+            // extractor NAL unit length prefix size; HevcDecoderConfigurationRecord.mLengthSizeMinus1 == 3
+            const std::size_t extractorLengthSize = 4;
+            // extractor NAL unit header size
+            const std::size_t extractorHeaderSize = 2;
+
+            std::uint8_t* write32(std::uint8_t* aDst, std::uint32_t aValue)
+            {
+                aDst[0] = std::uint8_t((aValue >> 24) & 0xff);
+                aDst[1] = std::uint8_t((aValue >> 16) & 0xff);
+                aDst[2] = std::uint8_t((aValue >> 8) & 0xff);
+                aDst[3] = std::uint8_t((aValue >> 0) & 0xff);
+                return aDst + 4;
+            }
+        }  // anonymous namespace
+
         FrameData StreamSegmenter::Segmenter::HevcExtractorSampleConstructor::toFrameData() const
         {
-            BitStream sampleStream;
+            FrameData data(getSize());
+            write(data.data());
+            return data;
+        }
+
+        std::size_t StreamSegmenter::Segmenter::HevcExtractorSampleConstructor::getSize() const
+        {
+            return 1 + 1 + 4 + 4;
+        }
 
+        std::uint8_t* StreamSegmenter::Segmenter::HevcExtractorSampleConstructor::write(std::uint8_t* aDst) const
+        {
             // unsigned int(8) track_ref_index;
             // signed int(8) sample_offset;
             // unsigned int((lengthSizeMinusOne + 1) * 8) data_offset;
             // unsigned int((lengthSizeMinusOne + 1) * 8) data_length;
 
-            sampleStream.write8Bits(static_cast<uint8_t>(trackId));
-            sampleStream.write8Bits(static_cast<uint8_t>(sampleOffset));
+            *aDst++ = static_cast<uint8_t>(trackId);
+            *aDst++ = static_cast<uint8_t>(sampleOffset);
 
             // @note HevcDecoderConfigurationRecord.lengthSizeMinusOne is 3 so this should be correct
             //       but to be completely compatible, code should decide if it needs to write 1,2 or 4 bytes
             //       depending on HevcDecoderConfigurationRecord.lengthSizeMinusOne
-            sampleStream.write32Bits(dataOffset);
-            sampleStream.write32Bits(dataLength);
-
-            return StreamSegmenter::FrameData(sampleStream.getStorage().begin(), sampleStream.getStorage().end());
+            aDst = write32(aDst, dataOffset);
+            aDst = write32(aDst, dataLength);
+            return aDst;
         }
 
         FrameData StreamSegmenter::Segmenter::HevcExtractorInlineConstructor::toFrameData() const
         {
-            FrameData data;
+            FrameData data(getSize());
+            write(data.data());
+            return data;
+        }
 
+        std::size_t StreamSegmenter::Segmenter::HevcExtractorInlineConstructor::getSize() const
+        {
+            return 1 + inlineData.size();
+        }
+
+        std::uint8_t* StreamSegmenter::Segmenter::HevcExtractorInlineConstructor::write(std::uint8_t* aDst) const
+        {
             // unsigned int(8) length;
             // unsigned int(8) inline_data[length];
 
-            data.push_back(inlineData.size());
-            data.insert(data.end(), inlineData.begin(), inlineData.end());
-            return data;
+            *aDst++ = static_cast<uint8_t>(inlineData.size());
+            return std::copy(inlineData.begin(), inlineData.end(), aDst);
         }
 
         FrameData StreamSegmenter::Segmenter::HevcExtractor::toFrameData() const
         {
-            FrameData sampleData;
+            FrameData data(getSize());
+            write(data.data());
+            return data;
+        }
 
+        std::size_t StreamSegmenter::Segmenter::HevcExtractor::getSize() const
+        {
             if (!sampleConstructor && !inlineConstructor)
             {
                 throw std::runtime_error("Either sampleConstruct or inlineConstruct must be set for ExtractorSample");
             }
+            std::size_t size = 0;
             if (!!inlineConstructor)
             {
-                sampleData.push_back(2);  // constructor_type 2
-                auto sampleBody = inlineConstructor->toFrameData();
-                sampleData.insert(sampleData.end(), sampleBody.begin(), sampleBody.end());
+                size += 1 + inlineConstructor->getSize();
             }
             if (!!sampleConstructor)
             {
-                sampleData.push_back(0);  // constructor_type 0 ISO/IEC FDIS 14496-15:2014(E) A.7.2
-                auto sampleBody = sampleConstructor->toFrameData();
-                sampleData.insert(sampleData.end(), sampleBody.begin(), sampleBody.end());
+                size += 1 + sampleConstructor->getSize();
             }
+            return size;
+        }
 
-            return sampleData;
+        std::uint8_t* StreamSegmenter::Segmenter::HevcExtractor::write(std::uint8_t* aDst) const
+        {
+            if (!!inlineConstructor)
+            {
+                *aDst++ = 2;  // constructor_type 2
+                aDst    = inlineConstructor->write(aDst);
+            }
+            if (!!sampleConstructor)
+            {
+                *aDst++ = 0;  // constructor_type 0 ISO/IEC FDIS 14496-15:2014(E) A.7.2
+                aDst    = sampleConstructor->write(aDst);
+            }
+            return aDst;
         }
 
         FrameData StreamSegmenter::Segmenter::HevcExtractorTrackFrameData::toFrameData() const
         {
             FrameData completeFrame;
+            appendTo(completeFrame);
+            return completeFrame;
+        }
 
-            // reserve space for size of NAL unit
-            completeFrame.push_back(0);
-            completeFrame.push_back(0);
-            completeFrame.push_back(0);
-            completeFrame.push_back(0);
+        std::size_t StreamSegmenter::Segmenter::HevcExtractorTrackFrameData::getSize() const
+        {
+            std::size_t size = extractorLengthSize + extractorHeaderSize;
+            for (auto& sample : samples)
+            {
+                size += sample.getSize();
+            }
+            return size;
+        }
+
+        void StreamSegmenter::Segmenter::HevcExtractorTrackFrameData::appendTo(FrameData& aFrameData) const
+        {
+            // the size is computed from the constructors up front, so the NAL unit is written in one pass
+            const std::size_t size  = getSize();
+            const std::size_t begin = aFrameData.size();
+            aFrameData.resize(begin + size);
+            std::uint8_t* dst = aFrameData.data() + begin;
+
+            // Each NAL unit is preceeded by length of the NAL unit
+            // HevcDecoderConfigurationRecord.mLengthSizeMinus1 == 3 so we use 32bit field length
+            // ISO/IEC FDIS 14496-15:2014(E) 4.3.2
+            dst = write32(dst, static_cast<std::uint32_t>(size - extractorLengthSize));
 
             // NAL unit header
             // 1 bit forbidden zero bit
@@ -1102,25 +1173,13 @@ namespace StreamSegmenter
 
             std::uint16_t nalUnitHeader = forbiddenZero | nalUnitType | nuhLayerId | nuhTemporalId;
 
-            completeFrame.push_back(nalUnitHeader >> 8);
-            completeFrame.push_back(nalUnitHeader & 0xff);
+            *dst++ = static_cast<std::uint8_t>(nalUnitHeader >> 8);
+            *dst++ = static_cast<std::uint8_t>(nalUnitHeader & 0xff);
 
             for (auto& sample : samples)
             {
-                auto sampleData = sample.toFrameData();
-                completeFrame.insert(completeFrame.end(), sampleData.begin(), sampleData.end());
+                dst = sample.write(dst);
             }
-
-            // Each NAL unit is preceeded by length of the NAL unit
-            // HevcDecoderConfigurationRecord.mLengthSizeMinus1 == 3 so we use 32bit field length
-            // ISO/IEC FDIS 14496-15:2014(E) 4.3.2
-            std::uint32_t length = completeFrame.size() - 4;
-            completeFrame[0]     = (length >> 24) & 0xff;
-            completeFrame[1]     = (length >> 16) & 0xff;
-            completeFrame[2]     = (length >> 8) & 0xff;
-            completeFrame[3]     = (length >> 0) & 0xff;
-
-            return completeFrame;
         }
 
         TrackDescription::TrackDescription(TrackMeta aTrackMeta,
@@ -1790,7 +1849,7 @@ namespace StreamSegmenter
         }
         BitStream bsOut;
         sidx.writeBox(bsOut);
-        auto storage = bsOut.getStorage();
+        const auto& storage = bsOut.getStorage();
         return {storage.begin(), storage.end()};
     }
 
@@ -1841,7 +1900,7 @@ namespace StreamSegmenter
         }
         BitStream bsOut;
         sidx.writeBox(bsOut);
-        auto storage = bsOut.getStorage();
+        const auto& storage = bsOut.getStorage();
         return {storage.begin(), storage.end()};
     }
 
@@ -0,0 +1,534 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Replays recorded bandwidth traces against the bitrate ladder of a real MPD with the rate-selection policies of
+// DashBitrateContoller, without downloading or decoding anything. The controller itself makes the decisions, with
+// simulated time, throughput, download speed and buffer level in place of the downloader and the monitors. Segments
+// are downloaded back to back; the playback buffer drains in real time and downloading pauses while the buffer is
+// above the target.
+//
+// The ladder is taken from the video adaptation sets with the most representations: rung n is the sum of the n:th
+// lowest bandwidth of each, ie. the whole picture at one quality. With tiles, --foreground-share is the share of the
+// tiles that follow the selected quality, like the viewport and margin tiles in the player.
+//
+// A trace is a text file with one "<duration in ms> <throughput in kbps>" pair per line; lines starting with # are
+// ignored. The simulation ends when the trace ends.
+//
+// Reported per policy: mean bitrate, number of switches, rebuffering time, and the mean time it takes to reach the
+// highest sustainable quality after the bandwidth goes up ("recovery").
+//
+// Usage: AbrSimulator <mpd> <trace> [--policy legacy|harmonic|bola|all] [--buffer-ms N] [--segment-ms N]
+//                     [--foreground-share F] [--log]
+
+#include "DashProvider/NVRDashAbrPolicy.h"
+#include "DashProvider/NVRDashBitrateController.h"
+#include "Foundation/NVRMemorySystem.h"
+#include "Foundation/NVRNew.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+OMAF_NS_BEGIN
+
+struct TracePoint
+{
+    uint32_t durationMs;
+    float64_t bps;
+};
+
+struct Ladder
+{
+    std::vector<uint32_t> bitrates;
+    uint32_t segmentDurationMs;
+};
+
+static bool_t readAttribute(const std::string& aElement, const char_t* aName, std::string& aValue)
+{
+    std::string key = std::string(" ") + aName + "=\"";
+    size_t start = aElement.find(key);
+    if (start == std::string::npos)
+    {
+        return false;
+    }
+    start += key.size();
+    size_t end = aElement.find('"', start);
+    if (end == std::string::npos)
+    {
+        return false;
+    }
+    aValue = aElement.substr(start, end - start);
+    return true;
+}
+
+// Not a general XML parser; enough for the MPDs written by the creator and most others
+static bool_t readLadder(const char_t* aFilename, Ladder& aLadder)
+{
+    std::ifstream file(aFilename);
+    if (!file)
+    {
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string mpd = content.str();
+
+    std::vector<std::vector<uint32_t>> adaptationSets;
+    bool_t inVideoSet = false;
+    uint32_t segmentDurationMs = 0;
+    for (size_t pos = mpd.find('<'); pos != std::string::npos; pos = mpd.find('<', pos + 1))
+    {
+        size_t end = mpd.find('>', pos);
+        if (end == std::string::npos)
+        {
+            break;
+        }
+        std::string element = mpd.substr(pos, end - pos);
+        std::string value;
+        if (element.compare(0, 14, "<AdaptationSet") == 0)
+        {
+            // the mime type may also be given in the representations
+            inVideoSet = !readAttribute(element, "mimeType", value) || value.find("video") == 0;
+            adaptationSets.push_back(std::vector<uint32_t>());
+        }
+        else if (element.compare(0, 15, "<Representation") == 0 && inVideoSet && !adaptationSets.empty())
+        {
+            if (readAttribute(element, "mimeType", value) && value.find("video") != 0)
+            {
+                continue;
+            }
+            if (readAttribute(element, "bandwidth", value))
+            {
+                adaptationSets.back().push_back((uint32_t) strtoul(value.c_str(), OMAF_NULL, 10));
+            }
+        }
+        else if (element.compare(0, 16, "<SegmentTemplate") == 0 && segmentDurationMs == 0)
+        {
+            std::string timescale = "1";
+            readAttribute(element, "timescale", timescale);
+            if (readAttribute(element, "duration", value))
+            {
+                segmentDurationMs =
+                    (uint32_t)(strtoull(value.c_str(), OMAF_NULL, 10) * 1000 / strtoull(timescale.c_str(), OMAF_NULL, 10));
+            }
+        }
+    }
+
+    size_t rungs = 0;
+    for (size_t i = 0; i < adaptationSets.size(); i++)
+    {
+        rungs = adaptationSets[i].size() > rungs ? adaptationSets[i].size() : rungs;
+    }
+    aLadder.bitrates.assign(rungs, 0);
+    for (size_t i = 0; i < adaptationSets.size(); i++)
+    {
+        std::vector<uint32_t>& bitrates = adaptationSets[i];
+        if (bitrates.size() != rungs)
+        {
+            continue;
+        }
+        std::sort(bitrates.begin(), bitrates.end());
+        for (size_t n = 0; n < rungs; n++)
+        {
+            aLadder.bitrates[n] += bitrates[n];
+        }
+    }
+    if (aLadder.segmentDurationMs == 0)
+    {
+        aLadder.segmentDurationMs = segmentDurationMs;
+    }
+    return rungs > 0;
+}
+
+static bool_t readTrace(const char_t* aFilename, std::vector<TracePoint>& aTrace)
+{
+    std::ifstream file(aFilename);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::istringstream fields(line);
+        TracePoint point;
+        float64_t kbps = 0.0;
+        if (fields >> point.durationMs >> kbps && point.durationMs > 0)
+        {
+            point.bps = kbps * 1000.0;
+            aTrace.push_back(point);
+        }
+    }
+    return !aTrace.empty();
+}
+
+// DashBitrateContoller fed by the simulation instead of a video downloader; the simulation sets the public members
+// before each update
+class SimulatedBitrateController : public DashBitrateContoller
+{
+public:
+    SimulatedBitrateController(const Ladder& aLadder, float32_t aForegroundShare)
+        : nowMs(0)
+        , throughput(0)
+        , downloadSpeed(0.f)
+        , bufferLevelMs(0)
+        , bufferTargetMs(0)
+        , segmentDurationMs(aLadder.segmentDurationMs)
+    {
+        Bitrates bitrates;
+        for (size_t i = 0; i < aLadder.bitrates.size() && i < bitrates.getCapacity(); i++)
+        {
+            bitrates.add(aLadder.bitrates[i]);
+        }
+        mForegroundShare = aForegroundShare;
+        initializeBitrates(bitrates, true);
+    }
+
+    size_t getBitrateIndex() const
+    {
+        return (size_t) mCurrentBitrateIndex;
+    }
+
+    uint32_t nowMs;
+    uint32_t throughput;
+    float32_t downloadSpeed;
+    uint32_t bufferLevelMs;
+    uint32_t bufferTargetMs;
+    uint32_t segmentDurationMs;
+
+protected:
+    virtual uint32_t getClockTimeMs() const
+    {
+        return nowMs;
+    }
+
+    virtual void_t readAbrInput(AbrInput& aInput, uint32_t aBandwidthOverhead)
+    {
+        aInput.throughput = throughput;
+        aInput.downloadSpeed = downloadSpeed;
+        aInput.bufferLevelMs = bufferLevelMs;
+        aInput.bufferTargetMs = bufferTargetMs;
+        aInput.segmentDurationMs = segmentDurationMs;
+    }
+
+    virtual bool_t canSwitch()
+    {
+        // segments are downloaded one at a time, so a switch never waits for one in progress
+        return true;
+    }
+
+    virtual void_t doUpdate()
+    {
+        mIssueCount = 0;
+    }
+
+    virtual void_t increaseCache()
+    {
+    }
+};
+
+class Trace
+{
+public:
+    Trace(const std::vector<TracePoint>& aPoints)
+        : mPoints(aPoints)
+        , mIndex(0)
+        , mOffsetMs(0.0)
+    {
+    }
+
+    bool_t atEnd() const
+    {
+        return mIndex >= mPoints.size();
+    }
+
+    float64_t currentBps() const
+    {
+        return atEnd() ? 0.0 : mPoints[mIndex].bps;
+    }
+
+    // Download aBits; returns the time taken, or a negative value if the trace ended first
+    float64_t download(float64_t aBits)
+    {
+        float64_t elapsedMs = 0.0;
+        while (!atEnd())
+        {
+            float64_t leftMs = mPoints[mIndex].durationMs - mOffsetMs;
+            float64_t bitsLeft = mPoints[mIndex].bps * leftMs / 1000.0;
+            if (bitsLeft >= aBits && mPoints[mIndex].bps > 0.0)
+            {
+                float64_t takesMs = aBits * 1000.0 / mPoints[mIndex].bps;
+                mOffsetMs += takesMs;
+                return elapsedMs + takesMs;
+            }
+            aBits -= bitsLeft;
+            elapsedMs += leftMs;
+            advance();
+        }
+        return -1.0;
+    }
+
+    void_t wait(float64_t aMs)
+    {
+        while (!atEnd() && aMs > 0.0)
+        {
+            float64_t leftMs = mPoints[mIndex].durationMs - mOffsetMs;
+            if (leftMs > aMs)
+            {
+                mOffsetMs += aMs;
+                return;
+            }
+            aMs -= leftMs;
+            advance();
+        }
+    }
+
+private:
+    void_t advance()
+    {
+        mIndex++;
+        mOffsetMs = 0.0;
+    }
+
+    const std::vector<TracePoint>& mPoints;
+    size_t mIndex;
+    float64_t mOffsetMs;
+};
+
+struct Result
+{
+    float64_t meanBitrate;
+    uint32_t switches;
+    float64_t rebufferMs;
+    float64_t meanRecoveryMs;
+    uint32_t recoveries;
+    uint32_t segments;
+};
+
+static Result simulate(AbrPolicyType::Enum aType,
+                       const Ladder& aLadder,
+                       const std::vector<TracePoint>& aPoints,
+                       uint32_t aBufferTargetMs,
+                       float32_t aForegroundShare,
+                       bool_t aLog)
+{
+    SimulatedBitrateController controller(aLadder, aForegroundShare);
+    controller.setAbrPolicy(aType);
+    controller.bufferTargetMs = aBufferTargetMs;
+    Trace trace(aPoints);
+
+    // for the bandwidth a bitrate index needs, as the policies count it
+
+    AbrInput input;
+    input.bitrates = aLadder.bitrates.data();
+    input.nrBitrates = aLadder.bitrates.size();
+    input.currentIndex = 0;
+    input.foregroundShare = aForegroundShare;
+
+    Result result = {};
+    float64_t nowMs = 0.0;
+    float64_t bufferMs = 0.0;
+    float64_t bitrateSum = 0.0;
+    bool_t playing = false;
+
+    // the index reachable with the current bandwidth, and since when, while the selected one is below it
+    size_t recoveryTarget = 0;
+    float64_t recoveryStartMs = -1.0;
+    float64_t recoverySumMs = 0.0;
+
+    while (!trace.atEnd())
+    {
+        controller.nowMs = (uint32_t) nowMs;
+        controller.bufferLevelMs = (uint32_t) bufferMs;
+        controller.update(0);
+        size_t index = controller.getBitrateIndex();
+        if (index != input.currentIndex)
+        {
+            result.switches++;
+        }
+        input.currentIndex = index;
+
+        size_t sustainable = AbrPolicy::highestSustainableIndex(input, (float32_t) trace.currentBps());
+        if (sustainable > recoveryTarget && index < sustainable)
+        {
+            recoveryTarget = sustainable;
+            recoveryStartMs = nowMs;
+        }
+        if (recoveryStartMs >= 0.0 && (index >= recoveryTarget || sustainable < recoveryTarget))
+        {
+            if (index >= recoveryTarget)
+            {
+                recoverySumMs += nowMs - recoveryStartMs;
+                result.recoveries++;
+            }
+            recoveryStartMs = -1.0;
+        }
+        recoveryTarget = recoveryStartMs >= 0.0 ? recoveryTarget : sustainable;
+
+        float64_t bits = (float64_t) AbrPolicy::requiredBandwidth(input, index) * aLadder.segmentDurationMs / 1000.0;
+        float64_t downloadMs = trace.download(bits);
+        if (downloadMs < 0.0)
+        {
+            break;
+        }
+        nowMs += downloadMs;
+        if (playing)
+        {
+            bufferMs -= downloadMs;
+            if (bufferMs < 0.0)
+            {
+                result.rebufferMs -= bufferMs;
+                bufferMs = 0.0;
+                controller.reportDownloadProblem(IssueType::BASELAYER_BUFFERING);
+            }
+        }
+        bufferMs += aLadder.segmentDurationMs;
+        playing = true;
+
+        controller.throughput = downloadMs > 0.0 ? (uint32_t)(bits * 1000.0 / downloadMs) : 0;
+        controller.downloadSpeed = downloadMs > 0.0 ? (float32_t)(aLadder.segmentDurationMs / downloadMs) : 0.f;
+        bitrateSum += aLadder.bitrates[index];
+        result.segments++;
+
+        if (aLog)
+        {
+            printf("%s %.0f ms: index %zu, download %.0f ms, throughput %u, buffer %.0f ms\n",
+                   AbrPolicy::getName(aType), nowMs, index, downloadMs, controller.throughput, bufferMs);
+        }
+
+        if (bufferMs > aBufferTargetMs)
+        {
+            float64_t idleMs = bufferMs - aBufferTargetMs;
+            trace.wait(idleMs);
+            nowMs += idleMs;
+            bufferMs = aBufferTargetMs;
+        }
+    }
+
+    result.meanBitrate = result.segments > 0 ? bitrateSum / result.segments : 0.0;
+    result.meanRecoveryMs = result.recoveries > 0 ? recoverySumMs / result.recoveries : 0.0;
+    return result;
+}
+
+static int runSimulator(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s <mpd> <trace> [--policy legacy|harmonic|bola|all] [--buffer-ms N] [--segment-ms N] "
+               "[--foreground-share F] [--log]\n",
+               argv[0]);
+        return 1;
+    }
+
+    std::vector<AbrPolicyType::Enum> types;
+    uint32_t bufferTargetMs = 8000;
+    float32_t foregroundShare = 1.f;
+    bool_t log = false;
+    Ladder ladder;
+    ladder.segmentDurationMs = 0;
+    for (int i = 3; i < argc; i++)
+    {
+        const char_t* arg = argv[i];
+        const char_t* value = i + 1 < argc ? argv[i + 1] : "";
+        if (strcmp(arg, "--policy") == 0)
+        {
+            for (int type = 0; type < AbrPolicyType::COUNT; type++)
+            {
+                if (strcmp(value, "all") == 0 || strcmp(value, AbrPolicy::getName((AbrPolicyType::Enum) type)) == 0)
+                {
+                    types.push_back((AbrPolicyType::Enum) type);
+                }
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--buffer-ms") == 0)
+        {
+            bufferTargetMs = (uint32_t) atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--segment-ms") == 0)
+        {
+            ladder.segmentDurationMs = (uint32_t) atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--foreground-share") == 0)
+        {
+            foregroundShare = (float32_t) atof(value);
+            i++;
+        }
+        else if (strcmp(arg, "--log") == 0)
+        {
+            log = true;
+        }
+        else
+        {
+            printf("Unknown option %s\n", arg);
+            return 1;
+        }
+    }
+    if (types.empty())
+    {
+        for (int type = 0; type < AbrPolicyType::COUNT; type++)
+        {
+            types.push_back((AbrPolicyType::Enum) type);
+        }
+    }
+
+    if (!readLadder(argv[1], ladder) || ladder.segmentDurationMs == 0)
+    {
+        printf("Could not read the bitrates and the segment duration from %s (use --segment-ms if needed)\n", argv[1]);
+        return 1;
+    }
+    std::vector<TracePoint> trace;
+    if (!readTrace(argv[2], trace))
+    {
+        printf("Could not read trace %s\n", argv[2]);
+        return 1;
+    }
+
+    printf("Ladder (bps):");
+    for (size_t i = 0; i < ladder.bitrates.size(); i++)
+    {
+        printf(" %u", ladder.bitrates[i]);
+    }
+    printf("\nSegment %u ms, buffer target %u ms, foreground share %.2f\n", ladder.segmentDurationMs,
+           bufferTargetMs, foregroundShare);
+
+    printf("%-10s %14s %9s %13s %13s %9s\n", "policy", "mean bitrate", "switches", "rebuffer ms", "recovery ms",
+           "segments");
+    for (size_t i = 0; i < types.size(); i++)
+    {
+        Result result = simulate(types[i], ladder, trace, bufferTargetMs, foregroundShare, log);
+        printf("%-10s %14.0f %9u %13.0f %13.0f %9u\n", AbrPolicy::getName(types[i]), result.meanBitrate,
+               result.switches, result.rebufferMs, result.meanRecoveryMs, result.segments);
+    }
+    return 0;
+}
+
+OMAF_NS_END
+
+int main(int argc, char** argv)
+{
+    OMAF::Private::MemorySystem::Create();
+    int result = OMAF::Private::runSimulator(argc, argv);
+    OMAF::Private::MemorySystem::Destroy();
+    return result;
+}
@@ -0,0 +1,144 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Fetches a set of segment urls from an HTTP server, e.g. a loopback server serving a Creator generated DASH tree,
+// first with a new TCP connection per request and then with keep-alive connections shared through the connection
+// pool. Every connection runs on its own thread like the DashSegmentStreams of tiled playback do, so the requests are
+// also bounded by the per host request slots of the pool.
+//
+// Usage: HttpConnectionBenchmark <connections> <rounds> <url> [url...]
+
+#include "Foundation/NVRHttp.h"
+#include "Foundation/NVRMemorySystem.h"
+#include "Foundation/NVRNew.h"
+#include "Foundation/NVRThread.h"
+#include "Foundation/NVRTime.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+OMAF_NS_BEGIN
+
+static const uint32_t MAX_CONNECTIONS = 32;
+
+struct BenchmarkParameters
+{
+    uint32_t keepAliveMS;
+    uint32_t rounds;
+    char** urls;
+    uint32_t urlCount;
+    uint32_t failures;
+    uint64_t bytes;
+};
+
+static Thread::ReturnValue fetchUrls(const Thread& thread, void_t* userData)
+{
+    OMAF_UNUSED_VARIABLE(thread);
+
+    BenchmarkParameters* parameters = (BenchmarkParameters*) userData;
+    MemoryAllocator& allocator = *MemorySystem::DefaultHeapAllocator();
+    HttpConnection* connection = Http::createHttpConnection(allocator);
+    connection->setKeepAlive(parameters->keepAliveMS);
+    DataBuffer<uint8_t> output(allocator, 64 * 1024);
+
+    for (uint32_t round = 0; round < parameters->rounds; round++)
+    {
+        for (uint32_t i = 0; i < parameters->urlCount; i++)
+        {
+            connection->setUri(Url(parameters->urls[i]));
+            connection->get(&output);
+            connection->waitForCompletion();
+
+            const HttpRequestState& state = connection->getState();
+
+            if (state.connectionState != HttpConnectionState::COMPLETED || state.httpStatus < 200 ||
+                state.httpStatus >= 300)
+            {
+                parameters->failures++;
+            }
+            else
+            {
+                parameters->bytes += output.getSize();
+            }
+        }
+    }
+
+    OMAF_DELETE(allocator, connection);
+
+    return 0;
+}
+
+static void_t runConnections(const char_t* name,
+                             uint32_t keepAliveMS,
+                             uint32_t connections,
+                             uint32_t rounds,
+                             char** urls,
+                             uint32_t urlCount)
+{
+    Thread threads[MAX_CONNECTIONS];
+    BenchmarkParameters parameters[MAX_CONNECTIONS];
+    Thread::EntryFunction function;
+    function.bind<&fetchUrls>();
+
+    int64_t start = Time::getClockTimeUs();
+    for (uint32_t i = 0; i < connections; i++)
+    {
+        parameters[i].keepAliveMS = keepAliveMS;
+        parameters[i].rounds = rounds;
+        parameters[i].urls = urls;
+        parameters[i].urlCount = urlCount;
+        parameters[i].failures = 0;
+        parameters[i].bytes = 0;
+        threads[i].start(function, &parameters[i]);
+    }
+
+    uint32_t failures = 0;
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < connections; i++)
+    {
+        threads[i].join();
+        failures += parameters[i].failures;
+        bytes += parameters[i].bytes;
+    }
+    int64_t elapsedUs = Time::getClockTimeUs() - start;
+
+    uint32_t requests = connections * rounds * urlCount;
+    printf("%-10s %6u requests, %4u failed, %10llu bytes, %8.1f ms, %7.3f ms/request\n", name, requests, failures,
+           (unsigned long long) bytes, elapsedUs / 1000.0, elapsedUs / 1000.0 / requests);
+}
+
+static int runBenchmark(uint32_t aConnections, uint32_t aRounds, char** aUrls, uint32_t aUrlCount)
+{
+    runConnections("close", 0, aConnections, aRounds, aUrls, aUrlCount);
+    runConnections("keep-alive", 30000, aConnections, aRounds, aUrls, aUrlCount);
+    return 0;
+}
+
+OMAF_NS_END
+
+int main(int argc, char** argv)
+{
+    uint32_t connections = argc > 1 ? (uint32_t) atoi(argv[1]) : 0;
+    uint32_t rounds = argc > 2 ? (uint32_t) atoi(argv[2]) : 0;
+    if (argc < 4 || connections == 0 || connections > OMAF::Private::MAX_CONNECTIONS || rounds == 0)
+    {
+        printf("Usage: %s <connections <= 32> <rounds> <url> [url...]\n", argv[0]);
+        return 1;
+    }
+    OMAF::Private::MemorySystem::Create();
+    int result = OMAF::Private::runBenchmark(connections, rounds, argv + 3, (uint32_t)(argc - 3));
+    OMAF::Private::MemorySystem::Destroy();
+    return result;
+}
@@ -0,0 +1,150 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Compares the default heap allocator with the per-thread scratch allocator for the allocation pattern of the parser,
+// VAS and downloader threads: bursts of small, short-lived allocations per segment. Every thread allocates a burst of
+// blocks, touches them and releases them; the heap frees each block, the scratch allocator is reset once per burst.
+// Configure with -DENABLE_MEMORY_TRACKING=ON to include the cost of the allocation tracking.
+//
+// Usage: MemoryAllocatorBenchmark [threads] [bursts per thread] [allocations per burst]
+
+#include "Foundation/NVRMemorySystem.h"
+#include "Foundation/NVRNew.h"
+#include "Foundation/NVRThread.h"
+#include "Foundation/NVRTime.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+OMAF_NS_BEGIN
+
+static const uint32_t MAX_THREADS = 16;
+
+struct BenchmarkParameters
+{
+    MemoryAllocator* allocator;
+    bool_t scratch;
+    uint32_t bursts;
+    uint32_t allocations;
+    uint32_t checksum;
+};
+
+static Thread::ReturnValue allocateBursts(const Thread& thread, void_t* userData)
+{
+    OMAF_UNUSED_VARIABLE(thread);
+
+    BenchmarkParameters* parameters = (BenchmarkParameters*) userData;
+    MemoryAllocator& allocator = *parameters->allocator;
+    uint8_t** blocks = OMAF_NEW_ARRAY_HEAP(uint8_t*, parameters->allocations);
+    uint32_t seed = 12345;
+    uint32_t checksum = 0;
+
+    for (uint32_t burst = 0; burst < parameters->bursts; burst++)
+    {
+        for (uint32_t i = 0; i < parameters->allocations; i++)
+        {
+            // sizes of sample info, packet and string style objects
+            seed = seed * 1103515245 + 12345;
+            size_t size = 16 + ((seed >> 16) % 240);
+            blocks[i] = (uint8_t*) allocator.Allocate(size, OMAF_DEFAULT_ALIGN);
+            blocks[i][0] = (uint8_t) i;
+            blocks[i][size - 1] = (uint8_t) burst;
+        }
+
+        for (uint32_t i = 0; i < parameters->allocations; i++)
+        {
+            checksum += blocks[i][0];
+        }
+
+        if (parameters->scratch)
+        {
+            MemorySystem::ResetScratchAllocator();
+        }
+        else
+        {
+            for (uint32_t i = 0; i < parameters->allocations; i++)
+            {
+                allocator.Free(blocks[i]);
+            }
+        }
+    }
+
+    OMAF_DELETE_ARRAY_HEAP(blocks);
+    parameters->checksum = checksum;
+
+    return 0;
+}
+
+static int64_t runThreads(MemoryAllocator* allocator,
+                          bool_t scratch,
+                          uint32_t threadCount,
+                          uint32_t bursts,
+                          uint32_t allocations)
+{
+    Thread threads[MAX_THREADS];
+    BenchmarkParameters parameters[MAX_THREADS];
+    Thread::EntryFunction function;
+    function.bind<&allocateBursts>();
+
+    int64_t start = Time::getClockTimeUs();
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        parameters[i].allocator = allocator;
+        parameters[i].scratch = scratch;
+        parameters[i].bursts = bursts;
+        parameters[i].allocations = allocations;
+        parameters[i].checksum = 0;
+        threads[i].start(function, &parameters[i]);
+    }
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        threads[i].join();
+    }
+    return Time::getClockTimeUs() - start;
+}
+
+static int runBenchmark(uint32_t aThreads, uint32_t aBursts, uint32_t aAllocations)
+{
+    uint64_t total = (uint64_t) aThreads * aBursts * aAllocations;
+
+    int64_t heapUs = runThreads(MemorySystem::DefaultHeapAllocator(), false, aThreads, aBursts, aAllocations);
+    int64_t scratchUs = runThreads(MemorySystem::DefaultScratchAllocator(), true, aThreads, aBursts, aAllocations);
+
+    printf("%u threads, %llu allocations\n", aThreads, (unsigned long long) total);
+    printf("heap:    %8.1f ms, %6.1f ns/allocation\n", heapUs / 1000.0, heapUs * 1000.0 / total);
+    printf("scratch: %8.1f ms, %6.1f ns/allocation\n", scratchUs / 1000.0, scratchUs * 1000.0 / total);
+    printf("scratch allocator arenas: %llu bytes\n",
+           (unsigned long long) MemorySystem::DefaultScratchAllocator()->TotalAllocatedSize());
+    return 0;
+}
+
+OMAF_NS_END
+
+int main(int argc, char** argv)
+{
+    uint32_t threads = argc > 1 ? (uint32_t) atoi(argv[1]) : 4;
+    uint32_t bursts = argc > 2 ? (uint32_t) atoi(argv[2]) : 2000;
+    uint32_t allocations = argc > 3 ? (uint32_t) atoi(argv[3]) : 1000;
+    if (threads == 0 || threads > OMAF::Private::MAX_THREADS || bursts == 0 || allocations == 0 ||
+        allocations > 10000)
+    {
+        printf("Usage: %s [threads <= 16] [bursts per thread] [allocations per burst <= 10000]\n", argv[0]);
+        return 1;
+    }
+    OMAF::Private::MemorySystem::Create();
+    int result = OMAF::Private::runBenchmark(threads, bursts, allocations);
+    OMAF::Private::MemorySystem::Destroy();
+    return result;
+}
@@ -0,0 +1,213 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Measures the packet handoff between a producer and a consumer thread, as between the parser and a decoder or
+// renderer: packets circulate through a filled and an empty queue. Compares the mutex protected FixedQueue that
+// MediaPacketQueue used with SpscQueue. Each side yields when the queue it waits on is empty.
+//
+// Usage: PacketQueueBenchmark [packets] [packets in circulation]
+
+#include "Foundation/NVRFixedQueue.h"
+#include "Foundation/NVRMemorySystem.h"
+#include "Foundation/NVRMutex.h"
+#include "Foundation/NVRNew.h"
+#include "Foundation/NVRSpscQueue.h"
+#include "Foundation/NVRThread.h"
+#include "Foundation/NVRTime.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+OMAF_NS_BEGIN
+
+static const size_t QUEUE_CAPACITY = 300;
+
+struct Packet
+{
+    uint32_t sequence;
+};
+
+class LockedQueue
+{
+public:
+    bool_t push(Packet* packet)
+    {
+        Mutex::ScopeLock lock(mMutex);
+        if (mQueue.getSize() == mQueue.getCapacity())
+        {
+            return false;
+        }
+        mQueue.push(packet);
+        return true;
+    }
+
+    Packet* pop()
+    {
+        Mutex::ScopeLock lock(mMutex);
+        if (mQueue.isEmpty())
+        {
+            return OMAF_NULL;
+        }
+        Packet* packet = mQueue.front();
+        mQueue.pop();
+        return packet;
+    }
+
+private:
+    Mutex mMutex;
+    FixedQueue<Packet*, QUEUE_CAPACITY> mQueue;
+};
+
+class LockFreeQueue
+{
+public:
+    bool_t push(Packet* packet)
+    {
+        return mQueue.push(packet);
+    }
+
+    Packet* pop()
+    {
+        if (mQueue.isEmpty())
+        {
+            return OMAF_NULL;
+        }
+        Packet* packet = mQueue.front();
+        mQueue.pop();
+        return packet;
+    }
+
+private:
+    SpscQueue<Packet*, QUEUE_CAPACITY> mQueue;
+};
+
+template <typename Queue>
+struct Handoff
+{
+    Queue filled;
+    Queue empty;
+    uint32_t packets;
+    uint32_t errors;
+};
+
+template <typename Queue>
+static Thread::ReturnValue produce(const Thread& thread, void_t* userData)
+{
+    OMAF_UNUSED_VARIABLE(thread);
+
+    Handoff<Queue>* handoff = (Handoff<Queue>*) userData;
+    for (uint32_t sequence = 0; sequence < handoff->packets; sequence++)
+    {
+        Packet* packet = handoff->empty.pop();
+        while (packet == OMAF_NULL)
+        {
+            Thread::yield();
+            packet = handoff->empty.pop();
+        }
+        packet->sequence = sequence;
+        handoff->filled.push(packet);
+    }
+    return 0;
+}
+
+template <typename Queue>
+static Thread::ReturnValue consume(const Thread& thread, void_t* userData)
+{
+    OMAF_UNUSED_VARIABLE(thread);
+
+    Handoff<Queue>* handoff = (Handoff<Queue>*) userData;
+    for (uint32_t sequence = 0; sequence < handoff->packets; sequence++)
+    {
+        Packet* packet = handoff->filled.pop();
+        while (packet == OMAF_NULL)
+        {
+            Thread::yield();
+            packet = handoff->filled.pop();
+        }
+        if (packet->sequence != sequence)
+        {
+            handoff->errors++;
+        }
+        handoff->empty.push(packet);
+    }
+    return 0;
+}
+
+template <typename Queue>
+static int64_t runHandoff(uint32_t aPackets, uint32_t aCirculating, uint32_t& aErrors)
+{
+    Handoff<Queue>* handoff = OMAF_NEW_HEAP(Handoff<Queue>);
+    Packet* packets = OMAF_NEW_ARRAY_HEAP(Packet, aCirculating);
+    for (uint32_t i = 0; i < aCirculating; i++)
+    {
+        handoff->empty.push(&packets[i]);
+    }
+    handoff->packets = aPackets;
+    handoff->errors = 0;
+
+    Thread producer;
+    Thread consumer;
+    Thread::EntryFunction produceFunction;
+    produceFunction.bind<&produce<Queue> >();
+    Thread::EntryFunction consumeFunction;
+    consumeFunction.bind<&consume<Queue> >();
+
+    int64_t start = Time::getClockTimeUs();
+    consumer.start(consumeFunction, handoff);
+    producer.start(produceFunction, handoff);
+    producer.join();
+    consumer.join();
+    int64_t elapsed = Time::getClockTimeUs() - start;
+
+    aErrors = handoff->errors;
+    OMAF_DELETE_ARRAY_HEAP(packets);
+    OMAF_DELETE_HEAP(handoff);
+    return elapsed;
+}
+
+static int runBenchmark(uint32_t aPackets, uint32_t aCirculating)
+{
+    uint32_t lockedErrors = 0;
+    uint32_t lockFreeErrors = 0;
+    int64_t lockedUs = runHandoff<LockedQueue>(aPackets, aCirculating, lockedErrors);
+    int64_t lockFreeUs = runHandoff<LockFreeQueue>(aPackets, aCirculating, lockFreeErrors);
+
+    printf("%u packets, %u in circulation\n", aPackets, aCirculating);
+    printf("mutex + FixedQueue: %8.1f ms, %6.1f ns/packet\n", lockedUs / 1000.0, lockedUs * 1000.0 / aPackets);
+    printf("SpscQueue:          %8.1f ms, %6.1f ns/packet\n", lockFreeUs / 1000.0, lockFreeUs * 1000.0 / aPackets);
+    if (lockedErrors != 0 || lockFreeErrors != 0)
+    {
+        printf("packets out of order: %u / %u\n", lockedErrors, lockFreeErrors);
+        return 1;
+    }
+    return 0;
+}
+
+OMAF_NS_END
+
+int main(int argc, char** argv)
+{
+    uint32_t packets = argc > 1 ? (uint32_t) atoi(argv[1]) : 2000000;
+    uint32_t circulating = argc > 2 ? (uint32_t) atoi(argv[2]) : 16;
+    if (packets == 0 || circulating == 0 || circulating > OMAF::Private::QUEUE_CAPACITY)
+    {
+        printf("Usage: %s [packets] [packets in circulation <= 300]\n", argv[0]);
+        return 1;
+    }
+    OMAF::Private::MemorySystem::Create();
+    int result = OMAF::Private::runBenchmark(packets, circulating);
+    OMAF::Private::MemorySystem::Destroy();
+    return result;
+}
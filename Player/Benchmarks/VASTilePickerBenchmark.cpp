@@ -0,0 +1,161 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Compares the direct viewport-tile intersection done by VASTilePicker with the quantized VASTileIndex lookup.
+// A synthetic equirect tile grid is searched with a deterministic pseudo-random head motion trace, and the number of
+// full searches (every tile of every row) per second is reported for both, together with the number of tiles whose
+// viewport/margin classification differs due to the quantization.
+//
+// Usage: VASTilePickerBenchmark [picks] [rows] [tiles per row]
+
+#include "Foundation/NVRMemorySystem.h"
+#include "Foundation/NVRTime.h"
+#include "VAS/NVRVASTileIndex.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+OMAF_NS_BEGIN
+
+// same as in VASTilePicker
+static const float64_t INTERSECTION_AREA_THR = 300.f;
+static const float64_t VIEWPORT_EXTENSION = 1.2f;
+
+struct HeadPosition
+{
+    float64_t longitude;
+    float64_t latitude;
+};
+
+static int runBenchmark(uint32_t aPicks, uint32_t aRows, uint32_t aTilesPerRow)
+{
+    // tile grid; the viewports must outlive the index as it only references them
+    VASTileViewport* tiles = OMAF_NEW_ARRAY_HEAP(VASTileViewport, aRows * aTilesPerRow);
+    VASTileIndex index;
+    index.reset(VASTileType::EQUIRECT_ENHANCEMENT);
+    float64_t tileWidth = 360.0 / aTilesPerRow;
+    float64_t tileHeight = 180.0 / aRows;
+    for (uint32_t row = 0; row < aRows; row++)
+    {
+        VASTileViewports viewports;
+        for (uint32_t i = 0; i < aTilesPerRow; i++)
+        {
+            VASTileViewport& tile = tiles[row * aTilesPerRow + i];
+            tile.set(-180.0 + (i + 0.5) * tileWidth, -90.0 + (row + 0.5) * tileHeight, tileWidth, tileHeight,
+                     VASLongitudeDirection::COUNTER_CLOCKWISE);
+            viewports.add(&tile);
+        }
+        index.addRow(viewports);
+    }
+
+    // head motion: small steps with occasional jumps, like the head tracker at 90 Hz
+    HeadPosition* trace = OMAF_NEW_ARRAY_HEAP(HeadPosition, aPicks);
+    uint32_t seed = 12345;
+    HeadPosition position = {0.0, 0.0};
+    for (uint32_t i = 0; i < aPicks; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        float64_t step = ((seed >> 16) % 2000) / 1000.0 - 1.0;
+        position.longitude += (seed % 50 == 0) ? step * 90.0 : step * 2.0;
+        position.latitude += (seed % 7 == 0) ? step : 0.0;
+        if (position.longitude > 180.0)
+        {
+            position.longitude -= 360.0;
+        }
+        else if (position.longitude < -180.0)
+        {
+            position.longitude += 360.0;
+        }
+        position.latitude = clamp(position.latitude, -80.0, 80.0);
+        trace[i] = position;
+    }
+
+    VASRenderedViewport viewport;
+    float64_t checksum = 0.0;
+
+    int64_t start = Time::getClockTimeUs();
+    for (uint32_t i = 0; i < aPicks; i++)
+    {
+        viewport.setPosition(trace[i].longitude, trace[i].latitude, 90.0 * VIEWPORT_EXTENSION,
+                             90.0 * VIEWPORT_EXTENSION, VASTileType::EQUIRECT_ENHANCEMENT);
+        for (uint32_t t = 0; t < aRows * aTilesPerRow; t++)
+        {
+            checksum += viewport.intersect(tiles[t]);
+        }
+    }
+    int64_t directUs = Time::getClockTimeUs() - start;
+
+    start = Time::getClockTimeUs();
+    VASTileCoverage coverage;
+    for (uint32_t i = 0; i < aPicks; i++)
+    {
+        viewport.setPosition(trace[i].longitude, trace[i].latitude, 90.0 * VIEWPORT_EXTENSION,
+                             90.0 * VIEWPORT_EXTENSION, VASTileType::EQUIRECT_ENHANCEMENT);
+        for (uint32_t row = 0; row < aRows; row++)
+        {
+            index.getCoverage(viewport, row, coverage);
+            checksum += coverage[0];
+        }
+    }
+    int64_t indexUs = Time::getClockTimeUs() - start;
+
+    // classification differences between the direct and quantized areas
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < aPicks; i++)
+    {
+        viewport.setPosition(trace[i].longitude, trace[i].latitude, 90.0 * VIEWPORT_EXTENSION,
+                             90.0 * VIEWPORT_EXTENSION, VASTileType::EQUIRECT_ENHANCEMENT);
+        for (uint32_t row = 0; row < aRows; row++)
+        {
+            index.getCoverage(viewport, row, coverage);
+            for (uint32_t t = 0; t < aTilesPerRow; t++)
+            {
+                float64_t direct = viewport.intersect(tiles[row * aTilesPerRow + t]);
+                if ((direct > INTERSECTION_AREA_THR) != (coverage[t] > INTERSECTION_AREA_THR))
+                {
+                    mismatches++;
+                }
+            }
+        }
+    }
+
+    printf("picks=%u rows=%u tiles_per_row=%u\n", aPicks, aRows, aTilesPerRow);
+    printf("direct_picks_per_sec=%.0f\n", aPicks * 1000000.0 / (directUs > 0 ? directUs : 1));
+    printf("index_picks_per_sec=%.0f\n", aPicks * 1000000.0 / (indexUs > 0 ? indexUs : 1));
+    printf("classification_mismatches=%u of %u\n", mismatches, aPicks * aRows * aTilesPerRow);
+    printf("checksum=%f\n", checksum);
+
+    OMAF_DELETE_ARRAY_HEAP(trace);
+    OMAF_DELETE_ARRAY_HEAP(tiles);
+    return 0;
+}
+
+OMAF_NS_END
+
+int main(int argc, char** argv)
+{
+    uint32_t picks = argc > 1 ? (uint32_t) atoi(argv[1]) : 100000;
+    uint32_t rows = argc > 2 ? (uint32_t) atoi(argv[2]) : 12;
+    uint32_t tilesPerRow = argc > 3 ? (uint32_t) atoi(argv[3]) : 24;
+    if (picks == 0 || rows == 0 || rows > 60 || tilesPerRow == 0 || tilesPerRow > 60)
+    {
+        printf("Usage: %s [picks] [rows <= 60] [tiles per row <= 60]\n", argv[0]);
+        return 1;
+    }
+    OMAF::Private::MemorySystem::Create();
+    int result = OMAF::Private::runBenchmark(picks, rows, tilesPerRow);
+    OMAF::Private::MemorySystem::Destroy();
+    return result;
+}
@@ -0,0 +1,297 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Offline check of the viewport prediction used for tile prefetch. A recorded head motion trace is replayed through
+// VASViewportPredictor the way omaf_headless renders it, ie. the latest due sample every 16 ms, and each prediction is
+// compared with where the head actually is one horizon later:
+// - the angular error of the predicted viewport center, against simply holding the current one
+// - on a synthetic equirect tile grid, the tiles the future viewport needs that the current one does not; the share of
+//   them the predicted viewport covered is the prefetch hit ratio, and the share of the prefetched tiles that were
+//   needed is the precision
+//
+// The trace has the format of omaf_headless: one "<time ms> <yaw> <pitch> <roll>" sample per line, in degrees; lines
+// starting with # are ignored.
+//
+// With --check the exit code is 1 if the prediction is not closer to the future viewport than holding the current
+// one, or the hit ratio is below --min-hit-ratio.
+//
+// Usage: ViewportPredictionReplay <trace> [--horizon-ms N] [--rows N] [--tiles-per-row N] [--min-hit-ratio F]
+//                                 [--check]
+
+#include "Foundation/NVRMemorySystem.h"
+#include "Math/OMAFMathFunctions.h"
+#include "VAS/NVRVASTileIndex.h"
+#include "VAS/NVRVASViewportPredictor.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+OMAF_NS_BEGIN
+
+// same as in VASTilePicker
+static const float64_t INTERSECTION_AREA_THR = 300.f;
+static const float64_t VIEWPORT_EXTENSION = 1.2f;
+
+// same as in omaf_headless
+static const uint32_t FRAME_INTERVAL_MS = 16;
+static const float64_t FIELD_OF_VIEW = 90.0;
+
+struct HeadPosition
+{
+    uint32_t timeMs;
+    float64_t longitude;
+    float64_t latitude;
+};
+
+static bool_t readTrace(const char_t* aFilename, std::vector<HeadPosition>& aTrace)
+{
+    std::ifstream file(aFilename);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::istringstream fields(line);
+        HeadPosition position;
+        float64_t roll = 0.0;
+        if (fields >> position.timeMs >> position.longitude >> position.latitude >> roll)
+        {
+            aTrace.push_back(position);
+        }
+    }
+    return !aTrace.empty();
+}
+
+// the latest sample due at aTimeMs, as omaf_headless renders it
+static const HeadPosition& positionAt(const std::vector<HeadPosition>& aTrace, uint32_t aTimeMs)
+{
+    size_t index = 0;
+    while (index + 1 < aTrace.size() && aTrace[index + 1].timeMs <= aTimeMs)
+    {
+        index++;
+    }
+    return aTrace[index];
+}
+
+static float64_t angularDistance(float64_t aLongitude1,
+                                 float64_t aLatitude1,
+                                 float64_t aLongitude2,
+                                 float64_t aLatitude2)
+{
+    float64_t lat1 = toRadians(aLatitude1);
+    float64_t lat2 = toRadians(aLatitude2);
+    float64_t cosine = sin(lat1) * sin(lat2) + cos(lat1) * cos(lat2) * cos(toRadians(aLongitude1 - aLongitude2));
+    return toDegrees(acos(clamp(cosine, -1.0, 1.0)));
+}
+
+// marks the tiles the viewport at the position covers, rows * tiles per row flags
+static void_t coveredTiles(VASTileIndex& aIndex,
+                           float64_t aLongitude,
+                           float64_t aLatitude,
+                           uint32_t aTilesPerRow,
+                           std::vector<bool_t>& aCovered)
+{
+    VASRenderedViewport viewport;
+    viewport.setPosition(aLongitude, aLatitude, FIELD_OF_VIEW * VIEWPORT_EXTENSION, FIELD_OF_VIEW * VIEWPORT_EXTENSION,
+                         VASTileType::EQUIRECT_ENHANCEMENT);
+    VASTileCoverage coverage;
+    for (size_t row = 0; row < aIndex.getNrRows(); row++)
+    {
+        aIndex.getCoverage(viewport, row, coverage);
+        for (uint32_t t = 0; t < aTilesPerRow; t++)
+        {
+            aCovered[row * aTilesPerRow + t] = coverage[t] > INTERSECTION_AREA_THR;
+        }
+    }
+}
+
+static int runReplay(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s <trace> [--horizon-ms N] [--rows N] [--tiles-per-row N] [--min-hit-ratio F] [--check]\n",
+               argv[0]);
+        return 1;
+    }
+
+    // VASTilePicker predicts 1.5 segment durations ahead; 1 s segments
+    uint32_t horizonMs = 1500;
+    uint32_t rows = 12;
+    uint32_t tilesPerRow = 24;
+    float64_t minHitRatio = 0.0;
+    bool_t check = false;
+    for (int i = 2; i < argc; i++)
+    {
+        const char_t* arg = argv[i];
+        const char_t* value = i + 1 < argc ? argv[i + 1] : "";
+        if (strcmp(arg, "--horizon-ms") == 0)
+        {
+            horizonMs = (uint32_t) atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--rows") == 0)
+        {
+            rows = (uint32_t) atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--tiles-per-row") == 0)
+        {
+            tilesPerRow = (uint32_t) atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--min-hit-ratio") == 0)
+        {
+            minHitRatio = atof(value);
+            i++;
+        }
+        else if (strcmp(arg, "--check") == 0)
+        {
+            check = true;
+        }
+        else
+        {
+            printf("Unknown option %s\n", arg);
+            return 1;
+        }
+    }
+    if (horizonMs == 0 || rows == 0 || rows > 60 || tilesPerRow == 0 || tilesPerRow > 60)
+    {
+        printf("The horizon must be positive, and the grid at most 60 x 60 tiles\n");
+        return 1;
+    }
+
+    std::vector<HeadPosition> trace;
+    if (!readTrace(argv[1], trace))
+    {
+        printf("Could not read trace %s\n", argv[1]);
+        return 1;
+    }
+
+    // tile grid; the viewports must outlive the index as it only references them
+    std::vector<VASTileViewport> tiles(rows * tilesPerRow);
+    VASTileIndex index;
+    index.reset(VASTileType::EQUIRECT_ENHANCEMENT);
+    float64_t tileWidth = 360.0 / tilesPerRow;
+    float64_t tileHeight = 180.0 / rows;
+    for (uint32_t row = 0; row < rows; row++)
+    {
+        VASTileViewports viewports;
+        for (uint32_t i = 0; i < tilesPerRow; i++)
+        {
+            VASTileViewport& tile = tiles[row * tilesPerRow + i];
+            tile.set(-180.0 + (i + 0.5) * tileWidth, -90.0 + (row + 0.5) * tileHeight, tileWidth, tileHeight,
+                     VASLongitudeDirection::COUNTER_CLOCKWISE);
+            viewports.add(&tile);
+        }
+        index.addRow(viewports);
+    }
+
+    VASViewportPredictor predictor;
+    std::vector<bool_t> current(tiles.size());
+    std::vector<bool_t> future(tiles.size());
+    std::vector<bool_t> predicted(tiles.size());
+
+    uint32_t frames = 0;
+    uint32_t predictions = 0;
+    float64_t predictedErrorSum = 0.0;
+    float64_t holdErrorSum = 0.0;
+    uint32_t needed = 0;
+    uint32_t prefetched = 0;
+    uint32_t hits = 0;
+
+    uint32_t endMs = trace.back().timeMs;
+    for (uint32_t nowMs = trace.front().timeMs; nowMs + horizonMs <= endMs; nowMs += FRAME_INTERVAL_MS)
+    {
+        const HeadPosition& now = positionAt(trace, nowMs);
+        predictor.addSample((int64_t) nowMs * 1000, now.longitude, now.latitude);
+        frames++;
+
+        float64_t longitude = 0.0;
+        float64_t latitude = 0.0;
+        if (!predictor.predict(horizonMs, longitude, latitude))
+        {
+            // nothing is prefetched while the head is still
+            continue;
+        }
+        predictions++;
+
+        const HeadPosition& later = positionAt(trace, nowMs + horizonMs);
+        predictedErrorSum += angularDistance(longitude, latitude, later.longitude, later.latitude);
+        holdErrorSum += angularDistance(now.longitude, now.latitude, later.longitude, later.latitude);
+
+        coveredTiles(index, now.longitude, now.latitude, tilesPerRow, current);
+        coveredTiles(index, later.longitude, later.latitude, tilesPerRow, future);
+        coveredTiles(index, longitude, latitude, tilesPerRow, predicted);
+        for (size_t t = 0; t < tiles.size(); t++)
+        {
+            if (current[t])
+            {
+                continue;
+            }
+            needed += future[t] ? 1 : 0;
+            prefetched += predicted[t] ? 1 : 0;
+            hits += future[t] && predicted[t] ? 1 : 0;
+        }
+    }
+
+    float64_t predictedError = predictions > 0 ? predictedErrorSum / predictions : 0.0;
+    float64_t holdError = predictions > 0 ? holdErrorSum / predictions : 0.0;
+    float64_t hitRatio = needed > 0 ? (float64_t) hits / needed : 0.0;
+    float64_t precision = prefetched > 0 ? (float64_t) hits / prefetched : 0.0;
+
+    printf("horizon_ms=%u rows=%u tiles_per_row=%u\n", horizonMs, rows, tilesPerRow);
+    printf("frames=%u predictions=%u\n", frames, predictions);
+    printf("mean_error_deg predicted=%.2f hold=%.2f\n", predictedError, holdError);
+    printf("tiles needed=%u prefetched=%u hits=%u\n", needed, prefetched, hits);
+    printf("hit_ratio=%.3f precision=%.3f\n", hitRatio, precision);
+
+    if (check)
+    {
+        if (predictions == 0)
+        {
+            printf("FAIL: no predictions; the trace has no head motion\n");
+            return 1;
+        }
+        if (predictedError >= holdError)
+        {
+            printf("FAIL: the prediction is not closer to the future viewport than the current one\n");
+            return 1;
+        }
+        if (hitRatio < minHitRatio)
+        {
+            printf("FAIL: hit ratio %.3f is below %.3f\n", hitRatio, minHitRatio);
+            return 1;
+        }
+        printf("PASS\n");
+    }
+    return 0;
+}
+
+OMAF_NS_END
+
+int main(int argc, char** argv)
+{
+    OMAF::Private::MemorySystem::Create();
+    int result = OMAF::Private::runReplay(argc, argv);
+    OMAF::Private::MemorySystem::Destroy();
+    return result;
+}
@@ -0,0 +1,39 @@
+
+#
+# This file is part of Nokia OMAF implementation
+#
+# Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+#
+# Contact: omaf@nokia.com
+#
+# This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+# subsidiaries. All rights are reserved.
+#
+# Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+# written consent of Nokia.
+
+set(TARGET_OS_LINUX "linux")
+set(OMAF_CMAKE_TARGET_OS ${TARGET_OS_LINUX})
+
+add_definitions(-DTARGET_OS_LINUX)
+
+set(CMAKE_CXX_FLAGS_RELEASE "${CMAKE_CXX_FLAGS_RELEASE} -fvisibility=hidden") #by default hide all symbols, only export explicitly (we do NOT want to publicize our internal methods/data)
+set(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS} -Wl,--no-undefined")    #Force linker error for unresolved symbols
+
+set(OMAF_ROOT ..)
+set(OMAF_COMMON_DEPS
+    pthread
+    dl
+    )
+
+IF(CMAKE_BUILD_TYPE STREQUAL "Debug")
+    set(MP4VR_LIB_DIR ${CMAKE_SOURCE_DIR}/${OMAF_ROOT}/Mp4/lib/Linux/Debug)
+ELSE()
+    set(MP4VR_LIB_DIR ${CMAKE_SOURCE_DIR}/${OMAF_ROOT}/Mp4/lib/Linux/Release)
+ENDIF()
+
+set(OMAF_COMMON_DEPS ${OMAF_COMMON_DEPS} ${MP4VR_LIB_DIR}/libmp4vr_shared.so)
+
+set(libprefix "lib")
+set(libsuffix "a")
+set(dashsuffix "so")
@@ -18,7 +18,7 @@
 #include "API/OMAFPlayerPlatformParameters.h"
 #include "OMAFPlayerDataTypes.h"
 
-#if defined(__ANDROID__)
+#if defined(__ANDROID__) || defined(__gnu_linux__)
 
 #if defined(OMAF_BUILD_SHARED_LIBRARY)
 
@@ -360,6 +360,31 @@ namespace OMAF
          * @param aVolume Volume, ranging from 0.0f to 1.0f
          */
         virtual void_t setAudioVolume(float aVolume) = 0;
+
+        /**
+         * Returns latency statistics for a stage of the streaming pipeline
+         * @param aCategory The pipeline stage
+         * @return Statistics, count is 0 if nothing has been recorded
+         */
+        virtual LatencyStatistics getLatencyStatistics(LatencyCategory::Enum aCategory) = 0;
+
+        /**
+         * Configures the cache of downloaded segments, consulted before any segment is requested over HTTP.
+         * Reconfiguring drops the segments cached in memory.
+         * @param aSettings Cache settings
+         * @return Result::OK on success, Result::ITEM_NOT_FOUND if the disk directory does not exist; the memory cache is
+         * used in that case
+         */
+        virtual Result::Enum setSegmentCacheSettings(const SegmentCacheSettings& aSettings) = 0;
+
+        /**
+         * Sets a directory where the sample tables of local MP4 files are cached, so that opening the same file again
+         * is faster. Used by the files loaded after the call; caching is disabled by default.
+         * @param aDirectory Existing directory for the cache, NULL or empty disables the cache
+         * @return Result::OK on success, Result::ITEM_NOT_FOUND if the directory does not exist; caching is disabled
+         * in that case
+         */
+        virtual Result::Enum setIndexCacheDirectory(const char* aDirectory) = 0;
     };
 
     /**
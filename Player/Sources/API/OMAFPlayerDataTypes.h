@@ -192,7 +192,9 @@ namespace OMAF
             D3D11 = 0x10,  ///< DirectX 11
             D3D12 = 0x20,  ///< DirectX 12, not currently supported
 
-            COUNT = 6  ///< Enum max value
+            NIL = 0x40,  ///< No rendering, for headless playback
+
+            COUNT = 7  ///< Enum max value
         };
     };
 
@@ -244,6 +246,43 @@ namespace OMAF
         StreamType::Enum streamType;  ///< Stream type
     };
 
+    namespace LatencyCategory
+    {
+        enum Enum
+        {
+            INVALID = -1,  ///< Invalid enum
+
+            SEGMENT_DOWNLOAD,  ///< Time from sending a segment request until the segment is fully received
+            SEGMENT_PARSE,     ///< Time spent parsing a downloaded segment
+            TILE_SWITCH,       ///< Time from selecting a new tile representation until it is in use
+
+            COUNT  ///< Enum max value
+        };
+    }
+
+    /**
+     * Latency statistics of one stage of the streaming pipeline, collected since the player was created
+     */
+    struct LatencyStatistics
+    {
+        uint32_t count;          ///< Number of recorded samples
+        uint64_t minUs;          ///< Smallest recorded latency
+        uint64_t maxUs;          ///< Largest recorded latency
+        uint64_t averageUs;      ///< Average latency
+        uint64_t medianUs;       ///< Median latency of the most recent samples
+        uint64_t percentile95Us; ///< 95th percentile latency of the most recent samples
+    };
+
+    /**
+     * Settings of the cache of downloaded DASH segments. The cache is shared by all streams and is disabled by default.
+     */
+    struct SegmentCacheSettings
+    {
+        uint64_t memoryBudgetBytes;  ///< Bytes of segments kept in memory, 0 disables the cache
+        const char* diskPath;        ///< Existing directory for the disk cache, NULL or empty for memory only
+        uint64_t diskBudgetBytes;    ///< Bytes of segments kept in the disk directory
+    };
+
     namespace HeadTransformSource
     {
         enum Enum
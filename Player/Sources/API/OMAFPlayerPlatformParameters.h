@@ -98,6 +98,20 @@ namespace OMAF
 #error Unsupported platform
 #endif
 
+#elif defined(__gnu_linux__)
+
+    struct PlatformParameters
+    {
+        PlatformParameters()
+            : storagePath(NULL)
+            , assetPath(NULL)
+        {
+        }
+
+        const char* storagePath;  ///< Path to the storage folder
+        const char* assetPath;    ///< Path to the assets folder
+    };
+
 #elif defined(__APPLE__) && defined(__MACH__)
 
     struct PlatformParameters
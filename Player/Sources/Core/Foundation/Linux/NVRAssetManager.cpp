@@ -0,0 +1,137 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "Foundation/NVRAssetManager.h"
+
+#include "Foundation/NVRAssert.h"
+#include "Foundation/NVRDependencies.h"
+
+OMAF_NS_BEGIN
+namespace AssetManager
+{
+    FileHandle InvalidFileHandle = NULL;
+
+    PathName gAssetPath;
+
+    bool_t FileExists(const char_t* path)
+    {
+        PathName filePath = GetFullPath(path);
+        struct stat st;
+        int result = stat(filePath, &st);
+
+        return (result == 0 && S_ISREG(st.st_mode));
+    }
+
+    bool_t DirExists(const char_t* path)
+    {
+        PathName dirPath = GetFullPath(path);
+        struct stat st;
+        int result = stat(dirPath, &st);
+
+        return (result == 0 && S_ISDIR(st.st_mode));
+    }
+
+    PathName GetFullPath(const char_t* path)
+    {
+        PathName fullPath = gAssetPath;
+        fullPath.append(path);
+
+        return fullPath;
+    }
+
+    FileHandle Open(const char_t* filename, FileSystem::AccessMode::Enum mode)
+    {
+        FileHandle handle = InvalidFileHandle;
+
+        PathName filePath = GetFullPath(filename);
+
+        switch (mode)
+        {
+        case FileSystem::AccessMode::READ:
+        {
+            handle = fopen(filePath, "rb");
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        return handle;
+    }
+
+    void_t Close(FileHandle handle)
+    {
+        if (handle != InvalidFileHandle)
+        {
+            fclose((FILE*) handle);
+        }
+    }
+
+    int64_t Read(FileHandle handle, void_t* destination, int64_t bytes)
+    {
+        if (handle != InvalidFileHandle)
+        {
+            return fread(destination, 1, (size_t) bytes, (FILE*) handle);
+        }
+
+        return 0;
+    }
+
+    bool_t Seek(FileHandle handle, int64_t offset)
+    {
+        if (handle != InvalidFileHandle)
+        {
+            return (0 == fseeko((FILE*) handle, (off_t) offset, SEEK_CUR));
+        }
+
+        return false;
+    }
+
+    int64_t Tell(FileHandle handle)
+    {
+        if (handle != InvalidFileHandle)
+        {
+            return ftello((FILE*) handle);
+        }
+
+        return (int64_t) -1;
+    }
+
+    bool_t IsOpen(FileHandle handle)
+    {
+        if (handle != InvalidFileHandle)
+        {
+            return true;
+        }
+
+        return false;
+    }
+
+    int64_t GetSize(FileHandle handle)
+    {
+        if (handle != InvalidFileHandle)
+        {
+            struct stat st;
+            int result = fstat(fileno((FILE*) handle), &st);
+
+            OMAF_ASSERT(result == 0, "");
+
+            return st.st_size;
+        }
+
+        return 0;
+    }
+}  // namespace AssetManager
+OMAF_NS_END
@@ -0,0 +1,152 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "NVRBandwidthMonitorLinux.h"
+#include "Foundation/NVRDependencies.h"
+#include "Foundation/NVRLogger.h"
+#include "Foundation/NVRNew.h"
+#include "Foundation/NVRTime.h"
+
+OMAF_NS_BEGIN
+
+OMAF_LOG_ZONE(BandwidthMonitorLinux)
+
+static const uint32_t MEASUREMENT_PERIOD_MS = 5 * 1000;
+static const uint32_t MEASUREMENT_INTERVAL_MS = MEASUREMENT_PERIOD_MS / SAMPLE_ARRAY_SIZE;
+
+BandwidthMonitorLinux::BandwidthMonitorLinux()
+    : BandwidthMonitor()
+    , mInitialBytes(0)
+{
+    mThread.setPriority(Thread::Priority::LOWEST);
+    mThread.setName("BandwidthMonitorLinux");
+
+    Thread::EntryFunction function;
+    function.bind<BandwidthMonitorLinux, &BandwidthMonitorLinux::threadEntry>(this);
+
+    mThread.start(function);
+}
+
+BandwidthMonitorLinux::~BandwidthMonitorLinux()
+{
+    if (mThread.isValid() && mThread.isRunning())
+    {
+        mRunning = false;
+        mMeasurementEnabled.signal();
+        mThread.stop();
+        mThread.join();
+    }
+}
+
+Thread::ReturnValue BandwidthMonitorLinux::threadEntry(const Thread& thread, void_t* userData)
+{
+    mInitialBytes = readReceivedBytes();
+
+    if (mInitialBytes < 0)
+    {
+        OMAF_LOG_W("/proc/net/dev not available, fallbacking to basic method");
+        // fallback to the basic way of monitoring, implemented in the base class
+        mSupported = false;
+        mRunning = false;
+    }
+    else
+    {
+        mSupported = true;
+        mRunning = true;
+    }
+
+    // app-level main loop, exited only if the thread must exit, and never entered if not supported
+    while (mRunning)
+    {
+        // enabled when there is a clip open; do bandwidth estimation once in MEASUREMENT_INTERVAL_MS
+        mMeasurementEnabled.wait();
+        if (!mRunning)
+        {
+            break;
+        }
+        measure();
+        Thread::sleep(MEASUREMENT_INTERVAL_MS);
+    }
+
+    return 0;
+}
+
+int64_t BandwidthMonitorLinux::getBytesDownloaded()
+{
+    int64_t bytes = readReceivedBytes();
+
+    if (bytes < mInitialBytes)
+    {
+        return 0;
+    }
+
+    return bytes - mInitialBytes;
+}
+
+int64_t BandwidthMonitorLinux::readReceivedBytes()
+{
+    FILE* file = fopen("/proc/net/dev", "r");
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    int64_t total = 0;
+    char_t line[512];
+    uint32_t lineIndex = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        // First two lines are headers
+        if (lineIndex++ < 2)
+        {
+            continue;
+        }
+
+        char_t* separator = strchr(line, ':');
+
+        if (separator == NULL)
+        {
+            continue;
+        }
+
+        *separator = '\0';
+
+        const char_t* name = line;
+
+        while (*name == ' ')
+        {
+            name++;
+        }
+
+        if (strcmp(name, "lo") == 0)
+        {
+            continue;
+        }
+
+        unsigned long long rxBytes = 0;
+
+        if (sscanf(separator + 1, "%llu", &rxBytes) == 1)
+        {
+            total += (int64_t) rxBytes;
+        }
+    }
+
+    fclose(file);
+
+    return total;
+}
+
+OMAF_NS_END
@@ -0,0 +1,45 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVRAtomicBoolean.h"
+#include "Foundation/NVRBandwidthMonitor.h"
+#include "Foundation/NVRFixedArray.h"
+#include "Foundation/NVRSpinlock.h"
+#include "Foundation/NVRThread.h"
+#include "NVREssentials.h"
+
+OMAF_NS_BEGIN
+
+class BandwidthMonitorLinux : public BandwidthMonitor
+{
+public:
+    BandwidthMonitorLinux();
+    ~BandwidthMonitorLinux();
+
+protected:
+    int64_t getBytesDownloaded();
+
+private:
+    Thread::ReturnValue threadEntry(const Thread& thread, void_t* userData);
+
+    // Sum of received bytes of all non-loopback interfaces in /proc/net/dev, or -1 if not available
+    int64_t readReceivedBytes();
+
+private:
+    int64_t mInitialBytes;
+};
+
+OMAF_NS_END
@@ -0,0 +1,274 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "Foundation/NVRDeviceInfo.h"
+
+#include <stdlib.h>
+#include <sys/utsname.h>
+#include "Foundation/NVRBase64.h"
+#include "Foundation/NVRClock.h"
+#include "Foundation/NVRDependencies.h"
+#include "Foundation/NVRNew.h"
+#include "Foundation/NVRString.h"
+#include "Platform/OMAFDataTypes.h"
+
+OMAF_NS_BEGIN
+namespace DeviceInfo
+{
+    static FixedString256 sOSName;
+    static FixedString256 sOSVersion;
+    static FixedString256 sDeviceModel;
+    static FixedString256 sDeviceType;
+    static FixedString256 sDevicePlatformInfo;
+    static FixedString256 sDevicePlatformId;
+    static FixedString256 sAppId;
+    static FixedString256 sAppBuildNumber;
+
+    void initialize()
+    {
+        // just pre-fetch everything.
+        getOSName();
+        getOSVersion();
+        getDeviceModel();
+        getDeviceType();
+        getDevicePlatformInfo();
+        getDevicePlatformId();
+        getAppId();
+    }
+
+    void shutdown()
+    {
+        // do nothing.
+    }
+
+    // Reads the value of the first "key : value" line in /proc/cpuinfo that matches the given key
+    static bool_t readCpuInfo(const char_t* key, FixedString256& value)
+    {
+        FILE* file = fopen("/proc/cpuinfo", "r");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        bool_t found = false;
+        size_t keyLength = strlen(key);
+        char_t line[512];
+
+        while (!found && fgets(line, sizeof(line), file) != NULL)
+        {
+            if (strncmp(line, key, keyLength) != 0)
+            {
+                continue;
+            }
+
+            char_t* separator = strchr(line, ':');
+
+            if (separator == NULL)
+            {
+                continue;
+            }
+
+            char_t* start = separator + 1;
+
+            while (*start == ' ' || *start == '\t')
+            {
+                start++;
+            }
+
+            size_t length = strlen(start);
+
+            while (length > 0 && (start[length - 1] == '\n' || start[length - 1] == '\r'))
+            {
+                length--;
+            }
+
+            value.append(start, length);
+            found = true;
+        }
+
+        fclose(file);
+
+        return found;
+    }
+
+    const FixedString256& getOSName()
+    {
+        if (sOSName.isEmpty())
+        {
+            sOSName = "Linux";
+        }
+        return sOSName;
+    }
+
+    const FixedString256& getOSVersion()
+    {
+        if (sOSVersion.isEmpty())
+        {
+            struct utsname name;
+
+            if (uname(&name) == 0)
+            {
+                sOSVersion = name.release;
+            }
+            else
+            {
+                sOSVersion = "Unknown";
+            }
+        }
+        return sOSVersion;
+    }
+
+    const FixedString256& getDeviceModel()
+    {
+        if (sDeviceModel.isEmpty())
+        {
+            struct utsname name;
+
+            if (uname(&name) == 0)
+            {
+                sDeviceModel.appendFormat("%s %s", name.nodename, name.machine);
+            }
+            else
+            {
+                sDeviceModel = "Unknown";
+            }
+        }
+        return sDeviceModel;
+    }
+
+    const FixedString256& getDeviceType()
+    {
+        if (sDeviceType.isEmpty())
+        {
+            sDeviceType = "Linux";
+        }
+        return sDeviceType;
+    }
+
+    const FixedString256& getDevicePlatformInfo()
+    {
+        if (sDevicePlatformInfo.isEmpty())
+        {
+            long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+            sDevicePlatformInfo.appendFormat("%s (%ld cores)", getDevicePlatformId().getData(), cores);
+        }
+        return sDevicePlatformInfo;
+    }
+
+    const FixedString256& getDevicePlatformId()
+    {
+        if (sDevicePlatformId.isEmpty())
+        {
+            if (!readCpuInfo("model name", sDevicePlatformId))
+            {
+                sDevicePlatformId = "Unknown";
+            }
+        }
+        return sDevicePlatformId;
+    }
+
+    FixedString256 getUniqueId()
+    {
+        char_t unique[256];
+
+        ::srand((unsigned) Clock::getRandomSeed());
+        int32_t r1 = rand();
+        int32_t r2 = rand();
+        int32_t r3 = rand();
+        uint64_t timestamp = Clock::getRandomSeed();  // epoch time in microseconds gives further spread to the id
+
+        sprintf(unique, "Linux%d%d%d%llu", r1, r2, r3, (unsigned long long) timestamp);
+        String inputString(*MemorySystem::DefaultHeapAllocator(), unique);
+        String baseString(*MemorySystem::DefaultHeapAllocator());
+        Base64::encode(inputString, baseString);
+
+        return FixedString256(baseString);
+    }
+
+    const FixedString256& getAppId()
+    {
+        if (sAppId.isEmpty())
+        {
+            // there is no package name for Linux executables, so use the executable name instead
+            char_t path[PATH_MAX];
+            ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+
+            if (length > 0)
+            {
+                path[length] = '\0';
+
+                const char_t* name = strrchr(path, '/');
+                sAppId = (name != NULL) ? name + 1 : path;
+            }
+            else
+            {
+                sAppId = "Unknown";
+            }
+        }
+        return sAppId;
+    }
+
+    const FixedString256& getAppBuildNumber()
+    {
+        if (sAppBuildNumber.isEmpty())
+        {
+            sAppBuildNumber = "Unknown";
+        }
+        return sAppBuildNumber;
+    }
+
+    bool_t deviceSupports2VideoTracks()
+    {
+        return true;
+    }
+
+    bool_t deviceSupportsHEVC()
+    {
+        return true;
+    }
+
+    bool_t deviceCanReconfigureVideoDecoder()
+    {
+        return true;
+    }
+
+    LayeredVASTypeSupport::Enum deviceSupportsLayeredVAS()
+    {
+        return LayeredVASTypeSupport::FULL_STEREO;
+    }
+
+    uint32_t maxLayeredVASTileCount()
+    {
+        return 12;  // same as desktop Windows, 6x2 tile grid stereo
+    }
+
+    uint32_t maxDecodedPixelCountPerSecond()
+    {
+        // Frames are not decoded on Linux, use the desktop limit so that stream selection behaves as on Windows
+        return 4 * 4096 * 2048 * 30;  // 4 x 4k @ 30fps
+    }
+
+    bool_t deviceSupportsSubsegments()
+    {
+        return true;
+    }
+
+    bool_t isCurrentDeviceSupported()
+    {
+        return true;
+    }
+}  // namespace DeviceInfo
+OMAF_NS_END
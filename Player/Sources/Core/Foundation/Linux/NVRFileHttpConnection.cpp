@@ -0,0 +1,524 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "NVRFileHttpConnection.h"
+
+#include "Foundation/NVRDependencies.h"
+#include "Foundation/NVRLogger.h"
+#include "Foundation/NVRStorageManager.h"
+#include "Foundation/NVRTime.h"
+
+OMAF_NS_BEGIN
+OMAF_LOG_ZONE(FileHttpConnection)
+
+static const uint32_t READ_CHUNK_SIZE = 64 * 1024;
+
+FileHttpConnection::FileHttpConnection(MemoryAllocator& allocator)
+    : mAllocator(allocator)
+    , mThread()
+    , mMutex()
+    , mEvent(false, false)
+    , mStateChangeEvent(false, false)
+    , mUrl()
+    , mHeaders()
+    , mOutputBuffer(OMAF_NULL)
+    , mHeadOnly(false)
+    , mHttpRequestState()
+    , mHeadersChanged(false)
+    , mInternalHttpRequestState()
+    , mHttpDataProcessor(OMAF_NULL)
+{
+    Thread::EntryFunction function;
+    function.bind<FileHttpConnection, &FileHttpConnection::threadEntry>(this);
+
+    mThread.setPriority(Thread::Priority::INHERIT);
+    mThread.setName("HTTP::FileHttpConnection");
+
+    mThread.start(function);
+}
+
+FileHttpConnection::~FileHttpConnection()
+{
+    abortRequest();
+    waitForCompletion();
+
+    mMutex.lock();
+    mInternalHttpRequestState.connectionState = HttpConnectionState::INVALID;
+    mMutex.unlock();
+
+    if (mThread.isValid() && mThread.isRunning())
+    {
+        mThread.stop();
+        mEvent.reset();
+        mEvent.signal();
+        mThread.join();
+    }
+}
+
+const HttpRequestState& FileHttpConnection::getState() const
+{
+    Spinlock::ScopeLock lock(mMutex);
+    mHttpRequestState.connectionState = mInternalHttpRequestState.connectionState;
+    mHttpRequestState.httpStatus = mInternalHttpRequestState.httpStatus;
+
+    if (mHeadersChanged)
+    {
+        mHttpRequestState.headers = mInternalHttpRequestState.headers;
+        mHeadersChanged = false;
+    }
+
+    mHttpRequestState.bytesDownloaded = mInternalHttpRequestState.bytesDownloaded;
+    mHttpRequestState.bytesUploaded = mInternalHttpRequestState.bytesUploaded;
+    mHttpRequestState.totalBytes = mInternalHttpRequestState.totalBytes;
+    mHttpRequestState.input = mInternalHttpRequestState.input;
+    mHttpRequestState.output = mInternalHttpRequestState.output;
+
+    return mHttpRequestState;
+}
+
+void_t FileHttpConnection::setUserAgent(const utf8_t* aUserAgent)
+{
+    // Not sent anywhere
+    OMAF_UNUSED_VARIABLE(aUserAgent);
+}
+
+void_t FileHttpConnection::setTimeout(uint32_t timeoutMS)
+{
+    // Local reads do not time out
+    OMAF_UNUSED_VARIABLE(timeoutMS);
+}
+
+void_t FileHttpConnection::setHttpDataProcessor(IHttpDataProcessor* aHttpDataProcessor)
+{
+    mHttpDataProcessor = aHttpDataProcessor;
+}
+
+bool_t FileHttpConnection::setUri(const Url& url)
+{
+    if (url.isEmpty())
+    {
+        return false;
+    }
+
+    Spinlock::ScopeLock lock(mMutex);
+
+    if (mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS ||
+        mInternalHttpRequestState.connectionState == HttpConnectionState::ABORTING)
+    {
+        // not possible to change while in progress
+        return false;
+    }
+
+    checkRequestState();
+
+    mUrl = url;
+
+    mStateChangeEvent.signal();
+    return true;
+}
+
+void_t FileHttpConnection::setHeaders(const HttpHeaderList& headers)
+{
+    Spinlock::ScopeLock lock(mMutex);
+
+    if ((mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS) ||
+        (mInternalHttpRequestState.connectionState == HttpConnectionState::ABORTING))
+    {
+        // not possible to change while in progress
+        return;
+    }
+
+    mHeaders = headers;
+}
+
+void_t FileHttpConnection::setKeepAlive(uint32_t timeMS)
+{
+    // No connections to keep alive
+    OMAF_UNUSED_VARIABLE(timeMS);
+}
+
+HttpRequest::Enum FileHttpConnection::get(DataBuffer<uint8_t>* output)
+{
+    return start(output, false);
+}
+
+HttpRequest::Enum FileHttpConnection::post(const DataBuffer<uint8_t>* input, DataBuffer<uint8_t>* output)
+{
+    OMAF_UNUSED_VARIABLE(input);
+    OMAF_UNUSED_VARIABLE(output);
+    OMAF_LOG_W("POST is not supported for local files");
+
+    return HttpRequest::FAILED;
+}
+
+HttpRequest::Enum FileHttpConnection::head()
+{
+    return start(OMAF_NULL, true);
+}
+
+void_t FileHttpConnection::abortRequest()
+{
+    Spinlock::ScopeLock lock(mMutex);
+
+    if (mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS)
+    {
+        mInternalHttpRequestState.connectionState = HttpConnectionState::ABORTING;
+        mStateChangeEvent.signal();
+    }
+}
+
+void_t FileHttpConnection::waitForCompletion()
+{
+    // wait for it...
+    for (;;)
+    {
+        if (hasCompleted())
+        {
+            break;
+        }
+        mStateChangeEvent.wait(5000);
+    }
+}
+
+bool_t FileHttpConnection::hasCompleted()
+{
+    HttpConnectionState::Enum state = getConnectionState();
+    if (state == HttpConnectionState::ABORTED || state == HttpConnectionState::COMPLETED ||
+        state == HttpConnectionState::FAILED || state == HttpConnectionState::IDLE ||
+        state == HttpConnectionState::INVALID)
+    {
+        return true;
+    }
+    return false;
+}
+
+HttpConnectionState::Enum FileHttpConnection::getConnectionState() const
+{
+    Spinlock::ScopeLock lock(mMutex);
+    return mInternalHttpRequestState.connectionState;
+}
+
+void_t FileHttpConnection::checkRequestState()
+{
+    if (mInternalHttpRequestState.connectionState != HttpConnectionState::IDLE)
+    {
+        mInternalHttpRequestState = HttpRequestState();
+        mInternalHttpRequestState.connectionState = HttpConnectionState::IDLE;
+
+        mHeadersChanged = true;
+    }
+}
+
+HttpRequest::Enum FileHttpConnection::start(DataBuffer<uint8_t>* output, bool_t headOnly)
+{
+    if (mUrl.isEmpty() || mInternalHttpRequestState.connectionState != HttpConnectionState::IDLE ||
+        !mThread.isValid() || !mThread.isRunning() || mThread.shouldStop())
+    {
+        return HttpRequest::FAILED;
+    }
+
+    OMAF_LOG_D("FileHttpConnection::start %s", mUrl.getData());
+
+    mMutex.lock();
+
+    mHeadOnly = headOnly;
+    mOutputBuffer = output;
+    mInternalHttpRequestState.connectionState = HttpConnectionState::IN_PROGRESS;
+
+    mStateChangeEvent.signal();
+
+    mMutex.unlock();
+
+    mEvent.reset();
+    mEvent.signal();
+
+    return HttpRequest::OK;
+}
+
+bool_t FileHttpConnection::resolvePath(const Url& url, PathName& path) const
+{
+    static const char_t* FILE_SCHEME = "file://";
+    static const char_t* SCHEME_SEPARATOR = "://";
+
+    path.clear();
+
+    if (url.findFirst(FILE_SCHEME) == 0)
+    {
+        path = url.substring(strlen(FILE_SCHEME));
+    }
+    else
+    {
+        size_t schemeEnd = url.findFirst(SCHEME_SEPARATOR);
+
+        if (schemeEnd == Npos)
+        {
+            // Plain path, relative to the storage path
+            path = StorageManager::GetFullPath(url.getData());
+        }
+        else
+        {
+            // Drop scheme and authority, resolve the path component under the storage path
+            // findFirst() returns the position relative to the start index
+            size_t authorityStart = schemeEnd + strlen(SCHEME_SEPARATOR);
+            size_t pathStart = url.findFirst("/", authorityStart);
+
+            if (pathStart == Npos)
+            {
+                return false;
+            }
+
+            pathStart += authorityStart;
+
+            path = StorageManager::GetFullPath(url.substring(pathStart + 1).getData());
+        }
+    }
+
+    // Query strings and fragments have no meaning for local files
+    size_t queryStart = path.findFirst("?");
+
+    if (queryStart != Npos)
+    {
+        path = path.substring(0, queryStart);
+    }
+
+    size_t fragmentStart = path.findFirst("#");
+
+    if (fragmentStart != Npos)
+    {
+        path = path.substring(0, fragmentStart);
+    }
+
+    return !path.isEmpty();
+}
+
+bool_t FileHttpConnection::parseByteRange(uint64_t fileSize, uint64_t& first, uint64_t& last) const
+{
+    first = 0;
+    last = fileSize > 0 ? fileSize - 1 : 0;
+
+    for (HttpHeaderPairList::ConstIterator it = mHeaders.begin(); it != mHeaders.end(); ++it)
+    {
+        if (strcasecmp((*it).first.getData(), "Range") != 0)
+        {
+            continue;
+        }
+
+        unsigned long long rangeFirst = 0;
+        unsigned long long rangeLast = 0;
+        int count = sscanf((*it).second.getData(), "bytes=%llu-%llu", &rangeFirst, &rangeLast);
+
+        if (count < 1)
+        {
+            return false;
+        }
+
+        first = rangeFirst;
+
+        if (count == 2 && rangeLast < last)
+        {
+            last = rangeLast;
+        }
+
+        return (first <= last && first < fileSize);
+    }
+
+    return true;
+}
+
+bool_t FileHttpConnection::doRequest()
+{
+    PathName path;
+
+    if (!resolvePath(mUrl, path))
+    {
+        OMAF_LOG_E("Cannot map url to a local file: %s", mUrl.getData());
+        return false;
+    }
+
+    FILE* file = fopen(path.getData(), "rb");
+
+    if (file == NULL)
+    {
+        OMAF_LOG_W("File not found: %s", path.getData());
+
+        Spinlock::ScopeLock lock(mMutex);
+        mInternalHttpRequestState.httpStatus = 404;
+
+        return true;
+    }
+
+    struct stat st;
+    fstat(fileno(file), &st);
+    uint64_t fileSize = (uint64_t) st.st_size;
+
+    uint64_t first = 0;
+    uint64_t last = 0;
+    bool_t partial = false;
+
+    for (HttpHeaderPairList::ConstIterator it = mHeaders.begin(); it != mHeaders.end(); ++it)
+    {
+        if (strcasecmp((*it).first.getData(), "Range") == 0)
+        {
+            partial = true;
+            break;
+        }
+    }
+
+    if (!parseByteRange(fileSize, first, last))
+    {
+        fclose(file);
+
+        Spinlock::ScopeLock lock(mMutex);
+        mInternalHttpRequestState.httpStatus = 416;
+
+        return true;
+    }
+
+    uint64_t contentLength = (fileSize > 0) ? (last - first + 1) : 0;
+
+    HttpHeaderList responseHeaders;
+    FixedString1024 value;
+
+    value.appendFormat("%llu", (unsigned long long) contentLength);
+    responseHeaders.add("Content-Length", value.getData());
+
+    if (partial)
+    {
+        value.clear();
+        value.appendFormat("bytes %llu-%llu/%llu", (unsigned long long) first, (unsigned long long) last,
+                           (unsigned long long) fileSize);
+        responseHeaders.add("Content-Range", value.getData());
+    }
+
+    mMutex.lock();
+    mInternalHttpRequestState.httpStatus = partial ? 206 : 200;
+    mInternalHttpRequestState.totalBytes = contentLength;
+    mInternalHttpRequestState.headers = responseHeaders;
+    mHeadersChanged = true;
+    mMutex.unlock();
+
+    bool_t result = true;
+
+    if (!mHeadOnly && mOutputBuffer != OMAF_NULL)
+    {
+        mOutputBuffer->clear();
+
+        if (mOutputBuffer->getCapacity() < contentLength)
+        {
+            mOutputBuffer->reAllocate((size_t) contentLength);
+        }
+
+        if (fseeko(file, (off_t) first, SEEK_SET) != 0)
+        {
+            result = false;
+        }
+
+        uint64_t totalRead = 0;
+
+        while (result && totalRead < contentLength && getConnectionState() == HttpConnectionState::IN_PROGRESS)
+        {
+            size_t chunk = (size_t)(contentLength - totalRead);
+
+            if (chunk > READ_CHUNK_SIZE)
+            {
+                chunk = READ_CHUNK_SIZE;
+            }
+
+            size_t read = fread(mOutputBuffer->getDataPtr() + totalRead, 1, chunk, file);
+
+            if (read == 0)
+            {
+                result = false;
+                break;
+            }
+
+            totalRead += read;
+            mOutputBuffer->setSize((size_t) totalRead);
+
+            mMutex.lock();
+            mInternalHttpRequestState.bytesDownloaded = totalRead;
+            mMutex.unlock();
+        }
+    }
+
+    fclose(file);
+
+    return result;
+}
+
+Thread::ReturnValue FileHttpConnection::threadEntry(const Thread& thread, void_t* userData)
+{
+    OMAF_UNUSED_VARIABLE(thread);
+    OMAF_UNUSED_VARIABLE(userData);
+
+    while (mThread.isRunning() && !mThread.shouldStop())
+    {
+        if (getConnectionState() == HttpConnectionState::ABORTING)
+        {
+            Spinlock::ScopeLock lock(mMutex);
+            mInternalHttpRequestState.connectionState = HttpConnectionState::ABORTED;
+            mStateChangeEvent.signal();
+        }
+
+        if (getConnectionState() != HttpConnectionState::IN_PROGRESS)
+        {
+            mEvent.wait();
+        }
+
+        if (getConnectionState() != HttpConnectionState::IN_PROGRESS)
+        {
+            continue;
+        }
+
+        bool_t result = doRequest();
+
+        mMutex.lock();
+
+        mUrl.clear();
+
+        mHeaders.clear();
+
+        mInternalHttpRequestState.output = mOutputBuffer;
+        mInternalHttpRequestState.input = OMAF_NULL;
+
+        mOutputBuffer = OMAF_NULL;
+
+        if (result && mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS)
+        {
+            if (mHttpDataProcessor != OMAF_NULL)
+            {
+                mMutex.unlock();
+                mHttpDataProcessor->processHttpData();
+                mMutex.lock();
+            }
+            mInternalHttpRequestState.connectionState = HttpConnectionState::COMPLETED;
+        }
+        else if (mInternalHttpRequestState.connectionState == HttpConnectionState::ABORTING)
+        {
+            mInternalHttpRequestState.connectionState = HttpConnectionState::ABORTED;
+        }
+        else
+        {
+            mInternalHttpRequestState.connectionState = HttpConnectionState::FAILED;
+        }
+
+        mStateChangeEvent.signal();
+
+        mMutex.unlock();
+    }
+
+    return 0;
+}
+
+OMAF_NS_END
@@ -0,0 +1,112 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVREvent.h"
+#include "Foundation/NVRHttpConnection.h"
+#include "Foundation/NVRPathName.h"
+#include "Foundation/NVRSpinlock.h"
+#include "Foundation/NVRThread.h"
+
+OMAF_NS_BEGIN
+
+/*
+ * HttpConnection that serves requests from the local file system, used by the headless Linux build.
+ *
+ * file:// urls are opened as such. For http:// and https:// urls the scheme and authority are dropped and the
+ * remaining path is resolved under the StorageManager path, so that a DASH presentation copied to local disk (or
+ * served from a loopback mount) can be played back without a network stack. Byte range requests are honoured.
+ */
+class FileHttpConnection : public HttpConnection
+{
+public:
+    FileHttpConnection(MemoryAllocator& allocator);
+
+    virtual ~FileHttpConnection();
+
+    virtual const HttpRequestState& getState() const;
+
+    virtual void_t setUserAgent(const utf8_t* aUserAgent);
+
+    virtual void_t setTimeout(uint32_t timeoutMS);
+
+    virtual void_t setHttpDataProcessor(IHttpDataProcessor* aHttpDataProcessor);
+
+    virtual bool_t setUri(const Url& url);
+
+    virtual void_t setHeaders(const HttpHeaderList& headers);
+
+    virtual void_t setKeepAlive(uint32_t timeMS);
+    // Async
+    virtual HttpRequest::Enum get(DataBuffer<uint8_t>* output);
+    // Async
+    virtual HttpRequest::Enum post(const DataBuffer<uint8_t>* input, DataBuffer<uint8_t>* output);
+    // Async
+    virtual HttpRequest::Enum head();
+    // Async
+    virtual void_t abortRequest();
+    // Sync
+    virtual void_t waitForCompletion();
+    // Sync
+    virtual bool_t hasCompleted();
+
+protected:
+    Thread::ReturnValue threadEntry(const Thread& thread, void_t* userData);
+
+private:
+    OMAF_NO_COPY(FileHttpConnection);
+    OMAF_NO_ASSIGN(FileHttpConnection);
+
+    HttpRequest::Enum start(DataBuffer<uint8_t>* output, bool_t headOnly);
+
+    HttpConnectionState::Enum getConnectionState() const;
+
+    void_t checkRequestState();
+
+    bool_t resolvePath(const Url& url, PathName& path) const;
+
+    bool_t parseByteRange(uint64_t fileSize, uint64_t& first, uint64_t& last) const;
+
+    bool_t doRequest();
+
+private:
+    MemoryAllocator& mAllocator;
+
+    Thread mThread;
+
+    mutable Spinlock mMutex;
+
+    Event mEvent;
+
+    Event mStateChangeEvent;
+
+    Url mUrl;
+
+    HttpHeaderList mHeaders;
+
+    DataBuffer<uint8_t>* mOutputBuffer;
+
+    bool_t mHeadOnly;
+
+    mutable HttpRequestState mHttpRequestState;
+
+    mutable bool_t mHeadersChanged;
+
+    HttpRequestState mInternalHttpRequestState;
+
+    IHttpDataProcessor* mHttpDataProcessor;
+};
+
+OMAF_NS_END
@@ -0,0 +1,250 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "NVRHttpConnectionPool.h"
+
+#include "Foundation/NVRConditionVariable.h"
+#include "Foundation/NVRDependencies.h"
+#include "Foundation/NVRMutex.h"
+#include "Foundation/NVRTime.h"
+
+#include <poll.h>
+
+OMAF_NS_BEGIN
+
+namespace HttpConnectionPool
+{
+    static const uint32_t MAX_HOSTS = 16;
+    static const uint32_t MAX_IDLE_SOCKETS_PER_HOST = 8;
+
+    struct IdleSocket
+    {
+        int socket;
+        int32_t expiresMs;
+    };
+
+    struct Host
+    {
+        HostName name;
+        uint16_t port;
+        uint32_t requestsInFlight;
+        IdleSocket idleSockets[MAX_IDLE_SOCKETS_PER_HOST];  // oldest first
+        uint32_t idleSocketCount;
+    };
+
+    static Mutex gMutex;
+    static ConditionVariable gSlotReleased;
+    static Host gHosts[MAX_HOSTS];
+    static uint32_t gHostCount = 0;
+    static uint32_t gMaxRequestsPerHost = DEFAULT_MAX_REQUESTS_PER_HOST;
+
+    // Called with gMutex held. Returns OMAF_NULL if the host is not known and create is false, or if the host table
+    // is full of busy hosts; such requests are then neither pooled nor limited.
+    static Host* findHost(const HostName& name, uint16_t port, bool_t create)
+    {
+        Host* unused = OMAF_NULL;
+
+        for (uint32_t i = 0; i < gHostCount; i++)
+        {
+            Host& host = gHosts[i];
+
+            if (host.port == port && host.name == name)
+            {
+                return &host;
+            }
+
+            if (host.requestsInFlight == 0 && host.idleSocketCount == 0)
+            {
+                unused = &host;
+            }
+        }
+
+        if (!create)
+        {
+            return OMAF_NULL;
+        }
+
+        if (gHostCount < MAX_HOSTS)
+        {
+            unused = &gHosts[gHostCount++];
+        }
+
+        if (unused != OMAF_NULL)
+        {
+            unused->name = name;
+            unused->port = port;
+            unused->requestsInFlight = 0;
+            unused->idleSocketCount = 0;
+        }
+
+        return unused;
+    }
+
+    static void_t removeIdleSocket(Host& host, uint32_t index)
+    {
+        for (uint32_t i = index + 1; i < host.idleSocketCount; i++)
+        {
+            host.idleSockets[i - 1] = host.idleSockets[i];
+        }
+
+        host.idleSocketCount--;
+    }
+
+    static void_t closeExpiredSockets(Host& host, int32_t nowMs)
+    {
+        uint32_t i = 0;
+
+        while (i < host.idleSocketCount)
+        {
+            if (host.idleSockets[i].expiresMs - nowMs <= 0)
+            {
+                ::close(host.idleSockets[i].socket);
+                removeIdleSocket(host, i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    void_t setMaxRequestsPerHost(uint32_t count)
+    {
+        Mutex::ScopeLock lock(gMutex);
+        gMaxRequestsPerHost = count > 0 ? count : 1;
+        gSlotReleased.broadcast();
+    }
+
+    bool_t acquireRequestSlot(const HostName& name, uint16_t port, uint32_t timeoutMS)
+    {
+        Mutex::ScopeLock lock(gMutex);
+
+        Host* host = findHost(name, port, true);
+
+        if (host == OMAF_NULL)
+        {
+            return true;
+        }
+
+        int32_t deadlineMs = Time::getClockTimeMs() + (int32_t) timeoutMS;
+
+        while (host->requestsInFlight >= gMaxRequestsPerHost)
+        {
+            int32_t remainingMs = deadlineMs - Time::getClockTimeMs();
+
+            if (remainingMs <= 0)
+            {
+                return false;
+            }
+
+            gSlotReleased.wait(gMutex, (uint32_t) remainingMs);
+        }
+
+        host->requestsInFlight++;
+
+        return true;
+    }
+
+    void_t releaseRequestSlot(const HostName& name, uint16_t port)
+    {
+        Mutex::ScopeLock lock(gMutex);
+
+        Host* host = findHost(name, port, false);
+
+        if (host != OMAF_NULL && host->requestsInFlight > 0)
+        {
+            host->requestsInFlight--;
+            gSlotReleased.broadcast();
+        }
+    }
+
+    int acquireSocket(const HostName& name, uint16_t port)
+    {
+        Mutex::ScopeLock lock(gMutex);
+
+        Host* host = findHost(name, port, false);
+
+        if (host == OMAF_NULL)
+        {
+            return -1;
+        }
+
+        closeExpiredSockets(*host, Time::getClockTimeMs());
+
+        // newest first, it is the least likely to have been closed by the server
+        while (host->idleSocketCount > 0)
+        {
+            int socket = host->idleSockets[host->idleSocketCount - 1].socket;
+            host->idleSocketCount--;
+
+            // an idle socket should have nothing to read; if it is readable the server has closed it
+            struct pollfd fd = {socket, POLLIN, 0};
+
+            if (::poll(&fd, 1, 0) == 0)
+            {
+                return socket;
+            }
+
+            ::close(socket);
+        }
+
+        return -1;
+    }
+
+    void_t releaseSocket(const HostName& name, uint16_t port, int socket, uint32_t keepAliveMS)
+    {
+        Mutex::ScopeLock lock(gMutex);
+
+        Host* host = (keepAliveMS > 0) ? findHost(name, port, true) : OMAF_NULL;
+
+        if (host == OMAF_NULL)
+        {
+            ::close(socket);
+            return;
+        }
+
+        int32_t nowMs = Time::getClockTimeMs();
+
+        closeExpiredSockets(*host, nowMs);
+
+        if (host->idleSocketCount == MAX_IDLE_SOCKETS_PER_HOST)
+        {
+            ::close(host->idleSockets[0].socket);
+            removeIdleSocket(*host, 0);
+        }
+
+        IdleSocket& idle = host->idleSockets[host->idleSocketCount++];
+        idle.socket = socket;
+        idle.expiresMs = nowMs + (int32_t) keepAliveMS;
+    }
+
+    void_t closeIdleSockets()
+    {
+        Mutex::ScopeLock lock(gMutex);
+
+        for (uint32_t i = 0; i < gHostCount; i++)
+        {
+            Host& host = gHosts[i];
+
+            for (uint32_t j = 0; j < host.idleSocketCount; j++)
+            {
+                ::close(host.idleSockets[j].socket);
+            }
+
+            host.idleSocketCount = 0;
+        }
+    }
+}  // namespace HttpConnectionPool
+
+OMAF_NS_END
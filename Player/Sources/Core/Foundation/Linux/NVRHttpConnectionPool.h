@@ -0,0 +1,55 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVRFixedString.h"
+#include "Platform/OMAFDataTypes.h"
+
+OMAF_NS_BEGIN
+
+/*
+ * Process wide pool of persistent HTTP/1.1 connections used by SocketHttpConnection.
+ *
+ * Sockets whose response has been read completely are handed back here and reused by the next request to the same
+ * host and port, so that the many small tile segment requests of viewport dependent playback do not each pay for a
+ * TCP handshake. Each host also has a bounded number of request slots: every DashSegmentStream downloads on its own
+ * connection thread, and the slots keep those parallel fetches within what a server is expected to handle.
+ */
+namespace HttpConnectionPool
+{
+    typedef FixedString256 HostName;
+
+    static const uint32_t DEFAULT_MAX_REQUESTS_PER_HOST = 6;
+
+    // Sets the number of requests that may be in flight to one host at a time.
+    void_t setMaxRequestsPerHost(uint32_t count);
+
+    // Reserves a request slot for the host. Waits at most timeoutMS for a slot to free up and returns false if none
+    // did.
+    bool_t acquireRequestSlot(const HostName& host, uint16_t port, uint32_t timeoutMS);
+
+    void_t releaseRequestSlot(const HostName& host, uint16_t port);
+
+    // Returns an idle connected socket to the host, or -1 if there is none.
+    int acquireSocket(const HostName& host, uint16_t port);
+
+    // Hands back a socket with no unread response data. It is kept for reuse for keepAliveMS and closed after that.
+    void_t releaseSocket(const HostName& host, uint16_t port, int socket, uint32_t keepAliveMS);
+
+    // Closes all idle sockets.
+    void_t closeIdleSockets();
+}  // namespace HttpConnectionPool
+
+OMAF_NS_END
@@ -0,0 +1,63 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "Foundation/NVRLogger.h"
+
+OMAF_NS_BEGIN
+ConsoleLogger::ConsoleLogger()
+{
+}
+
+ConsoleLogger::~ConsoleLogger()
+{
+}
+
+static void_t logToConsole(char_t level, const char_t* zone, const char_t* format, va_list args)
+{
+    va_list copy;
+    va_copy(copy, args);
+
+    ::fprintf(stderr, "%c/%s: ", level, zone);
+    ::vfprintf(stderr, format, copy);
+    ::fprintf(stderr, "\n");
+    ::fflush(stderr);
+
+    va_end(copy);
+}
+
+void_t ConsoleLogger::logVerbose(const char_t* zone, const char_t* format, va_list args)
+{
+    logToConsole('V', zone, format, args);
+}
+
+void_t ConsoleLogger::logDebug(const char_t* zone, const char_t* format, va_list args)
+{
+    logToConsole('D', zone, format, args);
+}
+
+void_t ConsoleLogger::logInfo(const char_t* zone, const char_t* format, va_list args)
+{
+    logToConsole('I', zone, format, args);
+}
+
+void_t ConsoleLogger::logWarning(const char_t* zone, const char_t* format, va_list args)
+{
+    logToConsole('W', zone, format, args);
+}
+
+void_t ConsoleLogger::logError(const char_t* zone, const char_t* format, va_list args)
+{
+    logToConsole('E', zone, format, args);
+}
+OMAF_NS_END
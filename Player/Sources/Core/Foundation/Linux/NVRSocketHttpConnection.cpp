@@ -0,0 +1,990 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "NVRSocketHttpConnection.h"
+
+#include "Foundation/NVRDependencies.h"
+#include "Foundation/NVRLogger.h"
+#include "Foundation/NVRStringUtilities.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+OMAF_NS_BEGIN
+OMAF_LOG_ZONE(SocketHttpConnection)
+
+static const uint32_t DEFAULT_TIMEOUT_MS = 10000;
+static const uint32_t DEFAULT_KEEP_ALIVE_MS = 30000;
+
+// socket waits are done in slices of this, so that aborts are noticed
+static const int32_t POLL_SLICE_MS = 50;
+
+static const size_t REQUEST_HEADER_SIZE = 8 * 1024;
+static const size_t RESPONSE_LINE_SIZE = 1024;
+
+// HttpHeaderList capacity
+static const uint32_t MAX_RESPONSE_HEADERS = 30;
+
+static const char_t* HTTP_SCHEME = "http://";
+static const char_t* METHOD_NAMES[] = {"GET", "POST", "HEAD"};
+
+static bool_t appendRequestLine(char_t* request, size_t& length, const char_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(request + length, REQUEST_HEADER_SIZE - length, format, args);
+    va_end(args);
+
+    if (written < 0 || (size_t) written >= REQUEST_HEADER_SIZE - length)
+    {
+        return false;
+    }
+
+    length += (size_t) written;
+    return true;
+}
+
+SocketHttpConnection::SocketHttpConnection(MemoryAllocator& allocator)
+    : mAllocator(allocator)
+    , mThread()
+    , mMutex()
+    , mEvent(false, false)
+    , mStateChangeEvent(false, false)
+    , mUrl()
+    , mHeaders()
+    , mUserAgent()
+    , mTimeoutMS(DEFAULT_TIMEOUT_MS)
+    , mKeepAliveMS(DEFAULT_KEEP_ALIVE_MS)
+    , mOutputBuffer(OMAF_NULL)
+    , mInputBuffer(OMAF_NULL)
+    , mMethod(Method::GET)
+    , mReceiveStart(0)
+    , mReceiveEnd(0)
+    , mBytesReceived(0)
+    , mHttpRequestState()
+    , mHeadersChanged(false)
+    , mInternalHttpRequestState()
+    , mHttpDataProcessor(OMAF_NULL)
+{
+    Thread::EntryFunction function;
+    function.bind<SocketHttpConnection, &SocketHttpConnection::threadEntry>(this);
+
+    mThread.setPriority(Thread::Priority::INHERIT);
+    mThread.setName("HTTP::SocketHttpConnection");
+
+    mThread.start(function);
+}
+
+SocketHttpConnection::~SocketHttpConnection()
+{
+    abortRequest();
+    waitForCompletion();
+
+    mMutex.lock();
+    mInternalHttpRequestState.connectionState = HttpConnectionState::INVALID;
+    mMutex.unlock();
+
+    if (mThread.isValid() && mThread.isRunning())
+    {
+        mThread.stop();
+        mEvent.reset();
+        mEvent.signal();
+        mThread.join();
+    }
+}
+
+const HttpRequestState& SocketHttpConnection::getState() const
+{
+    Spinlock::ScopeLock lock(mMutex);
+    mHttpRequestState.connectionState = mInternalHttpRequestState.connectionState;
+    mHttpRequestState.httpStatus = mInternalHttpRequestState.httpStatus;
+
+    if (mHeadersChanged)
+    {
+        mHttpRequestState.headers = mInternalHttpRequestState.headers;
+        mHeadersChanged = false;
+    }
+
+    mHttpRequestState.bytesDownloaded = mInternalHttpRequestState.bytesDownloaded;
+    mHttpRequestState.bytesUploaded = mInternalHttpRequestState.bytesUploaded;
+    mHttpRequestState.totalBytes = mInternalHttpRequestState.totalBytes;
+    mHttpRequestState.input = mInternalHttpRequestState.input;
+    mHttpRequestState.output = mInternalHttpRequestState.output;
+
+    return mHttpRequestState;
+}
+
+void_t SocketHttpConnection::setUserAgent(const utf8_t* aUserAgent)
+{
+    Spinlock::ScopeLock lock(mMutex);
+
+    mUserAgent.clear();
+
+    if (aUserAgent != OMAF_NULL && StringByteLength(aUserAgent) < mUserAgent.getCapacity())
+    {
+        mUserAgent = aUserAgent;
+    }
+}
+
+void_t SocketHttpConnection::setTimeout(uint32_t timeoutMS)
+{
+    Spinlock::ScopeLock lock(mMutex);
+
+    mTimeoutMS = (timeoutMS > 0) ? timeoutMS : DEFAULT_TIMEOUT_MS;
+}
+
+void_t SocketHttpConnection::setHttpDataProcessor(IHttpDataProcessor* aHttpDataProcessor)
+{
+    mHttpDataProcessor = aHttpDataProcessor;
+}
+
+bool_t SocketHttpConnection::setUri(const Url& url)
+{
+    if (url.isEmpty())
+    {
+        return false;
+    }
+
+    Spinlock::ScopeLock lock(mMutex);
+
+    if (mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS ||
+        mInternalHttpRequestState.connectionState == HttpConnectionState::ABORTING)
+    {
+        // not possible to change while in progress
+        return false;
+    }
+
+    checkRequestState();
+
+    mUrl = url;
+
+    mStateChangeEvent.signal();
+    return true;
+}
+
+void_t SocketHttpConnection::setHeaders(const HttpHeaderList& headers)
+{
+    Spinlock::ScopeLock lock(mMutex);
+
+    if ((mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS) ||
+        (mInternalHttpRequestState.connectionState == HttpConnectionState::ABORTING))
+    {
+        // not possible to change while in progress
+        return;
+    }
+
+    mHeaders = headers;
+}
+
+void_t SocketHttpConnection::setKeepAlive(uint32_t timeMS)
+{
+    Spinlock::ScopeLock lock(mMutex);
+
+    // 0 closes the connection after each request
+    mKeepAliveMS = timeMS;
+}
+
+HttpRequest::Enum SocketHttpConnection::get(DataBuffer<uint8_t>* output)
+{
+    return start(OMAF_NULL, output, Method::GET);
+}
+
+HttpRequest::Enum SocketHttpConnection::post(const DataBuffer<uint8_t>* input, DataBuffer<uint8_t>* output)
+{
+    return start(input, output, Method::POST);
+}
+
+HttpRequest::Enum SocketHttpConnection::head()
+{
+    return start(OMAF_NULL, OMAF_NULL, Method::HEAD);
+}
+
+void_t SocketHttpConnection::abortRequest()
+{
+    Spinlock::ScopeLock lock(mMutex);
+
+    if (mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS)
+    {
+        mInternalHttpRequestState.connectionState = HttpConnectionState::ABORTING;
+        mStateChangeEvent.signal();
+    }
+}
+
+void_t SocketHttpConnection::waitForCompletion()
+{
+    // wait for it...
+    for (;;)
+    {
+        if (hasCompleted())
+        {
+            break;
+        }
+        mStateChangeEvent.wait(5000);
+    }
+}
+
+bool_t SocketHttpConnection::hasCompleted()
+{
+    HttpConnectionState::Enum state = getConnectionState();
+    if (state == HttpConnectionState::ABORTED || state == HttpConnectionState::COMPLETED ||
+        state == HttpConnectionState::FAILED || state == HttpConnectionState::IDLE ||
+        state == HttpConnectionState::INVALID)
+    {
+        return true;
+    }
+    return false;
+}
+
+HttpConnectionState::Enum SocketHttpConnection::getConnectionState() const
+{
+    Spinlock::ScopeLock lock(mMutex);
+    return mInternalHttpRequestState.connectionState;
+}
+
+void_t SocketHttpConnection::checkRequestState()
+{
+    if (mInternalHttpRequestState.connectionState != HttpConnectionState::IDLE)
+    {
+        mInternalHttpRequestState = HttpRequestState();
+        mInternalHttpRequestState.connectionState = HttpConnectionState::IDLE;
+
+        mHeadersChanged = true;
+    }
+}
+
+HttpRequest::Enum SocketHttpConnection::start(const DataBuffer<uint8_t>* input,
+                                              DataBuffer<uint8_t>* output,
+                                              Method::Enum method)
+{
+    if (mUrl.isEmpty() || mInternalHttpRequestState.connectionState != HttpConnectionState::IDLE ||
+        !mThread.isValid() || !mThread.isRunning() || mThread.shouldStop())
+    {
+        return HttpRequest::FAILED;
+    }
+
+    OMAF_LOG_D("SocketHttpConnection::start %s %s", METHOD_NAMES[method], mUrl.getData());
+
+    mMutex.lock();
+
+    mMethod = method;
+    mInputBuffer = input;
+    mOutputBuffer = output;
+    mInternalHttpRequestState.connectionState = HttpConnectionState::IN_PROGRESS;
+
+    mStateChangeEvent.signal();
+
+    mMutex.unlock();
+
+    mEvent.reset();
+    mEvent.signal();
+
+    return HttpRequest::OK;
+}
+
+bool_t SocketHttpConnection::parseUrl(const Url& url,
+                                      HttpConnectionPool::HostName& host,
+                                      uint16_t& port,
+                                      Url& target) const
+{
+    if (url.findFirst(HTTP_SCHEME) != 0)
+    {
+        return false;
+    }
+
+    // findFirst() returns the position relative to the start index
+    size_t authorityStart = strlen(HTTP_SCHEME);
+    size_t pathStart = url.findFirst("/", authorityStart);
+
+    if (pathStart != Npos)
+    {
+        pathStart += authorityStart;
+    }
+
+    Url authority = url.substring(authorityStart, (pathStart == Npos) ? Npos : pathStart - authorityStart);
+
+    target = (pathStart == Npos) ? Url("/") : url.substring(pathStart);
+
+    size_t fragmentStart = target.findFirst("#");
+
+    if (fragmentStart != Npos)
+    {
+        target = target.substring(0, fragmentStart);
+    }
+
+    port = 80;
+
+    // a colon after the closing bracket of an IPv6 literal starts the port
+    size_t portStart = authority.findLast(":");
+
+    if (portStart != Npos && authority.findFirst("]", portStart) == Npos &&
+        (authority.findFirst("[") == Npos || authority.findFirst("]") != Npos))
+    {
+        int value = atoi(authority.getData() + portStart + 1);
+
+        if (value <= 0 || value > 65535)
+        {
+            return false;
+        }
+
+        port = (uint16_t) value;
+        authority = authority.substring(0, portStart);
+    }
+
+    if (authority.getLength() > 2 && authority.getData()[0] == '[' &&
+        authority.getData()[authority.getLength() - 1] == ']')
+    {
+        authority = authority.substring(1, authority.getLength() - 2);
+    }
+
+    if (authority.isEmpty() || authority.getLength() >= host.getCapacity())
+    {
+        return false;
+    }
+
+    host = authority.getData();
+
+    return true;
+}
+
+int SocketHttpConnection::connectTo(const HttpConnectionPool::HostName& host, uint16_t port)
+{
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    char_t service[8];
+    snprintf(service, sizeof(service), "%u", (uint32_t) port);
+
+    struct addrinfo* addresses = NULL;
+    int status = ::getaddrinfo(host.getData(), service, &hints, &addresses);
+
+    if (status != 0)
+    {
+        OMAF_LOG_W("Cannot resolve %s: %s", host.getData(), gai_strerror(status));
+        return -1;
+    }
+
+    int result = -1;
+
+    for (struct addrinfo* address = addresses; address != NULL && result < 0; address = address->ai_next)
+    {
+        int socket =
+            ::socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, address->ai_protocol);
+
+        if (socket < 0)
+        {
+            continue;
+        }
+
+        // requests are written in one go, do not hold them back
+        int noDelay = 1;
+        ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        if (::connect(socket, address->ai_addr, address->ai_addrlen) == 0 ||
+            (errno == EINPROGRESS && waitSocket(socket, POLLOUT)))
+        {
+            int error = 0;
+            socklen_t length = sizeof(error);
+
+            if (::getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0)
+            {
+                result = socket;
+                continue;
+            }
+        }
+
+        ::close(socket);
+    }
+
+    ::freeaddrinfo(addresses);
+
+    if (result < 0)
+    {
+        OMAF_LOG_W("Cannot connect to %s:%u", host.getData(), (uint32_t) port);
+    }
+
+    return result;
+}
+
+bool_t SocketHttpConnection::waitSocket(int socket, int16_t events)
+{
+    int32_t waitedMs = 0;
+
+    while (getConnectionState() == HttpConnectionState::IN_PROGRESS)
+    {
+        struct pollfd fd = {socket, events, 0};
+        int ready = ::poll(&fd, 1, POLL_SLICE_MS);
+
+        if (ready > 0)
+        {
+            // errors and hangups are reported by the following socket call
+            return true;
+        }
+
+        if (ready < 0 && errno != EINTR)
+        {
+            return false;
+        }
+
+        waitedMs += POLL_SLICE_MS;
+
+        if (waitedMs >= (int32_t) mTimeoutMS)
+        {
+            OMAF_LOG_W("Request timed out: %s", mUrl.getData());
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool_t SocketHttpConnection::sendAll(int socket, const uint8_t* data, size_t size)
+{
+    size_t sent = 0;
+
+    while (sent < size)
+    {
+        ssize_t count = ::send(socket, data + sent, size - sent, MSG_NOSIGNAL);
+
+        if (count > 0)
+        {
+            sent += (size_t) count;
+        }
+        else if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            if (!waitSocket(socket, POLLOUT))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int32_t SocketHttpConnection::receive(int socket)
+{
+    // Refills the receive buffer. Returns the number of bytes received, 0 if the server closed the connection and -1
+    // on errors, timeouts and aborts.
+    mReceiveStart = 0;
+    mReceiveEnd = 0;
+
+    // Servers that write the response headers and body separately would otherwise stall on Nagle's algorithm until
+    // our delayed ACK; Linux clears quick ACK mode on its own, so it is renewed per read.
+    int quickAck = 1;
+    ::setsockopt(socket, IPPROTO_TCP, TCP_QUICKACK, &quickAck, sizeof(quickAck));
+
+    for (;;)
+    {
+        ssize_t count = ::recv(socket, mReceiveBuffer, RECEIVE_BUFFER_SIZE, 0);
+
+        if (count >= 0)
+        {
+            mReceiveEnd = (size_t) count;
+            mBytesReceived += (uint64_t) count;
+
+            return (int32_t) count;
+        }
+
+        if (errno == EINTR)
+        {
+            continue;
+        }
+
+        if ((errno != EAGAIN && errno != EWOULDBLOCK) || !waitSocket(socket, POLLIN))
+        {
+            return -1;
+        }
+    }
+}
+
+bool_t SocketHttpConnection::readLine(int socket, char_t* line, size_t capacity)
+{
+    // overlong lines are truncated
+    size_t length = 0;
+
+    for (;;)
+    {
+        if (mReceiveStart == mReceiveEnd && receive(socket) <= 0)
+        {
+            return false;
+        }
+
+        const uint8_t* begin = mReceiveBuffer + mReceiveStart;
+        size_t available = mReceiveEnd - mReceiveStart;
+        const uint8_t* newline = (const uint8_t*) memchr(begin, '\n', available);
+        size_t count = (newline != NULL) ? (size_t)(newline - begin) : available;
+        size_t copied = (count < capacity - 1 - length) ? count : capacity - 1 - length;
+
+        memcpy(line + length, begin, copied);
+        length += copied;
+        mReceiveStart += count;
+
+        if (newline != NULL)
+        {
+            mReceiveStart++;
+
+            if (length > 0 && line[length - 1] == '\r')
+            {
+                length--;
+            }
+
+            line[length] = '\0';
+
+            return true;
+        }
+    }
+}
+
+void_t SocketHttpConnection::appendOutput(const uint8_t* data, size_t size)
+{
+    if (mOutputBuffer != OMAF_NULL)
+    {
+        size_t required = mOutputBuffer->getSize() + size;
+
+        if (required > mOutputBuffer->getCapacity())
+        {
+            size_t capacity = mOutputBuffer->getCapacity() * 2;
+            mOutputBuffer->reserve(capacity > required ? capacity : required);
+        }
+
+        memcpy(mOutputBuffer->getDataPtr() + mOutputBuffer->getSize(), data, size);
+        mOutputBuffer->setSize(required);
+    }
+
+    Spinlock::ScopeLock lock(mMutex);
+    mInternalHttpRequestState.bytesDownloaded += size;
+}
+
+bool_t SocketHttpConnection::readBody(int socket, uint64_t length)
+{
+    uint64_t remaining = length;
+
+    while (remaining > 0)
+    {
+        if (mReceiveStart == mReceiveEnd && receive(socket) <= 0)
+        {
+            return false;
+        }
+
+        size_t available = mReceiveEnd - mReceiveStart;
+        size_t count = (available < remaining) ? available : (size_t) remaining;
+
+        appendOutput(mReceiveBuffer + mReceiveStart, count);
+
+        mReceiveStart += count;
+        remaining -= count;
+    }
+
+    return true;
+}
+
+bool_t SocketHttpConnection::readChunkedBody(int socket)
+{
+    char_t line[RESPONSE_LINE_SIZE];
+
+    for (;;)
+    {
+        if (!readLine(socket, line, RESPONSE_LINE_SIZE))
+        {
+            return false;
+        }
+
+        // chunk extensions after the size are ignored
+        char_t* end = NULL;
+        uint64_t chunkSize = strtoull(line, &end, 16);
+
+        if (end == line)
+        {
+            return false;
+        }
+
+        if (chunkSize == 0)
+        {
+            break;
+        }
+
+        if (!readBody(socket, chunkSize) || !readLine(socket, line, RESPONSE_LINE_SIZE))
+        {
+            return false;
+        }
+    }
+
+    // trailer, ends with an empty line
+    do
+    {
+        if (!readLine(socket, line, RESPONSE_LINE_SIZE))
+        {
+            return false;
+        }
+    } while (line[0] != '\0');
+
+    return true;
+}
+
+bool_t SocketHttpConnection::readBodyUntilClose(int socket)
+{
+    for (;;)
+    {
+        if (mReceiveStart < mReceiveEnd)
+        {
+            appendOutput(mReceiveBuffer + mReceiveStart, mReceiveEnd - mReceiveStart);
+            mReceiveStart = mReceiveEnd;
+        }
+
+        int32_t count = receive(socket);
+
+        if (count == 0)
+        {
+            return true;
+        }
+
+        if (count < 0)
+        {
+            return false;
+        }
+    }
+}
+
+SocketHttpConnection::ExchangeResult::Enum SocketHttpConnection::exchange(int socket,
+                                                                          const HttpConnectionPool::HostName& host,
+                                                                          uint16_t port,
+                                                                          const Url& target)
+{
+    char_t request[REQUEST_HEADER_SIZE];
+    size_t length = 0;
+
+    // IPv6 literals are bracketed in the Host header
+    const char_t* hostFormat = (host.findFirst(":") != Npos) ? "Host: [%s]" : "Host: %s";
+    size_t bodySize = (mMethod == Method::POST && mInputBuffer != OMAF_NULL) ? mInputBuffer->getSize() : 0;
+
+    bool_t result = appendRequestLine(request, length, "%s %s HTTP/1.1\r\n", METHOD_NAMES[mMethod], target.getData()) &&
+                    appendRequestLine(request, length, hostFormat, host.getData()) &&
+                    ((port == 80) ? appendRequestLine(request, length, "\r\n")
+                                  : appendRequestLine(request, length, ":%u\r\n", (uint32_t) port)) &&
+                    (mUserAgent.isEmpty() ||
+                     appendRequestLine(request, length, "User-Agent: %s\r\n", mUserAgent.getData())) &&
+                    appendRequestLine(request, length, "Connection: %s\r\n",
+                                      (mKeepAliveMS > 0) ? "keep-alive" : "close");
+
+    for (HttpHeaderPairList::ConstIterator it = mHeaders.begin(); result && it != mHeaders.end(); ++it)
+    {
+        result = appendRequestLine(request, length, "%s: %s\r\n", (*it).first.getData(), (*it).second.getData());
+    }
+
+    if (result && mMethod == Method::POST)
+    {
+        result = appendRequestLine(request, length, "Content-Length: %zu\r\n", bodySize);
+    }
+
+    if (!result || !appendRequestLine(request, length, "\r\n"))
+    {
+        OMAF_LOG_E("Request headers too long: %s", mUrl.getData());
+        return ExchangeResult::FAILED;
+    }
+
+    mReceiveStart = 0;
+    mReceiveEnd = 0;
+    mBytesReceived = 0;
+
+    if (!sendAll(socket, (const uint8_t*) request, length) ||
+        (bodySize > 0 && !sendAll(socket, mInputBuffer->getDataPtr(), bodySize)))
+    {
+        return ExchangeResult::NO_RESPONSE;
+    }
+
+    mMutex.lock();
+    mInternalHttpRequestState.bytesUploaded = bodySize;
+    mMutex.unlock();
+
+    char_t line[RESPONSE_LINE_SIZE];
+    int status = 0;
+    int64_t contentLength = -1;
+    bool_t chunked = false;
+    bool_t close = false;
+    HttpHeaderList headers;
+
+    // interim 1xx responses are skipped
+    do
+    {
+        if (!readLine(socket, line, RESPONSE_LINE_SIZE))
+        {
+            return (mBytesReceived == 0) ? ExchangeResult::NO_RESPONSE : ExchangeResult::FAILED;
+        }
+
+        int major = 0;
+        int minor = 0;
+
+        if (sscanf(line, "HTTP/%d.%d %d", &major, &minor, &status) != 3)
+        {
+            OMAF_LOG_W("Malformed status line from %s", host.getData());
+            return ExchangeResult::FAILED;
+        }
+
+        // HTTP/1.0 closes unless told otherwise
+        close = (mKeepAliveMS == 0) || (major == 1 && minor == 0);
+        contentLength = -1;
+        chunked = false;
+        headers.clear();
+
+        uint32_t headerCount = 0;
+
+        for (;;)
+        {
+            if (!readLine(socket, line, RESPONSE_LINE_SIZE))
+            {
+                return ExchangeResult::FAILED;
+            }
+
+            if (line[0] == '\0')
+            {
+                break;
+            }
+
+            char_t* value = strchr(line, ':');
+
+            if (value == NULL)
+            {
+                continue;
+            }
+
+            *value++ = '\0';
+
+            while (*value == ' ' || *value == '\t')
+            {
+                value++;
+            }
+
+            if (strcasecmp(line, "Content-Length") == 0)
+            {
+                contentLength = strtoll(value, NULL, 10);
+            }
+            else if (strcasecmp(line, "Transfer-Encoding") == 0)
+            {
+                chunked = (strcasestr(value, "chunked") != NULL);
+            }
+            else if (strcasecmp(line, "Connection") == 0)
+            {
+                if (strcasestr(value, "close") != NULL)
+                {
+                    close = true;
+                }
+                else if (strcasestr(value, "keep-alive") != NULL && mKeepAliveMS > 0)
+                {
+                    close = false;
+                }
+            }
+
+            if (headerCount < MAX_RESPONSE_HEADERS && strlen(line) < HttpHeaderPair().first.getCapacity())
+            {
+                headers.add(line, value);
+                headerCount++;
+            }
+        }
+    } while (status >= 100 && status < 200);
+
+    mMutex.lock();
+    mInternalHttpRequestState.httpStatus = status;
+    mInternalHttpRequestState.totalBytes = (contentLength >= 0 && !chunked) ? (uint64_t) contentLength : (uint64_t) -1;
+    mInternalHttpRequestState.headers = headers;
+    mHeadersChanged = true;
+    mMutex.unlock();
+
+    if (mOutputBuffer != OMAF_NULL)
+    {
+        mOutputBuffer->clear();
+    }
+
+    if (mMethod == Method::HEAD || status == 204 || status == 304)
+    {
+        // no body
+        result = true;
+    }
+    else if (chunked)
+    {
+        result = readChunkedBody(socket);
+    }
+    else if (contentLength >= 0)
+    {
+        if (mOutputBuffer != OMAF_NULL && mOutputBuffer->getCapacity() < (uint64_t) contentLength)
+        {
+            mOutputBuffer->reAllocate((size_t) contentLength);
+        }
+
+        result = readBody(socket, (uint64_t) contentLength);
+    }
+    else
+    {
+        result = readBodyUntilClose(socket);
+        close = true;
+    }
+
+    if (!result)
+    {
+        return ExchangeResult::FAILED;
+    }
+
+    // anything after the response was not asked for, do not let it leak into the next request
+    if (close || mReceiveStart != mReceiveEnd)
+    {
+        return ExchangeResult::COMPLETED_CLOSE;
+    }
+
+    return ExchangeResult::COMPLETED;
+}
+
+bool_t SocketHttpConnection::doRequest()
+{
+    HttpConnectionPool::HostName host;
+    uint16_t port = 0;
+    Url target;
+
+    if (!parseUrl(mUrl, host, port, target))
+    {
+        OMAF_LOG_E("Unsupported url: %s", mUrl.getData());
+        return false;
+    }
+
+    int32_t waitedMs = 0;
+
+    while (!HttpConnectionPool::acquireRequestSlot(host, port, POLL_SLICE_MS))
+    {
+        waitedMs += POLL_SLICE_MS;
+
+        if (getConnectionState() != HttpConnectionState::IN_PROGRESS || waitedMs >= (int32_t) mTimeoutMS)
+        {
+            return false;
+        }
+    }
+
+    ExchangeResult::Enum result = ExchangeResult::FAILED;
+
+    // A pooled socket may have been closed by the server after the liveness check, so a request that got no response
+    // on one is retried once on a new connection. POSTs are not retried.
+    for (uint32_t attempt = 0; attempt < 2; attempt++)
+    {
+        int socket = HttpConnectionPool::acquireSocket(host, port);
+        bool_t reused = (socket >= 0);
+
+        if (!reused)
+        {
+            socket = connectTo(host, port);
+        }
+
+        if (socket < 0)
+        {
+            break;
+        }
+
+        result = exchange(socket, host, port, target);
+
+        if (result == ExchangeResult::COMPLETED)
+        {
+            HttpConnectionPool::releaseSocket(host, port, socket, mKeepAliveMS);
+        }
+        else
+        {
+            ::close(socket);
+        }
+
+        if (result != ExchangeResult::NO_RESPONSE || !reused || mMethod == Method::POST ||
+            getConnectionState() != HttpConnectionState::IN_PROGRESS)
+        {
+            break;
+        }
+    }
+
+    HttpConnectionPool::releaseRequestSlot(host, port);
+
+    return (result == ExchangeResult::COMPLETED || result == ExchangeResult::COMPLETED_CLOSE);
+}
+
+Thread::ReturnValue SocketHttpConnection::threadEntry(const Thread& thread, void_t* userData)
+{
+    OMAF_UNUSED_VARIABLE(thread);
+    OMAF_UNUSED_VARIABLE(userData);
+
+    while (mThread.isRunning() && !mThread.shouldStop())
+    {
+        if (getConnectionState() == HttpConnectionState::ABORTING)
+        {
+            Spinlock::ScopeLock lock(mMutex);
+            mInternalHttpRequestState.connectionState = HttpConnectionState::ABORTED;
+            mStateChangeEvent.signal();
+        }
+
+        if (getConnectionState() != HttpConnectionState::IN_PROGRESS)
+        {
+            mEvent.wait();
+        }
+
+        if (getConnectionState() != HttpConnectionState::IN_PROGRESS)
+        {
+            continue;
+        }
+
+        bool_t result = doRequest();
+
+        mMutex.lock();
+
+        mUrl.clear();
+
+        mHeaders.clear();
+
+        mInternalHttpRequestState.output = mOutputBuffer;
+        mInternalHttpRequestState.input = mInputBuffer;
+
+        mOutputBuffer = OMAF_NULL;
+        mInputBuffer = OMAF_NULL;
+
+        if (result && mInternalHttpRequestState.connectionState == HttpConnectionState::IN_PROGRESS)
+        {
+            if (mHttpDataProcessor != OMAF_NULL)
+            {
+                mMutex.unlock();
+                mHttpDataProcessor->processHttpData();
+                mMutex.lock();
+            }
+            mInternalHttpRequestState.connectionState = HttpConnectionState::COMPLETED;
+        }
+        else if (mInternalHttpRequestState.connectionState == HttpConnectionState::ABORTING)
+        {
+            mInternalHttpRequestState.connectionState = HttpConnectionState::ABORTED;
+        }
+        else
+        {
+            mInternalHttpRequestState.connectionState = HttpConnectionState::FAILED;
+        }
+
+        mStateChangeEvent.signal();
+
+        mMutex.unlock();
+    }
+
+    return 0;
+}
+
+OMAF_NS_END
@@ -0,0 +1,173 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVREvent.h"
+#include "Foundation/NVRHttpConnection.h"
+#include "Foundation/NVRSpinlock.h"
+#include "Foundation/NVRThread.h"
+
+#include "NVRHttpConnectionPool.h"
+
+OMAF_NS_BEGIN
+
+/*
+ * HttpConnection over POSIX sockets, used by the Linux build.
+ *
+ * Speaks plain HTTP/1.1 (no TLS). Connections are kept alive and shared with other instances through
+ * HttpConnectionPool, which also bounds the number of concurrent requests per host. Requests run on a worker thread
+ * per instance like on the other platforms; socket waits are sliced so that aborts are noticed promptly.
+ */
+class SocketHttpConnection : public HttpConnection
+{
+public:
+    SocketHttpConnection(MemoryAllocator& allocator);
+
+    virtual ~SocketHttpConnection();
+
+    virtual const HttpRequestState& getState() const;
+
+    virtual void_t setUserAgent(const utf8_t* aUserAgent);
+
+    virtual void_t setTimeout(uint32_t timeoutMS);
+
+    virtual void_t setHttpDataProcessor(IHttpDataProcessor* aHttpDataProcessor);
+
+    virtual bool_t setUri(const Url& url);
+
+    virtual void_t setHeaders(const HttpHeaderList& headers);
+
+    virtual void_t setKeepAlive(uint32_t timeMS);
+    // Async
+    virtual HttpRequest::Enum get(DataBuffer<uint8_t>* output);
+    // Async
+    virtual HttpRequest::Enum post(const DataBuffer<uint8_t>* input, DataBuffer<uint8_t>* output);
+    // Async
+    virtual HttpRequest::Enum head();
+    // Async
+    virtual void_t abortRequest();
+    // Sync
+    virtual void_t waitForCompletion();
+    // Sync
+    virtual bool_t hasCompleted();
+
+protected:
+    Thread::ReturnValue threadEntry(const Thread& thread, void_t* userData);
+
+private:
+    OMAF_NO_COPY(SocketHttpConnection);
+    OMAF_NO_ASSIGN(SocketHttpConnection);
+
+    struct Method
+    {
+        enum Enum
+        {
+            GET,
+            POST,
+            HEAD
+        };
+    };
+
+    struct ExchangeResult
+    {
+        enum Enum
+        {
+            COMPLETED,        // response read, socket can be reused
+            COMPLETED_CLOSE,  // response read, socket must be closed
+            NO_RESPONSE,      // nothing received, a reused socket may have been closed by the server
+            FAILED
+        };
+    };
+
+    HttpRequest::Enum start(const DataBuffer<uint8_t>* input, DataBuffer<uint8_t>* output, Method::Enum method);
+
+    HttpConnectionState::Enum getConnectionState() const;
+
+    void_t checkRequestState();
+
+    bool_t parseUrl(const Url& url, HttpConnectionPool::HostName& host, uint16_t& port, Url& target) const;
+
+    int connectTo(const HttpConnectionPool::HostName& host, uint16_t port);
+
+    bool_t waitSocket(int socket, int16_t events);
+
+    bool_t sendAll(int socket, const uint8_t* data, size_t size);
+
+    int32_t receive(int socket);
+
+    bool_t readLine(int socket, char_t* line, size_t capacity);
+
+    bool_t readBody(int socket, uint64_t length);
+
+    bool_t readChunkedBody(int socket);
+
+    bool_t readBodyUntilClose(int socket);
+
+    void_t appendOutput(const uint8_t* data, size_t size);
+
+    ExchangeResult::Enum exchange(int socket,
+                                  const HttpConnectionPool::HostName& host,
+                                  uint16_t port,
+                                  const Url& target);
+
+    bool_t doRequest();
+
+private:
+    static const uint32_t RECEIVE_BUFFER_SIZE = 16 * 1024;
+
+    MemoryAllocator& mAllocator;
+
+    Thread mThread;
+
+    mutable Spinlock mMutex;
+
+    Event mEvent;
+
+    Event mStateChangeEvent;
+
+    Url mUrl;
+
+    HttpHeaderList mHeaders;
+
+    FixedString1024 mUserAgent;
+
+    uint32_t mTimeoutMS;
+
+    uint32_t mKeepAliveMS;
+
+    DataBuffer<uint8_t>* mOutputBuffer;
+
+    const DataBuffer<uint8_t>* mInputBuffer;
+
+    Method::Enum mMethod;
+
+    uint8_t mReceiveBuffer[RECEIVE_BUFFER_SIZE];
+
+    size_t mReceiveStart;
+
+    size_t mReceiveEnd;
+
+    uint64_t mBytesReceived;
+
+    mutable HttpRequestState mHttpRequestState;
+
+    mutable bool_t mHeadersChanged;
+
+    HttpRequestState mInternalHttpRequestState;
+
+    IHttpDataProcessor* mHttpDataProcessor;
+};
+
+OMAF_NS_END
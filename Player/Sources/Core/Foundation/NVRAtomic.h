@@ -281,6 +281,71 @@ namespace Atomic
 
 #error Unsupported platform
 
+#endif
+    }
+
+    //
+    // Ordered loads and stores for publishing data between threads without a full read-modify-write
+    //
+
+    OMAF_INLINE int32_t loadAcquire(OMAF_VOLATILE int32_t* ptr)
+    {
+        OMAF_ASSERT_ALIGNMENT(ptr, 4, 0);
+
+#if OMAF_COMPILER_CL
+
+        return _InterlockedCompareExchange((LONG volatile*) ptr, 0, 0);
+
+#elif OMAF_COMPILER_LLVM || OMAF_COMPILER_GCC
+
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+
+#else
+
+#error Unsupported platform
+
+#endif
+    }
+
+    OMAF_INLINE void_t storeRelease(OMAF_VOLATILE int32_t* ptr, int32_t value)
+    {
+        OMAF_ASSERT_ALIGNMENT(ptr, 4, 0);
+
+#if OMAF_COMPILER_CL
+
+        _InterlockedExchange((LONG volatile*) ptr, value);
+
+#elif OMAF_COMPILER_LLVM || OMAF_COMPILER_GCC
+
+        __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+
+#else
+
+#error Unsupported platform
+
+#endif
+    }
+
+    //
+    // Pointer operations
+    //
+
+    OMAF_INLINE void_t* exchangePointer(void_t* OMAF_VOLATILE* ptr, void_t* value)
+    {
+        OMAF_ASSERT_ALIGNMENT(ptr, sizeof(void_t*), 0);
+
+#if OMAF_COMPILER_CL
+
+        return _InterlockedExchangePointer(ptr, value);
+
+#elif OMAF_COMPILER_LLVM || OMAF_COMPILER_GCC
+
+        return __atomic_exchange_n(ptr, value, __ATOMIC_ACQ_REL);
+
+#else
+
+#error Unsupported platform
+
 #endif
     }
 }  // namespace Atomic
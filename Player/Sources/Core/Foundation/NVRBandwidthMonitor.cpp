@@ -19,6 +19,8 @@
 #include "Math/OMAFMathFunctions.h"
 #if OMAF_PLATFORM_ANDROID
 #include "Foundation/Android/NVRBandwidthMonitorAndroid.h"
+#elif OMAF_PLATFORM_LINUX
+#include "Foundation/Linux/NVRBandwidthMonitorLinux.h"
 #else
 #include "Foundation/Windows/NVRBandwidthMonitorWindows.h"
 #endif
@@ -35,6 +37,8 @@ BandwidthMonitor* BandwidthMonitor::getInstance()
     {
 #if OMAF_PLATFORM_ANDROID
         sInstance = OMAF_NEW_HEAP(BandwidthMonitorAndroid);
+#elif OMAF_PLATFORM_LINUX
+        sInstance = OMAF_NEW_HEAP(BandwidthMonitorLinux);
 #else
         sInstance = OMAF_NEW_HEAP(BandwidthMonitorWindows);
 #endif
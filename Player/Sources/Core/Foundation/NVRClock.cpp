@@ -29,7 +29,7 @@ namespace Clock
 
     static uint64_t _startTicks = 0;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     static timeval _startTime = {0, 0};
 
@@ -59,7 +59,7 @@ namespace Clock
 
         _startTicks = counter.QuadPart;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
         _ticksPerSecond = CLOCKS_PER_SEC;
         _secondsPerTick = 1.0 / (float64_t) CLOCKS_PER_SEC;
@@ -89,7 +89,7 @@ namespace Clock
 
         return ticks;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
         return (CLOCKS_PER_SEC * getSeconds());
 
@@ -113,7 +113,7 @@ namespace Clock
 
         return (uint64_t) ms;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
         struct timeval currentTime;
         ::gettimeofday(&currentTime, NULL);
@@ -183,7 +183,7 @@ namespace Clock
 
         return seconds;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
         struct timeval currentTime;
         ::gettimeofday(&currentTime, NULL);
@@ -214,7 +214,7 @@ namespace Clock
         secondsSince1601.HighPart = fileTime.dwHighDateTime;
         elapsedSec = (time_t)((secondsSince1601.QuadPart - epoch) / 10000000L);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
         struct timeval tv;
         ::gettimeofday(&tv, NULL);
         elapsedSec = tv.tv_sec;
@@ -238,7 +238,7 @@ namespace Clock
 
         seed = secondsSince1601.QuadPart / 10;  // 1 unit == 100 nanosecond; use microseconds like in other platforms
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
         struct timeval tv;
         ::gettimeofday(&tv, NULL);
         seed = tv.tv_usec;
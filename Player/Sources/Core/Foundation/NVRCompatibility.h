@@ -20,6 +20,10 @@
 
 #include "Foundation/Android/NVRCompatibility.h"
 
+#elif OMAF_PLATFORM_LINUX
+
+#include "Foundation/Linux/NVRCompatibility.h"
+
 #elif OMAF_PLATFORM_WINDOWS
 
 #include "Foundation/Windows/NVRCompatibility.h"
@@ -30,7 +30,7 @@ ConditionVariable::ConditionVariable()
 
     ::InitializeConditionVariable(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     pthread_condattr_t attr;
     ::pthread_condattr_init(&attr);
@@ -50,7 +50,7 @@ ConditionVariable::~ConditionVariable()
 {
 #if OMAF_PLATFORM_WINDOWS || OMAF_PLATFORM_UWP
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_cond_destroy(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -69,7 +69,7 @@ void_t ConditionVariable::wait(Mutex& mutex)
 
     ::SleepConditionVariableCS(&mHandle, &mutex.mHandle, INFINITE);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_cond_wait(&mHandle, &mutex.mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -93,7 +93,7 @@ void_t ConditionVariable::wait(Mutex& mutex, uint32_t timeoutMs)
 
     ::SleepConditionVariableCS(&mHandle, &mutex.mHandle, timeoutMs);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     struct timespec ts;
     ::clock_gettime(CLOCK_REALTIME, &ts);
@@ -123,7 +123,7 @@ void_t ConditionVariable::signal()
 
     ::WakeConditionVariable(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_cond_signal(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -142,7 +142,7 @@ void_t ConditionVariable::broadcast()
 
     ::WakeAllConditionVariable(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_cond_broadcast(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
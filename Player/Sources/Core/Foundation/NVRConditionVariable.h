@@ -42,7 +42,7 @@ public:
 
     typedef CONDITION_VARIABLE Handle;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     typedef pthread_cond_t Handle;
 
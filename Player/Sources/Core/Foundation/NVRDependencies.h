@@ -47,6 +47,18 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#elif OMAF_PLATFORM_LINUX
+
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
 #elif OMAF_PLATFORM_WINDOWS
 
 #define WIN32_LEAN_AND_MEAN
@@ -52,11 +52,7 @@ int64_t DiskFileStream::readImpl(void_t* destination, int64_t bytes)
 
 int64_t DiskFileStream::writeImpl(const void_t* source, int64_t bytes)
 {
-    OMAF_UNUSED_VARIABLE(source);
-    OMAF_UNUSED_VARIABLE(bytes);
-    OMAF_ASSERT_NOT_IMPLEMENTED();
-
-    return 0;
+    return DiskManager::Write(mFileHandle, source, bytes);
 }
 
 bool_t DiskFileStream::seekImpl(int64_t offset)
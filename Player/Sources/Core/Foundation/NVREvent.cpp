@@ -18,7 +18,7 @@
 
 OMAF_NS_BEGIN
 
-#if OMAF_PLATFORM_ANDROID
+#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
 // http://www.cs.wustl.edu/~schmidt/win32-cv-1.html
 // http://www.cs.wustl.edu/~schmidt/win32-cv-2.html
@@ -156,7 +156,7 @@ Event::Event(bool_t manualReset, bool_t initialState)
     mHandle = ::CreateEvent(NULL, manualReset, initialState, NULL);
     OMAF_ASSERT(mHandle != NULL, "Failed to create condition");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     eventInit(&mHandle, manualReset, initialState);
 
@@ -170,7 +170,7 @@ Event::~Event()
     BOOL result = ::CloseHandle(mHandle);
     OMAF_ASSERT(result == TRUE, "Failed to close condition");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     eventDestroy(&mHandle);
 
@@ -184,7 +184,7 @@ void_t Event::signal()
     BOOL result = ::SetEvent(mHandle);
     OMAF_ASSERT(result == TRUE, "Failed to signal condition");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     eventSignal(&mHandle);
 
@@ -198,7 +198,7 @@ void_t Event::reset()
     BOOL result = ::ResetEvent(mHandle);
     OMAF_ASSERT(result == TRUE, "Failed to reset condition");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     eventReset(&mHandle);
 
@@ -213,7 +213,7 @@ bool_t Event::wait()
 
     return (result == WAIT_OBJECT_0);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     return eventWait(&mHandle, NULL);
 
@@ -235,7 +235,7 @@ bool_t Event::wait(uint32_t timeoutMs)
 
     return true;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     // pthread_cond_timedwait takes absolute time
     timespec abstime;
@@ -45,7 +45,7 @@ public:
 
     typedef void* Handle;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     struct Handle
     {
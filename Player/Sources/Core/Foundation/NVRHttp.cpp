@@ -42,6 +42,14 @@ OMAF_NS_END
 
 #include "Android/NVRAndroidHttpConnection.h"
 
+#elif OMAF_PLATFORM_LINUX && OMAF_LINUX_FILE_HTTP
+
+#include "Linux/NVRFileHttpConnection.h"
+
+#elif OMAF_PLATFORM_LINUX
+
+#include "Linux/NVRSocketHttpConnection.h"
+
 #endif
 
 OMAF_NS_BEGIN
@@ -79,6 +87,10 @@ namespace Http
             createHttpConnectionWIN(allocator);
 #elif OMAF_PLATFORM_ANDROID
             OMAF_NEW(allocator, AndroidHttpConnection)(allocator);
+#elif OMAF_PLATFORM_LINUX && OMAF_LINUX_FILE_HTTP
+            OMAF_NEW(allocator, FileHttpConnection)(allocator);
+#elif OMAF_PLATFORM_LINUX
+            OMAF_NEW(allocator, SocketHttpConnection)(allocator);
 #else
 #error No HttpConnection defined
 #endif
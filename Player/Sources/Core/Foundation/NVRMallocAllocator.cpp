@@ -42,33 +42,88 @@ MallocAllocator::MallocAllocator(const char_t* name)
 MallocAllocator::~MallocAllocator()
 {
 #if OMAF_MEMORY_TRACKING == 1
-    gMutex.lock();
-    MemoryBlockHeader* cur = gRoot;
     int leaked = 0;
-    while (cur)
+    for (uint32_t i = 0; i < TRACKING_SHARD_COUNT; i++)
     {
-        if (cur->BLOB != 0xFEEDCAFE)
+        TrackingShard& shard = mShards[i];
+        shard.mutex.lock();
+        MemoryBlockHeader* cur = shard.root;
+        while (cur)
         {
-            LogDispatcher::logError("MallocAllocator", "MEMORY CORRUPTION DETECTED!");
-            break;
-        }
-        if (cur->filename[0] == 0)
-        {
-            LogDispatcher::logError("MallocAllocator", "MEMORY LEAK: <NoInfo> %d %p", cur->allocSize,
-                                    cur + OMAF_SIZE_OF(MemoryBlockHeader));
+            if (cur->BLOB != 0xFEEDCAFE)
+            {
+                LogDispatcher::logError("MallocAllocator", "MEMORY CORRUPTION DETECTED!");
+                break;
+            }
+            if (cur->filename[0] == 0)
+            {
+                LogDispatcher::logError("MallocAllocator", "MEMORY LEAK: <NoInfo> %d %p", cur->allocSize,
+                                        cur + OMAF_SIZE_OF(MemoryBlockHeader));
+            }
+            else
+            {
+                LogDispatcher::logError("MallocAllocator", "MEMORY LEAK: %s:%d", cur->filename, cur->line);
+            }
+            leaked++;
+            cur = cur->next;
         }
-        else
-        {
-            LogDispatcher::logError("MallocAllocator", "MEMORY LEAK: %s:%d", cur->filename, cur->line);
-        }
-        leaked++;
-        cur = cur->next;
+        shard.mutex.unlock();
     }
     OMAF_ASSERT(leaked == 0, "Memory leak detected");
-    gMutex.unlock();
 #endif
 }
 
+#if OMAF_MEMORY_TRACKING == 1
+
+MallocAllocator::TrackingShard& MallocAllocator::getShard(const MemoryBlockHeader* header)
+{
+    // mix in the upper bits, large blocks are page aligned
+    size_t key = (size_t) header;
+    key ^= (key >> 12) ^ (key >> 20);
+
+    return mShards[(key >> 4) % TRACKING_SHARD_COUNT];
+}
+
+void_t MallocAllocator::track(MemoryBlockHeader* header)
+{
+    TrackingShard& shard = getShard(header);
+
+    shard.mutex.lock();
+    header->prev = NULL;
+    header->next = shard.root;
+    if (shard.root)
+    {
+        shard.root->prev = header;
+    }
+    shard.root = header;
+    shard.allocatedBytes += header->allocSize;
+    shard.mutex.unlock();
+}
+
+void_t MallocAllocator::untrack(MemoryBlockHeader* header)
+{
+    TrackingShard& shard = getShard(header);
+
+    shard.mutex.lock();
+    if (header->prev == NULL)
+    {
+        // header was the root, so next is now root.
+        shard.root = header->next;
+    }
+    else
+    {
+        header->prev->next = header->next;
+    }
+    if (header->next)
+    {
+        header->next->prev = header->prev;
+    }
+    shard.allocatedBytes -= header->allocSize;
+    shard.mutex.unlock();
+}
+
+#endif
+
 void_t* MallocAllocator::Allocate(size_t size, size_t align)
 {
     if (align < OMAF_DEFAULT_ALIGN)
@@ -99,14 +154,7 @@ void_t* MallocAllocator::Allocate(size_t size, size_t align)
         headerPtr->BLOB = 0xFEEDCAFE;
         headerPtr->filename[0] = 0;
         headerPtr->line = 0;
-        gMutex.lock();
-        headerPtr->prev = NULL;
-        headerPtr->next = gRoot;
-        if (gRoot)
-            gRoot->prev = headerPtr;
-        gRoot = headerPtr;
-        gMutex.unlock();
-
+        track(headerPtr);
 #endif
     }
 
@@ -145,15 +193,7 @@ void_t* MallocAllocator::Allocate_Track(size_t size, size_t align, const char_t*
         headerPtr->filename[255] = 0;
         headerPtr->line = line;
 
-        gMutex.lock();
-        headerPtr->prev = NULL;
-        headerPtr->next = gRoot;
-        if (gRoot)
-        {
-            gRoot->prev = headerPtr;
-        }
-        gRoot = headerPtr;
-        gMutex.unlock();
+        track(headerPtr);
     }
 
     return data;
@@ -177,21 +217,7 @@ void_t MallocAllocator::Free(void_t* ptr)
             LogDispatcher::logError("MallocAllocator", "MEMORY CORRUPTION DETECTED!");
             OMAF_ISSUE_BREAK();
         }
-        gMutex.lock();
-        if (headerPtr->prev == NULL)
-        {
-            // headerPtr was the root, so next is now root.
-            gRoot = headerPtr->next;
-        }
-        else
-        {
-            headerPtr->prev->next = headerPtr->next;
-        }
-        if (headerPtr->next)
-        {
-            headerPtr->next->prev = headerPtr->prev;
-        }
-        gMutex.unlock();
+        untrack(headerPtr);
 #endif
 
 
@@ -222,6 +248,16 @@ size_t MallocAllocator::AllocatedSize(void_t* ptr)
 
 size_t MallocAllocator::TotalAllocatedSize()
 {
+#if OMAF_MEMORY_TRACKING == 1
+    size_t total = 0;
+    for (uint32_t i = 0; i < TRACKING_SHARD_COUNT; i++)
+    {
+        Mutex::ScopeLock lock(mShards[i].mutex);
+        total += mShards[i].allocatedBytes;
+    }
+    return total;
+#else
     return (size_t) -1;
+#endif
 }
 OMAF_NS_END
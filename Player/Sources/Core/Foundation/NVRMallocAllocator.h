@@ -43,8 +43,22 @@ public:  // MemoryAllocator
 private:
     struct MemoryBlockHeader;
 #if OMAF_MEMORY_TRACKING == 1
-    Mutex gMutex;
-    MemoryBlockHeader* gRoot = NULL;
+    // Live blocks are tracked in lists sharded by block address, so that concurrently allocating threads rarely
+    // contend for the same lock.
+    struct TrackingShard
+    {
+        Mutex mutex;
+        MemoryBlockHeader* root = NULL;
+        size_t allocatedBytes = 0;
+    };
+
+    static const uint32_t TRACKING_SHARD_COUNT = 16;
+
+    TrackingShard& getShard(const MemoryBlockHeader* header);
+    void_t track(MemoryBlockHeader* header);
+    void_t untrack(MemoryBlockHeader* header);
+
+    TrackingShard mShards[TRACKING_SHARD_COUNT];
 #endif
 };
 OMAF_NS_END
@@ -20,6 +20,7 @@
 #include "Foundation/NVRMallocAllocator.h"
 #include "Foundation/NVRMemoryAllocator.h"
 #include "Foundation/NVRNew.h"
+#include "Foundation/NVRScratchAllocator.h"
 
 OMAF_NS_BEGIN
 
@@ -38,6 +39,7 @@ namespace MemorySystem
 
     MemoryAllocator* defaultHeapAllocator = OMAF_NULL;
     MemoryAllocator* debugHeapAllocator = OMAF_NULL;
+    ScratchAllocator* scratchAllocator = OMAF_NULL;
 
     void_t Create(MemoryAllocator* clientHeapAllocator, size_t scratchAllocatorSize)
     {
@@ -53,7 +55,12 @@ namespace MemorySystem
             OMAF_ASSERT_NOT_NULL(defaultHeapAllocator);
         }
 
-        OMAF_UNUSED_VARIABLE(scratchAllocatorSize);
+        // Scratch allocator with a per-thread arena of the given size, size 0 disables it
+        if (scratchAllocatorSize > 0)
+        {
+            scratchAllocator = OMAF_NEW(*defaultHeapAllocator, ScratchAllocator)(
+                "Default scratch allocator", *defaultHeapAllocator, scratchAllocatorSize);
+        }
 
 // Create debug heap allocator
 #if OMAF_ENABLE_DEBUG_HEAP
@@ -75,6 +82,12 @@ namespace MemorySystem
 
 #endif
 
+        if (scratchAllocator != OMAF_NULL)
+        {
+            OMAF_DELETE(*defaultHeapAllocator, scratchAllocator);
+            scratchAllocator = OMAF_NULL;
+        }
+
         if (defaultHeapAllocator != OMAF_NULL)
         {
             Destruct<MallocAllocator>(defaultHeapAllocator);
@@ -92,9 +105,28 @@ namespace MemorySystem
 
     MemoryAllocator* DefaultScratchAllocator()
     {
-        OMAF_ASSERT_NOT_IMPLEMENTED();
+        if (scratchAllocator == OMAF_NULL)
+        {
+            return DefaultHeapAllocator();
+        }
+
+        return scratchAllocator;
+    }
 
-        return OMAF_NULL;
+    void_t ResetScratchAllocator()
+    {
+        if (scratchAllocator != OMAF_NULL)
+        {
+            scratchAllocator->reset();
+        }
+    }
+
+    void_t ReleaseScratchAllocator()
+    {
+        if (scratchAllocator != OMAF_NULL)
+        {
+            scratchAllocator->release();
+        }
     }
 
     MemoryAllocator* DebugHeapAllocator()
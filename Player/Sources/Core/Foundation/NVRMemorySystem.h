@@ -33,6 +33,12 @@ namespace MemorySystem
     MemoryAllocator* DefaultHeapAllocator();
     MemoryAllocator* DefaultScratchAllocator();
 
+    // Rewinds the scratch arena of the calling thread, e.g. once per frame or segment.
+    void_t ResetScratchAllocator();
+
+    // Returns the scratch arena of the calling thread for reuse by other threads, called when a thread exits.
+    void_t ReleaseScratchAllocator();
+
     MemoryAllocator* DebugHeapAllocator();
 }  // namespace MemorySystem
 
@@ -27,7 +27,7 @@ Mutex::Mutex()
 
     ::InitializeCriticalSection(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     ::pthread_mutexattr_t attr;
     ::pthread_mutexattr_init(&attr);
@@ -48,7 +48,7 @@ Mutex::~Mutex()
 
     ::DeleteCriticalSection(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     ::pthread_mutex_destroy(&mHandle);
 
@@ -65,7 +65,7 @@ void_t Mutex::lock()
 
     ::EnterCriticalSection(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_mutex_lock(&mHandle);
     OMAF_ASSERT(result == 0, "Mutex lock failed");
@@ -84,7 +84,7 @@ void_t Mutex::unlock()
 
     ::LeaveCriticalSection(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_mutex_unlock(&mHandle);
     OMAF_ASSERT(result == 0, "Mutex unlock failed");
@@ -103,7 +103,7 @@ bool_t Mutex::tryLock()
 
     return ::TryEnterCriticalSection(&mHandle) != FALSE;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     return (::pthread_mutex_trylock(&mHandle) == 0);
 
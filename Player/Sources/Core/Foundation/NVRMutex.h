@@ -143,7 +143,7 @@ private:
 
     typedef CRITICAL_SECTION Handle;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     typedef pthread_mutex_t Handle;
 
@@ -28,7 +28,7 @@ ReadWriteLock::ReadWriteLock()
 
     ::InitializeSRWLock(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_rwlock_init(&mHandle, NULL);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -47,7 +47,7 @@ ReadWriteLock::~ReadWriteLock()
 
     // SRW locks do not need to be explicitly destroyed.
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_rwlock_destroy(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -66,7 +66,7 @@ void_t ReadWriteLock::lockShared()
 
     ::AcquireSRWLockShared(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_rwlock_rdlock(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -85,7 +85,7 @@ void_t ReadWriteLock::unlockShared()
 
     ::ReleaseSRWLockShared(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_rwlock_unlock(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -104,7 +104,7 @@ void_t ReadWriteLock::lockExclusive()
 
     ::AcquireSRWLockExclusive(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_rwlock_wrlock(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -123,7 +123,7 @@ void_t ReadWriteLock::unlockExclusive()
 
     ::ReleaseSRWLockExclusive(&mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::pthread_rwlock_unlock(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
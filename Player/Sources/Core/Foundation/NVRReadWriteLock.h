@@ -40,7 +40,7 @@ public:
 
     typedef SRWLOCK Handle;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     typedef pthread_rwlock_t Handle;
 
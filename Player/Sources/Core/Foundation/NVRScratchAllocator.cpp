@@ -0,0 +1,234 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "Foundation/NVRScratchAllocator.h"
+
+#include "Foundation/NVRAlignment.h"
+#include "Foundation/NVRAssert.h"
+#include "Foundation/NVRAtomic.h"
+#include "Foundation/NVRLogger.h"
+
+OMAF_NS_BEGIN
+
+OMAF_LOG_ZONE(ScratchAllocator)
+
+struct ScratchAllocator::Arena
+{
+    uint8_t* data;
+    size_t size;
+    size_t offset;
+
+    Arena* next;      // all arenas
+    Arena* nextFree;  // arenas released by exited threads
+};
+
+struct ScratchAllocator::BlockHeader
+{
+    Arena* arena;          // OMAF_NULL if the block overflowed to the backing allocator
+    uint8_t* baseAddress;  // start of the block including header and alignment
+    size_t allocSize;
+};
+
+ScratchAllocator::ScratchAllocator(const char_t* name, MemoryAllocator& backingAllocator, size_t arenaSize)
+    : MemoryAllocator(name)
+    , mBackingAllocator(backingAllocator)
+    , mArenaSize(arenaSize)
+    , mArenas(OMAF_NULL)
+    , mFreeArenas(OMAF_NULL)
+    , mArenaCount(0)
+    , mOverflowCount(0)
+{
+}
+
+ScratchAllocator::~ScratchAllocator()
+{
+    if (mOverflowCount > 0)
+    {
+        OMAF_LOG_D("%s: %d allocations overflowed %d arenas of %zu bytes", GetName(), mOverflowCount, mArenaCount,
+                   mArenaSize);
+    }
+
+    // threads have exited by now, so the arenas can be released without locking
+    while (mArenas != OMAF_NULL)
+    {
+        Arena* arena = mArenas;
+        mArenas = arena->next;
+
+        mBackingAllocator.Free(arena);
+    }
+}
+
+ScratchAllocator::Arena* ScratchAllocator::getArena()
+{
+    Arena* arena = mThreadArena.getValue<Arena>();
+
+    if (arena == OMAF_NULL && mArenaSize > 0)
+    {
+        Spinlock::ScopeLock lock(mArenaLock);
+
+        if (mFreeArenas != OMAF_NULL)
+        {
+            arena = mFreeArenas;
+            mFreeArenas = arena->nextFree;
+        }
+        else
+        {
+            // arena bookkeeping and data in one block
+            arena = (Arena*) mBackingAllocator.Allocate(OMAF_SIZE_OF(Arena) + mArenaSize, OMAF_DEFAULT_ALIGN);
+
+            if (arena == OMAF_NULL)
+            {
+                return OMAF_NULL;
+            }
+
+            arena->data = (uint8_t*) ptrAdd(arena, OMAF_SIZE_OF(Arena));
+            arena->size = mArenaSize;
+            arena->next = mArenas;
+            mArenas = arena;
+            mArenaCount++;
+        }
+
+        arena->offset = 0;
+        arena->nextFree = OMAF_NULL;
+
+        mThreadArena.setValue(arena);
+    }
+
+    return arena;
+}
+
+void_t ScratchAllocator::reset()
+{
+    Arena* arena = mThreadArena.getValue<Arena>();
+
+    if (arena != OMAF_NULL)
+    {
+        arena->offset = 0;
+    }
+}
+
+void_t ScratchAllocator::release()
+{
+    Arena* arena = mThreadArena.getValue<Arena>();
+
+    if (arena != OMAF_NULL)
+    {
+        mThreadArena.setValue(OMAF_NULL);
+
+        Spinlock::ScopeLock lock(mArenaLock);
+
+        arena->offset = 0;
+        arena->nextFree = mFreeArenas;
+        mFreeArenas = arena;
+    }
+}
+
+void_t* ScratchAllocator::Allocate(size_t size, size_t align)
+{
+    if (align < OMAF_DEFAULT_ALIGN)
+    {
+        align = OMAF_DEFAULT_ALIGN;
+    }
+
+    Arena* arena = getArena();
+
+    if (arena != OMAF_NULL)
+    {
+        uint8_t* base = arena->data + arena->offset;
+        uint8_t* data = (uint8_t*) alignPtr(base + OMAF_SIZE_OF(BlockHeader), align);
+
+        if ((size_t)(data - arena->data) + size <= arena->size)
+        {
+            BlockHeader* header = (BlockHeader*) (data - OMAF_SIZE_OF(BlockHeader));
+            header->arena = arena;
+            header->baseAddress = base;
+            header->allocSize = size;
+
+            arena->offset = (size_t)(data - arena->data) + size;
+
+            return data;
+        }
+    }
+
+    Atomic::increment(&mOverflowCount);
+
+    uint8_t* base = (uint8_t*) mBackingAllocator.Allocate(OMAF_SIZE_OF(BlockHeader) + size + align, OMAF_DEFAULT_ALIGN);
+
+    if (base == OMAF_NULL)
+    {
+        return OMAF_NULL;
+    }
+
+    uint8_t* data = (uint8_t*) alignPtr(base + OMAF_SIZE_OF(BlockHeader), align);
+
+    BlockHeader* header = (BlockHeader*) (data - OMAF_SIZE_OF(BlockHeader));
+    header->arena = OMAF_NULL;
+    header->baseAddress = base;
+    header->allocSize = size;
+
+    return data;
+}
+
+#if OMAF_MEMORY_TRACKING == 1
+
+void_t* ScratchAllocator::Allocate_Track(size_t size, size_t align, const char_t* file, uint32_t line)
+{
+    OMAF_UNUSED_VARIABLE(file);
+    OMAF_UNUSED_VARIABLE(line);
+
+    return Allocate(size, align);
+}
+
+#endif
+
+void_t ScratchAllocator::Free(void_t* ptr)
+{
+    if (ptr != OMAF_NULL)
+    {
+        BlockHeader* header = (BlockHeader*) ptrSubtract(ptr, OMAF_SIZE_OF(BlockHeader));
+        Arena* arena = header->arena;
+
+        if (arena == OMAF_NULL)
+        {
+            mBackingAllocator.Free(header->baseAddress);
+        }
+        else if (arena == mThreadArena.getValue<Arena>() &&
+                 (uint8_t*) ptr + header->allocSize == arena->data + arena->offset)
+        {
+            // newest allocation of the calling thread, rewind so that scoped temporaries are reused immediately
+            arena->offset = (size_t)(header->baseAddress - arena->data);
+        }
+    }
+}
+
+size_t ScratchAllocator::AllocatedSize(void_t* ptr)
+{
+    if (ptr != OMAF_NULL)
+    {
+        BlockHeader* header = (BlockHeader*) ptrSubtract(ptr, OMAF_SIZE_OF(BlockHeader));
+
+        return header->allocSize;
+    }
+
+    return 0;
+}
+
+size_t ScratchAllocator::TotalAllocatedSize()
+{
+    Spinlock::ScopeLock lock(mArenaLock);
+
+    return mArenaCount * mArenaSize;
+}
+
+OMAF_NS_END
@@ -0,0 +1,83 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVRMemoryAllocator.h"
+#include "Foundation/NVRSpinlock.h"
+#include "Foundation/NVRThreadLocalStorage.h"
+#include "Platform/OMAFDataTypes.h"
+
+OMAF_NS_BEGIN
+
+//
+// Scratch allocator for short-lived allocations.
+//
+// Each thread bumps allocations from its own arena, so there is no locking on the allocation path. Freeing the newest
+// allocation of the calling thread rewinds the arena, other frees are no-ops and the memory is reclaimed when the
+// owning thread calls reset(), e.g. once per frame or segment. Allocations that do not fit to the arena fall back to
+// the backing allocator.
+//
+class ScratchAllocator : public MemoryAllocator
+{
+public:
+    ScratchAllocator(const char_t* name, MemoryAllocator& backingAllocator, size_t arenaSize);
+    virtual ~ScratchAllocator();
+
+    // Rewinds the arena of the calling thread. Memory allocated from it by the calling thread must not be used after
+    // this.
+    void_t reset();
+
+    // Rewinds the arena of the calling thread and hands it over to the next thread that needs one. Called when a
+    // thread exits.
+    void_t release();
+
+public:  // MemoryAllocator
+    virtual void_t* Allocate(size_t size, size_t align);
+    virtual void_t Free(void_t* ptr);
+
+#if OMAF_MEMORY_TRACKING == 1
+
+    virtual void_t*
+    Allocate_Track(size_t size, size_t align = OMAF_DEFAULT_ALIGN, const char_t* file = NULL, uint32_t line = 0);
+
+#endif
+
+    virtual size_t AllocatedSize(void_t* ptr);
+    virtual size_t TotalAllocatedSize();
+
+private:
+    OMAF_NO_COPY(ScratchAllocator);
+    OMAF_NO_ASSIGN(ScratchAllocator);
+
+    struct Arena;
+    struct BlockHeader;
+
+    Arena* getArena();
+
+private:
+    MemoryAllocator& mBackingAllocator;
+    size_t mArenaSize;
+
+    ThreadLocalStorage mThreadArena;
+
+    Spinlock mArenaLock;
+    Arena* mArenas;
+    Arena* mFreeArenas;
+    uint32_t mArenaCount;
+
+    OMAF_VOLATILE int32_t mOverflowCount;
+};
+
+OMAF_NS_END
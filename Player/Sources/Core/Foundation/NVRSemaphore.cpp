@@ -31,7 +31,7 @@ Semaphore::Semaphore(uint32_t initialCount)
     mHandle = (Handle)::CreateSemaphore(NULL, mInitialCount, 0x7fffffff, NULL);
     OMAF_ASSERT_NOT_NULL(mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::sem_init(&mHandle, 1, mInitialCount);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -51,7 +51,7 @@ Semaphore::~Semaphore()
     BOOL result = ::CloseHandle(mHandle);
     OMAF_ASSERT(result == TRUE, "");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::sem_destroy(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -72,7 +72,7 @@ void_t Semaphore::signal()
     BOOL result = ::ReleaseSemaphore(mHandle, 1, &count);
     OMAF_ASSERT(result == TRUE, "");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::sem_post(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -92,7 +92,7 @@ void_t Semaphore::wait()
     DWORD result = ::WaitForSingleObject(mHandle, INFINITE);
     OMAF_ASSERT(result != WAIT_FAILED, "");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::sem_wait(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -113,7 +113,7 @@ bool_t Semaphore::tryWait()
 
     return (result == WAIT_OBJECT_0);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::sem_trywait(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -137,7 +137,7 @@ void_t Semaphore::reset()
     mHandle = (Handle)::CreateSemaphore(NULL, mInitialCount, 0x7fffffff, NULL);
     OMAF_ASSERT_NOT_NULL(mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = ::sem_destroy(&mHandle);
     OMAF_ASSERT(result == 0, ::strerror(errno));
@@ -40,7 +40,7 @@ public:
 
     typedef HANDLE Handle;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     typedef sem_t Handle;
 
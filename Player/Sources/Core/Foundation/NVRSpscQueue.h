@@ -0,0 +1,75 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVRAtomic.h"
+#include "Foundation/NVRCompatibility.h"
+#include "Foundation/NVRNonCopyable.h"
+#include "Platform/OMAFCompiler.h"
+#include "Platform/OMAFDataTypes.h"
+
+OMAF_NS_BEGIN
+
+//
+// Bounded FIFO queue for handing objects from exactly one producer thread to exactly one consumer thread.
+//
+// push() may only be called by the producer, front() and pop() only by the consumer. Neither side takes a lock or
+// waits for the other; a full queue rejects the push. getSize() and isEmpty() may be called from either side and
+// return a snapshot. clear() requires that neither side is active.
+//
+
+template <typename T, size_t N>
+class SpscQueue
+{
+public:
+    SpscQueue();
+    ~SpscQueue();
+
+    size_t getCapacity() const;
+    size_t getSize() const;
+
+    bool_t isEmpty() const;
+    bool_t isFull() const;
+
+    void_t clear();
+
+    // Producer
+    bool_t push(const T& object);
+
+    // Consumer
+    T& front();
+    void_t pop();
+
+private:
+    OMAF_NO_COPY(SpscQueue);
+    OMAF_NO_ASSIGN(SpscQueue);
+
+    static const size_t CACHE_LINE_SIZE = 64;
+
+private:
+    // Positions run modulo 2 * N so that a full queue can be told apart from an empty one; the slot is the position
+    // modulo N. Head is written by the consumer and tail by the producer only, so they are kept on separate cache
+    // lines.
+    OMAF_VOLATILE int32_t mHead;
+    uint8_t mHeadPadding[CACHE_LINE_SIZE - sizeof(int32_t)];
+
+    OMAF_VOLATILE int32_t mTail;
+    uint8_t mTailPadding[CACHE_LINE_SIZE - sizeof(int32_t)];
+
+    T mData[N];
+};
+OMAF_NS_END
+
+#include "Foundation/NVRSpscQueueImpl.h"
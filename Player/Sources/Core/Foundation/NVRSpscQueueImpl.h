@@ -0,0 +1,105 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "Foundation/NVRAssert.h"
+
+OMAF_NS_BEGIN
+template <typename T, size_t N>
+SpscQueue<T, N>::SpscQueue()
+    : mHead(0)
+    , mTail(0)
+{
+    OMAF_COMPILE_ASSERT((N > 0 && N < OMAF_INT32_MAX / 2));
+}
+
+template <typename T, size_t N>
+SpscQueue<T, N>::~SpscQueue()
+{
+}
+
+template <typename T, size_t N>
+size_t SpscQueue<T, N>::getCapacity() const
+{
+    return N;
+}
+
+template <typename T, size_t N>
+size_t SpscQueue<T, N>::getSize() const
+{
+    // Load the head first: the tail can only move ahead meanwhile, so the size never appears negative
+    size_t head = (size_t) Atomic::loadAcquire((OMAF_VOLATILE int32_t*) &mHead);
+    size_t tail = (size_t) Atomic::loadAcquire((OMAF_VOLATILE int32_t*) &mTail);
+
+    return (tail + 2 * N - head) % (2 * N);
+}
+
+template <typename T, size_t N>
+bool_t SpscQueue<T, N>::isEmpty() const
+{
+    return getSize() == 0;
+}
+
+template <typename T, size_t N>
+bool_t SpscQueue<T, N>::isFull() const
+{
+    return getSize() >= N;
+}
+
+template <typename T, size_t N>
+void_t SpscQueue<T, N>::clear()
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        mData[i] = T();
+    }
+    Atomic::storeRelease(&mHead, 0);
+    Atomic::storeRelease(&mTail, 0);
+}
+
+template <typename T, size_t N>
+bool_t SpscQueue<T, N>::push(const T& object)
+{
+    // Only the producer writes the tail, so a plain read is enough
+    size_t tail = (size_t) mTail;
+    size_t head = (size_t) Atomic::loadAcquire(&mHead);
+
+    if ((tail + 2 * N - head) % (2 * N) >= N)
+    {
+        return false;
+    }
+
+    mData[tail % N] = object;
+    Atomic::storeRelease(&mTail, (int32_t)((tail + 1) % (2 * N)));
+
+    return true;
+}
+
+template <typename T, size_t N>
+T& SpscQueue<T, N>::front()
+{
+    OMAF_ASSERT(!isEmpty(), "Queue is empty");
+
+    return mData[(size_t) mHead % N];
+}
+
+template <typename T, size_t N>
+void_t SpscQueue<T, N>::pop()
+{
+    OMAF_ASSERT(!isEmpty(), "Queue is empty");
+
+    size_t head = (size_t) mHead;
+    mData[head % N] = T();
+    Atomic::storeRelease(&mHead, (int32_t)((head + 1) % (2 * N)));
+}
+OMAF_NS_END
@@ -14,6 +14,8 @@
  */
 #include "Foundation/NVRThread.h"
 
+#include "Foundation/NVRMemorySystem.h"
+
 #if OMAF_PLATFORM_ANDROID
 #include "Foundation/Android/NVRAndroid.h"
 #endif
@@ -37,6 +39,10 @@ Thread::Id Thread::mMainThreadId = ::GetCurrentThreadId();
 
 Thread::Id Thread::mMainThreadId = ::gettid();
 
+#elif OMAF_PLATFORM_LINUX
+
+Thread::Id Thread::mMainThreadId = (Thread::Id)::syscall(SYS_gettid);
+
 #else
 
 #error Unsupported platform
@@ -92,7 +98,7 @@ static Thread::Priority::Enum convertToThreadPriority(int priority)
     return Thread::Priority::INVALID;
 }
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
 static int convertToOSThreadPriority(Thread::Priority::Enum priority, int policy)
 {
@@ -134,7 +140,7 @@ static Thread::Priority::Enum convertToThreadPriority(int priority, int policy)
 const Thread::Handle Thread::InvalidHandle = INVALID_HANDLE_VALUE;
 const Thread::Id Thread::InvalidId = UINT32_MAX;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
 const Thread::Handle Thread::InvalidHandle = 0;
 const Thread::Id Thread::InvalidId = 0;
@@ -188,7 +194,7 @@ Thread::~Thread()
         mHandle = InvalidHandle;
         mId = InvalidId;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
         ::pthread_detach(mHandle);
 
@@ -274,7 +280,7 @@ bool_t Thread::start(EntryFunction function, void_t* userData)
         return false;
     }
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int result = 0;
     OMAF_UNUSED_VARIABLE(result);
@@ -344,7 +350,7 @@ bool_t Thread::join()
         return false;
     }
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     void* status = NULL;
     int result = ::pthread_join(mHandle, &status);
@@ -382,7 +388,7 @@ void_t Thread::sleep(uint32_t milliseconds)
 
     ::Sleep(milliseconds);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     ::usleep(milliseconds * 1000);
 
@@ -399,7 +405,7 @@ void_t Thread::yield()
 
     ::SwitchToThread();
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     ::sched_yield();
 
@@ -420,6 +426,10 @@ Thread::Id Thread::getCurrentThreadId()
 
     return ::gettid();
 
+#elif OMAF_PLATFORM_LINUX
+
+    return (Thread::Id)::syscall(SYS_gettid);
+
 #else
 
 #error Unsupported platform
@@ -441,7 +451,7 @@ bool_t Thread::isMainThread()
 
 DWORD WINAPI Thread::threadMain(LPVOID threadInstance)
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
 void_t* Thread::threadMain(void_t* threadInstance)
 
@@ -499,7 +509,7 @@ void_t* Thread::threadMain(void_t* threadInstance)
 
 #pragma warning(pop)
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
         ::prctl(PR_SET_NAME, threadName, 0, 0, 0);
 
@@ -521,7 +531,7 @@ void_t* Thread::threadMain(void_t* threadInstance)
 
         ::SetThreadPriority(thread->mHandle, priority);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
         int policy = 0;
         int nativePriority = convertToOSThreadPriority(priority, policy);
@@ -565,6 +575,8 @@ void_t* Thread::threadMain(void_t* threadInstance)
     // Call user defined entry function
     threadResult = thread->mEntryFunction.invoke(*thread, thread->mUserData);
 
+    MemorySystem::ReleaseScratchAllocator();
+
     thread->mRunning = false;
 
     ////////////////////////////////////////////////////////////////////////////////
@@ -591,9 +603,9 @@ void_t* Thread::threadMain(void_t* threadInstance)
 
     return (unsigned) threadResult;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
-    return (void_t*) threadResult;
+    return (void_t*)(intptr_t) threadResult;
 
 #else
 
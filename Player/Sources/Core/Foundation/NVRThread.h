@@ -32,7 +32,7 @@ public:
     typedef HANDLE Handle;
     typedef DWORD Id;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     typedef pthread_t Handle;
     typedef pid_t Id;
@@ -140,7 +140,7 @@ private:
 
     static DWORD WINAPI threadMain(LPVOID threadInstance);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     static void_t* threadMain(void_t* threadInstance);
 
@@ -25,7 +25,7 @@ ThreadLocalStorage::ThreadLocalStorage()
     mHandle = ::TlsAlloc();
     OMAF_ASSERT(mHandle != TLS_OUT_OF_INDEXES, "");
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int status = ::pthread_key_create(&mHandle, NULL);
     OMAF_ASSERT(status == 0, "");
@@ -44,7 +44,7 @@ ThreadLocalStorage::~ThreadLocalStorage()
 
     ::TlsFree(mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int status = ::pthread_key_delete((pthread_key_t) mHandle);
     OMAF_ASSERT(status == 0, "");
@@ -63,7 +63,7 @@ void_t* ThreadLocalStorage::getValue() const
 
     return ::TlsGetValue(mHandle);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     return (void_t*) ::pthread_getspecific((pthread_key_t) mHandle);
 
@@ -80,7 +80,7 @@ bool_t ThreadLocalStorage::setValue(void_t* value)
 
     return (::TlsSetValue(mHandle, value) == TRUE);
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     int status = ::pthread_setspecific((pthread_key_t) mHandle, value);
 
@@ -35,7 +35,7 @@ public:
 
     typedef DWORD Handle;
 
-#elif OMAF_PLATFORM_ANDROID
+#elif OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     typedef pthread_key_t Handle;
 
@@ -19,7 +19,7 @@
 #include "Foundation/NVRCompatibility.h"
 
 OMAF_NS_BEGIN
-#if (OMAF_PLATFORM_ANDROID)
+#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 static int64_t getNs(const timespec& ts)
 {
     return (ts.tv_sec * 1000000000ll + ts.tv_nsec);
@@ -33,7 +33,7 @@ int32_t Time::getClockTimeMs()
 
 int64_t Time::getClockTimeUs()
 {
-#if (OMAF_PLATFORM_ANDROID)
+#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     timespec ts;
     ::clock_gettime(CLOCK_REALTIME, &ts);
@@ -58,7 +58,7 @@ int32_t Time::getProcessTimeMs()
 
 int64_t Time::getProcessTimeUs()
 {
-#if (OMAF_PLATFORM_ANDROID)
+#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     timespec ts;
     ::clock_gettime(CLOCK_REALTIME, &ts);
@@ -84,7 +84,7 @@ int32_t Time::getThreadTimeMs()
 
 int64_t Time::getThreadTimeUs()
 {
-#if (OMAF_PLATFORM_ANDROID)
+#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     timespec ts;
     ::clock_gettime(CLOCK_REALTIME, &ts);
@@ -105,7 +105,7 @@ int64_t Time::getThreadTimeUs()
 
 time_t Time::fromUTCString(const char_t* timeStr)
 {
-#if (OMAF_PLATFORM_ANDROID)
+#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_LINUX
 
     const char_t* timeFormat = "%Y-%m-%dT%H:%M:%S";  // yyyy-MM-ddThh:mm:ss
     struct tm time;
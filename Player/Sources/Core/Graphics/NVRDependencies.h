@@ -96,6 +96,10 @@
 
 #endif
 
+#elif OMAF_PLATFORM_LINUX
+
+// Headless build, only the NULL render backend is available
+
 #else
 
 #error Unsupported platform
@@ -46,6 +46,15 @@ OMAF_NS_BEGIN
 #define OMAF_SUPPORTS_GRAPHICS_API_D3D11 1
 #define OMAF_SUPPORTS_GRAPHICS_API_D3D12 0
 
+#elif OMAF_PLATFORM_LINUX
+
+// Headless build, only the NULL render backend is available
+#define OMAF_SUPPORTS_GRAPHICS_API_OPENGL 0
+#define OMAF_SUPPORTS_GRAPHICS_API_OPENGL_ES 0
+#define OMAF_SUPPORTS_GRAPHICS_API_VULKAN 0
+#define OMAF_SUPPORTS_GRAPHICS_API_D3D11 0
+#define OMAF_SUPPORTS_GRAPHICS_API_D3D12 0
+
 #endif
 
 // Define emptys
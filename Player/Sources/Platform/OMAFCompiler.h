@@ -124,7 +124,7 @@ namespace OMAF
 
 #elif OMAF_CPU_X86_64
 
-#define OMAF_ISSUE_BREAK() __asm {int 3}  // __asm__ ("svc 0")
+#define OMAF_ISSUE_BREAK() __asm__("int $3")
 
 #elif OMAF_CPU_ARM
 
@@ -185,4 +185,31 @@ namespace OMAF
             return Private::SeekAccuracy::INVALID;
         }
     }
+
+    Private::LatencyCategory::Enum convertLatencyCategory(OMAF::LatencyCategory::Enum category)
+    {
+        switch (category)
+        {
+        case OMAF::LatencyCategory::SEGMENT_DOWNLOAD:
+            return Private::LatencyCategory::SEGMENT_DOWNLOAD;
+        case OMAF::LatencyCategory::SEGMENT_PARSE:
+            return Private::LatencyCategory::SEGMENT_PARSE;
+        case OMAF::LatencyCategory::TILE_SWITCH:
+            return Private::LatencyCategory::TILE_SWITCH;
+        default:
+            return Private::LatencyCategory::INVALID;
+        }
+    }
+
+    OMAF::LatencyStatistics convertLatencySummary(const Private::LatencySummary& summary)
+    {
+        OMAF::LatencyStatistics statistics;
+        statistics.count = summary.count;
+        statistics.minUs = summary.minUs;
+        statistics.maxUs = summary.maxUs;
+        statistics.averageUs = summary.averageUs;
+        statistics.medianUs = summary.medianUs;
+        statistics.percentile95Us = summary.percentile95Us;
+        return statistics;
+    }
 }  // namespace OMAF
@@ -17,6 +17,7 @@
 #include "NVRNamespace.h"
 
 #include "Media/NVRMediaInformation.h"
+#include "Provider/NVRLatencyStatistics.h"
 #include "NVRPlayer.h"
 #include "OMAFPlayerDataTypes.h"
 
@@ -31,4 +32,7 @@ namespace OMAF
     OMAF::MediaInformation convertMediaInformation(Private::MediaInformation information);
 
     Private::SeekAccuracy::Enum convertSeekAccuracy(OMAF::SeekAccuracy::Enum accuracy);
+
+    Private::LatencyCategory::Enum convertLatencyCategory(OMAF::LatencyCategory::Enum category);
+    OMAF::LatencyStatistics convertLatencySummary(const Private::LatencySummary& summary);
 }  // namespace OMAF
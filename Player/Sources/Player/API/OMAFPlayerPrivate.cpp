@@ -16,11 +16,14 @@
 
 #include "buildinfo.hpp"
 
+#include "DashProvider/NVRDashSegmentCache.h"
 #include "Foundation/NVRArray.h"
 #include "Foundation/NVRDeviceInfo.h"
+#include "Foundation/NVRDiskManager.h"
 #include "Foundation/NVRLogger.h"
 
 #include "Graphics/NVRRenderBackend.h"
+#include "Media/NVRMP4Parser.h"
 
 
 namespace OMAF
@@ -80,6 +83,9 @@ namespace OMAF
         case OMAF::GraphicsAPI::D3D12:
             rendererType = Private::RendererType::D3D12;
             break;
+        case OMAF::GraphicsAPI::NIL:
+            rendererType = Private::RendererType::NIL;
+            break;
         default:
             OMAF_ASSERT_UNREACHABLE();
             break;
@@ -121,12 +127,14 @@ namespace OMAF
         sprintf(version, "%d.%d.%d", major, minor, revision);
 
         Private::MemoryZero(&mAudioState, OMAF_SIZE_OF(mAudioState));
+        Private::LatencyStatistics::reset();
         initialize();
     }
 
     OmafPlayerPrivate::~OmafPlayerPrivate()
     {
         deinitialize();
+        Private::DashSegmentCache::shutdown();
     }
 
     void_t OmafPlayerPrivate::initialize()
@@ -768,4 +776,35 @@ namespace OMAF
         }
     }
 
+    LatencyStatistics OmafPlayerPrivate::getLatencyStatistics(LatencyCategory::Enum aCategory)
+    {
+        Private::LatencyCategory::Enum category = convertLatencyCategory(aCategory);
+        if (category == Private::LatencyCategory::INVALID)
+        {
+            return convertLatencySummary(Private::LatencySummary());
+        }
+        return convertLatencySummary(Private::LatencyStatistics::getSummary(category));
+    }
+
+    Result::Enum OmafPlayerPrivate::setSegmentCacheSettings(const SegmentCacheSettings& aSettings)
+    {
+        if (!Private::DashSegmentCache::configure(aSettings.memoryBudgetBytes, aSettings.diskPath,
+                                                  aSettings.diskBudgetBytes))
+        {
+            return Result::ITEM_NOT_FOUND;
+        }
+        return Result::OK;
+    }
+
+    Result::Enum OmafPlayerPrivate::setIndexCacheDirectory(const char* aDirectory)
+    {
+        if (aDirectory != OMAF_NULL && aDirectory[0] != '\0' && !Private::DiskManager::DirExists(aDirectory))
+        {
+            Private::MP4VRParser::setIndexCacheDirectory(OMAF_NULL);
+            return Result::ITEM_NOT_FOUND;
+        }
+        Private::MP4VRParser::setIndexCacheDirectory(aDirectory);
+        return Result::OK;
+    }
+
 }  // namespace OMAF
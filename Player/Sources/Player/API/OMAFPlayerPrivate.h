@@ -120,6 +120,11 @@ namespace OMAF
 
         virtual void_t setAudioVolume(float aVolume);
 
+        virtual LatencyStatistics getLatencyStatistics(LatencyCategory::Enum aCategory);
+
+        virtual Result::Enum setSegmentCacheSettings(const SegmentCacheSettings& aSettings);
+        virtual Result::Enum setIndexCacheDirectory(const char* aDirectory);
+
     public:  // AudioRenderer observer
         virtual void_t onRendererReady();
         virtual void_t onRendererPlaying();
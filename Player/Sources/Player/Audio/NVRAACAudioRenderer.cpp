@@ -87,6 +87,7 @@ Error::Enum AACAudioRenderer::reset()
         mPlaying = false;
     }
 
+    Spinlock::ScopeLock lock(mBufferLock);
     while (mMainAACBuffers.hasFilledPackets())
     {
         mMainAACBuffers.pushEmptyPacket(mMainAACBuffers.popFilledPacket());
@@ -382,11 +383,13 @@ Error::Enum AACAudioRenderer::removeAllStreams()
 {
     OMAF_LOG_D("removeAllStreams");
     mMainStreamId = InvalidStreamId;
+    mBufferLock.lock();
     while (mMainAACBuffers.hasFilledPackets())
     {
         mMainAACBuffers.pushEmptyPacket(mMainAACBuffers.popFilledPacket());
     }
     mMainAACBuffers.reset();
+    mBufferLock.unlock();
 
     while (!mAdditionalAudios.isEmpty())
     {
@@ -461,7 +464,7 @@ bool_t AACAudioRenderer::storeAACFrame(MediaPacketQueue& aBufferQueue, MP4VRMedi
 
 Error::Enum AACAudioRenderer::write(streamid_t aStreamId, MP4VRMediaPacket* aPacket)
 {
-    Spinlock lock(mBufferLock);
+    // Producer side of the packet queues, which need no lock against the consumer in fetchAACFrame
     if (aStreamId == mMainStreamId)
     {
         if (!storeAACFrame(mMainAACBuffers, aPacket))
@@ -487,7 +490,8 @@ Error::Enum AACAudioRenderer::write(streamid_t aStreamId, MP4VRMediaPacket* aPac
 
 AudioReturnValue::Enum AACAudioRenderer::flush()
 {
-    Spinlock lock(mBufferLock);
+    // Drains the queues as a second consumer, so must exclude fetchAACFrame
+    Spinlock::ScopeLock lock(mBufferLock);
     while (mMainAACBuffers.hasFilledPackets())
     {
         mMainAACBuffers.pushEmptyPacket(mMainAACBuffers.popFilledPacket());
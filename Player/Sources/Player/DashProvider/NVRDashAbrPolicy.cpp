@@ -0,0 +1,272 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "DashProvider/NVRDashAbrPolicy.h"
+#include "Foundation/NVRNew.h"
+
+#include <math.h>
+
+OMAF_NS_BEGIN
+
+// The legacy policy steps up only when segments download this many times faster than they play
+static const float32_t LEGACY_UPSWITCH_SPEED_FACTOR = 2.f;
+
+// Only this share of the throughput estimate is planned to be used
+static const float32_t HARMONIC_MEAN_SAFETY_FACTOR = 0.9f;
+
+// BOLA's gamma * p: the weight of avoiding rebuffering against the bitrate utility
+static const float32_t BOLA_GAMMA_P = 5.f;
+
+// Smallest buffer target used by BOLA, in segments; the bitrates are spread over the buffer levels below the target
+// minus one segment, so with less there is no room to follow the buffer level
+static const float32_t BOLA_MIN_BUFFER_TARGET_SEGMENTS = 2.f;
+
+AbrPolicy* AbrPolicy::create(AbrPolicyType::Enum aType)
+{
+    switch (aType)
+    {
+    case AbrPolicyType::LEGACY:
+        return OMAF_NEW_HEAP(AbrPolicyLegacy);
+    case AbrPolicyType::HARMONIC_MEAN:
+        return OMAF_NEW_HEAP(AbrPolicyHarmonicMean);
+    case AbrPolicyType::BOLA:
+        return OMAF_NEW_HEAP(AbrPolicyBola);
+    default:
+        return OMAF_NULL;
+    }
+}
+
+const char_t* AbrPolicy::getName(AbrPolicyType::Enum aType)
+{
+    switch (aType)
+    {
+    case AbrPolicyType::LEGACY:
+        return "legacy";
+    case AbrPolicyType::HARMONIC_MEAN:
+        return "harmonic";
+    case AbrPolicyType::BOLA:
+        return "bola";
+    default:
+        return "invalid";
+    }
+}
+
+AbrPolicy::~AbrPolicy()
+{
+}
+
+uint32_t AbrPolicy::requiredBandwidth(const AbrInput& aInput, size_t aIndex)
+{
+    uint32_t background = aInput.bitrates[0];
+    uint32_t bitrate = aInput.bitrates[aIndex];
+    return background + (uint32_t)(aInput.foregroundShare * (float32_t)(bitrate - background));
+}
+
+size_t AbrPolicy::highestSustainableIndex(const AbrInput& aInput, float32_t aBandwidth)
+{
+    size_t index = 0;
+    for (size_t i = 1; i < aInput.nrBitrates; i++)
+    {
+        if ((float32_t) requiredBandwidth(aInput, i) <= aBandwidth)
+        {
+            index = i;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return index;
+}
+
+AbrPolicyLegacy::AbrPolicyLegacy()
+{
+}
+
+AbrPolicyLegacy::~AbrPolicyLegacy()
+{
+}
+
+AbrPolicyType::Enum AbrPolicyLegacy::getType() const
+{
+    return AbrPolicyType::LEGACY;
+}
+
+size_t AbrPolicyLegacy::selectBitrateIndex(const AbrInput& aInput)
+{
+    if (aInput.issueCount > ABR_ISSUE_REPORTING_LIMIT)
+    {
+        if (aInput.currentIndex == 0)
+        {
+            return 0;
+        }
+        if (aInput.throughput == 0 || aInput.throughput > aInput.bitrates[aInput.currentIndex])
+        {
+            // not enough samples yet, or there should be enough throughput but still issues; step by 1
+            return aInput.currentIndex - 1;
+        }
+        // the highest bitrate below the throughput, starting from the one below the current
+        for (size_t i = aInput.currentIndex; i > 0; i--)
+        {
+            if (aInput.throughput > aInput.bitrates[i - 1])
+            {
+                return i - 1;
+            }
+        }
+        return 0;
+    }
+
+    if (aInput.currentIndex + 1 >= aInput.nrBitrates || aInput.downloadSpeed <= LEGACY_UPSWITCH_SPEED_FACTOR)
+    {
+        return aInput.currentIndex;
+    }
+    if (aInput.throughput > 0)
+    {
+        // sanity check: don't go up to a bitrate the throughput does not sustain, but don't go down either
+        size_t sustainable = 0;
+        for (size_t i = 0; i < aInput.nrBitrates && aInput.bitrates[i] < aInput.throughput; i++)
+        {
+            sustainable = i;
+        }
+        if (sustainable <= aInput.currentIndex)
+        {
+            return aInput.currentIndex;
+        }
+    }
+    return aInput.currentIndex + 1;
+}
+
+AbrPolicyHarmonicMean::AbrPolicyHarmonicMean()
+    : mSamples()
+    , mNextSample(0)
+{
+}
+
+AbrPolicyHarmonicMean::~AbrPolicyHarmonicMean()
+{
+}
+
+AbrPolicyType::Enum AbrPolicyHarmonicMean::getType() const
+{
+    return AbrPolicyType::HARMONIC_MEAN;
+}
+
+size_t AbrPolicyHarmonicMean::selectBitrateIndex(const AbrInput& aInput)
+{
+    if (aInput.throughput > 0)
+    {
+        if (mSamples.getSize() < mSamples.getCapacity())
+        {
+            mSamples.add((float32_t) aInput.throughput);
+        }
+        else
+        {
+            mSamples[mNextSample] = (float32_t) aInput.throughput;
+        }
+        mNextSample = (mNextSample + 1) % mSamples.getCapacity();
+    }
+    if (mSamples.isEmpty())
+    {
+        return aInput.currentIndex;
+    }
+
+    float32_t inverseSum = 0.f;
+    for (size_t i = 0; i < mSamples.getSize(); i++)
+    {
+        inverseSum += 1.f / mSamples[i];
+    }
+    float32_t estimate = (float32_t) mSamples.getSize() / inverseSum;
+
+    size_t index = highestSustainableIndex(aInput, estimate * HARMONIC_MEAN_SAFETY_FACTOR);
+    if (index > aInput.currentIndex)
+    {
+        // don't go up while there are download issues or the buffer is still refilling
+        if (aInput.issueCount > 0 ||
+            (aInput.bufferTargetMs > 0 && aInput.bufferLevelMs < aInput.bufferTargetMs / 2))
+        {
+            index = aInput.currentIndex;
+        }
+    }
+    return index;
+}
+
+AbrPolicyBola::AbrPolicyBola()
+{
+}
+
+AbrPolicyBola::~AbrPolicyBola()
+{
+}
+
+AbrPolicyType::Enum AbrPolicyBola::getType() const
+{
+    return AbrPolicyType::BOLA;
+}
+
+size_t AbrPolicyBola::selectBitrateIndex(const AbrInput& aInput)
+{
+    if (aInput.segmentDurationMs == 0 || aInput.nrBitrates < 2)
+    {
+        // the buffer level in segments is not known
+        return aInput.currentIndex;
+    }
+
+    float32_t bufferLevel = (float32_t) aInput.bufferLevelMs / (float32_t) aInput.segmentDurationMs;
+    float32_t bufferTarget = (float32_t) aInput.bufferTargetMs / (float32_t) aInput.segmentDurationMs;
+    if (bufferTarget < BOLA_MIN_BUFFER_TARGET_SEGMENTS)
+    {
+        bufferTarget = BOLA_MIN_BUFFER_TARGET_SEGMENTS;
+    }
+
+    // utility of a bitrate is the log of its size relative to the lowest one
+    float32_t lowest = (float32_t) requiredBandwidth(aInput, 0);
+    float32_t highestUtility =
+        (float32_t)::log((float32_t) requiredBandwidth(aInput, aInput.nrBitrates - 1) / lowest);
+    float32_t v = (bufferTarget - 1.f) / (highestUtility + BOLA_GAMMA_P);
+
+    // maximize (V * (utility + gamma * p) - buffer level) / size; if that is not positive for any bitrate, the
+    // buffer is above the target and the highest bitrate is used
+    size_t index = aInput.nrBitrates - 1;
+    float32_t bestScore = 0.f;
+    for (size_t i = 0; i < aInput.nrBitrates; i++)
+    {
+        float32_t size = (float32_t) requiredBandwidth(aInput, i);
+        float32_t utility = (float32_t)::log(size / lowest);
+        float32_t score = (v * (utility + BOLA_GAMMA_P) - bufferLevel) / size;
+        if (score > bestScore)
+        {
+            bestScore = score;
+            index = i;
+        }
+    }
+
+    if (index > aInput.currentIndex)
+    {
+        if (aInput.issueCount > 0)
+        {
+            index = aInput.currentIndex;
+        }
+        else if (aInput.throughput > 0)
+        {
+            size_t sustainable = highestSustainableIndex(aInput, (float32_t) aInput.throughput);
+            if (sustainable < index)
+            {
+                index = sustainable > aInput.currentIndex ? sustainable : aInput.currentIndex;
+            }
+        }
+    }
+    return index;
+}
+
+OMAF_NS_END
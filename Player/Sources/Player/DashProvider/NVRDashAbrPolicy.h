@@ -0,0 +1,128 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVRFixedArray.h"
+#include "NVREssentials.h"
+
+OMAF_NS_BEGIN
+
+namespace AbrPolicyType
+{
+    enum Enum
+    {
+        INVALID = -1,
+        LEGACY,         // the step-by-step heuristic DashBitrateContoller has always used
+        HARMONIC_MEAN,  // harmonic mean of the recent throughput samples
+        BOLA,           // buffer based, BOLA-O
+        COUNT
+    };
+}
+
+// DashBitrateContoller consults the policy at once, without waiting for the update interval, when there are more
+// download issues than this; magic number 5 is based on experiments
+static const uint32_t ABR_ISSUE_REPORTING_LIMIT = 5;
+
+// What a policy knows at each decision. Bitrates are in ascending order, as in DashBitrateContoller.
+struct AbrInput
+{
+    const uint32_t* bitrates;
+    size_t nrBitrates;
+    size_t currentIndex;
+
+    // measured throughput in bps, 0 if not available
+    uint32_t throughput;
+
+    // segment duration / download time of the latest segments, as in DashSpeedFactorMonitor
+    float32_t downloadSpeed;
+
+    // downloaded but not yet played video, and the target for it
+    uint32_t bufferLevelMs;
+    uint32_t bufferTargetMs;
+    uint32_t segmentDurationMs;
+
+    // With tiles, only the viewport and margin tiles follow the selected bitrate, while the rest stay at the
+    // background quality, ie. the lowest bitrate. This is their share of all tiles; 1 when not tiled.
+    float32_t foregroundShare;
+
+    // download issues reported since the previous switch
+    uint32_t issueCount;
+};
+
+class AbrPolicy
+{
+public:
+    static AbrPolicy* create(AbrPolicyType::Enum aType);
+    static const char_t* getName(AbrPolicyType::Enum aType);
+
+    virtual ~AbrPolicy();
+
+    virtual AbrPolicyType::Enum getType() const = 0;
+
+    // Called about once per second and whenever there are download issues; returns the bitrate index to use
+    virtual size_t selectBitrateIndex(const AbrInput& aInput) = 0;
+
+    // Bandwidth needed by the bitrate index when only the foreground tiles use it
+    static uint32_t requiredBandwidth(const AbrInput& aInput, size_t aIndex);
+
+    // Highest bitrate index whose required bandwidth fits in aBandwidth, or 0
+    static size_t highestSustainableIndex(const AbrInput& aInput, float32_t aBandwidth);
+};
+
+// The original heuristic of DashBitrateContoller: on more than ABR_ISSUE_REPORTING_LIMIT download issues goes down
+// to the highest bitrate below the throughput, or one step if the throughput is not known; otherwise goes up one step
+// when segments download more than twice as fast as they play, unless the throughput would not sustain it. Bitrates
+// are compared as such, without the foreground share.
+class AbrPolicyLegacy : public AbrPolicy
+{
+public:
+    AbrPolicyLegacy();
+    virtual ~AbrPolicyLegacy();
+
+    virtual AbrPolicyType::Enum getType() const;
+    virtual size_t selectBitrateIndex(const AbrInput& aInput);
+};
+
+// Throughput based: picks the highest bitrate that fits in a safety margin of the harmonic mean of the recent
+// throughput samples. The harmonic mean is dominated by the low samples, so single bursts don't cause upswitches,
+// but unlike the legacy heuristic a recovered bandwidth is used at once, not one step per second.
+class AbrPolicyHarmonicMean : public AbrPolicy
+{
+public:
+    AbrPolicyHarmonicMean();
+    virtual ~AbrPolicyHarmonicMean();
+
+    virtual AbrPolicyType::Enum getType() const;
+    virtual size_t selectBitrateIndex(const AbrInput& aInput);
+
+private:
+    FixedArray<float32_t, 5> mSamples;
+    size_t mNextSample;
+};
+
+// Buffer based (Spiteri et al., BOLA: Near-Optimal Bitrate Adaptation for Online Videos): the bitrate follows
+// the buffer level, from the lowest bitrate at an empty buffer to the highest one near the buffer target. As in
+// BOLA-O, an upswitch is limited to what the measured throughput sustains, to avoid oscillation.
+class AbrPolicyBola : public AbrPolicy
+{
+public:
+    AbrPolicyBola();
+    virtual ~AbrPolicyBola();
+
+    virtual AbrPolicyType::Enum getType() const;
+    virtual size_t selectBitrateIndex(const AbrInput& aInput);
+};
+
+OMAF_NS_END
@@ -22,6 +22,7 @@
 #include "Foundation/NVRTime.h"
 #include "Media/NVRMediaType.h"
 #include "Metadata/NVRCubemapDefinitions.h"
+#include "Provider/NVRLatencyStatistics.h"
 #include "VideoDecoder/NVRVideoDecoderManager.h"
 
 
@@ -41,6 +42,7 @@ DashAdaptationSet::DashAdaptationSet(DashAdaptationSetObserver& observer)
     , mContent()
     , mNextRepresentation(OMAF_NULL)
     , mDownloadStartTime(INVALID_START_TIME)
+    , mSwitchRequestTimeUs(-1)
     , mIsSeekable(false)
     , mCoveredViewport(OMAF_NULL)
     , mVideoChannel(StereoRole::UNKNOWN)
@@ -1023,6 +1025,21 @@ void_t DashAdaptationSet::doSwitchRepresentation()
                mCurrentRepresentation->getBitrate(), mNextRepresentation->getId(), mNextRepresentation->getBitrate());
     mCurrentRepresentation = mNextRepresentation;
     mNextRepresentation = OMAF_NULL;
+    recordSwitchLatency();
+}
+
+void_t DashAdaptationSet::markSwitchRequested()
+{
+    mSwitchRequestTimeUs = Time::getClockTimeUs();
+}
+
+void_t DashAdaptationSet::recordSwitchLatency()
+{
+    if (mSwitchRequestTimeUs >= 0)
+    {
+        LatencyStatistics::record(LatencyCategory::TILE_SWITCH, Time::getClockTimeUs() - mSwitchRequestTimeUs);
+        mSwitchRequestTimeUs = -1;
+    }
 }
 
 void_t DashAdaptationSet::processSegmentIndexDownload(uint32_t segmentId)
@@ -1061,6 +1078,15 @@ bool_t DashAdaptationSet::getAlignmentId(uint64_t& segmentDurationMs, uint32_t&
     }
 }
 
+uint32_t DashAdaptationSet::getCachedSegmentCount() const
+{
+    if (mCurrentRepresentation != OMAF_NULL)
+    {
+        return mCurrentRepresentation->cachedSegments();
+    }
+    return 0;
+}
+
 uint32_t DashAdaptationSet::getNrOfRepresentations() const
 {
     return (uint32_t) mRepresentations.getSize();
@@ -1142,6 +1168,7 @@ void_t DashAdaptationSet::selectBitrate(uint32_t aBitrate)
         }
         OMAF_LOG_V("Switch to %s", nextRepresentation->getId());
         mNextRepresentation = nextRepresentation;
+        markSwitchRequested();
         if (!mContent.matches(MediaContent::Type::VIDEO_ENHANCEMENT))  // What if it is enhancement? When it starts?
         {
             OMAF_LOG_V("Start downloading next %s index %d", mNextRepresentation->getId(), segmentIndex);
@@ -159,6 +159,8 @@ public:
     virtual VideoStreamMode::Enum getVideoStreamMode() const;
 
     virtual bool_t getAlignmentId(uint64_t& segmentDurationMs, uint32_t& aAlignmentId);
+    // number of downloaded segments not yet played in the current representation
+    virtual uint32_t getCachedSegmentCount() const;
 
     virtual uint32_t getNrOfRepresentations() const;
     virtual Error::Enum
@@ -201,6 +203,9 @@ public:
 protected:
     virtual Error::Enum doInitialize(DashComponents aDashComponents, uint32_t& aInitializationSegmentId);
     virtual void_t doSwitchRepresentation();
+    // Track the time it takes from selecting mNextRepresentation until doSwitchRepresentation
+    void_t markSwitchRequested();
+    void_t recordSwitchLatency();
     virtual bool_t parseVideoProperties(DashComponents& aNextComponents);
     virtual void_t parseVideoViewport(DashComponents& aNextComponents);
     virtual bool_t parseVideoQuality(DashComponents& aNextComponents,
@@ -217,6 +222,7 @@ protected:
     DashAdaptationSetObserver& mObserver;
     MediaContent mContent;
     time_t mDownloadStartTime;
+    int64_t mSwitchRequestTimeUs;
     typedef FixedArray<DashRepresentation*, 512> Representations;
     Representations mRepresentations;  // ordered by bitrate; owns the members
     DashRepresentation* mCurrentRepresentation;
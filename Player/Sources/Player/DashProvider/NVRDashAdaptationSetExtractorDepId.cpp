@@ -174,6 +174,7 @@ bool_t DashAdaptationSetExtractorDepId::selectRepresentation(const VASTileViewpo
                 return false;
             }
             mNextRepresentation = *it;
+            markSwitchRequested();
             OMAF_LOG_V("selectRepresentation for extractor, found: %s", mNextRepresentation->getId());
             // find the dependencies for this one
             for (RepresentationDependencies::Iterator dRepr = mDependingRepresentationIds.begin();
@@ -238,6 +239,7 @@ void_t DashAdaptationSetExtractorDepId::doSwitchRepresentation()
 #endif
     mCurrentRepresentation = mNextRepresentation;
     mNextRepresentation = OMAF_NULL;
+    recordSwitchLatency();
 }
 
 bool_t DashAdaptationSetExtractorDepId::prepareForSwitch(uint32_t aNextProcessedSegment, bool_t aAggressiveSwitch)
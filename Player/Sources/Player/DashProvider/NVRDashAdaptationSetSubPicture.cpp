@@ -79,6 +79,7 @@ void_t DashAdaptationSetSubPicture::doSwitchRepresentation()
 #endif
     mCurrentRepresentation = mNextRepresentation;
     mNextRepresentation = OMAF_NULL;
+    recordSwitchLatency();
 }
 
 OMAF_NS_END
@@ -414,6 +414,7 @@ bool_t DashAdaptationSetTile::selectQuality(uint8_t aQualityLevel,
         mNextRepresentation->stopDownload();
     }
     mNextRepresentation = nextRepresentation;
+    markSwitchRequested();
 
     if (aRole == TileRole::BACKGROUND || aRole == TileRole::BACKGROUND_POLE)
     {
@@ -528,6 +529,7 @@ bool_t DashAdaptationSetTile::selectRepresentation(DependableRepresentations& aD
             {
                 OMAF_LOG_V("selectRepresentation, found: %s", (*repr)->getId());
                 mNextRepresentation = *repr;
+                markSwitchRequested();
                 mCurrentRepresentation->stopDownloadAsync(
                     false, false);  // don't abort since that can cause sync issues with segments
                 return prepareForSwitch(aNextProcessedSegment,
@@ -694,6 +696,7 @@ void_t DashAdaptationSetTile::doSwitchRepresentation()
     mCurrentRepresentation->switchedToAnother();
     mCurrentRepresentation = mNextRepresentation;
     mNextRepresentation = OMAF_NULL;
+    recordSwitchLatency();
 }
 
 // Since OMAF requires that representations within an adaptation set have the same resolution, we should pick the
@@ -26,8 +26,7 @@ OMAF_LOG_ZONE(DashBitrateContoller);
 
 const float32_t BITRATE_UPGRADE_MULTIPLIER = 1.3f;
 const int64_t RETRY_INTERVAL_MS = 500;
-const float32_t UPSWITCH_SPEED_FACTOR = 2.f;
-const int ISSUE_REPORTING_LIMIT = 5;  // magic number 5 is based on experiments
+const float32_t DEFAULT_PREFETCH_BANDWIDTH_SHARE = 0.15f;
 
 DashBitrateContoller::DashBitrateContoller()
     : mVideoDownloader(OMAF_NULL)
@@ -41,20 +40,46 @@ DashBitrateContoller::DashBitrateContoller()
     , mQualityForeground(1)
     , mQualityBackground(1)
     , mCanEstimate(false)
+    , mPrefetchBandwidthShare(DEFAULT_PREFETCH_BANDWIDTH_SHARE)
+    , mAbrPolicy(AbrPolicy::create(AbrPolicyType::LEGACY))
+    , mForegroundShare(1.f)
 {
 }
 
 DashBitrateContoller::~DashBitrateContoller()
 {
+    OMAF_DELETE_HEAP(mAbrPolicy);
     BandwidthMonitor::setMode(false);
 }
 
+void_t DashBitrateContoller::setAbrPolicy(AbrPolicyType::Enum aType)
+{
+    AbrPolicy* policy = AbrPolicy::create(aType);
+    if (policy != OMAF_NULL)
+    {
+        OMAF_DELETE_HEAP(mAbrPolicy);
+        mAbrPolicy = policy;
+    }
+}
+
+AbrPolicyType::Enum DashBitrateContoller::getAbrPolicy() const
+{
+    return mAbrPolicy->getType();
+}
+
+void_t DashBitrateContoller::setTileSplit(size_t aNrForegroundTiles, size_t aNrTiles)
+{
+    if (aNrTiles > 0 && aNrForegroundTiles <= aNrTiles)
+    {
+        mForegroundShare = (float32_t) aNrForegroundTiles / (float32_t) aNrTiles;
+    }
+}
+
 void_t DashBitrateContoller::initialize(DashVideoDownloader* aVideoDownloader)
 {
     OMAF_ASSERT(mVideoDownloader == OMAF_NULL, "Already initialized");
     mVideoDownloader = aVideoDownloader;
 
-    mLastBitrateCheckTimeMs = Time::getClockTimeMs();
     // Store the possible bitrates to member (assuming they don't change over time even if mpd gets updated)
     // First all the baselayer bitrates for non-tiled use
     // Note! The whole bitrate controller assumes that baselayer bitrate(0) is always used with tiles, and that there
@@ -62,153 +87,93 @@ void_t DashBitrateContoller::initialize(DashVideoDownloader* aVideoDownloader)
     // layer(s) and enh layer(s), so using other base layers would be solely player's decision. Also, it assumes the
     // tiles have equal bitrates, i.e. the bitrates from tile(0) can be used with all tiles. Even though that may not be
     // accurate, it may be a fair approximation, considering the complexity of the accurate estimation.
-    mPossibleBitrates.add(mVideoDownloader->getBitrates());
-    mNrVideoBitrates = (uint32_t) mPossibleBitrates.getSize();
-    mCanEstimate = BandwidthMonitor::setMode(true);
-    if (mPossibleBitrates.isEmpty())
-    {
-        mCanEstimate = false;
-    }
+    initializeBitrates(mVideoDownloader->getBitrates(), BandwidthMonitor::setMode(true));
 }
 
 bool_t DashBitrateContoller::update(uint32_t aBandwidthOverhead)
 {
-    int32_t now = Time::getClockTimeMs();
-
-    // old single problem don't stay there forever preventing upgrades
-
-    if (mIssueCount > ISSUE_REPORTING_LIMIT)
-    {
-        mUpdateInterval = 1000;
-        if (mCurrentBitrateIndex > 0)
-        {
-            // check the throughput
-            bool_t isFunctional = false;
-            uint32_t throughput = BandwidthMonitor::getInstantaneousThroughputInBps(isFunctional) - aBandwidthOverhead;
-            uint32_t oldBitrateIndex = mCurrentBitrateIndex;
-            if (isFunctional)
-            {
-                OMAF_LOG_ABR("ABRSwitchDown: Go down");
-                setBitrate(findDowngradeBitrateIndex(mPossibleBitrates, throughput));
-            }
-            else
-            {
-                OMAF_LOG_ABR("ABRSwitchDown: Go down by 1 step");
-                // bandwidth monitor not functional
-                setBitrate(mCurrentBitrateIndex - 1);
-            }
+    return updateWithPolicy(aBandwidthOverhead);
+}
 
-            doUpdate();
-            mLastBitrateCheckTimeMs = Time::getClockTimeMs();
+bool_t DashBitrateContoller::updateWithPolicy(uint32_t aBandwidthOverhead)
+{
+    uint32_t now = getClockTimeMs();
 
-            OMAF_LOG_ABR(
-                "ABR(Time/State/OldQ/NewQ/throughput/delayedsegments/speedfactor) %d ABR_RULE_THROUGHPUT %d %d %d "
-                "%d %f",
-                mLastBitrateCheckTimeMs, oldBitrateIndex, mCurrentBitrateIndex, throughput, mIssueCount,
-                DashSpeedFactorMonitor::getDownloadSpeed());
-            return true;
-        }
-        else
-        {
-            OMAF_LOG_ABR("ABRSwitchDown: Already at lowest bitrate, resetting mIssueCount");
-            increaseCache();
-            mIssueCount = 0;
-            return false;
-        }
-    }
-    else if (!mCanEstimate || mCurrentBitrateIndex == mPossibleBitrates.getSize() - 1 ||
-             ((now - mLastBitrateCheckTimeMs < mUpdateInterval) &&
-              !(mRetry && now - mLastBitrateCheckTimeMs > RETRY_INTERVAL_MS)))
+    // download issues are handled at once, otherwise the policy is consulted once per interval
+    if (mIssueCount <= ABR_ISSUE_REPORTING_LIMIT &&
+        (!mCanEstimate || (now - mLastBitrateCheckTimeMs < mUpdateInterval &&
+                           !(mRetry && now - mLastBitrateCheckTimeMs > RETRY_INTERVAL_MS))))
     {
-        // It doesn't make sense to check for upgrade too frequently
         return false;
     }
     mLastBitrateCheckTimeMs = now;
-    mRetry = false;
     mUpdateInterval = 1000;
-    if (mCurrentBitrateIndex < mPossibleBitrates.getSize() - 1 &&
-        DashSpeedFactorMonitor::getDownloadSpeed() > UPSWITCH_SPEED_FACTOR)
+    mRetry = false;
+
+    AbrInput input;
+    input.bitrates = mPossibleBitrates.getData();
+    input.nrBitrates = mPossibleBitrates.getSize();
+    input.currentIndex = (size_t) mCurrentBitrateIndex;
+    input.foregroundShare = mForegroundShare;
+    input.issueCount = mIssueCount;
+    readAbrInput(input, aBandwidthOverhead);
+
+    size_t bitrateIndex = mAbrPolicy->selectBitrateIndex(input);
+    if (bitrateIndex == (size_t) mCurrentBitrateIndex)
     {
-        // step up by 1
-        if (canSwitch())
+        if (mIssueCount > ABR_ISSUE_REPORTING_LIMIT)
         {
-            bool_t isFunctional = false;
-            uint8_t bitrateIndex = mCurrentBitrateIndex + 1;
-            /* Sanity check, don't try to switch if the new rate is unsustainable */
-            uint32_t throughput = BandwidthMonitor::getInstantaneousThroughputInBps(isFunctional) - aBandwidthOverhead;
-            uint8_t bitrateIndexfromThroughput = bitrateIndex;
-            if (isFunctional)
+            if (mCurrentBitrateIndex == 0)
             {
-                bitrateIndexfromThroughput = getQualityFromThroughput(mPossibleBitrates, throughput);
+                OMAF_LOG_ABR("ABR %s: Already at lowest bitrate, resetting mIssueCount",
+                             AbrPolicy::getName(mAbrPolicy->getType()));
+                increaseCache();
             }
-            /* only check to make sure we are not increasing to unsustainable levels */
-            if (bitrateIndex > bitrateIndexfromThroughput)
-            {
-                if (bitrateIndexfromThroughput <= mCurrentBitrateIndex)
-                {
-                    OMAF_LOG_ABR(
-                        "Sanity check Throughput: Current: %d, Time: %d, Throughput: %d (%d) - Enforcing no change ",
-                        mCurrentBitrateIndex, bitrateIndex, bitrateIndexfromThroughput, throughput);
-                    /* Avoid oscillations - do not drop quality until buffer level falls */
-                    return false;
-                }
-                else
-                {
-                    /* In the single incremental case, this  case should never happen, but if the algorithm does
-                    bigger increments in the future, this failsafe would avoid pitfalls */
-                    OMAF_LOG_ABR(
-                        "Sanity check Throughput: Current: %d, Time: %d, Throughput: %d - Enforcing change to "
-                        "throughput index",
-                        mCurrentBitrateIndex, bitrateIndex, bitrateIndexfromThroughput);
-                    bitrateIndex = bitrateIndexfromThroughput;
-                }
-            }
-            OMAF_LOG_V("ABRSwitchUp by 1 step");
-            setBitrate(bitrateIndex);
-            doUpdate();
-            return true;
-        }
-        else
-        {
-            // use temporarily shorter time
-            OMAF_LOG_ABR("ABRSwitchUp: Bitrate change from %d to %d not possible now, try again later",
-                         mPossibleBitrates[mCurrentBitrateIndex], mPossibleBitrates[mCurrentBitrateIndex + 1]);
-            mRetry = true;
+            mIssueCount = 0;
         }
+        return false;
     }
-    else
+    if (bitrateIndex > (size_t) mCurrentBitrateIndex && !canSwitch())
     {
-        OMAF_LOG_ABR("Upgrade not possible: CurrentIndex: %d, Speedfactor %f", mCurrentBitrateIndex,
-                     DashSpeedFactorMonitor::getDownloadSpeed());
+        // use temporarily shorter time
+        OMAF_LOG_ABR("ABR %s: Bitrate change from %d to %d not possible now, try again later",
+                     AbrPolicy::getName(mAbrPolicy->getType()), mPossibleBitrates[mCurrentBitrateIndex],
+                     mPossibleBitrates[bitrateIndex]);
+        mRetry = true;
+        return false;
     }
 
-    return false;
+    OMAF_LOG_ABR("ABR(Time/Policy/OldQ/NewQ/throughput/buffer/speedfactor/issues) %d %s %d %d %d %d %f %d", now,
+                 AbrPolicy::getName(mAbrPolicy->getType()), mCurrentBitrateIndex, (int32_t) bitrateIndex,
+                 input.throughput, input.bufferLevelMs, input.downloadSpeed, mIssueCount);
+    setBitrate(bitrateIndex);
+    doUpdate();
+    return true;
 }
 
-size_t DashBitrateContoller::getQualityFromThroughput(const Bitrates& aBitrates, uint32_t throughput)
+void_t DashBitrateContoller::initializeBitrates(const Bitrates& aBitrates, bool_t aCanEstimate)
 {
-    size_t chosenIndex = 0;
-
-    /*Not enough instances of throughput, don't change the quality*/
-    if (throughput == 0)
-    {
-        return mCurrentBitrateIndex;
-    }
-
+    mLastBitrateCheckTimeMs = getClockTimeMs();
+    mPossibleBitrates.add(aBitrates);
+    mNrVideoBitrates = (uint32_t) mPossibleBitrates.getSize();
+    mCanEstimate = aCanEstimate && !mPossibleBitrates.isEmpty();
+}
 
-    for (int i = 0; i < aBitrates.getSize(); i++)
-    {
-        if (aBitrates[i] < throughput)
-        {
-            chosenIndex = i;
-        }
-        else
-        {
-            break;
-        }
-    }
+uint32_t DashBitrateContoller::getClockTimeMs() const
+{
+    return Time::getClockTimeMs();
+}
 
-    return chosenIndex;
+void_t DashBitrateContoller::readAbrInput(AbrInput& aInput, uint32_t aBandwidthOverhead)
+{
+    bool_t isFunctional = false;
+    uint32_t throughput = BandwidthMonitor::getInstantaneousThroughputInBps(isFunctional);
+    aInput.throughput = isFunctional && throughput > aBandwidthOverhead ? throughput - aBandwidthOverhead : 0;
+    aInput.downloadSpeed = DashSpeedFactorMonitor::getDownloadSpeed();
+    aInput.bufferLevelMs = 0;
+    aInput.segmentDurationMs = 0;
+    mVideoDownloader->getBufferLevel(aInput.bufferLevelMs, aInput.segmentDurationMs);
+    aInput.bufferTargetMs = mVideoDownloader->getBufferingTimeMs();
 }
 
 bool_t DashBitrateContoller::canSwitch()
@@ -227,48 +192,6 @@ void_t DashBitrateContoller::doUpdate()
     mIssueCount = 0;
 }
 
-int32_t DashBitrateContoller::findDowngradeBitrateIndex(const Bitrates& aBitrates, const uint32_t aThroughput)
-{
-    // Set to 0 at first so that if nothing better is found, the lowest one is used
-    size_t chosenIndex = 0;
-    if (aThroughput == 0)
-    {
-        if (mCurrentBitrateIndex > 0)
-        {
-            // not enough samples available yet (?), try stepping by 1
-            return mCurrentBitrateIndex - 1;
-        }
-        else
-        {
-            return mCurrentBitrateIndex;
-        }
-    }
-
-    uint32_t currentBitrate = aBitrates.at(mCurrentBitrateIndex);
-    if (aThroughput > currentBitrate)
-    {
-        // There should be enough throughput, but still some issues detected? Try stepping by 1
-        return mCurrentBitrateIndex - 1;
-    }
-
-    if (aBitrates.getSize() > 1)
-    {
-        for (size_t i = mCurrentBitrateIndex; i > 0; i--)
-        {
-            // we came here since there were download issues, so we start checking from current-1 index
-            size_t index = i - 1;
-            uint32_t bitrate = aBitrates.at(index);
-
-            if (aThroughput > bitrate)
-            {
-                chosenIndex = index;
-                break;
-            }
-        }
-    }
-    return chosenIndex;
-}
-
 bool_t DashBitrateContoller::setBitrate(size_t aBitrateIndex)
 {
     uint8_t delta = mCurrentBitrateIndex - aBitrateIndex;
@@ -287,7 +210,7 @@ bool_t DashBitrateContoller::reportDownloadProblem(IssueType::Enum aIssueType)
     OMAF_LOG_W("download problem! Issue type: %d", aIssueType);
     if (aIssueType == IssueType::BASELAYER_BUFFERING)
     {
-        mIssueCount = ISSUE_REPORTING_LIMIT;
+        mIssueCount = ABR_ISSUE_REPORTING_LIMIT;
     }
 
     mIssueCount++;
@@ -363,6 +286,27 @@ bool_t DashBitrateContoller::getQualityLevelMargin(size_t aNrViewportTiles,
     }
 }
 
+bool_t DashBitrateContoller::getQualityLevelPrefetch(uint8_t& aLevel, uint8_t& aNrLevels, float32_t& aBandwidthShare) const
+{
+    // same level as margins; with 2 or less levels there is nothing between viewport and background
+    if (mNrQualityLevels > 2 && mPrefetchBandwidthShare > 0.f)
+    {
+        aNrLevels = mNrQualityLevels;
+        aLevel = min(mQualityForeground + 1, (int) mQualityBackground);
+        aBandwidthShare = mPrefetchBandwidthShare;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void_t DashBitrateContoller::setPrefetchBandwidthShare(float32_t aShare)
+{
+    mPrefetchBandwidthShare = aShare;
+}
+
 
 DashBitrateContollerExtractor::DashBitrateContollerExtractor()
     : DashBitrateContoller()
@@ -13,6 +13,7 @@
  * written consent of Nokia.
  */
 #pragma once
+#include "DashProvider/NVRDashAbrPolicy.h"
 #include "DashProvider/NVRDashIssueType.h"
 #include "DashProvider/NVRDashVideoDownloader.h"
 #include "Foundation/NVRFixedArray.h"
@@ -38,16 +39,32 @@ public:
     virtual bool_t getQualityLevelBackground(uint8_t& aLevel, uint8_t& aNrLevels) const;
     virtual bool_t getQualityLevelMargin(uint8_t& aLevel) const;
     virtual bool_t getQualityLevelMargin(size_t aNrViewportTiles, size_t& aMarginTilesBudget, uint8_t& aLevel) const;
+    // tiles predicted to enter the viewport are prefetched at aLevel, using at most aBandwidthShare of the viewport
+    // tiles' bandwidth on top of the background quality
+    virtual bool_t getQualityLevelPrefetch(uint8_t& aLevel, uint8_t& aNrLevels, float32_t& aBandwidthShare) const;
+    void_t setPrefetchBandwidthShare(float32_t aShare);
+
+    // Select the rate-selection policy; LEGACY is the default
+    void_t setAbrPolicy(AbrPolicyType::Enum aType);
+    AbrPolicyType::Enum getAbrPolicy() const;
+
+    // Number of tiles that follow the selected bitrate (viewport and margins) out of all tiles, for the policies
+    void_t setTileSplit(size_t aNrForegroundTiles, size_t aNrTiles);
 
 protected:
     virtual void_t doUpdate();
     virtual bool_t setBitrate(size_t aBitrateIndex);
     virtual void_t increaseCache();
 
+    // Where the bitrates, the time and the policy input come from; the video downloader and the monitors by default,
+    // overridden to drive the controller without them, like the ABR simulator does
+    void_t initializeBitrates(const Bitrates& aBitrates, bool_t aCanEstimate);
+    virtual uint32_t getClockTimeMs() const;
+    virtual void_t readAbrInput(AbrInput& aInput, uint32_t aBandwidthOverhead);
+    virtual bool_t canSwitch();
+
 private:
-    bool_t canSwitch();
-    int32_t findDowngradeBitrateIndex(const Bitrates& aBitrates, const uint32_t aAvailableBandwidth);
-    size_t getQualityFromThroughput(const Bitrates& aBitrates, uint32_t throughput);
+    bool_t updateWithPolicy(uint32_t aBandwidthOverhead);
 
 protected:
     DashVideoDownloader* mVideoDownloader;
@@ -58,6 +75,9 @@ protected:
     uint8_t mQualityForeground;
     uint32_t mNrVideoBitrates;
     Bitrates mPossibleBitrates;
+    float32_t mPrefetchBandwidthShare;
+    AbrPolicy* mAbrPolicy;
+    float32_t mForegroundShare;
 
 private:
     uint32_t mLastBitrateCheckTimeMs;
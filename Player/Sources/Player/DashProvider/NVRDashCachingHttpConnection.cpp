@@ -0,0 +1,194 @@
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "DashProvider/NVRDashCachingHttpConnection.h"
+
+#include "DashProvider/NVRDashSegmentCache.h"
+#include "Foundation/NVRHttp.h"
+
+OMAF_NS_BEGIN
+
+DashCachingHttpConnection::DashCachingHttpConnection(MemoryAllocator& allocator)
+    : mAllocator(allocator)
+    , mConnection(Http::createHttpConnection(allocator))
+    , mHttpDataProcessor(OMAF_NULL)
+    , mUrl()
+    , mHeaders()
+    , mServedFromCache(false)
+    , mCachedState()
+    , mStorePending(false)
+    , mOutput(OMAF_NULL)
+{
+    mCachedState.connectionState = HttpConnectionState::IDLE;
+}
+
+DashCachingHttpConnection::~DashCachingHttpConnection()
+{
+    OMAF_DELETE(mAllocator, mConnection);
+}
+
+const HttpRequestState& DashCachingHttpConnection::getState() const
+{
+    if (mServedFromCache)
+    {
+        return mCachedState;
+    }
+
+    const HttpRequestState& state = mConnection->getState();
+    storeIfCompleted(state);
+
+    return state;
+}
+
+void_t DashCachingHttpConnection::setUserAgent(const utf8_t* aUserAgent)
+{
+    mConnection->setUserAgent(aUserAgent);
+}
+
+void_t DashCachingHttpConnection::setTimeout(uint32_t timeoutMS)
+{
+    mConnection->setTimeout(timeoutMS);
+}
+
+void_t DashCachingHttpConnection::setHttpDataProcessor(IHttpDataProcessor* aHttpDataProcessor)
+{
+    mHttpDataProcessor = aHttpDataProcessor;
+    mConnection->setHttpDataProcessor(aHttpDataProcessor);
+}
+
+bool_t DashCachingHttpConnection::setUri(const Url& url)
+{
+    mUrl = url;
+    mServedFromCache = false;
+    mStorePending = false;
+
+    return mConnection->setUri(url);
+}
+
+void_t DashCachingHttpConnection::setHeaders(const HttpHeaderList& headers)
+{
+    mHeaders = headers;
+    mConnection->setHeaders(headers);
+}
+
+void_t DashCachingHttpConnection::setKeepAlive(uint32_t timeMS)
+{
+    mConnection->setKeepAlive(timeMS);
+}
+
+HttpRequest::Enum DashCachingHttpConnection::get(DataBuffer<uint8_t>* output)
+{
+    mServedFromCache = false;
+    mStorePending = false;
+
+    if (output != OMAF_NULL && DashSegmentCache::lookup(mUrl, mHeaders, *output))
+    {
+        bool_t ranged = false;
+        for (HttpHeaderPairList::ConstIterator it = mHeaders.begin(); it != mHeaders.end(); ++it)
+        {
+            ranged = ranged || (*it).first == "Range";
+        }
+
+        mCachedState = HttpRequestState();
+        mCachedState.httpStatus = ranged ? 206 : 200;
+        mCachedState.bytesDownloaded = output->getSize();
+        mCachedState.totalBytes = output->getSize();
+        mCachedState.output = output;
+        mServedFromCache = true;
+
+        if (mHttpDataProcessor != OMAF_NULL)
+        {
+            mHttpDataProcessor->processHttpData();
+        }
+        mCachedState.connectionState = HttpConnectionState::COMPLETED;
+
+        return HttpRequest::OK;
+    }
+
+    HttpRequest::Enum result = mConnection->get(output);
+    mStorePending = (result == HttpRequest::OK && output != OMAF_NULL);
+    mOutput = output;
+
+    return result;
+}
+
+HttpRequest::Enum DashCachingHttpConnection::post(const DataBuffer<uint8_t>* input, DataBuffer<uint8_t>* output)
+{
+    mServedFromCache = false;
+    mStorePending = false;
+
+    return mConnection->post(input, output);
+}
+
+HttpRequest::Enum DashCachingHttpConnection::head()
+{
+    mServedFromCache = false;
+    mStorePending = false;
+
+    return mConnection->head();
+}
+
+void_t DashCachingHttpConnection::abortRequest()
+{
+    mStorePending = false;
+
+    if (mServedFromCache)
+    {
+        mCachedState.connectionState = HttpConnectionState::ABORTED;
+        return;
+    }
+    mConnection->abortRequest();
+}
+
+void_t DashCachingHttpConnection::waitForCompletion()
+{
+    if (!mServedFromCache)
+    {
+        mConnection->waitForCompletion();
+    }
+}
+
+bool_t DashCachingHttpConnection::hasCompleted()
+{
+    if (mServedFromCache)
+    {
+        return true;
+    }
+    if (mConnection->hasCompleted())
+    {
+        storeIfCompleted(mConnection->getState());
+        return true;
+    }
+    return false;
+}
+
+bool_t DashCachingHttpConnection::isServedFromCache() const
+{
+    return mServedFromCache;
+}
+
+void_t DashCachingHttpConnection::storeIfCompleted(const HttpRequestState& state) const
+{
+    if (!mStorePending || state.connectionState != HttpConnectionState::COMPLETED)
+    {
+        return;
+    }
+    mStorePending = false;
+
+    if (state.httpStatus >= 200 && state.httpStatus < 300 && mOutput->getSize() > 0)
+    {
+        DashSegmentCache::store(mUrl, mHeaders, mOutput->getDataPtr(), mOutput->getSize());
+    }
+}
+
+OMAF_NS_END
@@ -0,0 +1,87 @@
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "NVREssentials.h"
+
+#include "Foundation/NVRHttpConnection.h"
+
+OMAF_NS_BEGIN
+
+/*
+ * HttpConnection that serves GET requests from DashSegmentCache when possible, and otherwise forwards them to a
+ * platform connection and adds successful responses to the cache.
+ *
+ * A cache hit completes synchronously within get(). Responses are stored when the owner observes the completed state
+ * through getState() or hasCompleted(), i.e. on the owner's thread rather than the download thread.
+ */
+class DashCachingHttpConnection : public HttpConnection
+{
+public:
+    DashCachingHttpConnection(MemoryAllocator& allocator);
+
+    virtual ~DashCachingHttpConnection();
+
+    virtual const HttpRequestState& getState() const;
+
+    virtual void_t setUserAgent(const utf8_t* aUserAgent);
+
+    virtual void_t setTimeout(uint32_t timeoutMS);
+
+    virtual void_t setHttpDataProcessor(IHttpDataProcessor* aHttpDataProcessor);
+
+    virtual bool_t setUri(const Url& url);
+
+    virtual void_t setHeaders(const HttpHeaderList& headers);
+
+    virtual void_t setKeepAlive(uint32_t timeMS);
+    // Async, or completes immediately on a cache hit
+    virtual HttpRequest::Enum get(DataBuffer<uint8_t>* output);
+    // Async, never cached
+    virtual HttpRequest::Enum post(const DataBuffer<uint8_t>* input, DataBuffer<uint8_t>* output);
+    // Async, never cached
+    virtual HttpRequest::Enum head();
+    // Async
+    virtual void_t abortRequest();
+    // Sync
+    virtual void_t waitForCompletion();
+    // Sync
+    virtual bool_t hasCompleted();
+
+    // True if the latest GET was answered from the segment cache instead of the network
+    bool_t isServedFromCache() const;
+
+private:
+    OMAF_NO_COPY(DashCachingHttpConnection);
+    OMAF_NO_ASSIGN(DashCachingHttpConnection);
+
+    void_t storeIfCompleted(const HttpRequestState& state) const;
+
+private:
+    MemoryAllocator& mAllocator;
+    HttpConnection* mConnection;
+    IHttpDataProcessor* mHttpDataProcessor;
+
+    Url mUrl;
+    HttpHeaderList mHeaders;
+
+    bool_t mServedFromCache;
+    HttpRequestState mCachedState;
+
+    // Set while a forwarded GET may still be added to the cache
+    mutable bool_t mStorePending;
+    const DataBuffer<uint8_t>* mOutput;
+};
+
+OMAF_NS_END
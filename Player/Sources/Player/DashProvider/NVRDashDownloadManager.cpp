@@ -85,6 +85,14 @@ void_t DashDownloadManager::disableABR()
     }
 }
 
+void_t DashDownloadManager::setAbrPolicy(AbrPolicyType::Enum aType)
+{
+    if (mCurrentViewpoint && mCurrentViewpoint->videoDownloader)
+    {
+        mCurrentViewpoint->videoDownloader->setAbrPolicy(aType);
+    }
+}
+
 void_t DashDownloadManager::setBandwidthOverhead(uint32_t aBandwithOverhead)
 {
     mCurrentViewpoint->videoDownloader->setBandwidthOverhead(aBandwithOverhead);
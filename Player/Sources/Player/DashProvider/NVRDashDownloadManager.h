@@ -69,6 +69,7 @@ public:
 
     void_t enableABR();
     void_t disableABR();
+    void_t setAbrPolicy(AbrPolicyType::Enum aType);
     void_t setBandwidthOverhead(uint32_t aBandwidthOverhead);
 
     uint32_t getCurrentBitrate();
@@ -178,6 +178,9 @@ void_t DashProvider::parserThreadCallback()
 
         while (1)
         {
+            // segments are parsed in this loop, so nothing allocated from the scratch arena outlives a round
+            MemorySystem::ResetScratchAllocator();
+
             if (mSeekTargetUs != OMAF_UINT64_MAX)
             {
                 doSeek();
@@ -262,6 +262,15 @@ MP4VRParser* DashRepresentation::getParserInstance()
     return mParser;
 }
 
+bool_t DashRepresentation::hasParserInstance() const
+{
+    if (mAssociatedToRepresentation != OMAF_NULL)
+    {
+        return mAssociatedToRepresentation->hasParserInstance();
+    }
+    return mParser != OMAF_NULL;
+}
+
 dash::mpd::ISegmentTemplate* DashRepresentation::getSegmentTemplate(DashComponents dashComponents)
 {
     // Try first from the representation
@@ -329,7 +338,7 @@ Error::Enum DashRepresentation::startDownloadFromSegment(uint32_t& aTargetDownlo
     mDownloading = true;
     // clear too old segments that were loaded previously but never read (ABR switch was done before they were read)
     uint32_t id = 0;
-    if (getParserInstance()->getNewestSegmentId(mSegmentContent.initializationSegmentId, id))
+    if (hasParserInstance() && getParserInstance()->getNewestSegmentId(mSegmentContent.initializationSegmentId, id))
     {
         if (aNextToBeProcessedSegmentId == INVALID_SEGMENT_INDEX)
         {
@@ -361,6 +370,11 @@ Error::Enum DashRepresentation::startDownloadFromSegment(uint32_t& aTargetDownlo
 
 Error::Enum DashRepresentation::seekStreamsTo(uint64_t seekToPts)
 {
+    if (!hasParserInstance())
+    {
+        // nothing parsed, nothing to seek
+        return Error::OK;
+    }
     getParserInstance()->seekToUs(seekToPts, mAudioStreams, mVideoStreams, SeekDirection::PREVIOUS,
                                   SeekAccuracy::FRAME_ACCURATE);
     return Error::OK;
@@ -521,9 +535,9 @@ void_t DashRepresentation::clearDownloadedContent(bool_t aResetInitialization)
     if (mSegmentStream != OMAF_NULL)
     {
         mSegmentStream->clearDownloadedSegments();
-        if (mAssociatedToRepresentation == OMAF_NULL)
+        if (mAssociatedToRepresentation == OMAF_NULL && mParser != OMAF_NULL)
         {  // dependent representations share parser. Let owner clean up parser.
-            getParserInstance()->releaseAllSegments(mAudioStreams, mVideoStreams, mMetadataStreams,
+            mParser->releaseAllSegments(mAudioStreams, mVideoStreams, mMetadataStreams,
                                                     aResetInitialization);
         }
         if (aResetInitialization)
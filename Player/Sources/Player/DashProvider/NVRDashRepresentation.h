@@ -89,6 +89,8 @@ public:
 
     void setAssociatedToRepresentation(DashRepresentation* representation);
     MP4VRParser* getParserInstance();
+    // false until the parser is needed; tile representations that feed an extractor may never need one
+    bool_t hasParserInstance() const;
     virtual void_t setLoopingOn();
 
 public:
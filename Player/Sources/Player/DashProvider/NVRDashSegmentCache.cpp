@@ -0,0 +1,608 @@
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "DashProvider/NVRDashSegmentCache.h"
+
+#include "DashProvider/NVRDashLog.h"
+#include "Foundation/NVRDiskFileStream.h"
+#include "Foundation/NVRDiskManager.h"
+#include "Foundation/NVRHashMap.h"
+#include "Foundation/NVRMemorySystem.h"
+#include "Foundation/NVRMutex.h"
+#include "Foundation/NVRNew.h"
+#include "Foundation/NVRPathName.h"
+
+OMAF_NS_BEGIN
+OMAF_LOG_ZONE(DashSegmentCache)
+
+namespace DashSegmentCache
+{
+    static const size_t INDEX_BUCKET_COUNT = 1021;
+    static const uint32_t SEGMENT_FILE_MAGIC = 0x53474d43;  // "SGMC"
+    static const uint32_t INDEX_FILE_MAGIC = 0x53474d49;    // "SGMI"
+    static const uint32_t INDEX_FILE_VERSION = 1;
+    static const char_t* INDEX_FILE_NAME = "segments.idx";
+    static const char_t* SEGMENT_FILE_EXTENSION = ".seg";
+    static const char_t* TEMP_FILE_EXTENSION = ".tmp";
+
+    // The hash selects the entry; the full key is kept with the data since hashes may collide
+    struct Key
+    {
+        uint64_t hash;
+        Url url;
+        FixedString64 range;
+    };
+
+    struct MemoryEntry
+    {
+        Key key;
+        uint8_t* data;
+        size_t size;
+        MemoryEntry* prev;  // more recently used
+        MemoryEntry* next;  // less recently used
+    };
+
+    struct DiskEntry
+    {
+        uint64_t hash;
+        uint64_t size;
+        DiskEntry* prev;
+        DiskEntry* next;
+    };
+
+    // Header of a segment file, followed by the URL, the range and the segment data
+    struct SegmentFileHeader
+    {
+        uint32_t magic;
+        uint32_t urlSize;
+        uint32_t rangeSize;
+        uint32_t reserved;
+    };
+
+    struct IndexFileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t count;
+    };
+
+    // Entries in most recently used first order
+    struct IndexFileEntry
+    {
+        uint64_t hash;
+        uint64_t size;
+    };
+
+    template <typename T>
+    struct LruList
+    {
+        T* head;
+        T* tail;
+    };
+
+    typedef HashMap<uint64_t, MemoryEntry*> MemoryIndex;
+    typedef HashMap<uint64_t, DiskEntry*> DiskIndex;
+
+    struct CacheState
+    {
+        MemoryAllocator* allocator;
+
+        MemoryIndex* memoryIndex;
+        LruList<MemoryEntry> memoryLru;
+        uint64_t memoryBudget;
+        uint64_t memoryUsed;
+
+        DiskIndex* diskIndex;
+        LruList<DiskEntry> diskLru;
+        uint64_t diskBudget;
+        uint64_t diskUsed;
+
+        uint32_t memoryHits;
+        uint32_t diskHits;
+        uint32_t misses;
+    };
+
+    static CacheState sState;
+    static PathName sDiskPath;
+    static Mutex sMutex;
+
+    template <typename T>
+    static void_t unlink(LruList<T>& list, T* entry)
+    {
+        if (entry->prev != OMAF_NULL)
+        {
+            entry->prev->next = entry->next;
+        }
+        else
+        {
+            list.head = entry->next;
+        }
+        if (entry->next != OMAF_NULL)
+        {
+            entry->next->prev = entry->prev;
+        }
+        else
+        {
+            list.tail = entry->prev;
+        }
+        entry->prev = OMAF_NULL;
+        entry->next = OMAF_NULL;
+    }
+
+    template <typename T>
+    static void_t pushFront(LruList<T>& list, T* entry)
+    {
+        entry->prev = OMAF_NULL;
+        entry->next = list.head;
+        if (list.head != OMAF_NULL)
+        {
+            list.head->prev = entry;
+        }
+        else
+        {
+            list.tail = entry;
+        }
+        list.head = entry;
+    }
+
+    template <typename T>
+    static void_t pushBack(LruList<T>& list, T* entry)
+    {
+        entry->next = OMAF_NULL;
+        entry->prev = list.tail;
+        if (list.tail != OMAF_NULL)
+        {
+            list.tail->next = entry;
+        }
+        else
+        {
+            list.head = entry;
+        }
+        list.tail = entry;
+    }
+
+    // 64-bit FNV-1a, continued from the given hash
+    static uint64_t hashString(const char_t* str, uint64_t hash)
+    {
+        while (*str != '\0')
+        {
+            hash ^= (uint8_t) *str++;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    static void_t makeKey(const Url& url, const HttpHeaderList& headers, Key& key)
+    {
+        key.url = url;
+        key.range.clear();
+        for (HttpHeaderPairList::ConstIterator it = headers.begin(); it != headers.end(); ++it)
+        {
+            if ((*it).first == "Range")
+            {
+                key.range.append((*it).second.getData());
+                break;
+            }
+        }
+        key.hash = hashString(key.range.getData(), hashString(key.url.getData(), 14695981039346656037ull));
+    }
+
+    static bool_t keysEqual(const Key& left, const Key& right)
+    {
+        return left.hash == right.hash && left.url == right.url && left.range == right.range;
+    }
+
+    static PathName diskFileName(uint64_t hash, const char_t* extension)
+    {
+        PathName fileName = sDiskPath;
+        fileName.appendFormat("%016llx%s", (unsigned long long) hash, extension);
+        return fileName;
+    }
+
+    static PathName indexFileName()
+    {
+        PathName fileName = sDiskPath;
+        fileName.append(INDEX_FILE_NAME);
+        return fileName;
+    }
+
+    static void_t removeMemoryEntry(MemoryEntry* entry)
+    {
+        sState.memoryIndex->remove(entry->key.hash);
+        unlink(sState.memoryLru, entry);
+        sState.memoryUsed -= entry->size;
+
+        OMAF_FREE(*sState.allocator, entry->data);
+        OMAF_DELETE(*sState.allocator, entry);
+    }
+
+    static void_t insertMemoryEntry(const Key& key, const uint8_t* data, size_t dataSize)
+    {
+        if (dataSize > sState.memoryBudget)
+        {
+            return;
+        }
+
+        MemoryIndex::Iterator it = sState.memoryIndex->find(key.hash);
+        if (it != MemoryIndex::InvalidIterator)
+        {
+            removeMemoryEntry(*it);
+        }
+        while (sState.memoryUsed + dataSize > sState.memoryBudget)
+        {
+            removeMemoryEntry(sState.memoryLru.tail);
+        }
+
+        MemoryEntry* entry = OMAF_NEW(*sState.allocator, MemoryEntry);
+        entry->key = key;
+        entry->data = (uint8_t*) OMAF_ALLOC(*sState.allocator, dataSize);
+        entry->size = dataSize;
+        memcpy(entry->data, data, dataSize);
+
+        pushFront(sState.memoryLru, entry);
+        sState.memoryIndex->insert(key.hash, entry);
+        sState.memoryUsed += dataSize;
+    }
+
+    static void_t removeDiskEntry(DiskEntry* entry, bool_t deleteFile)
+    {
+        if (deleteFile)
+        {
+            DiskManager::Delete(diskFileName(entry->hash, SEGMENT_FILE_EXTENSION));
+        }
+        sState.diskIndex->remove(entry->hash);
+        unlink(sState.diskLru, entry);
+        sState.diskUsed -= entry->size;
+
+        OMAF_DELETE(*sState.allocator, entry);
+    }
+
+    static void_t evictDiskEntries()
+    {
+        while (sState.diskUsed > sState.diskBudget)
+        {
+            removeDiskEntry(sState.diskLru.tail, true);
+        }
+    }
+
+    // Adds an entry or marks an existing one as most recently used
+    static void_t touchDiskEntry(uint64_t hash, uint64_t size)
+    {
+        DiskIndex::Iterator it = sState.diskIndex->find(hash);
+        if (it != DiskIndex::InvalidIterator)
+        {
+            DiskEntry* entry = *it;
+            unlink(sState.diskLru, entry);
+            pushFront(sState.diskLru, entry);
+            sState.diskUsed = sState.diskUsed - entry->size + size;
+            entry->size = size;
+        }
+        else
+        {
+            DiskEntry* entry = OMAF_NEW(*sState.allocator, DiskEntry);
+            entry->hash = hash;
+            entry->size = size;
+            pushFront(sState.diskLru, entry);
+            sState.diskIndex->insert(hash, entry);
+            sState.diskUsed += size;
+        }
+        evictDiskEntries();
+    }
+
+    static void_t loadDiskIndex()
+    {
+        DiskFileStream stream;
+        if (!stream.open(indexFileName(), FileSystem::AccessMode::READ))
+        {
+            return;
+        }
+
+        IndexFileHeader header;
+        if (stream.read(&header, OMAF_SIZE_OF(header)) == OMAF_SIZE_OF(header) && header.magic == INDEX_FILE_MAGIC &&
+            header.version == INDEX_FILE_VERSION)
+        {
+            IndexFileEntry fileEntry;
+            for (uint64_t i = 0; i < header.count; ++i)
+            {
+                if (stream.read(&fileEntry, OMAF_SIZE_OF(fileEntry)) != OMAF_SIZE_OF(fileEntry))
+                {
+                    break;
+                }
+                if (sState.diskIndex->contains(fileEntry.hash))
+                {
+                    continue;
+                }
+
+                DiskEntry* entry = OMAF_NEW(*sState.allocator, DiskEntry);
+                entry->hash = fileEntry.hash;
+                entry->size = fileEntry.size;
+                pushBack(sState.diskLru, entry);
+                sState.diskIndex->insert(entry->hash, entry);
+                sState.diskUsed += entry->size;
+            }
+        }
+        stream.close();
+
+        // The budget may have been lowered since the index was written
+        evictDiskEntries();
+        OMAF_LOG_D("Loaded %zu cached segments (%llu bytes) from %s", sState.diskIndex->getSize(),
+                   (unsigned long long) sState.diskUsed, sDiskPath.getData());
+    }
+
+    static void_t saveDiskIndex()
+    {
+        DiskFileStream stream;
+        if (!stream.open(indexFileName(), FileSystem::AccessMode::WRITE))
+        {
+            OMAF_LOG_W("Cannot write segment cache index to %s", sDiskPath.getData());
+            return;
+        }
+
+        IndexFileHeader header;
+        header.magic = INDEX_FILE_MAGIC;
+        header.version = INDEX_FILE_VERSION;
+        header.count = sState.diskIndex->getSize();
+        stream.write(&header, OMAF_SIZE_OF(header));
+
+        for (DiskEntry* entry = sState.diskLru.head; entry != OMAF_NULL; entry = entry->next)
+        {
+            IndexFileEntry fileEntry;
+            fileEntry.hash = entry->hash;
+            fileEntry.size = entry->size;
+            stream.write(&fileEntry, OMAF_SIZE_OF(fileEntry));
+        }
+        stream.close();
+    }
+
+    // Reads a segment file written by writeSegmentFile. Done without holding the lock: a file is only ever replaced
+    // by a rename, so a reader sees either the old or the new complete file.
+    static bool_t readSegmentFile(const PathName& fileName, const Key& key, DataBuffer<uint8_t>& output)
+    {
+        DiskFileStream stream;
+        if (!stream.open(fileName, FileSystem::AccessMode::READ))
+        {
+            return false;
+        }
+
+        bool_t valid = false;
+        SegmentFileHeader header;
+        if (stream.read(&header, OMAF_SIZE_OF(header)) == OMAF_SIZE_OF(header) && header.magic == SEGMENT_FILE_MAGIC &&
+            header.urlSize == key.url.getSize() && header.rangeSize == key.range.getSize())
+        {
+            char_t keyData[1024 + 64];
+            size_t keySize = header.urlSize + header.rangeSize;
+            int64_t dataSize = stream.getSize() - (int64_t)(OMAF_SIZE_OF(header) + keySize);
+
+            if (stream.read(keyData, keySize) == (int64_t) keySize &&
+                memcmp(keyData, key.url.getData(), header.urlSize) == 0 &&
+                memcmp(keyData + header.urlSize, key.range.getData(), header.rangeSize) == 0 && dataSize > 0)
+            {
+                if (output.getCapacity() < (size_t) dataSize)
+                {
+                    output.reAllocate((size_t) dataSize);
+                }
+                if (stream.read(output.getDataPtr(), dataSize) == dataSize)
+                {
+                    output.setSize((size_t) dataSize);
+                    valid = true;
+                }
+            }
+        }
+        stream.close();
+
+        if (!valid)
+        {
+            output.clear();
+        }
+        return valid;
+    }
+
+    static bool_t writeSegmentFile(const Key& key, const uint8_t* data, size_t dataSize)
+    {
+        PathName tempFileName = diskFileName(key.hash, TEMP_FILE_EXTENSION);
+        DiskFileStream stream;
+        if (!stream.open(tempFileName, FileSystem::AccessMode::WRITE))
+        {
+            return false;
+        }
+
+        SegmentFileHeader header;
+        header.magic = SEGMENT_FILE_MAGIC;
+        header.urlSize = (uint32_t) key.url.getSize();
+        header.rangeSize = (uint32_t) key.range.getSize();
+        header.reserved = 0;
+
+        bool_t written = stream.write(&header, OMAF_SIZE_OF(header)) == OMAF_SIZE_OF(header) &&
+                         stream.write(key.url.getData(), header.urlSize) == header.urlSize &&
+                         stream.write(key.range.getData(), header.rangeSize) == header.rangeSize &&
+                         stream.write(data, dataSize) == (int64_t) dataSize;
+        stream.close();
+
+        PathName fileName = diskFileName(key.hash, SEGMENT_FILE_EXTENSION);
+        if (written)
+        {
+            // Rename does not replace an existing file on every platform
+            DiskManager::Delete(fileName);
+            written = DiskManager::Rename(tempFileName, fileName);
+        }
+        if (!written)
+        {
+            OMAF_LOG_W("Cannot write cached segment to %s", fileName.getData());
+            DiskManager::Delete(tempFileName);
+        }
+        return written;
+    }
+
+    static void_t release()
+    {
+        if (sState.memoryIndex != OMAF_NULL)
+        {
+            OMAF_LOG_D("Segment cache hits: %u from memory, %u from disk, misses: %u", sState.memoryHits,
+                       sState.diskHits, sState.misses);
+
+            while (sState.memoryLru.head != OMAF_NULL)
+            {
+                removeMemoryEntry(sState.memoryLru.head);
+            }
+            OMAF_DELETE(*sState.allocator, sState.memoryIndex);
+        }
+        if (sState.diskIndex != OMAF_NULL)
+        {
+            saveDiskIndex();
+
+            while (sState.diskLru.head != OMAF_NULL)
+            {
+                removeDiskEntry(sState.diskLru.head, false);
+            }
+            OMAF_DELETE(*sState.allocator, sState.diskIndex);
+        }
+
+        MemoryZero(&sState, OMAF_SIZE_OF(sState));
+        sDiskPath.clear();
+    }
+
+    bool_t configure(uint64_t memoryBudgetBytes, const char_t* diskPath, uint64_t diskBudgetBytes)
+    {
+        Mutex::ScopeLock lock(sMutex);
+        release();
+
+        if (memoryBudgetBytes == 0)
+        {
+            return true;
+        }
+
+        sState.allocator = MemorySystem::DefaultHeapAllocator();
+        sState.memoryIndex = OMAF_NEW(*sState.allocator, MemoryIndex)(*sState.allocator, INDEX_BUCKET_COUNT);
+        sState.memoryBudget = memoryBudgetBytes;
+
+        if (diskPath != OMAF_NULL && diskPath[0] != '\0' && diskBudgetBytes > 0)
+        {
+            if (DiskManager::DirExists(diskPath))
+            {
+                sDiskPath.append(diskPath);
+                if (diskPath[strlen(diskPath) - 1] != '/')
+                {
+                    sDiskPath.append("/");
+                }
+                sState.diskIndex = OMAF_NEW(*sState.allocator, DiskIndex)(*sState.allocator, INDEX_BUCKET_COUNT);
+                sState.diskBudget = diskBudgetBytes;
+                loadDiskIndex();
+            }
+            else
+            {
+                OMAF_LOG_W("Segment cache directory %s does not exist, using the memory cache only", diskPath);
+                return false;
+            }
+        }
+
+        OMAF_LOG_D("Segment cache enabled, memory budget %llu bytes, disk budget %llu bytes",
+                   (unsigned long long) sState.memoryBudget, (unsigned long long) sState.diskBudget);
+        return true;
+    }
+
+    void_t shutdown()
+    {
+        Mutex::ScopeLock lock(sMutex);
+        release();
+    }
+
+    bool_t isEnabled()
+    {
+        Mutex::ScopeLock lock(sMutex);
+        return sState.memoryIndex != OMAF_NULL;
+    }
+
+    bool_t lookup(const Url& url, const HttpHeaderList& headers, DataBuffer<uint8_t>& output)
+    {
+        Key key;
+        PathName fileName;
+        {
+            Mutex::ScopeLock lock(sMutex);
+            if (sState.memoryIndex == OMAF_NULL)
+            {
+                return false;
+            }
+
+            makeKey(url, headers, key);
+            MemoryIndex::Iterator it = sState.memoryIndex->find(key.hash);
+            if (it != MemoryIndex::InvalidIterator && keysEqual((*it)->key, key))
+            {
+                MemoryEntry* entry = *it;
+                unlink(sState.memoryLru, entry);
+                pushFront(sState.memoryLru, entry);
+
+                if (output.getCapacity() < entry->size)
+                {
+                    output.reAllocate(entry->size);
+                }
+                output.setData(entry->data, entry->size);
+                sState.memoryHits++;
+                return true;
+            }
+            if (sState.diskIndex == OMAF_NULL)
+            {
+                sState.misses++;
+                return false;
+            }
+            // Files not in the index, e.g. left behind by a session that did not shut down cleanly, are still used
+            fileName = diskFileName(key.hash, SEGMENT_FILE_EXTENSION);
+        }
+
+        bool_t found = readSegmentFile(fileName, key, output);
+
+        Mutex::ScopeLock lock(sMutex);
+        if (sState.diskIndex == OMAF_NULL)
+        {
+            // Reconfigured while reading
+            return found;
+        }
+        if (!found)
+        {
+            sState.misses++;
+            return false;
+        }
+        sState.diskHits++;
+        touchDiskEntry(key.hash, output.getSize());
+        insertMemoryEntry(key, output.getDataPtr(), output.getSize());
+        return true;
+    }
+
+    void_t store(const Url& url, const HttpHeaderList& headers, const uint8_t* data, size_t dataSize)
+    {
+        Key key;
+        bool_t writeToDisk = false;
+        {
+            Mutex::ScopeLock lock(sMutex);
+            if (sState.memoryIndex == OMAF_NULL || dataSize == 0)
+            {
+                return;
+            }
+
+            makeKey(url, headers, key);
+            insertMemoryEntry(key, data, dataSize);
+            writeToDisk = sState.diskIndex != OMAF_NULL && dataSize <= sState.diskBudget &&
+                          !sState.diskIndex->contains(key.hash);
+        }
+
+        if (writeToDisk && writeSegmentFile(key, data, dataSize))
+        {
+            Mutex::ScopeLock lock(sMutex);
+            if (sState.diskIndex != OMAF_NULL)
+            {
+                touchDiskEntry(key.hash, dataSize);
+            }
+        }
+    }
+}  // namespace DashSegmentCache
+
+OMAF_NS_END
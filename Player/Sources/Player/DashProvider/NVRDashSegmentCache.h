@@ -0,0 +1,45 @@
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "NVREssentials.h"
+
+#include "Foundation/NVRDataBuffer.h"
+#include "Foundation/NVRHttpConnection.h"
+#include "Foundation/NVRHttpHeaderList.h"
+
+OMAF_NS_BEGIN
+
+// Process wide cache of downloaded DASH segments, keyed by URL and byte range. Recently used segments are kept in
+// memory within a byte budget, and optionally written to a directory on disk with a budget of its own, so that seeking
+// back, looping and switching back to an earlier quality do not download the same bytes again.
+// The cache is disabled until configured with a non-zero memory budget.
+namespace DashSegmentCache
+{
+    // diskPath may be OMAF_NULL or empty to use the memory tier only. Reconfiguring drops the memory tier.
+    // Returns false if the disk directory does not exist, in which case only the memory tier is used.
+    bool_t configure(uint64_t memoryBudgetBytes, const char_t* diskPath, uint64_t diskBudgetBytes);
+
+    // Persists the disk index and releases all memory held by the cache
+    void_t shutdown();
+
+    bool_t isEnabled();
+
+    // Copies a cached response to output. Returns false if the segment is not cached.
+    bool_t lookup(const Url& url, const HttpHeaderList& headers, DataBuffer<uint8_t>& output);
+
+    void_t store(const Url& url, const HttpHeaderList& headers, const uint8_t* data, size_t dataSize);
+}  // namespace DashSegmentCache
+
+OMAF_NS_END
@@ -15,8 +15,8 @@
 #include "DashProvider/NVRDashSegmentStream.h"
 
 #include "DashProvider/NVRDashLog.h"
-#include "Foundation/NVRHttp.h"
 #include "Foundation/NVRTime.h"
+#include "Provider/NVRLatencyStatistics.h"
 
 OMAF_NS_BEGIN
 OMAF_LOG_ZONE(DashSegmentStream)
@@ -88,9 +88,9 @@ DashSegmentStream::DashSegmentStream(uint32_t bandwidth,
     OMAF_ASSERT(observer != OMAF_NULL, "");
 
     mBaseUrls = DashUtils::ResolveBaseUrl(mDashComponents);
-    mSegmentConnection = Http::createHttpConnection(mMemoryAllocator);
+    mSegmentConnection = OMAF_NEW(mMemoryAllocator, DashCachingHttpConnection)(mMemoryAllocator);
     mSegmentConnection->setHttpDataProcessor(this);
-    mSegmentIndexConnection = Http::createHttpConnection(mMemoryAllocator);
+    mSegmentIndexConnection = OMAF_NEW(mMemoryAllocator, DashCachingHttpConnection)(mMemoryAllocator);
 }
 
 DashSegmentStream::~DashSegmentStream()
@@ -654,14 +654,21 @@ void_t DashSegmentStream::processDownloadingMediaSegment(bool_t aLateReception)
         mDownloadRetryCounter = 0;
         mDownloadByteRange = {0, 0};
         size_t bytesDownloaded = state.bytesDownloaded;
-        int64_t downloadTimeMs = (Time::getClockTimeUs() - mSegmentDownloadStartTime) / 1000;
+        int64_t downloadTimeUs = Time::getClockTimeUs() - mSegmentDownloadStartTime;
+        int64_t downloadTimeMs = downloadTimeUs / 1000;
         mTotalBytesDownloaded += bytesDownloaded;
 
         mState = DashSegmentStreamState::IDLE;
-        if (aLateReception)
+        if (aLateReception || mSegmentConnection->isServedFromCache())
         {
+            // a zero download time keeps the segment out of the download speed estimate; a cached segment arrives
+            // without any network transfer, so its time says nothing about the bandwidth
             downloadTimeMs = 0;
         }
+        else
+        {
+            LatencyStatistics::record(LatencyCategory::SEGMENT_DOWNLOAD, (uint64_t) downloadTimeUs);
+        }
         handleDownloadedSegment(downloadTimeMs, bytesDownloaded);
 
         // DASH_LOG_D("\t%d\tfinished downloading repr\t%s\tsegment\t%d\t\t%zd\tbytes, download time ms\t%d",
@@ -20,6 +20,7 @@
 
 #include "NVRErrorCodes.h"
 
+#include "DashProvider/NVRDashCachingHttpConnection.h"
 #include "DashProvider/NVRDashMediaSegment.h"
 #include "DashProvider/NVRDashUtils.h"
 #include "Foundation/NVRFixedQueue.h"
@@ -195,7 +196,7 @@ protected:
     uint32_t mRetryIndex;
     DashSegmentStreamState::Enum mState;
 
-    HttpConnection* mSegmentConnection;
+    DashCachingHttpConnection* mSegmentConnection;
     struct ByteRange
     {
         uint64_t startByte;
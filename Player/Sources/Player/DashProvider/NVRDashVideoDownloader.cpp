@@ -85,6 +85,7 @@ DashVideoDownloader::DashVideoDownloader()
     , mStreamUpdateNeeded(false)
     , mReselectSources(false)
     , mABREnabled(true)
+    , mAbrPolicyType(AbrPolicyType::LEGACY)
     , mBandwidthOverhead(0)
     , mBaseLayerDecoderPixelsinSec(0)
     , mTileSetupDone(false)
@@ -109,6 +110,15 @@ void_t DashVideoDownloader::disableABR()
     mABREnabled = false;
 }
 
+void_t DashVideoDownloader::setAbrPolicy(AbrPolicyType::Enum aType)
+{
+    mAbrPolicyType = aType;
+    if (mBitrateController != OMAF_NULL)
+    {
+        mBitrateController->setAbrPolicy(aType);
+    }
+}
+
 void_t DashVideoDownloader::setBandwidthOverhead(uint32_t aBandwithOverhead)
 {
     mBandwidthOverhead = aBandwithOverhead;
@@ -324,6 +334,7 @@ Error::Enum DashVideoDownloader::completeInitialization(DashComponents& aDashCom
     }
     mBitrateController = OMAF_NEW_HEAP(DashBitrateContoller);
     mBitrateController->initialize(this);
+    mBitrateController->setAbrPolicy(mAbrPolicyType);
 
     return Error::OK;
 }
@@ -982,6 +993,25 @@ void_t DashVideoDownloader::increaseCache()
     mVideoBaseAdaptationSet->setBufferingTime(mBufferingTimeMs);
 }
 
+bool_t DashVideoDownloader::getBufferLevel(uint32_t& aBufferLevelMs, uint32_t& aSegmentDurationMs)
+{
+    uint64_t segmentDurationMs = 0;
+    uint32_t alignmentId = 0;
+    mVideoBaseAdaptationSet->getAlignmentId(segmentDurationMs, alignmentId);
+    if (segmentDurationMs == 0)
+    {
+        return false;
+    }
+    aSegmentDurationMs = (uint32_t) segmentDurationMs;
+    aBufferLevelMs = mVideoBaseAdaptationSet->getCachedSegmentCount() * aSegmentDurationMs;
+    return true;
+}
+
+uint32_t DashVideoDownloader::getBufferingTimeMs() const
+{
+    return mBufferingTimeMs;
+}
+
 bool_t DashVideoDownloader::checkAssociation(DashAdaptationSet* aAdaptationSet, const RepresentationId& aAssociatedTo)
 {
     for (size_t j = 0; j < mAdaptationSets.getSize(); j++)
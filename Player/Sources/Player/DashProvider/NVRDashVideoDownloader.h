@@ -14,6 +14,7 @@
  */
 #pragma once
 
+#include "DashProvider/NVRDashAbrPolicy.h"
 #include "DashProvider/NVRDashAdaptationSet.h"
 #include "DashProvider/NVRDashAdaptationSetExtractorMR.h"
 #include "Foundation/NVRAtomicBoolean.h"
@@ -87,6 +88,7 @@ public:
 
     void_t enableABR();
     void_t disableABR();
+    void_t setAbrPolicy(AbrPolicyType::Enum aType);
     void_t setBandwidthOverhead(uint32_t aBandwidthOverhead);
 
 
@@ -159,6 +161,9 @@ public:
     virtual void_t selectBitrate(uint32_t bitrate);
     virtual bool_t isABRSwitchOngoing();
     virtual void_t increaseCache();
+    // downloaded but not yet played video and the segment duration; false if not known
+    virtual bool_t getBufferLevel(uint32_t& aBufferLevelMs, uint32_t& aSegmentDurationMs);
+    virtual uint32_t getBufferingTimeMs() const;
 
     virtual bool_t checkAssociation(DashAdaptationSet* aAdaptationSet, const RepresentationId& aAssociatedTo);
     virtual const char_t* findDashAssociationForStream(streamid_t aStreamId, const char_t* aAssociationType) const;
@@ -215,6 +220,7 @@ protected:
     bool_t mRunning;
     uint32_t mBandwidthOverhead;
     bool_t mABREnabled;
+    AbrPolicyType::Enum mAbrPolicyType;
 
 private:
     DashStreamType::Enum mStreamType;
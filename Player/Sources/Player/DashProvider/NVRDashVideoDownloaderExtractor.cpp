@@ -38,6 +38,9 @@
 OMAF_NS_BEGIN
 OMAF_LOG_ZONE(DashVideoDownloaderExtractor)
 
+// the viewport is predicted this many segment durations ahead, as a tile switch takes effect from the next segment
+static const float32_t PREDICTION_HORIZON_SEGMENTS = 1.5f;
+
 DashVideoDownloaderExtractor::DashVideoDownloaderExtractor()
     : DashVideoDownloader()
     , mVideoPartialTiles()
@@ -327,6 +330,7 @@ Error::Enum DashVideoDownloaderExtractor::completeInitialization(DashComponents&
     estimateBitrates(nrQualityLevels);
 
     mBitrateController->initialize(this);
+    mBitrateController->setAbrPolicy(mAbrPolicyType);
 
     // Video stream id plays a special role with extractors, it must be shared between the representations.
     // Typically RWMQ extractors have only one representation, but as creating shared ID should not cause any harm
@@ -552,6 +556,8 @@ void_t DashVideoDownloaderExtractor::checkVASVideoStreams(uint64_t currentPTS)
             if (mBitrateController->getQualityLevelMargin(viewportTiles.getSize(), nrMarginTiles, level))
             {
                 VASTileSelection marginTiles = mTilePicker->getLatestMargins(nrMarginTiles, toBackground);
+                mBitrateController->setTileSplit(viewportTiles.getSize() + marginTiles.getSize(),
+                                                 mVideoPartialTiles.getNrAdaptationSets());
 
                 for (VASTileSelection::Iterator it = marginTiles.begin(); it != marginTiles.end(); ++it)
                 {
@@ -559,6 +565,9 @@ void_t DashVideoDownloaderExtractor::checkVASVideoStreams(uint64_t currentPTS)
                         ->selectQuality(level, nrLevels, nextProcessedSegment, TileRole::FOREGROUND_MARGIN);
                 }
             }
+            // then prefetch the tiles predicted to enter the viewport, updating also toBackground
+            selectPrefetchTiles(viewportTiles, nextProcessedSegment, true, toBackground);
+
             // and finally drop tiles to background quality
             if (mBitrateController->getQualityLevelBackground(level, nrLevels))
             {
@@ -574,6 +583,25 @@ void_t DashVideoDownloaderExtractor::checkVASVideoStreams(uint64_t currentPTS)
             mStreamUpdateNeeded = updateVideoStreams();
             mStreamChangeMonitor.update();  // trigger also renderer thread to update streams
         }
+        else
+        {
+            // viewport tiles are unchanged, but the predicted viewport may have moved
+            uint32_t nextProcessedSegment =
+                ((DashAdaptationSetExtractor*) mVideoBaseAdaptationSet)->getNextProcessedSegmentId();
+            if (selectPrefetchTiles(viewportTiles, nextProcessedSegment, false, toBackground))
+            {
+                uint8_t nrLevels = 0;
+                uint8_t level = 0;
+                if (mBitrateController->getQualityLevelBackground(level, nrLevels))
+                {
+                    for (VASTileSelection::Iterator it = toBackground.begin(); it != toBackground.end(); ++it)
+                    {
+                        ((DashAdaptationSetTile*) (*it)->getAdaptationSet())
+                            ->selectQuality(level, nrLevels, nextProcessedSegment, TileRole::BACKGROUND);
+                    }
+                }
+            }
+        }
 
         return;
     }
@@ -583,6 +611,11 @@ void_t DashVideoDownloaderExtractor::initializeTiles()
 {
     if (!mVideoPartialTiles.isEmpty())
     {
+        uint64_t segmentDurationMs = 0;
+        uint32_t alignmentId = 0;
+        mVideoBaseAdaptationSet->getAlignmentId(segmentDurationMs, alignmentId);
+        mTilePicker->setPredictionHorizon((uint32_t)(segmentDurationMs * PREDICTION_HORIZON_SEGMENTS));
+
         bool_t selectionUpdated = false;
         VASTileSelection toViewport;
         VASTileSelection toBackground;
@@ -613,6 +646,8 @@ void_t DashVideoDownloaderExtractor::initializeTiles()
             if (mBitrateController->getQualityLevelMargin(viewportTiles.getSize(), nrMarginTiles, level))
             {
                 VASTileSelection marginTiles = mTilePicker->getLatestMargins(nrMarginTiles, toBackground);
+                mBitrateController->setTileSplit(viewportTiles.getSize() + marginTiles.getSize(),
+                                                 mVideoPartialTiles.getNrAdaptationSets());
 
                 for (VASTileSelection::Iterator it = marginTiles.begin(); it != marginTiles.end(); ++it)
                 {
@@ -620,6 +655,9 @@ void_t DashVideoDownloaderExtractor::initializeTiles()
                         ->selectQuality(level, nrLevels, nextProcessedSegment, TileRole::FOREGROUND_MARGIN);
                 }
             }
+            // then prefetch the tiles predicted to enter the viewport, updating also toBackground
+            selectPrefetchTiles(viewportTiles, nextProcessedSegment, true, toBackground);
+
             // and finally drop tiles to background quality
             if (mBitrateController->getQualityLevelBackground(level, nrLevels))
             {
@@ -633,6 +671,77 @@ void_t DashVideoDownloaderExtractor::initializeTiles()
         return;
     }
 }
+// Upgrades the tiles predicted to enter the viewport from background to margin quality, so that a head turn finds them
+// already in better than background quality. Returns true if the prefetch set or aToBackground changed.
+bool_t DashVideoDownloaderExtractor::selectPrefetchTiles(const VASTileSelection& aViewportTiles,
+                                                         uint32_t aNextProcessedSegment,
+                                                         bool_t aForce,
+                                                         VASTileSelection& aToBackground)
+{
+    uint8_t level = 0;
+    uint8_t nrLevels = 0;
+    float32_t bandwidthShare = 0.f;
+    size_t maxTiles = 0;
+    if (mBitrateController->getQualityLevelPrefetch(level, nrLevels, bandwidthShare))
+    {
+        maxTiles = estimatePrefetchTileCount(aViewportTiles, level, nrLevels, bandwidthShare);
+    }
+    // with 0 tiles the picker releases the earlier prefetched tiles to aToBackground
+    bool_t updated = false;
+    VASTileSelection prefetchTiles = mTilePicker->getLatestPrefetch(maxTiles, aForce, updated, aToBackground);
+    if (!updated)
+    {
+        return false;
+    }
+    for (VASTileSelection::Iterator it = prefetchTiles.begin(); it != prefetchTiles.end(); ++it)
+    {
+        ((DashAdaptationSetTile*) (*it)->getAdaptationSet())
+            ->selectQuality(level, nrLevels, aNextProcessedSegment, TileRole::FOREGROUND_MARGIN);
+    }
+    return true;
+}
+
+// Number of tiles whose upgrade from background to prefetch quality fits in the given share of the viewport bandwidth.
+// Tiles are assumed to have equal bitrates, like in the bitrate controller.
+size_t DashVideoDownloaderExtractor::estimatePrefetchTileCount(const VASTileSelection& aViewportTiles,
+                                                               uint8_t aLevel,
+                                                               uint8_t aNrLevels,
+                                                               float32_t aBandwidthShare) const
+{
+    if (aViewportTiles.isEmpty())
+    {
+        return 0;
+    }
+    uint32_t viewportBandwidth = 0;
+    for (VASTileSelection::ConstIterator it = aViewportTiles.begin(); it != aViewportTiles.end(); ++it)
+    {
+        viewportBandwidth += (*it)->getAdaptationSet()->getCurrentBandwidth();
+    }
+
+    DashAdaptationSetTile* tile = (DashAdaptationSetTile*) aViewportTiles.at(0)->getAdaptationSet();
+    DashRepresentation* prefetchRepresentation = tile->getRepresentationForQuality(aLevel, aNrLevels);
+    if (prefetchRepresentation == OMAF_NULL)
+    {
+        return 0;
+    }
+    uint32_t extraBitrate = prefetchRepresentation->getBitrate();
+    uint8_t backgroundLevel = 0;
+    uint8_t nrLevels = 0;
+    if (mBitrateController->getQualityLevelBackground(backgroundLevel, nrLevels))
+    {
+        DashRepresentation* backgroundRepresentation = tile->getRepresentationForQuality(backgroundLevel, nrLevels);
+        if (backgroundRepresentation != OMAF_NULL && backgroundRepresentation->getBitrate() < extraBitrate)
+        {
+            extraBitrate -= backgroundRepresentation->getBitrate();
+        }
+    }
+    if (extraBitrate == 0)
+    {
+        return 0;
+    }
+    return (size_t)(aBandwidthShare * viewportBandwidth / extraBitrate);
+}
+
 #ifdef OMAF_ABR_LOGGING
 void_t DashVideoDownloaderExtractor::printViewportTiles(VASTileSelection& viewport) const
 {
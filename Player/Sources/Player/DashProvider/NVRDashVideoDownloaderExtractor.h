@@ -65,6 +65,14 @@ protected:
 
     virtual void_t checkVASVideoStreams(uint64_t currentPTS);
     void_t initializeTiles();
+    bool_t selectPrefetchTiles(const VASTileSelection& aViewportTiles,
+                               uint32_t aNextProcessedSegment,
+                               bool_t aForce,
+                               VASTileSelection& aToBackground);
+    size_t estimatePrefetchTileCount(const VASTileSelection& aViewportTiles,
+                                     uint8_t aLevel,
+                                     uint8_t aNrLevels,
+                                     float32_t aBandwidthShare) const;
 
 protected:
     VASTilesLayer mVideoPartialTiles;
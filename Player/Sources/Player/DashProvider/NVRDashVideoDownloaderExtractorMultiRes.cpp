@@ -310,6 +310,7 @@ Error::Enum DashVideoDownloaderExtractorMultiRes::completeInitialization(DashCom
     ((DashAdaptationSetExtractorMR*) mVideoBaseAdaptationSet)->calculateBitrates(nrQualityLevels);
 
     mBitrateController->initialize(this);
+    mBitrateController->setAbrPolicy(mAbrPolicyType);
 
     // Video stream id plays a special role with extractors: in multi-res all extractors must share it within a
     // viewpoint. But it must change between viewpoints.
@@ -16,6 +16,7 @@
 
 #include "Foundation/NVRLogger.h"
 #include "Foundation/NVRMemoryAllocator.h"
+#include "Math/OMAFMathFunctions.h"
 #include "Media/NVRMP4Parser.h"
 #include "Media/NVRMediaFormat.h"
 #include "Media/NVRMediaPacket.h"
@@ -25,6 +26,25 @@
 OMAF_NS_BEGIN
 OMAF_LOG_ZONE(MP4MediaStream)
 
+namespace
+{
+    // Grow geometrically, so that appending one segment at a time costs amortized constant time per sample
+    template <typename T>
+    void_t appendWithGrowth(Array<T>& aArray, const T* aItems, size_t aCount)
+    {
+        if (aCount == 0)
+        {
+            return;
+        }
+        size_t required = aArray.getSize() + aCount;
+        if (required > aArray.getCapacity())
+        {
+            aArray.reserve(max(required, aArray.getCapacity() * 2));
+        }
+        aArray.add(aItems, aCount);
+    }
+}
+
 MP4MediaStream::MP4MediaStream(MediaFormat* format)
     : mAllocator(*MemorySystem::DefaultHeapAllocator())
     , mFormat(format)
@@ -34,7 +54,8 @@ MP4MediaStream::MP4MediaStream(MediaFormat* format)
     , mSampleIndex()
     , mTrack(OMAF_NULL)
     , mTrackId(OMAF_UINT32_MAX)
-    , mSampleTsPairs()
+    , mSamples(*MemorySystem::DefaultHeapAllocator())
+    , mSampleTsPairs(*MemorySystem::DefaultHeapAllocator())
     , mEmptyPackets()
     , mFilledPackets()
     , mMetadataStreams()
@@ -252,11 +273,11 @@ MediaFormat* MP4MediaStream::getFormat() const
 
 uint32_t MP4MediaStream::getConfigId() const
 {
-    if (mTrack == OMAF_NULL || mSampleIndex.mGlobalSampleIndex > mTrack->sampleProperties.size)
+    if (mTrack == OMAF_NULL || mSampleIndex.mGlobalSampleIndex > mSamples.getSize())
     {
         return 0;
     }
-    return mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].sampleDescriptionIndex;
+    return mSamples[mSampleIndex.mGlobalSampleIndex].sampleDescriptionIndex;
 }
 
 int32_t MP4MediaStream::getCount() const
@@ -274,20 +295,90 @@ void_t MP4MediaStream::setTrack(MP4VR::TrackInformation* track)
     }
 
     mTrackId = track->trackId;
+    mTrack = track;
+
+    mSamples.clear();
+    appendWithGrowth(mSamples, track->sampleProperties.begin(), track->sampleProperties.numElements);
+    syncSampleIndex();
+}
 
-    // sync the global index
-    if (track->sampleProperties.size > 0)
+void_t MP4MediaStream::setTimestamps(MP4VR::MP4VRFileReaderInterface* reader)
+{
+    MP4VR::DynArray<MP4VR::TimestampIDPair> timestamps;
+    if (reader->getTrackTimestamps(mTrackId, timestamps) == MP4VR::MP4VRFileReaderInterface::OK)
     {
-        if (track->sampleProperties[0].segmentId > mSampleIndex.mGlobalStartSegment)
+        mSampleTsPairs.clear();
+        appendWithGrowth(mSampleTsPairs, timestamps.begin(), timestamps.numElements);
+    }
+}
+
+void_t MP4MediaStream::addSegmentSamples(const MP4VR::DynArray<MP4VR::SampleInformation>& samples,
+                                         const MP4VR::DynArray<MP4VR::TimestampIDPair>& timestamps)
+{
+    appendWithGrowth(mSamples, samples.begin(), samples.numElements);
+    appendWithGrowth(mSampleTsPairs, timestamps.begin(), timestamps.numElements);
+    syncSampleIndex();
+}
+
+void_t MP4MediaStream::removeSegmentSamples(uint32_t segmentId)
+{
+    // segments are added in order, so the samples of a segment are always consecutive
+    size_t first = 0;
+    while (first < mSamples.getSize() && mSamples[first].segmentId != segmentId)
+    {
+        first++;
+    }
+    size_t count = 0;
+    uint32_t minSampleId = OMAF_UINT32_MAX;
+    uint32_t maxSampleId = 0;
+    while (first + count < mSamples.getSize() && mSamples[first + count].segmentId == segmentId)
+    {
+        minSampleId = min(minSampleId, mSamples[first + count].sampleId);
+        maxSampleId = max(maxSampleId, mSamples[first + count].sampleId);
+        count++;
+    }
+    if (count == 0)
+    {
+        return;
+    }
+    mSamples.removeAt(first, count);
+
+    // the timestamps of the segment are consecutive as well, but not in the same order as the samples
+    size_t firstTs = 0;
+    while (firstTs < mSampleTsPairs.getSize() &&
+           (mSampleTsPairs[firstTs].itemId < minSampleId || mSampleTsPairs[firstTs].itemId > maxSampleId))
+    {
+        firstTs++;
+    }
+    size_t countTs = 0;
+    while (firstTs + countTs < mSampleTsPairs.getSize() && mSampleTsPairs[firstTs + countTs].itemId >= minSampleId &&
+           mSampleTsPairs[firstTs + countTs].itemId <= maxSampleId)
+    {
+        countTs++;
+    }
+    if (countTs > 0)
+    {
+        mSampleTsPairs.removeAt(firstTs, countTs);
+    }
+
+    syncSampleIndex();
+}
+
+// sync the global index after samples have been added to or removed from the beginning of mSamples
+void_t MP4MediaStream::syncSampleIndex()
+{
+    if (mSamples.getSize() > 0)
+    {
+        if (mSamples[0].segmentId > mSampleIndex.mGlobalStartSegment)
         {
             // The very first segment is now added, or the old first segment in index struct (mGlobalStartSegment) is no
             // longer the first one
-            if (mSampleIndex.mCurrentSegment < track->sampleProperties[0].segmentId)
+            if (mSampleIndex.mCurrentSegment < mSamples[0].segmentId)
             {
                 // The very first segment is now added, or we were reading from a segment that became invalid
                 mSampleIndex.mGlobalSampleIndex = 0;
                 mSampleIndex.mSegmentSampleIndex = 0;
-                mSampleIndex.mCurrentSegment = track->sampleProperties[0].segmentId;
+                mSampleIndex.mCurrentSegment = mSamples[0].segmentId;
                 mNextRefFrame = 0;
                 OMAF_LOG_V("setTrack reset indices for %d", getStreamId());  // track->trackId);
             }
@@ -297,13 +388,12 @@ void_t MP4MediaStream::setTrack(MP4VR::TrackInformation* track)
                 // above)
                 // segment current-N was removed, count how many samples there still are before the current segment
                 // if N == 1 (1 or more segments removed, mCurrentSegment becomes the first one):
-                //         the while loop is skipped since track->sampleProperties[index].segmentId ==
-                //         mSampleIndex.mCurrentSegment;
+                //         the while loop is skipped since mSamples[index].segmentId == mSampleIndex.mCurrentSegment;
                 //         just use the index inside the current segment as the global index
                 // if N > 1 (1 or more segments removed, but some segments are still valid before the mCurrentSegment):
                 // the while loop becomes active
                 int32_t samplesInPrevSegments = 0;
-                while (track->sampleProperties[samplesInPrevSegments].segmentId < mSampleIndex.mCurrentSegment)
+                while (mSamples[samplesInPrevSegments].segmentId < mSampleIndex.mCurrentSegment)
                 {
                     samplesInPrevSegments++;
                 }
@@ -313,11 +403,11 @@ void_t MP4MediaStream::setTrack(MP4VR::TrackInformation* track)
                 // getStreamId());//track->trackId);
             }
 
-            mSampleIndex.mGlobalStartSegment = track->sampleProperties[0].segmentId;
+            mSampleIndex.mGlobalStartSegment = mSamples[0].segmentId;
         }
         else
         {
-            // OMAF_LOG_V("setTrack %d segmentIds %d %d", getStreamId(),track->sampleProperties[0].segmentId,
+            // OMAF_LOG_V("setTrack %d segmentIds %d %d", getStreamId(),mSamples[0].segmentId,
             // mSampleIndex.mGlobalStartSegment);
         }
     }
@@ -331,28 +421,22 @@ void_t MP4MediaStream::setTrack(MP4VR::TrackInformation* track)
         mNextRefFrame = 0;
         OMAF_LOG_D("setTrack set track without samples! %d", getStreamId());  // track->trackId);
     }
-    mTrack = track;
-}
-
-void_t MP4MediaStream::setTimestamps(MP4VR::MP4VRFileReaderInterface* reader)
-{
-    uint32_t result = reader->getTrackTimestamps(mTrackId, mSampleTsPairs);
 }
 
 // peek next sample without changing index
 Error::Enum MP4MediaStream::peekNextSample(uint32_t& sample) const
 {
-    if (mSampleIndex.mGlobalSampleIndex >= mTrack->sampleProperties.size)
+    if (mSampleIndex.mGlobalSampleIndex >= mSamples.getSize())
     {
         return Error::END_OF_FILE;
     }
-    sample = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].sampleId;
+    sample = mSamples[mSampleIndex.mGlobalSampleIndex].sampleId;
     return Error::OK;
 }
 
 Error::Enum MP4MediaStream::peekNextSampleTs(MP4VR::TimestampIDPair& sample) const
 {
-    if (mSampleIndex.mGlobalSampleIndex >= mSampleTsPairs.size)
+    if (mSampleIndex.mGlobalSampleIndex >= mSampleTsPairs.getSize())
     {
         return Error::END_OF_FILE;
     }
@@ -363,11 +447,11 @@ Error::Enum MP4MediaStream::peekNextSampleTs(MP4VR::TimestampIDPair& sample) con
 // get sample properties
 Error::Enum MP4MediaStream::peekNextSampleInfo(MP4VR::SampleInformation& sampleInfo) const
 {
-    if (mSampleIndex.mGlobalSampleIndex >= mTrack->sampleProperties.size)
+    if (mSampleIndex.mGlobalSampleIndex >= mSamples.getSize())
     {
         return Error::END_OF_FILE;
     }
-    sampleInfo = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex];
+    sampleInfo = mSamples[mSampleIndex.mGlobalSampleIndex];
     return Error::OK;
 }
 
@@ -378,29 +462,29 @@ Error::Enum MP4MediaStream::getNextSample(uint32_t& sample,
                                           uint32_t& configId,
                                           bool_t& segmentChanged)
 {
-    if (mSampleIndex.mGlobalSampleIndex >= mTrack->sampleProperties.size)
+    if (mSampleIndex.mGlobalSampleIndex >= mSamples.getSize())
     {
         return Error::END_OF_FILE;
     }
 
     if (mFormat->getDecoderConfigInfoId() != 0 &&
-        mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].sampleDescriptionIndex !=
+        mSamples[mSampleIndex.mGlobalSampleIndex].sampleDescriptionIndex !=
             mFormat->getDecoderConfigInfoId())
     {
         OMAF_LOG_D("Decoder configuration changed!");
         configChanged = true;
-        configId = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].sampleDescriptionIndex;
+        configId = mSamples[mSampleIndex.mGlobalSampleIndex].sampleDescriptionIndex;
     }
     else
     {
         configChanged = false;
     }
 
-    if (mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].segmentId != mSampleIndex.mCurrentSegment)
+    if (mSamples[mSampleIndex.mGlobalSampleIndex].segmentId != mSampleIndex.mCurrentSegment)
     {
         OMAF_LOG_V("getNextSample: Move to next segment %d",
-                   mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].segmentId);
-        mSampleIndex.mCurrentSegment = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].segmentId;
+                   mSamples[mSampleIndex.mGlobalSampleIndex].segmentId);
+        mSampleIndex.mCurrentSegment = mSamples[mSampleIndex.mGlobalSampleIndex].segmentId;
         mSampleIndex.mSegmentSampleIndex = 1;
         segmentChanged = true;
     }
@@ -410,8 +494,8 @@ Error::Enum MP4MediaStream::getNextSample(uint32_t& sample,
         segmentChanged = false;
     }
 
-    sample = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].sampleId;
-    sampleTimeMs = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].earliestTimestamp;
+    sample = mSamples[mSampleIndex.mGlobalSampleIndex].sampleId;
+    sampleTimeMs = mSamples[mSampleIndex.mGlobalSampleIndex].earliestTimestamp;
 
 	// DEBUG: Check that earliest timestamp matches
 	// for (auto& pair : mSampleTsPairs)
@@ -432,13 +516,13 @@ Error::Enum MP4MediaStream::getNextSample(uint32_t& sample,
 // timestamp-table is an alternative to sample time; used with timed metadata, not with normal streams
 Error::Enum MP4MediaStream::getNextSampleTs(MP4VR::TimestampIDPair& sample)
 {
-    if (mSampleIndex.mGlobalSampleIndex >= mSampleTsPairs.size)
+    if (mSampleIndex.mGlobalSampleIndex >= mSampleTsPairs.getSize())
     {
         return Error::END_OF_FILE;
     }
-    if (mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].segmentId != mSampleIndex.mCurrentSegment)
+    if (mSamples[mSampleIndex.mGlobalSampleIndex].segmentId != mSampleIndex.mCurrentSegment)
     {
-        mSampleIndex.mCurrentSegment = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].segmentId;
+        mSampleIndex.mCurrentSegment = mSamples[mSampleIndex.mGlobalSampleIndex].segmentId;
         mSampleIndex.mSegmentSampleIndex = 1;
     }
     else
@@ -457,16 +541,17 @@ Error::Enum MP4MediaStream::getNextSampleTs(MP4VR::TimestampIDPair& sample)
 bool_t MP4MediaStream::findSampleIdByTime(uint64_t timeMs, uint64_t& finalTimeMs, uint32_t& sampleId)
 {
     auto timeScaleMsPerTS = 1000.0 / mTrack->timeScale;
-    if (mTrack->sampleProperties[0].earliestTimestampTS * timeScaleMsPerTS > timeMs)
+    if (mSamples[0].earliestTimestampTS * timeScaleMsPerTS > timeMs)
     {
         // even the first sample has a higher timestamps than the required time, use it anyway
-        sampleId = mTrack->sampleProperties[0].sampleId;
-        finalTimeMs = mTrack->sampleProperties[0].earliestTimestampTS * timeScaleMsPerTS;
+        sampleId = mSamples[0].sampleId;
+        finalTimeMs = mSamples[0].earliestTimestampTS * timeScaleMsPerTS;
         return true;
     }
 
-    for (auto& sampleProp : mTrack->sampleProperties)
+    for (size_t index = 0; index < mSamples.getSize(); index++)
     {
+        const MP4VR::SampleInformation& sampleProp = mSamples[index];
         uint64_t sampleStartMs = sampleProp.earliestTimestampTS * timeScaleMsPerTS;
         uint64_t sampleEndMs = sampleStartMs + (uint64_t) sampleProp.sampleDurationTS * timeScaleMsPerTS;
 
@@ -483,7 +568,7 @@ bool_t MP4MediaStream::findSampleIdByTime(uint64_t timeMs, uint64_t& finalTimeMs
 
 bool_t MP4MediaStream::findSampleIdByIndex(uint32_t sampleNr, uint32_t& sampleId)
 {
-    if (mSampleTsPairs.size > sampleNr)
+    if (mSampleTsPairs.getSize() > sampleNr)
     {
         sampleId = mSampleTsPairs[sampleNr].itemId;
         return true;
@@ -497,16 +582,16 @@ void_t MP4MediaStream::setNextSampleId(uint32_t id, bool_t& segmentChanged)
 {
     OMAF_ASSERT(mTrack != OMAF_NULL, "No track assigned");
     size_t indexInSegment = 0;
-    for (size_t index = 0; index < mTrack->sampleProperties.size; index++)
+    for (size_t index = 0; index < mSamples.getSize(); index++)
     {
-        if (mTrack->sampleProperties[index].sampleId == id)
+        if (mSamples[index].sampleId == id)
         {
             mSampleIndex.mGlobalSampleIndex = static_cast<uint32_t>(index);
             mSampleIndex.mSegmentSampleIndex = static_cast<uint32_t>(indexInSegment);
             mNextRefFrame = 0;
             break;
         }
-        if (mTrack->sampleProperties[index].segmentId == mSampleIndex.mCurrentSegment)
+        if (mSamples[index].segmentId == mSampleIndex.mCurrentSegment)
         {
             indexInSegment++;
         }
@@ -527,8 +612,8 @@ uint32_t MP4MediaStream::getCurrentSegmentId() const
 uint32_t MP4MediaStream::getSamplesLeft() const
 {
     // mSampleIndex.mGlobalSampleIndex points to the next sample to read, and is not the 0-based playhead position /
-    // index. hence if we have 0 samples left, mSampleIndex.mGlobalSampleIndex == mTrack->sampleProperties.size
-    return (mTrack->sampleProperties.size - mSampleIndex.mGlobalSampleIndex);
+    // index. hence if we have 0 samples left, mSampleIndex.mGlobalSampleIndex == mSamples.getSize()
+    return (mSamples.getSize() - mSampleIndex.mGlobalSampleIndex);
 }
 
 bool_t MP4MediaStream::isCurrentSegmentInProgress() const
@@ -549,7 +634,7 @@ bool_t MP4MediaStream::isAtLastSegmentBoundary(uint32_t& aSegmentIndex) const
     {
         aSegmentIndex = mSampleIndex.mCurrentSegment;
     }
-    if (mSampleIndex.mSegmentSampleIndex == mTrack->sampleProperties.size)
+    if (mSampleIndex.mSegmentSampleIndex == mSamples.getSize())
     {
         // in the end of the last segment
         OMAF_LOG_V("Track %d isAtSegmentBoundary the last sample of available segments was read %d", mTrackId,
@@ -589,42 +674,42 @@ bool_t MP4MediaStream::isAtAnySegmentBoundary(uint32_t& aSegmentIndex) const
 uint64_t MP4MediaStream::getCurrentReadPositionMs()
 {
     uint64_t sampleTimeMs = 0;
-    if (mTrack != OMAF_NULL && mTrack->sampleProperties.size > 0)
+    if (mTrack != OMAF_NULL && mSamples.getSize() > 0)
     {
         uint32_t index = 0;
         if (mSampleIndex.mGlobalSampleIndex > 0)
         {
             index = mSampleIndex.mGlobalSampleIndex - 1;
         }
-        sampleTimeMs = mTrack->sampleProperties[index].earliestTimestamp;
+        sampleTimeMs = mSamples[index].earliestTimestamp;
     }
     return sampleTimeMs;
 }
 
 uint64_t MP4MediaStream::getTimeLeftInCurrentSegmentMs() const
 {
-    if (mTrack->sampleProperties.size == 0 || mSampleIndex.mGlobalSampleIndex >= mTrack->sampleProperties.size)
+    if (mSamples.getSize() == 0 || mSampleIndex.mGlobalSampleIndex >= mSamples.getSize())
     {
         return 0;
     }
-    uint64_t now = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].earliestTimestamp;
+    uint64_t now = mSamples[mSampleIndex.mGlobalSampleIndex].earliestTimestamp;
     uint64_t end = 0;
 
     // must not use mSampleIndex.mCurrentSegment since it may be 1 segment behind because mGlobalSampleIndex points to
     // the next sample to be read, and mCurrentSegment points to the last segment read
-    uint32_t currentSegment = mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex].segmentId;
-    for (uint32_t i = mSampleIndex.mGlobalSampleIndex; i < mTrack->sampleProperties.size; i++)
+    uint32_t currentSegment = mSamples[mSampleIndex.mGlobalSampleIndex].segmentId;
+    for (uint32_t i = mSampleIndex.mGlobalSampleIndex; i < mSamples.getSize(); i++)
     {
-        if (mTrack->sampleProperties[i].segmentId != currentSegment)
+        if (mSamples[i].segmentId != currentSegment)
         {
-            end = mTrack->sampleProperties[i - 1].earliestTimestamp;
+            end = mSamples[i - 1].earliestTimestamp;
             break;
         }
     }
     if (end == 0)
     {
         // there is no newer segment available, take the timestamp of the last available sample
-        end = mTrack->sampleProperties[mTrack->sampleProperties.size - 1].earliestTimestamp;
+        end = mSamples[mSamples.getSize() - 1].earliestTimestamp;
     }
     return (end - now);
 }
@@ -632,14 +717,14 @@ uint64_t MP4MediaStream::getTimeLeftInCurrentSegmentMs() const
 uint64_t MP4MediaStream::getFrameCount() const
 {
     OMAF_ASSERT(mTrack != OMAF_NULL, "No track assigned");
-    return mTrack->sampleProperties.size;
+    return mSamples.getSize();
 }
 
 // EoF or end of data in available segments
 bool_t MP4MediaStream::isEoF() const
 {
     OMAF_ASSERT(mTrack != OMAF_NULL, "No track assigned");
-    return (mSampleIndex.mGlobalSampleIndex >= mTrack->sampleProperties.size);
+    return (mSampleIndex.mGlobalSampleIndex >= mSamples.getSize());
 }
 
 uint32_t MP4MediaStream::framesUntilNextSyncFrame(uint64_t& syncFrameTimeMs)
@@ -648,11 +733,11 @@ uint32_t MP4MediaStream::framesUntilNextSyncFrame(uint64_t& syncFrameTimeMs)
     {
         // previously found frame index is out of date
         // find it
-        uint32_t count = mTrack->sampleProperties.size;
+        uint32_t count = mSamples.getSize();
         bool_t found = false;
         for (uint32_t i = mSampleIndex.mGlobalSampleIndex; i < count; i++)
         {
-            if (mTrack->sampleProperties[i].sampleType == MP4VR::OUTPUT_REFERENCE_FRAME)
+            if (mSamples[i].sampleType == MP4VR::OUTPUT_REFERENCE_FRAME)
             {
                 found = true;
                 mNextRefFrame = i;
@@ -663,18 +748,18 @@ uint32_t MP4MediaStream::framesUntilNextSyncFrame(uint64_t& syncFrameTimeMs)
         if (!found)
         {
             // couldn't find it, it must be in the next segment that is not yet available
-            syncFrameTimeMs = mTrack->sampleProperties[mTrack->sampleProperties.size - 1].earliestTimestamp +
+            syncFrameTimeMs = mSamples[mSamples.getSize() - 1].earliestTimestamp +
                 33;  // guessing frame interval
-            return mTrack->sampleProperties.size - mSampleIndex.mGlobalSampleIndex;
+            return mSamples.getSize() - mSampleIndex.mGlobalSampleIndex;
         }
     }
-    syncFrameTimeMs = mTrack->sampleProperties[mNextRefFrame].earliestTimestamp;
+    syncFrameTimeMs = mSamples[mNextRefFrame].earliestTimestamp;
     return mNextRefFrame - mSampleIndex.mGlobalSampleIndex + 1;
 }
 
 bool_t MP4MediaStream::isReferenceFrame()
 {
-    if (mTrack->sampleProperties[mSampleIndex.mGlobalSampleIndex - 1].sampleType == MP4VR::OUTPUT_REFERENCE_FRAME)
+    if (mSamples[mSampleIndex.mGlobalSampleIndex - 1].sampleType == MP4VR::OUTPUT_REFERENCE_FRAME)
     {
         return true;
     }
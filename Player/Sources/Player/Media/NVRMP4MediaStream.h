@@ -15,6 +15,7 @@
 #pragma once
 #include <reader/mp4vrfiledatatypes.h>
 #include <reader/mp4vrfilereaderinterface.h>
+#include "Foundation/NVRArray.h"
 #include "Foundation/NVRFixedQueue.h"
 #include "NVRNamespace.h"
 #include "Platform/OMAFDataTypes.h"
@@ -72,6 +73,13 @@ public:
     virtual uint32_t getMaxSampleSize() const;
 
     virtual void_t setTrack(MP4VR::TrackInformation* track);
+
+    // incremental alternatives to setTrack + setTimestamps, for the samples of a single segment
+    // (see MP4VRFileReaderInterface::getSegmentTrackInformations)
+    virtual void_t addSegmentSamples(const MP4VR::DynArray<MP4VR::SampleInformation>& samples,
+                                     const MP4VR::DynArray<MP4VR::TimestampIDPair>& timestamps);
+    virtual void_t removeSegmentSamples(uint32_t segmentId);
+
     // peek, no index changed
     virtual Error::Enum peekNextSample(uint32_t& sample) const;
     virtual Error::Enum peekNextSampleTs(MP4VR::TimestampIDPair& sample) const;
@@ -158,15 +166,20 @@ protected:
 
     SampleIndex mSampleIndex;
 
-    // reference, not owned
+    // reference, not owned; the samples are kept in mSamples
     MP4VR::TrackInformation* mTrack;
 
     uint32_t mSamplesRead;
 
+private:
+    void_t syncSampleIndex();
+
 private:
     uint32_t mTrackId;
 
-    MP4VR::DynArray<MP4VR::TimestampIDPair> mSampleTsPairs;
+    // samples of all the buffered segments, in segment order
+    Array<MP4VR::SampleInformation> mSamples;
+    Array<MP4VR::TimestampIDPair> mSampleTsPairs;
 
     // buffers allocated only when needed
     FixedQueue<MP4VRMediaPacket*, 100> mEmptyPackets;
@@ -32,12 +32,27 @@
 #include "Foundation/NVRClock.h"
 #include "Foundation/NVRDeviceInfo.h"
 #include "Foundation/NVRLogger.h"
+#include "Foundation/NVRTime.h"
 #include "Metadata/NVRCubemapDefinitions.h"
+#include "Provider/NVRLatencyStatistics.h"
 #include "VideoDecoder/NVRVideoDecoderManager.h"
 
 OMAF_NS_BEGIN
 OMAF_LOG_ZONE(MP4VRParser)
 
+static PathName sIndexCacheDirectory;
+static Mutex sIndexCacheMutex;
+
+void_t MP4VRParser::setIndexCacheDirectory(const char_t* aDirectory)
+{
+    Mutex::ScopeLock lock(sIndexCacheMutex);
+    sIndexCacheDirectory.clear();
+    if (aDirectory != OMAF_NULL)
+    {
+        sIndexCacheDirectory.append(aDirectory);
+    }
+}
+
 MP4VRParser::MP4VRParser(const MP4StreamCreator& aStreamCreator, ParserContext* ctx)
     : mAllocator(*MemorySystem::DefaultHeapAllocator())
     , mStreamCreator(aStreamCreator)
@@ -48,6 +63,7 @@ MP4VRParser::MP4VRParser(const MP4StreamCreator& aStreamCreator, ParserContext*
 #if OMAF_ENABLE_STREAM_VIDEO_PROVIDER
     , mMediaSegments(*MemorySystem::DefaultHeapAllocator())
     , mInitSegments()
+    , mInitSegmentContents()
 #endif
     , mReaderMutex()
     , mClientAssignVideoStreamId(false)
@@ -56,14 +72,16 @@ MP4VRParser::MP4VRParser(const MP4StreamCreator& aStreamCreator, ParserContext*
     , mNewTimestampBaseSegmentId(0)
     , mCtx(ctx)
 {
-    mReader = MP4VR::MP4VRFileReaderInterface::Create();
 }
 
 MP4VRParser::~MP4VRParser()
 {
-    mReader->close();
-    MP4VR::MP4VRFileReaderInterface::Destroy(mReader);
-    mReader = OMAF_NULL;
+    if (mReader != OMAF_NULL)
+    {
+        mReader->close();
+        MP4VR::MP4VRFileReaderInterface::Destroy(mReader);
+        mReader = OMAF_NULL;
+    }
     OMAF_DELETE(mAllocator, mTracks);
     mFileStream.close();
 #if OMAF_ENABLE_STREAM_VIDEO_PROVIDER
@@ -99,6 +117,7 @@ MP4VRParser::~MP4VRParser()
             OMAF_DELETE(mAllocator, (*it).second);
         }
         mInitSegments.clear();
+        mInitSegmentContents.clear();
     }
 
 #endif
@@ -233,6 +252,18 @@ Error::Enum MP4VRParser::parseVideoSources(MP4VideoStream& aVideoStream, BasicSo
     }
 }
 
+void_t MP4VRParser::createReader()
+{
+    // The reader is created only when some file data is parsed. E.g. tile representations whose segments are parsed
+    // by the extractor's parser use their own parser only for metadata, and never need a reader.
+    // Only the entry points that open input call this, all the other reader use comes after them.
+    Mutex::ScopeLock readerLock(mReaderMutex);
+    if (mReader == OMAF_NULL)
+    {
+        mReader = MP4VR::MP4VRFileReaderInterface::Create();
+    }
+}
+
 const CoreProviderSourceTypes& MP4VRParser::getVideoSourceTypes()
 {
     return mMetaDataParser.getVideoSourceTypes();
@@ -253,7 +284,15 @@ Error::Enum MP4VRParser::openInput(const PathName& mediaUri,
         return Error::FILE_NOT_FOUND;
     }
     OMAF_LOG_D("Initializing MP4VR reader with mediaUri: %s", mediaUri.getData());
+    createReader();
 
+    {
+        Mutex::ScopeLock lock(sIndexCacheMutex);
+        if (!sIndexCacheDirectory.isEmpty())
+        {
+            mReader->setIndexCacheDirectory(sIndexCacheDirectory.getData());
+        }
+    }
     int32_t result = mReader->initialize(&mFileStream);
 
     if (result == MP4VR::MP4VRFileReaderInterface::ErrorCode::OK)
@@ -388,9 +427,44 @@ Error::Enum MP4VRParser::prepareFile(MP4AudioStreams& aAudioStreams,
 }
 
 #if OMAF_ENABLE_STREAM_VIDEO_PROVIDER
+// FNV-1a, http://isthe.com/chongo/tech/comp/fnv/
+static uint64_t hashSegmentData(const uint8_t* aData, size_t aSize)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < aSize; i++)
+    {
+        hash ^= aData[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
 Error::Enum MP4VRParser::openSegmentedInput(MP4Segment* mp4Segment, bool_t aClientAssignVideoStreamId)
 {
     mClientAssignVideoStreamId = aClientAssignVideoStreamId;
+    createReader();
+
+    // The segment is owned and freed by the segment stream, and a new download may get the same address, so a parsed
+    // init segment is recognized by its id and content
+    const DataBuffer<uint8_t>* data = mp4Segment->getDataBuffer();
+    InitSegmentContent content(data->getSize(), hashSegmentData(data->getDataPtr(), data->getSize()));
+    for (size_t index = 0; index < mInitSegments.getSize(); index++)
+    {
+        if (mInitSegments[index].first == mp4Segment->getInitSegmentId())
+        {
+            if (mInitSegmentContents[index].second.first == content.first &&
+                mInitSegmentContents[index].second.second == content.second)
+            {
+                // parsed already, e.g. before an ABR switch away from this representation and back
+                return Error::OK;
+            }
+            mReader->invalidateInitializationSegment(mInitSegments[index].first);
+            OMAF_DELETE(mAllocator, mInitSegments[index].second);
+            mInitSegments.removeAt(index);
+            mInitSegmentContents.removeAt(index);
+            break;
+        }
+    }
 
     InitSegment initSegment(mp4Segment->getInitSegmentId(), OMAF_NEW(mAllocator, MP4SegmentStreamer)(mp4Segment));
 
@@ -413,6 +487,7 @@ Error::Enum MP4VRParser::openSegmentedInput(MP4Segment* mp4Segment, bool_t aClie
         }
 
 		mInitSegments.add(initSegment);
+        mInitSegmentContents.add(Pair<InitSegmentId, InitSegmentContent>(initSegment.first, content));
         return Error::OK;
         // we don't create streams yet at this point, because mp4reader can't provide all the necessary info, e.g.
         // decoderConfigInfo
@@ -480,6 +555,7 @@ Error::Enum MP4VRParser::addSegment(MP4Segment* mp4Segment,
         mNewTimestampBaseSegmentId = mp4Segment->getSegmentId();
     }
 
+    int64_t parseStartTimeUs = Time::getClockTimeUs();
     if (mReader->parseSegment(segment, mp4Segment->getInitSegmentId(), mp4Segment->getSegmentId(), earliestPTSinTS) !=
         MP4VR::MP4VRFileReaderInterface::OK)
     {
@@ -488,6 +564,7 @@ Error::Enum MP4VRParser::addSegment(MP4Segment* mp4Segment,
     }
     else
     {
+        LatencyStatistics::record(LatencyCategory::SEGMENT_PARSE, Time::getClockTimeUs() - parseStartTimeUs);
         (*segmentQueue)->push(segment);
     }
 
@@ -529,7 +606,12 @@ Error::Enum MP4VRParser::addSegment(MP4Segment* mp4Segment,
     }
     else
     {
-        updateStreams(aAudioStreams, aVideoStreams, aMetadataStreams);
+        Error::Enum ret = addSegmentToStreams(mp4Segment->getInitSegmentId(), mp4Segment->getSegmentId(),
+                                              aAudioStreams, aVideoStreams, aMetadataStreams);
+        if (ret != Error::OK)
+        {
+            return ret;
+        }
     }
 
     releaseUsedSegments(aAudioStreams, aVideoStreams, aMetadataStreams);
@@ -539,6 +621,7 @@ Error::Enum MP4VRParser::addSegment(MP4Segment* mp4Segment,
 
 Error::Enum MP4VRParser::addSegmentIndex(MP4Segment* mp4Segment, int32_t aAcceptedMinNumSegment)
 {
+    createReader();
     // No mutex on purpose - parseSegmentIndex isn't effected by other mReader usage
     uint32_t segmentId = mp4Segment->getSegmentId();
     OMAF_LOG_V("add SegmentIndex iD:%d", segmentId);
@@ -579,14 +662,16 @@ Error::Enum MP4VRParser::addSegmentIndex(MP4Segment* mp4Segment, int32_t aAccept
         }
     }
 
-    MP4SegmentStreamer* segment = OMAF_NEW(mAllocator, MP4SegmentStreamer)(mp4Segment);
+    // the streamer is needed only while parsing the index, so it comes from the scratch arena of this thread
+    MemoryAllocator& scratchAllocator = *MemorySystem::DefaultScratchAllocator();
+    MP4SegmentStreamer* segment = OMAF_NEW(scratchAllocator, MP4SegmentStreamer)(mp4Segment);
     MP4VR::DynArray<MP4VR::SegmentInformation>* segmentIndex =
         OMAF_NEW(mAllocator, MP4VR::DynArray<MP4VR::SegmentInformation>);
 
     if (mReader->parseSegmentIndex(segment, *segmentIndex) != MP4VR::MP4VRFileReaderInterface::OK)
     {
         OMAF_DELETE(mAllocator, segmentIndex);
-        OMAF_DELETE_HEAP(segment);
+        OMAF_DELETE(scratchAllocator, segment);
         return Error::INVALID_DATA;
     }
 
@@ -597,7 +682,7 @@ Error::Enum MP4VRParser::addSegmentIndex(MP4Segment* mp4Segment, int32_t aAccept
     if (segmentIndex->numElements < aAcceptedMinNumSegment)
     {
         OMAF_DELETE(mAllocator, segmentIndex);
-        OMAF_DELETE_HEAP(segment);
+        OMAF_DELETE(scratchAllocator, segment);
         return Error::NOT_SUPPORTED;
     }
 
@@ -608,7 +693,7 @@ Error::Enum MP4VRParser::addSegmentIndex(MP4Segment* mp4Segment, int32_t aAccept
     }
 
     mSegmentIndexes.add(segmentIndex);
-    OMAF_DELETE_HEAP(segment);
+    OMAF_DELETE(scratchAllocator, segment);
 
     return Error::OK;
 }
@@ -790,12 +875,16 @@ Error::Enum MP4VRParser::removeSegment(uint32_t initSegmentId,
 {
     OMAF_LOG_V("removeSegment %d", segmentId);
     Mutex::ScopeLock readerLock(mReaderMutex);
+    if (mReader == OMAF_NULL)
+    {
+        return Error::INVALID_STATE;
+    }
 
     int32_t result = mReader->invalidateSegment(initSegmentId, segmentId);
 
     if (result == MP4VR::MP4VRFileReaderInterface::OK)
     {
-        updateStreams(aAudioStreams, aVideoStreams, aMetadataStreams);
+        removeSegmentFromStreams(segmentId, aAudioStreams, aVideoStreams, aMetadataStreams);
 
         // remove the segment from queue
         // OMAF_ASSERT(mSegments.getSize() > 0, "Segment queue mismatch");
@@ -961,24 +1050,9 @@ bool_t MP4VRParser::releaseAllSegments(MP4AudioStreams& aAudioStreams,
                                   aMetadataStreams);
                 }
                 (*mediaSegmentIt)->clear();
-                if (aResetInitialization)
-                {
-                    for (InitSegments::Iterator initSegmentIt = mInitSegments.begin();
-                         initSegmentIt != mInitSegments.end(); ++initSegmentIt)
-                    {
-                        if ((*initSegmentIt).first == initSegmentId)
-                        {
-                            // and then invalidate the init segment
-                            mReader->invalidateInitializationSegment(initSegmentId);
-                            // if fails, what can we do, we are invalidating data here, so we just ignore the error as
-                            // we won't use this data any more anyways?
-
-                            OMAF_DELETE(mAllocator, (*initSegmentIt).second);
-                            mInitSegments.remove(*initSegmentIt);
-                            break;
-                        }
-                    }
-                }
+                // The parsed init segment is kept also when aResetInitialization is set: the representation
+                // passes the same init segment again when it is initialized the next time, and
+                // openSegmentedInput then reuses it instead of parsing it again.
             }
         }
         return true;
@@ -1642,8 +1716,9 @@ Error::Enum MP4VRParser::createStreams(MP4AudioStreams& aAudioStreams,
                                        MP4MetadataStreams& aMetadataStreams,
                                        FileFormatType::Enum fileFormat)
 {
-    Array<uint32_t> isExtractor(mAllocator);
-    Array<uint32_t> participatesExtractor(mAllocator);
+    // temporaries of this call only; the provider's parser thread resets its scratch arena once per loop round
+    Array<uint32_t> isExtractor(*MemorySystem::DefaultScratchAllocator());
+    Array<uint32_t> participatesExtractor(*MemorySystem::DefaultScratchAllocator());
     bool_t hasMetadata = false;
     if (mTracks != OMAF_NULL)
     {
@@ -1715,7 +1790,7 @@ Error::Enum MP4VRParser::createStreams(MP4AudioStreams& aAudioStreams,
             }
         }
 
-        std::set<uint32_t> refIds(trackOrGroupIds.begin(), trackOrGroupIds.end());
+        std::set<uint32_t> refIds(trackOrGroupIds.getData(), trackOrGroupIds.getData() + trackOrGroupIds.getSize());
         std::vector<uint32_t> intersection;
 
         std::set_intersection(trackRefIds.begin(), trackRefIds.end(), refIds.begin(), refIds.end(),
@@ -2101,6 +2176,123 @@ Error::Enum MP4VRParser::updateStreams(MP4AudioStreams& aAudioStreams,
     return Error::OK;
 }
 
+// update streams with the samples of a newly parsed segment; the cost does not depend on how much is buffered
+Error::Enum MP4VRParser::addSegmentToStreams(uint32_t aInitSegmentId,
+                                             uint32_t aSegmentId,
+                                             MP4AudioStreams& aAudioStreams,
+                                             MP4VideoStreams& aVideoStreams,
+                                             MP4MetadataStreams& aMetadataStreams)
+{
+    MP4VR::DynArray<MP4VR::TrackInformation> segmentTracks;
+    if (mReader->getSegmentTrackInformations(aInitSegmentId, aSegmentId, segmentTracks) !=
+        MP4VR::MP4VRFileReaderInterface::OK)
+    {
+        return Error::SEGMENT_CHANGE_FAILED;
+    }
+
+    for (MP4VR::TrackInformation* segmentTrack = segmentTracks.begin(); segmentTrack != segmentTracks.end();
+         segmentTrack++)
+    {
+        MP4VR::TrackInformation* track = OMAF_NULL;
+        for (MP4VR::TrackInformation* it = mTracks->begin(); it != mTracks->end(); it++)
+        {
+            if (it->trackId == segmentTrack->trackId)
+            {
+                track = it;
+                break;
+            }
+        }
+        if (track == OMAF_NULL)
+        {
+            // a track we have not seen before, e.g. from a newly associated initialization segment
+            return updateStreams(aAudioStreams, aVideoStreams, aMetadataStreams);
+        }
+    }
+
+    for (MP4VR::TrackInformation* segmentTrack = segmentTracks.begin(); segmentTrack != segmentTracks.end();
+         segmentTrack++)
+    {
+        MP4MediaStream* stream = OMAF_NULL;
+        if (segmentTrack->features & MP4VR::TrackFeatureEnum::IsVideoTrack)
+        {
+            for (size_t i = 0; i < aVideoStreams.getSize() && stream == OMAF_NULL; i++)
+            {
+                if (aVideoStreams[i]->getTrackId() == segmentTrack->trackId)
+                {
+                    stream = aVideoStreams[i];
+                }
+            }
+        }
+        else if (segmentTrack->features & MP4VR::TrackFeatureEnum::IsAudioTrack)
+        {
+            for (size_t i = 0; i < aAudioStreams.getSize() && stream == OMAF_NULL; i++)
+            {
+                if (aAudioStreams[i]->getTrackId() == segmentTrack->trackId)
+                {
+                    stream = aAudioStreams[i];
+                }
+            }
+        }
+        else if (segmentTrack->features & MP4VR::TrackFeatureEnum::IsMetadataTrack)
+        {
+            for (size_t i = 0; i < aMetadataStreams.getSize() && stream == OMAF_NULL; i++)
+            {
+                if (aMetadataStreams[i]->getTrackId() == segmentTrack->trackId)
+                {
+                    stream = aMetadataStreams[i];
+                }
+            }
+        }
+
+        if (stream != OMAF_NULL)
+        {
+            MP4VR::DynArray<MP4VR::TimestampIDPair> timestamps;
+            if (mReader->getSegmentTrackTimestamps(segmentTrack->trackId, aSegmentId, timestamps) !=
+                MP4VR::MP4VRFileReaderInterface::OK)
+            {
+                return Error::SEGMENT_CHANGE_FAILED;
+            }
+            stream->addSegmentSamples(segmentTrack->sampleProperties, timestamps);
+        }
+
+        for (MP4VR::TrackInformation* track = mTracks->begin(); track != mTracks->end(); track++)
+        {
+            if (track->trackId == segmentTrack->trackId)
+            {
+                if (segmentTrack->maxSampleSize > track->maxSampleSize)
+                {
+                    track->maxSampleSize = segmentTrack->maxSampleSize;
+                }
+                // keep samples of a still valid segment available for the sample property queries
+                track->sampleProperties = std::move(segmentTrack->sampleProperties);
+                break;
+            }
+        }
+    }
+
+    return Error::OK;
+}
+
+// drop the samples of an invalidated segment from the streams
+void_t MP4VRParser::removeSegmentFromStreams(uint32_t aSegmentId,
+                                             MP4AudioStreams& aAudioStreams,
+                                             MP4VideoStreams& aVideoStreams,
+                                             MP4MetadataStreams& aMetadataStreams)
+{
+    for (MP4VideoStreams::Iterator it = aVideoStreams.begin(); it != aVideoStreams.end(); ++it)
+    {
+        (*it)->removeSegmentSamples(aSegmentId);
+    }
+    for (MP4AudioStreams::Iterator it = aAudioStreams.begin(); it != aAudioStreams.end(); ++it)
+    {
+        (*it)->removeSegmentSamples(aSegmentId);
+    }
+    for (MP4MetadataStreams::Iterator it = aMetadataStreams.begin(); it != aMetadataStreams.end(); ++it)
+    {
+        (*it)->removeSegmentSamples(aSegmentId);
+    }
+}
+
 MetadataParser& MP4VRParser::getMetadataParser()
 {
     return mMetaDataParser;
@@ -2139,6 +2331,10 @@ Error::Enum MP4VRParser::getPropertyOverlayConfig(uint32_t aTrackId,
                                                   uint32_t aSampleId,
                                                   MP4VR::OverlayConfigProperty& aOverlayConfigProperty) const
 {
+    if (mReader == OMAF_NULL)
+    {
+        return Error::INVALID_STATE;
+    }
     int32_t result = mReader->getPropertyOverlayConfig(aTrackId, aSampleId, aOverlayConfigProperty);
     if (result != MP4VR::MP4VRFileReaderInterface::OK)
     {
@@ -2151,6 +2347,10 @@ Error::Enum MP4VRParser::getPropertyOverlayConfig(uint32_t aTrackId,
 
 Error::Enum MP4VRParser::getPropertyGroupsList(MP4VR::GroupsListProperty& aEntityGroups) const
 {
+    if (mReader == OMAF_NULL)
+    {
+        return Error::INVALID_STATE;
+    }
     int32_t result = mReader->getFileGroupsList(aEntityGroups);
         
     if (result != MP4VR::MP4VRFileReaderInterface::OK)
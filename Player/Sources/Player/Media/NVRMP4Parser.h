@@ -63,6 +63,9 @@ typedef FixedArray<MP4VR::DynArray<MP4VR::SegmentInformation>*, SEGMENT_INDEX_CO
 typedef uint32_t InitSegmentId;
 typedef Pair<InitSegmentId, MP4SegmentStreamer*> InitSegment;
 typedef FixedArray<InitSegment, INIT_SEGMENT_COUNT_MAX> InitSegments;
+// size and hash of the parsed init segment data, as the segment itself is freed by its owner
+typedef Pair<uint64_t, uint64_t> InitSegmentContent;
+typedef FixedArray<Pair<InitSegmentId, InitSegmentContent>, INIT_SEGMENT_COUNT_MAX> InitSegmentContents;
 
 typedef FixedQueue<MP4SegmentStreamer*, 1000> MediaSegments;
 typedef HashMap<InitSegmentId, MediaSegments*> MediaSegmentMap;
@@ -83,6 +86,12 @@ public:
     MP4VRParser(const MP4StreamCreator& aStreamCreator, ParserContext* ctx);
     virtual ~MP4VRParser();
 
+    /**
+     * Sets the directory where the reader caches the sample tables of local files, used by the files opened after
+     * the call. NULL or an empty string disables the cache.
+     */
+    static void_t setIndexCacheDirectory(const char_t* aDirectory);
+
     /**
      * Opens a given input.
      * @param mediaUri The media URI to open.
@@ -196,9 +205,21 @@ protected:
     virtual Error::Enum updateStreams(MP4AudioStreams& aAudioStreams,
                                       MP4VideoStreams& aVideoStreams,
                                       MP4MetadataStreams& aMetadataStreams);
+    virtual Error::Enum addSegmentToStreams(uint32_t aInitSegmentId,
+                                            uint32_t aSegmentId,
+                                            MP4AudioStreams& aAudioStreams,
+                                            MP4VideoStreams& aVideoStreams,
+                                            MP4MetadataStreams& aMetadataStreams);
+    virtual void_t removeSegmentFromStreams(uint32_t aSegmentId,
+                                            MP4AudioStreams& aAudioStreams,
+                                            MP4VideoStreams& aVideoStreams,
+                                            MP4MetadataStreams& aMetadataStreams);
 
     virtual bool_t readAACAudioMetadata(MP4AudioStream& stream);
 
+    // creates the file reader if there is none yet; called when opening input, not per read
+    void_t createReader();
+
 private:
     ParserContext* mCtx;
     MemoryAllocator& mAllocator;
@@ -206,7 +227,9 @@ private:
 
     MP4VR::MP4VRFileReaderInterface* mReader;
 
-    // holder for the tracks; accessed via streams who have handle to their corresponding track
+    // holder for the tracks; accessed via streams who have handle to their corresponding track.
+    // After the initial setup sampleProperties holds only the samples of the latest segment, the streams keep
+    // the samples of all the buffered segments themselves
     MP4VR::DynArray<MP4VR::TrackInformation>* mTracks;
 
     MetadataParser mMetaDataParser;
@@ -215,6 +238,7 @@ private:
 
 #if OMAF_ENABLE_STREAM_VIDEO_PROVIDER
     InitSegments mInitSegments;
+    InitSegmentContents mInitSegmentContents;
     MediaSegmentMap mMediaSegments;
     SegmentIndexes mSegmentIndexes;
 #endif
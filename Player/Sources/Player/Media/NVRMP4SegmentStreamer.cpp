@@ -42,6 +42,11 @@ uint32_t MP4SegmentStreamer::getSegmentId()
     return mSegment->getSegmentId();
 }
 
+MP4Segment* MP4SegmentStreamer::getSegment()
+{
+    return mSegment;
+}
+
 MP4VR::StreamInterface::offset_t MP4SegmentStreamer::read(char* buffer, MP4VR::StreamInterface::offset_t size)
 {
     if (mReadIndex + size >= mSegment->getDataBuffer()->getSize())
@@ -35,6 +35,7 @@ public:
 
     uint32_t getInitSegmentId();
     uint32_t getSegmentId();
+    MP4Segment* getSegment();
 
     offset_t read(char* buffer, offset_t size);
 
@@ -26,7 +26,6 @@ MediaPacketQueue::MediaPacketQueue(MemoryAllocator& allocator, uint32_t maxSampl
     , mMaxSampleSize(maxSampleSize)
     , mEmptyPackets()
     , mFilledPackets()
-    , mMutex()
 {
 }
 
@@ -43,13 +42,11 @@ MediaPacketQueue::~MediaPacketQueue()
 
 bool_t MediaPacketQueue::hasFilledPackets() const
 {
-    Mutex::ScopeLock lock(mMutex);
     return !mFilledPackets.isEmpty();
 }
 
 MP4VRMediaPacket* MediaPacketQueue::peekFilledPacket()
 {
-    Mutex::ScopeLock lock(mMutex);
     if (mFilledPackets.isEmpty())
     {
         return OMAF_NULL;
@@ -62,7 +59,6 @@ MP4VRMediaPacket* MediaPacketQueue::peekFilledPacket()
 
 MP4VRMediaPacket* MediaPacketQueue::popFilledPacket()
 {
-    Mutex::ScopeLock lock(mMutex);
     if (mFilledPackets.isEmpty())
     {
         return OMAF_NULL;
@@ -81,22 +77,20 @@ MP4VRMediaPacket* MediaPacketQueue::popFilledPacket()
 void_t MediaPacketQueue::pushFilledPacket(MP4VRMediaPacket* packet)
 {
     OMAF_ASSERT(packet != OMAF_NULL, "");
-    Mutex::ScopeLock lock(mMutex);
 
-    mFilledPackets.push(packet);
+    bool_t pushed = mFilledPackets.push(packet);
+    OMAF_ASSERT(pushed, "Too many filled packets");
+    OMAF_UNUSED_VARIABLE(pushed);
 }
 
 bool_t MediaPacketQueue::hasEmptyPackets(size_t count) const
 {
-    Mutex::ScopeLock lock(mMutex);
-
     // There is room for new filled packets so empty packet(s) must be available.
     return mFilledPackets.getCapacity() - mFilledPackets.getSize() > count;
 }
 
 MP4VRMediaPacket* MediaPacketQueue::popEmptyPacket()
 {
-    Mutex::ScopeLock lock(mMutex);
     MP4VRMediaPacket* packet = OMAF_NULL;
 
     if (mEmptyPackets.isEmpty())
@@ -119,14 +113,15 @@ MP4VRMediaPacket* MediaPacketQueue::popEmptyPacket()
 void_t MediaPacketQueue::pushEmptyPacket(MP4VRMediaPacket* packet)
 {
     OMAF_ASSERT(packet != OMAF_NULL, "");
-    Mutex::ScopeLock lock(mMutex);
     packet->setDataSize(0);
-    mEmptyPackets.push(packet);
+
+    bool_t pushed = mEmptyPackets.push(packet);
+    OMAF_ASSERT(pushed, "Too many empty packets");
+    OMAF_UNUSED_VARIABLE(pushed);
 }
 
 void_t MediaPacketQueue::reset()
 {
-    Mutex::ScopeLock lock(mMutex);
     for (size_t i = 0; i < mAllocatedPackets.getSize(); ++i)
     {
         OMAF_DELETE(mAllocator, mAllocatedPackets[i]);
@@ -14,8 +14,7 @@
  */
 #pragma once
 #include "Foundation/NVRFixedArray.h"
-#include "Foundation/NVRFixedQueue.h"
-#include "Foundation/NVRMutex.h"
+#include "Foundation/NVRSpscQueue.h"
 #include "Media/NVRIMediaPacketQueue.h"
 #include "NVRNamespace.h"
 
@@ -27,6 +26,9 @@ class MemoryAllocator;
 
 class MP4VRMediaPacket;
 
+// Packets circulate between one producer thread, which pops empty packets and pushes them filled, and one consumer
+// thread, which pops filled packets and returns them empty. Both directions are lock-free single producer / single
+// consumer queues. reset() must not run concurrently with either side.
 class MediaPacketQueue : public IMediaPacketQueue
 {
 public:
@@ -59,11 +61,11 @@ private:
 
     // NOTE: Ownership of MP4VRMediaPacket is kept even if packet is popped out temporarily.
 
-    FixedQueue<MP4VRMediaPacket*, MEDIAPACKETQUEUE_CAPACITY> mEmptyPackets;
-    FixedQueue<MP4VRMediaPacket*, MEDIAPACKETQUEUE_CAPACITY> mFilledPackets;
-    FixedArray<MP4VRMediaPacket*, MEDIAPACKETQUEUE_CAPACITY> mAllocatedPackets;
+    SpscQueue<MP4VRMediaPacket*, MEDIAPACKETQUEUE_CAPACITY> mEmptyPackets;
+    SpscQueue<MP4VRMediaPacket*, MEDIAPACKETQUEUE_CAPACITY> mFilledPackets;
 
-    mutable Mutex mMutex;
+    // Only touched by the producer
+    FixedArray<MP4VRMediaPacket*, MEDIAPACKETQUEUE_CAPACITY> mAllocatedPackets;
 };
 
 OMAF_NS_END
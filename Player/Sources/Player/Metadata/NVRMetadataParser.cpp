@@ -19,6 +19,8 @@
 #include "Metadata/NVROmafMetadataHelper.h"
 #include "Provider/NVRCoreProviderSources.h"
 
+#include <algorithm>
+
 #include "Foundation/NVRLogger.h"
 
 #include "Math/OMAFMathFunctions.h"
@@ -80,6 +80,22 @@ OMAF_NS_END
 
 #endif
 
+#if OMAF_PLATFORM_LINUX
+
+OMAF_NS_BEGIN
+namespace StorageManager
+{
+    extern PathName gStoragePath;
+}
+
+namespace AssetManager
+{
+    extern PathName gAssetPath;
+}
+OMAF_NS_END
+
+#endif
+
 #if OMAF_PLATFORM_ANDROID
 #include "Foundation/Android/NVRAndroid.h"
 #endif
@@ -188,6 +204,22 @@ Error::Enum initialize(RendererType::Enum rendererType,
     AssetManager::gAssetPath = platformParameters->assetPath;
 #endif
 
+#if OMAF_PLATFORM_LINUX
+    // Platform parameters are optional on Linux, paths default to the working directory
+    if (platformParameters != OMAF_NULL)
+    {
+        if (platformParameters->storagePath != OMAF_NULL)
+        {
+            StorageManager::gStoragePath = platformParameters->storagePath;
+        }
+
+        if (platformParameters->assetPath != OMAF_NULL)
+        {
+            AssetManager::gAssetPath = platformParameters->assetPath;
+        }
+    }
+#endif
+
 #if OMAF_GRAPHICS_API_D3D11
     renderBackendParameters.d3dDevice = platformParameters->d3dDevice;
 #endif
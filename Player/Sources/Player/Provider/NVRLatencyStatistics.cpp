@@ -0,0 +1,106 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "Provider/NVRLatencyStatistics.h"
+
+#include <algorithm>
+
+#include "Foundation/NVRSpinlock.h"
+
+OMAF_NS_BEGIN
+
+namespace LatencyStatistics
+{
+    // Percentiles are computed over a window of the latest samples to keep recording allocation free
+    static const uint32_t SAMPLE_WINDOW_SIZE = 1024;
+
+    struct CategoryData
+    {
+        uint32_t count;
+        uint64_t minUs;
+        uint64_t maxUs;
+        uint64_t totalUs;
+        uint32_t samples[SAMPLE_WINDOW_SIZE];
+    };
+
+    static CategoryData sCategories[LatencyCategory::COUNT];
+    static Spinlock sLock;
+
+    void_t record(LatencyCategory::Enum category, uint64_t latencyUs)
+    {
+        OMAF_ASSERT(category > LatencyCategory::INVALID && category < LatencyCategory::COUNT, "Invalid category");
+
+        Spinlock::LockGuard lock(sLock);
+        CategoryData& data = sCategories[category];
+
+        if (data.count == 0 || latencyUs < data.minUs)
+        {
+            data.minUs = latencyUs;
+        }
+        if (latencyUs > data.maxUs)
+        {
+            data.maxUs = latencyUs;
+        }
+        data.totalUs += latencyUs;
+        data.samples[data.count % SAMPLE_WINDOW_SIZE] = (uint32_t) std::min(latencyUs, (uint64_t) OMAF_UINT32_MAX);
+        data.count++;
+    }
+
+    LatencySummary getSummary(LatencyCategory::Enum category)
+    {
+        OMAF_ASSERT(category > LatencyCategory::INVALID && category < LatencyCategory::COUNT, "Invalid category");
+
+        LatencySummary summary;
+        uint32_t window[SAMPLE_WINDOW_SIZE];
+        uint32_t windowSize = 0;
+        {
+            Spinlock::LockGuard lock(sLock);
+            const CategoryData& data = sCategories[category];
+
+            if (data.count == 0)
+            {
+                return summary;
+            }
+
+            summary.count = data.count;
+            summary.minUs = data.minUs;
+            summary.maxUs = data.maxUs;
+            summary.averageUs = data.totalUs / data.count;
+
+            windowSize = std::min(data.count, SAMPLE_WINDOW_SIZE);
+            std::copy(data.samples, data.samples + windowSize, window);
+        }
+
+        std::sort(window, window + windowSize);
+        summary.medianUs = window[windowSize / 2];
+        summary.percentile95Us = window[(windowSize * 95) / 100];
+
+        return summary;
+    }
+
+    void_t reset()
+    {
+        Spinlock::LockGuard lock(sLock);
+
+        for (uint32_t i = 0; i < LatencyCategory::COUNT; ++i)
+        {
+            sCategories[i].count = 0;
+            sCategories[i].minUs = 0;
+            sCategories[i].maxUs = 0;
+            sCategories[i].totalUs = 0;
+        }
+    }
+}
+
+OMAF_NS_END
@@ -0,0 +1,65 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "NVREssentials.h"
+
+OMAF_NS_BEGIN
+
+namespace LatencyCategory
+{
+    enum Enum
+    {
+        INVALID = -1,
+
+        SEGMENT_DOWNLOAD,  // request sent -> segment fully received
+        SEGMENT_PARSE,     // segment handed to the MP4 reader -> samples available
+        TILE_SWITCH,       // new representation selected -> switch done
+
+        COUNT
+    };
+}
+
+struct LatencySummary
+{
+    LatencySummary()
+        : count(0)
+        , minUs(0)
+        , maxUs(0)
+        , averageUs(0)
+        , medianUs(0)
+        , percentile95Us(0)
+    {
+    }
+
+    uint32_t count;
+    uint64_t minUs;
+    uint64_t maxUs;
+    uint64_t averageUs;
+    uint64_t medianUs;        // over the most recent samples only
+    uint64_t percentile95Us;  // over the most recent samples only
+};
+
+// Process wide latency counters for the streaming pipeline. Recording is cheap and can be done from any thread.
+namespace LatencyStatistics
+{
+    void_t record(LatencyCategory::Enum category, uint64_t latencyUs);
+
+    LatencySummary getSummary(LatencyCategory::Enum category);
+
+    void_t reset();
+}
+
+OMAF_NS_END
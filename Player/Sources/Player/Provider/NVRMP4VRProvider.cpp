@@ -181,6 +181,9 @@ void_t MP4VRProvider::parserThreadCallback()
 
         while (1)
         {
+            // frames are read in this loop, so nothing allocated from the scratch arena outlives a round
+            MemorySystem::ResetScratchAllocator();
+
             VideoProviderState::Enum stateBeforeUserAction = getState();
 
             if (mPendingUserAction != PendingUserAction::INVALID)
@@ -383,6 +383,18 @@ size_t VASTilesLayer::getRows(VASTileRows& aOutputRows,
     }
 }
 
+const VASTileRows& VASTilesLayer::getAllRows(StereoRole::Enum channel) const
+{
+    if (channel == StereoRole::RIGHT)
+    {
+        return mRowsR;
+    }
+    else
+    {
+        return mRowsL;
+    }
+}
+
 size_t VASTilesLayer::getRowsInternal(VASTileRows& aOutputRows,
                                       const VASTileRows& aSourceRows,
                                       float64_t aLatitudeTop,
@@ -129,6 +129,8 @@ public:
     bool_t hasSeparateStereoTiles() const;
     size_t
     getRows(VASTileRows& aOutputRows, StereoRole::Enum channel, float64_t latitudeTop, float64_t latitudeBottom) const;
+    // all rows of the channel, including overlapping ones
+    const VASTileRows& getAllRows(StereoRole::Enum channel) const;
 
     // this should be only used when all tiles/adaptation sets need to be iterated
     DashAdaptationSetSubPicture* getAdaptationSetAt(size_t index) const;
@@ -0,0 +1,171 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "VAS/NVRVASTileIndex.h"
+#include "Foundation/NVRMemorySystem.h"
+#include "Math/OMAFMathFunctions.h"
+
+OMAF_NS_BEGIN
+
+// Bucket size in degrees. The error in the viewport position is at most half of this, which is in the same range as
+// the motion thresholds of the tile picker
+static const uint32_t INDEX_STEP_DEG = 2;
+static const uint32_t INDEX_LONGITUDE_BUCKETS = 360 / INDEX_STEP_DEG;
+static const uint32_t INDEX_LATITUDE_BUCKETS = 180 / INDEX_STEP_DEG + 1;  // both poles included
+static const uint32_t BUCKET_NOT_FILLED = OMAF_UINT32_MAX;
+
+VASTileIndex::VASTileIndex()
+    : mTiles(*MemorySystem::DefaultHeapAllocator())
+    , mRowStarts()
+    , mBuckets(*MemorySystem::DefaultHeapAllocator())
+    , mEntries(*MemorySystem::DefaultHeapAllocator())
+    , mHorFov(0.f)
+    , mVerFov(0.f)
+    , mTileType(VASTileType::EQUIRECT_ENHANCEMENT)
+{
+    mRowStarts.add(0);
+}
+
+VASTileIndex::~VASTileIndex()
+{
+}
+
+void_t VASTileIndex::reset(VASTileType::Enum aTileType)
+{
+    mTiles.clear();
+    mRowStarts.clear();
+    mRowStarts.add(0);
+    mBuckets.clear();
+    mEntries.clear();
+    mHorFov = 0.f;
+    mVerFov = 0.f;
+    mTileType = aTileType;
+}
+
+size_t VASTileIndex::addRow(const VASTileViewports& aTiles)
+{
+    OMAF_ASSERT(mRowStarts.getSize() < mRowStarts.getCapacity(), "Too many tile rows");
+    for (size_t i = 0; i < aTiles.getSize(); i++)
+    {
+        mTiles.add(aTiles[i]);
+    }
+    mRowStarts.add((uint32_t) mTiles.getSize());
+    // any filled bucket is missing the new row
+    mBuckets.clear();
+    mEntries.clear();
+    return mRowStarts.getSize() - 2;
+}
+
+size_t VASTileIndex::getNrRows() const
+{
+    return mRowStarts.getSize() - 1;
+}
+
+void_t VASTileIndex::getCoverage(const VASRenderedViewport& aViewport, size_t aRow, VASTileCoverage& aCoverage)
+{
+    OMAF_ASSERT(aRow < getNrRows(), "Invalid tile row");
+    float64_t horFov, verFov;
+    aViewport.getSpan(horFov, verFov);
+    if (mBuckets.isEmpty() || fabs(horFov - mHorFov) > 0.5 * INDEX_STEP_DEG ||
+        fabs(verFov - mVerFov) > 0.5 * INDEX_STEP_DEG)
+    {
+        flush(horFov, verFov);
+    }
+
+    size_t bucketIndex = getBucketIndex(aViewport.getCenterLongitude(), aViewport.getCenterLatitude());
+    if (mBuckets[bucketIndex].count == BUCKET_NOT_FILLED)
+    {
+        fillBucket(bucketIndex);
+    }
+
+    uint32_t rowSize = mRowStarts[aRow + 1] - mRowStarts[aRow];
+    aCoverage.clear();
+    for (uint32_t i = 0; i < rowSize; i++)
+    {
+        aCoverage.add(0.f);
+    }
+    // entries are in row order, so the row is a contiguous run
+    const Bucket& bucket = mBuckets[bucketIndex];
+    for (uint32_t i = bucket.first; i < bucket.first + bucket.count; i++)
+    {
+        const Entry& entry = mEntries[i];
+        if (entry.row == aRow)
+        {
+            aCoverage[entry.tile] = entry.area;
+        }
+        else if (entry.row > aRow)
+        {
+            break;
+        }
+    }
+}
+
+size_t VASTileIndex::getBucketIndex(float64_t aLongitude, float64_t aLatitude) const
+{
+    // round to the nearest grid point, so a bucket covers +-INDEX_STEP_DEG/2 around its center
+    int32_t longitudeIndex = (int32_t) floor((aLongitude + 180.0) / INDEX_STEP_DEG + 0.5);
+    longitudeIndex %= (int32_t) INDEX_LONGITUDE_BUCKETS;
+    if (longitudeIndex < 0)
+    {
+        longitudeIndex += INDEX_LONGITUDE_BUCKETS;
+    }
+    int32_t latitudeIndex = (int32_t) floor((clamp(aLatitude, -90.0, 90.0) + 90.0) / INDEX_STEP_DEG + 0.5);
+    return (size_t) latitudeIndex * INDEX_LONGITUDE_BUCKETS + longitudeIndex;
+}
+
+void_t VASTileIndex::fillBucket(size_t aBucketIndex)
+{
+    float64_t longitude = -180.0 + (float64_t)((aBucketIndex % INDEX_LONGITUDE_BUCKETS) * INDEX_STEP_DEG);
+    float64_t latitude = -90.0 + (float64_t)((aBucketIndex / INDEX_LONGITUDE_BUCKETS) * INDEX_STEP_DEG);
+    VASRenderedViewport viewport;
+    viewport.setPosition(longitude, latitude, mHorFov, mVerFov, mTileType);
+
+    Bucket& bucket = mBuckets[aBucketIndex];
+    bucket.first = (uint32_t) mEntries.getSize();
+    bucket.count = 0;
+    for (size_t row = 0; row < getNrRows(); row++)
+    {
+        for (uint32_t i = mRowStarts[row]; i < mRowStarts[row + 1]; i++)
+        {
+            float64_t area = viewport.intersect(*mTiles[i]);
+            if (area > 0)
+            {
+                Entry entry;
+                entry.row = (uint16_t) row;
+                entry.tile = (uint16_t)(i - mRowStarts[row]);
+                entry.area = (float32_t) area;
+                mEntries.add(entry);
+                bucket.count++;
+            }
+        }
+    }
+}
+
+void_t VASTileIndex::flush(float64_t aHorFov, float64_t aVerFov)
+{
+    mHorFov = aHorFov;
+    mVerFov = aVerFov;
+    Bucket empty;
+    empty.first = 0;
+    empty.count = BUCKET_NOT_FILLED;
+    mBuckets.clear();
+    mBuckets.reserve(INDEX_LONGITUDE_BUCKETS * INDEX_LATITUDE_BUCKETS);
+    for (uint32_t i = 0; i < INDEX_LONGITUDE_BUCKETS * INDEX_LATITUDE_BUCKETS; i++)
+    {
+        mBuckets.add(empty);
+    }
+    mEntries.clear();
+}
+
+OMAF_NS_END
@@ -0,0 +1,79 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "Foundation/NVRArray.h"
+#include "Foundation/NVRFixedArray.h"
+#include "VAS/NVRVASViewport.h"
+
+OMAF_NS_BEGIN
+
+typedef FixedArray<const VASTileViewport*, 60> VASTileViewports;  // covered viewports of the tiles in a row
+typedef FixedArray<float64_t, 60> VASTileCoverage;                // intersection area of each tile in a row
+
+/*
+ * Quantized viewport-to-tile intersection lookup.
+ * The sphere is split into buckets of INDEX_STEP_DEG x INDEX_STEP_DEG degrees. When a viewport falls into a bucket for
+ * the first time, a viewport centered in the bucket is intersected with all indexed tiles and the non-zero areas are
+ * stored. Later lookups in the same bucket only copy the stored areas, so the trigonometry of
+ * VASRenderedViewport::intersect is done once per bucket for the lifetime of the tile layout. The stored areas are
+ * valid for one viewport size; if the size changes, the buckets are flushed.
+ */
+class VASTileIndex
+{
+public:
+    VASTileIndex();
+    ~VASTileIndex();
+
+    void_t reset(VASTileType::Enum aTileType);
+
+    // returns the row index to be used in getCoverage. The viewports are referenced, not copied
+    size_t addRow(const VASTileViewports& aTiles);
+    size_t getNrRows() const;
+
+    // fills aCoverage with the intersection areas of the tiles in aRow for the bucket of aViewport
+    void_t getCoverage(const VASRenderedViewport& aViewport, size_t aRow, VASTileCoverage& aCoverage);
+
+private:
+    struct Entry
+    {
+        uint16_t row;
+        uint16_t tile;
+        float32_t area;
+    };
+
+    struct Bucket
+    {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    size_t getBucketIndex(float64_t aLongitude, float64_t aLatitude) const;
+    void_t fillBucket(size_t aBucketIndex);
+    void_t flush(float64_t aHorFov, float64_t aVerFov);
+
+private:
+    Array<const VASTileViewport*> mTiles;  // all tiles, row after row
+    FixedArray<uint32_t, 64> mRowStarts;   // index of the first tile of each row in mTiles; one extra at the end
+
+    Array<Bucket> mBuckets;
+    Array<Entry> mEntries;
+
+    float64_t mHorFov;
+    float64_t mVerFov;
+    VASTileType::Enum mTileType;
+};
+
+OMAF_NS_END
@@ -14,6 +14,7 @@
  */
 #include "VAS/NVRVASTilePicker.h"
 #include "Foundation/NVRDeviceInfo.h"
+#include "Foundation/NVRTime.h"
 #include "Math/OMAFMathFunctions.h"
 #include "VAS/NVRVASLog.h"
 
@@ -33,6 +34,9 @@ static const float64_t MOTION_THR_FAST_DEG = 10.f;
 static const float64_t VIEWPORT_EXTENSION =
     1.2f;  // multiplier for the high quality area around the actual viewport (width,height)
 
+// How often the predicted viewport is re-evaluated
+static const int64_t PREDICTION_INTERVAL_US = 100000;
+
 void_t VASTilePicker::MotionVector::clear()
 {
     deltaLatitude = 0.f;
@@ -78,6 +82,18 @@ VASTilePicker::VASTilePicker()
     , mForcedToMono(false)
     , mTileCountRestricted(false)
     , mTileType(VASTileType::EQUIRECT_ENHANCEMENT)
+    , mTileIndex()
+    , mIndexedRows()
+    , mIndexedLayer(OMAF_NULL)
+    , mPredictor()
+    , mPredictedViewport()
+    , mPredictionHorizonMs(0)
+    , mLastPredictionTimeUs(0)
+    , mPredictedTiles()
+    , mPredictionUpdated(false)
+    , mDownloadedPrefetchTiles()
+    , mPrefetchedCount(0)
+    , mPrefetchHitCount(0)
 {
     mRenderedViewport.setPosition(
         0.f, 0.f, 90.f, 90.f,
@@ -104,6 +120,8 @@ bool_t VASTilePicker::setRenderedViewPort(float64_t longitude,
     width *= VIEWPORT_EXTENSION;
     height *= VIEWPORT_EXTENSION;
 
+    mPredictor.addSample(Time::getClockTimeUs(), longitude, latitude);
+
     bool_t triggerTileSelection = true;
     if (!mSelectedTiles.isEmpty())
     {
@@ -160,6 +178,11 @@ bool_t VASTilePicker::setRenderedViewPort(float64_t longitude,
     }
     mRenderedViewport.setPosition(longitude, latitude, width, height, mTileType);
 
+    if (mPredictionHorizonMs > 0 && !mIndexedRows.isEmpty())
+    {
+        updatePrediction();
+    }
+
     // then do the tile selection
     if (triggerTileSelection || mPendingTiles || mTriggerTileSelection)
     {
@@ -196,6 +219,10 @@ void_t VASTilePicker::setupTileRendering(VASTilesLayer& allTiles,
         mTileCountRestricted = false;
     }
     mTileType = allTiles.getTileType();
+    if (mIndexedRows.isEmpty())
+    {
+        buildTileIndex(allTiles);
+    }
 }
 
 // called from renderer thread
@@ -238,6 +265,14 @@ VASTileSelection& VASTilePicker::getLatestTiles(bool_t& selectionUpdated,
         VAS_LOG_TILES_D("New tiles:", aToViewport);
         VAS_LOG_TILES_D("Dropped tiles:", aToBackground);
 
+        size_t hits = aToViewport.getSize() - aToViewport.difference(mDownloadedPrefetchTiles).getSize();
+        if (hits > 0)
+        {
+            mPrefetchHitCount += (uint32_t) hits;
+            OMAF_LOG_D("Prefetched tiles entered viewport: %zd, total %d of %d prefetched", hits, mPrefetchHitCount,
+                       mPrefetchedCount);
+        }
+
         selectionUpdated = true;
     }
     else
@@ -276,6 +311,54 @@ VASTileSelection& VASTilePicker::getLatestMargins(size_t aNumberOfTiles, VASTile
     return mDownloadedMarginTiles;
 }
 
+// called from provider thread
+VASTileSelection& VASTilePicker::getLatestPrefetch(size_t aNrTiles,
+                                                   bool_t aForce,
+                                                   bool_t& aUpdated,
+                                                   VASTileSelection& aToBackground)
+{
+    Spinlock::ScopeLock lock(mSpinlock);
+    if (!mPredictionUpdated && !aForce)
+    {
+        aUpdated = false;
+        return mDownloadedPrefetchTiles;
+    }
+    mPredictionUpdated = false;
+
+    VASTileSelection oldPrefetch = mDownloadedPrefetchTiles;
+    mDownloadedPrefetchTiles.clear();
+    for (size_t i = 0; i < mPredictedTiles.getSize() && mDownloadedPrefetchTiles.getSize() < aNrTiles; i++)
+    {
+        VASTileContainer* tile = mPredictedTiles[i];
+        if (!mDownloadedViewportTiles.contains(tile) && !mDownloadedMarginTiles.contains(tile))
+        {
+            mDownloadedPrefetchTiles.add(tile);
+        }
+    }
+
+    // prefetched tiles stay out of the background, and the ones no longer predicted go there unless they are in use
+    aToBackground = aToBackground.difference(mDownloadedPrefetchTiles);
+    VASTileSelection dropped = oldPrefetch.difference(mDownloadedPrefetchTiles)
+                                   .difference(mDownloadedViewportTiles)
+                                   .difference(mDownloadedMarginTiles);
+    aToBackground.add(dropped.difference(aToBackground));
+
+    VASTileSelection added = mDownloadedPrefetchTiles.difference(oldPrefetch);
+    mPrefetchedCount += (uint32_t) added.getSize();
+    aUpdated = aForce || !added.isEmpty() || !dropped.isEmpty();
+    if (!added.isEmpty())
+    {
+        VAS_LOG_TILES_D("Prefetch tiles:", added);
+    }
+    return mDownloadedPrefetchTiles;
+}
+
+void_t VASTilePicker::setPredictionHorizon(uint32_t aHorizonMs)
+{
+    OMAF_LOG_D("Viewport prediction horizon %d ms", aHorizonMs);
+    mPredictionHorizonMs = aHorizonMs;
+}
+
 void_t VASTilePicker::setAllSelected(const VASTilesLayer& aTiles)
 {
     if (mSelectionAll.isEmpty() && !aTiles.isEmpty())
@@ -574,10 +657,12 @@ bool_t VASTilePicker::pickTilesDeltaSearch(const VASTilesLayer& allTiles,
 void_t VASTilePicker::doFullSearchRow(const VASTiles& tilesInRow, VASTileSelection& candidates)
 {
     FixedArray<size_t, 60> noMatch;
+    VASTileCoverage coverageStorage;
+    const VASTileCoverage* coverage = getRowCoverage(mRenderedViewport, tilesInRow, coverageStorage);
 
     for (size_t i = 0; i < tilesInRow.getSize(); i++)
     {
-        float64_t area = mRenderedViewport.intersect(tilesInRow[i]->getCoveredViewport());
+        float64_t area = intersect(tilesInRow, i, coverage);
         if (area > INTERSECTION_AREA_THR)
         {
             // OMAF_LOG_D("Candidate tile %f", tilesInRow[i]->getCoveredViewport().getCenterLongitude());
@@ -607,11 +692,13 @@ void_t VASTilePicker::doDeltaSearchRow(const VASTiles& tilesInRow, size_t firstO
     int32_t firstIncluded = -1;
     int32_t lastIncluded = -1;
     FixedArray<size_t, 60> noMatch;
+    VASTileCoverage coverageStorage;
+    const VASTileCoverage* coverage = getRowCoverage(mRenderedViewport, tilesInRow, coverageStorage);
 
     for (int32_t i = first; i >= 0; i--)
     {
         // check how many tiles to left we need to go
-        float64_t area = mRenderedViewport.intersect(tilesInRow[i]->getCoveredViewport());
+        float64_t area = intersect(tilesInRow, i, coverage);
         if (area > INTERSECTION_AREA_THR)
         {
             if (lastIncluded < 0)
@@ -637,7 +724,7 @@ void_t VASTilePicker::doDeltaSearchRow(const VASTiles& tilesInRow, size_t firstO
     for (int32_t i = first + 1; i < tilesInRow.getSize(); i++)
     {
         // check how many tiles to right we need to go
-        float64_t area = mRenderedViewport.intersect(tilesInRow[i]->getCoveredViewport());
+        float64_t area = intersect(tilesInRow, i, coverage);
         if (area > INTERSECTION_AREA_THR)
         {
             if (firstIncluded < 0)
@@ -669,7 +756,7 @@ void_t VASTilePicker::doDeltaSearchRow(const VASTiles& tilesInRow, size_t firstO
             // wrap around from right to left
             for (int32_t i = 0; i < firstIncluded; i++)
             {
-                float64_t area = mRenderedViewport.intersect(tilesInRow[i]->getCoveredViewport());
+                float64_t area = intersect(tilesInRow, i, coverage);
                 if (area > INTERSECTION_AREA_THR)
                 {
                     //      OMAF_LOG_D("doDeltaSearchRow matched after wrap-around %d", i);
@@ -695,7 +782,7 @@ void_t VASTilePicker::doDeltaSearchRow(const VASTiles& tilesInRow, size_t firstO
             // wrap around from left to right
             for (int32_t i = (int32_t)(tilesInRow.getSize() - 1); i > lastIncluded; i--)
             {
-                float64_t area = mRenderedViewport.intersect(tilesInRow[i]->getCoveredViewport());
+                float64_t area = intersect(tilesInRow, i, coverage);
                 if (area > INTERSECTION_AREA_THR)
                 {
                     // OMAF_LOG_D("doDeltaSearchRow matched after wrap-around %d", i);
@@ -729,6 +816,132 @@ void_t VASTilePicker::doDeltaSearchRow(const VASTiles& tilesInRow, size_t firstO
     }
 }
 
+// The index is built from the full rows of the layer; the rows returned by VASTilesLayer::getRows are a subset of them
+void_t VASTilePicker::buildTileIndex(const VASTilesLayer& tiles)
+{
+    mTileIndex.reset(tiles.getTileType());
+    mIndexedRows.clear();
+    mIndexedLayer = &tiles;
+    const StereoRole::Enum channels[] = {StereoRole::LEFT, StereoRole::RIGHT};
+    for (size_t c = 0; c < OMAF_ARRAY_SIZE(channels); c++)
+    {
+        const VASTileRows& rows = tiles.getAllRows(channels[c]);
+        for (VASTileRows::ConstIterator it = rows.begin(); it != rows.end(); ++it)
+        {
+            if (mIndexedRows.getSize() == mIndexedRows.getCapacity())
+            {
+                // the remaining rows use the direct intersection
+                return;
+            }
+            const VASTiles& tilesInRow = (*it)->getTiles();
+            VASTileViewports viewports;
+            for (size_t i = 0; i < tilesInRow.getSize(); i++)
+            {
+                viewports.add(&tilesInRow[i]->getCoveredViewport());
+            }
+            mTileIndex.addRow(viewports);
+            mIndexedRows.add(&tilesInRow);
+        }
+    }
+    OMAF_LOG_D("Tile index built for %zd rows", mIndexedRows.getSize());
+}
+
+// Returns the quantized intersection areas of the row with the viewport, or OMAF_NULL if the row is not indexed
+const VASTileCoverage* VASTilePicker::getRowCoverage(const VASRenderedViewport& aViewport,
+                                                     const VASTiles& tilesInRow,
+                                                     VASTileCoverage& aCoverage)
+{
+    for (size_t row = 0; row < mIndexedRows.getSize(); row++)
+    {
+        if (mIndexedRows[row] == &tilesInRow)
+        {
+            mTileIndex.getCoverage(aViewport, row, aCoverage);
+            return &aCoverage;
+        }
+    }
+    return OMAF_NULL;
+}
+
+// called from renderer thread. Selects the tiles that the predicted viewport would use, with the same thresholds as the
+// actual selection
+void_t VASTilePicker::updatePrediction()
+{
+    int64_t now = Time::getClockTimeUs();
+    if (now - mLastPredictionTimeUs < PREDICTION_INTERVAL_US)
+    {
+        return;
+    }
+    mLastPredictionTimeUs = now;
+
+    VASTileSelection predicted;
+    float64_t longitude, latitude;
+    if (mPredictor.predict(mPredictionHorizonMs, longitude, latitude))
+    {
+        float64_t width, height;
+        mRenderedViewport.getSpan(width, height);
+        mPredictedViewport.setPosition(longitude, latitude, width, height, mTileType);
+
+        FixedArray<float64_t, 128> areas;
+        pickPredictedTiles(StereoRole::RIGHT, predicted, areas);
+        if (!mForcedToMono)
+        {
+            pickPredictedTiles(StereoRole::LEFT, predicted, areas);
+        }
+    }
+
+    Spinlock::ScopeLock lock(mSpinlock);
+    if (!predicted.difference(mPredictedTiles).isEmpty() || !mPredictedTiles.difference(predicted).isEmpty())
+    {
+        mPredictedTiles = predicted;
+        mPredictionUpdated = true;
+    }
+}
+
+// adds the tiles of the predicted viewport in largest area first order; aAreas is parallel to aPredicted
+void_t VASTilePicker::pickPredictedTiles(StereoRole::Enum channel,
+                                         VASTileSelection& aPredicted,
+                                         FixedArray<float64_t, 128>& aAreas)
+{
+    float64_t top, bottom;
+    mPredictedViewport.getTopBottom(top, bottom);
+    VASTileRows rows;
+    if (!mIndexedLayer->getRows(rows, channel, top, bottom))
+    {
+        return;
+    }
+    for (VASTileRows::ConstIterator it = rows.begin(); it != rows.end(); ++it)
+    {
+        const VASTiles& tilesInRow = (*it)->getTiles();
+        VASTileCoverage coverage;
+        if (getRowCoverage(mPredictedViewport, tilesInRow, coverage) == OMAF_NULL)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < tilesInRow.getSize() && aPredicted.getSize() < aPredicted.getCapacity(); i++)
+        {
+            if (coverage[i] > INTERSECTION_AREA_THR)
+            {
+                size_t j = 0;
+                while (j < aAreas.getSize() && aAreas[j] >= coverage[i])
+                {
+                    j++;
+                }
+                aAreas.add(coverage[i], j);
+                aPredicted.add(tilesInRow[i], j);
+            }
+        }
+    }
+}
+
+float64_t VASTilePicker::intersect(const VASTiles& tilesInRow, size_t aIndex, const VASTileCoverage* aCoverage) const
+{
+    if (aCoverage != OMAF_NULL)
+    {
+        return aCoverage->at(aIndex);
+    }
+    return mRenderedViewport.intersect(tilesInRow[aIndex]->getCoveredViewport());
+}
+
 void_t VASTilePicker::checkMarginTileNeighbor(const VASTiles& tilesInRow, size_t aIndex)
 {
     if (aIndex == 0)
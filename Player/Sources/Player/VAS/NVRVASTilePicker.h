@@ -17,6 +17,8 @@
 #include "DashProvider/NVRDashAdaptationSet.h"
 #include "Foundation/NVRSpinlock.h"
 #include "VAS/NVRVASTileContainer.h"
+#include "VAS/NVRVASTileIndex.h"
+#include "VAS/NVRVASViewportPredictor.h"
 
 OMAF_NS_BEGIN
 
@@ -54,6 +56,13 @@ public:
                                              VASTileSelection& aToViewport,
                                              VASTileSelection& aToBackground);
     virtual VASTileSelection& getLatestMargins(size_t aNrTiles, VASTileSelection& aToBackground);
+    // tiles predicted to enter the viewport, excluding current viewport and margin tiles; call after getLatestMargins
+    virtual VASTileSelection& getLatestPrefetch(size_t aNrTiles,
+                                                bool_t aForce,
+                                                bool_t& aUpdated,
+                                                VASTileSelection& aToBackground);
+    // how far ahead the viewport is predicted; 0 disables the prediction
+    virtual void_t setPredictionHorizon(uint32_t aHorizonMs);
     virtual VASTileSelection& getLatestTiles();
 
     virtual void_t setAllSelected(const VASTilesLayer& aTiles);
@@ -101,6 +110,14 @@ private:
     void_t doFullSearchRow(const VASTiles& tilesInRow, VASTileSelection& candidates);
     void_t doDeltaSearchRow(const VASTiles& tilesInRow, size_t first, VASTileSelection& candidates);
 
+    void_t buildTileIndex(const VASTilesLayer& tiles);
+    void_t updatePrediction();
+    void_t pickPredictedTiles(StereoRole::Enum channel, VASTileSelection& aPredicted, FixedArray<float64_t, 128>& aAreas);
+    const VASTileCoverage* getRowCoverage(const VASRenderedViewport& aViewport,
+                                          const VASTiles& tilesInRow,
+                                          VASTileCoverage& aCoverage);
+    float64_t intersect(const VASTiles& tilesInRow, size_t aIndex, const VASTileCoverage* aCoverage) const;
+
     void_t checkMarginTileNeighbor(const VASTiles& tilesInRow, size_t aIndex);
     void_t addMarginTile(VASTileContainer* aTile, float64_t aArea);
 
@@ -161,5 +178,21 @@ private:
     bool_t mForcedToMono;
 
     VASTileType::Enum mTileType;
+
+    // precomputed viewport-tile intersections; mIndexedRows maps the rows of the tile layer to index rows
+    VASTileIndex mTileIndex;
+    FixedArray<const VASTiles*, 64> mIndexedRows;
+    const VASTilesLayer* mIndexedLayer;
+
+    // viewport prediction; mPredictedTiles is written in renderer thread, the rest of the tile lists in provider thread
+    VASViewportPredictor mPredictor;
+    VASRenderedViewport mPredictedViewport;
+    uint32_t mPredictionHorizonMs;
+    int64_t mLastPredictionTimeUs;
+    VASTileSelection mPredictedTiles;
+    bool_t mPredictionUpdated;
+    VASTileSelection mDownloadedPrefetchTiles;
+    uint32_t mPrefetchedCount;
+    uint32_t mPrefetchHitCount;
 };
 OMAF_NS_END
@@ -0,0 +1,130 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "VAS/NVRVASViewportPredictor.h"
+#include "Math/OMAFMathFunctions.h"
+
+OMAF_NS_BEGIN
+
+// samples older than this are not used for the velocity
+static const int64_t HISTORY_WINDOW_US = 300000;
+static const size_t MIN_SAMPLES = 4;
+// slower motion than this (degrees per second) is treated as still
+static const float64_t MIN_VELOCITY_DEG_S = 5.0;
+// share of the linear extrapolation that is used, and the maximum predicted move in degrees
+static const float64_t PREDICTION_DAMPING = 0.6;
+static const float64_t MAX_PREDICTION_DEG = 90.0;
+
+VASViewportPredictor::VASViewportPredictor()
+    : mNewest(0)
+    , mCount(0)
+{
+}
+
+VASViewportPredictor::~VASViewportPredictor()
+{
+}
+
+void_t VASViewportPredictor::reset()
+{
+    mNewest = 0;
+    mCount = 0;
+}
+
+void_t VASViewportPredictor::addSample(int64_t aTimeUs, float64_t aLongitude, float64_t aLatitude)
+{
+    float64_t longitude = aLongitude;
+    if (mCount > 0)
+    {
+        const Sample& previous = mSamples[mNewest];
+        if (aTimeUs <= previous.timeUs)
+        {
+            return;
+        }
+        // keep the longitude continuous over the +-180 wrap
+        float64_t delta = aLongitude - fmod(previous.longitude, 360.0);
+        while (delta > 180.0)
+        {
+            delta -= 360.0;
+        }
+        while (delta < -180.0)
+        {
+            delta += 360.0;
+        }
+        longitude = previous.longitude + delta;
+        mNewest = (mNewest + 1) % HISTORY_SIZE;
+    }
+    mSamples[mNewest].timeUs = aTimeUs;
+    mSamples[mNewest].longitude = longitude;
+    mSamples[mNewest].latitude = aLatitude;
+    mCount = min(mCount + 1, HISTORY_SIZE);
+}
+
+bool_t VASViewportPredictor::predict(uint32_t aHorizonMs, float64_t& aLongitude, float64_t& aLatitude) const
+{
+    if (mCount < MIN_SAMPLES)
+    {
+        return false;
+    }
+    const Sample& newest = mSamples[mNewest];
+
+    // least squares slope over the window, time relative to the newest sample in seconds
+    float64_t sumT = 0.0, sumTT = 0.0, sumLon = 0.0, sumTLon = 0.0, sumLat = 0.0, sumTLat = 0.0;
+    size_t n = 0;
+    for (size_t i = 0; i < mCount; i++)
+    {
+        const Sample& sample = mSamples[(mNewest + HISTORY_SIZE - i) % HISTORY_SIZE];
+        if (newest.timeUs - sample.timeUs > HISTORY_WINDOW_US)
+        {
+            break;
+        }
+        float64_t t = (sample.timeUs - newest.timeUs) / 1000000.0;
+        sumT += t;
+        sumTT += t * t;
+        sumLon += sample.longitude;
+        sumTLon += t * sample.longitude;
+        sumLat += sample.latitude;
+        sumTLat += t * sample.latitude;
+        n++;
+    }
+    float64_t denominator = n * sumTT - sumT * sumT;
+    if (n < MIN_SAMPLES || denominator <= 0.0)
+    {
+        return false;
+    }
+    float64_t velocityLon = (n * sumTLon - sumT * sumLon) / denominator;
+    float64_t velocityLat = (n * sumTLat - sumT * sumLat) / denominator;
+    if (fabs(velocityLon) < MIN_VELOCITY_DEG_S && fabs(velocityLat) < MIN_VELOCITY_DEG_S)
+    {
+        return false;
+    }
+
+    float64_t horizonS = aHorizonMs / 1000.0;
+    float64_t deltaLon = clamp(velocityLon * horizonS * PREDICTION_DAMPING, -MAX_PREDICTION_DEG, MAX_PREDICTION_DEG);
+    float64_t deltaLat = clamp(velocityLat * horizonS * PREDICTION_DAMPING, -MAX_PREDICTION_DEG, MAX_PREDICTION_DEG);
+
+    aLongitude = fmod(newest.longitude + deltaLon, 360.0);
+    if (aLongitude > 180.0)
+    {
+        aLongitude -= 360.0;
+    }
+    else if (aLongitude < -180.0)
+    {
+        aLongitude += 360.0;
+    }
+    aLatitude = clamp(newest.latitude + deltaLat, -90.0, 90.0);
+    return true;
+}
+
+OMAF_NS_END
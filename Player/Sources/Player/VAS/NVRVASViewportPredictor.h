@@ -0,0 +1,55 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#include "NVREssentials.h"
+
+OMAF_NS_BEGIN
+
+/*
+ * Extrapolates the viewport center from the recent head motion.
+ * The angular velocity is a least squares fit over the samples of the last HISTORY_WINDOW_MS, and the prediction
+ * follows it with damping, since head motion usually decelerates before it stops.
+ */
+class VASViewportPredictor
+{
+public:
+    VASViewportPredictor();
+    ~VASViewportPredictor();
+
+    void_t reset();
+
+    // called for every rendered viewport, positions in degrees
+    void_t addSample(int64_t aTimeUs, float64_t aLongitude, float64_t aLatitude);
+
+    // returns false if there is not enough recent history, or the head is not moving
+    bool_t predict(uint32_t aHorizonMs, float64_t& aLongitude, float64_t& aLatitude) const;
+
+private:
+    struct Sample
+    {
+        int64_t timeUs;
+        float64_t longitude;  // unwrapped, i.e. not limited to +-180
+        float64_t latitude;
+    };
+
+    static const size_t HISTORY_SIZE = 32;
+
+    Sample mSamples[HISTORY_SIZE];
+    size_t mNewest;
+    size_t mCount;
+};
+
+OMAF_NS_END
@@ -13,6 +13,7 @@
  * written consent of Nokia.
  */
 #include "VideoDecoder/NVRDecodedFrameGroup.h"
+#include "Foundation/NVRAtomic.h"
 #include "Foundation/NVRLogger.h"
 #include "Graphics/NVRRenderBackend.h"
 #include "VideoDecoder/NVRFrameCache.h"
@@ -158,18 +159,11 @@ void_t DecodedFrameGroup::cleanupOldFrames(uint64_t currentPTS)
 void_t DecodedFrameGroup::flushFrames()
 {
     discardFramesInternal(OMAF_UINT64_MAX);
-    mStagedFrameLock.lock();
-    if (mStagedFrame != OMAF_NULL)
+    DecoderFrame* stagedFrame = fetchStagedFrame();
+    if (stagedFrame != OMAF_NULL)
     {
-        DecoderFrame* stagedFrame = mStagedFrame;
-        mStagedFrame = OMAF_NULL;
-        mStagedFrameLock.unlock();
         mFrameCache->releaseFrame(stagedFrame);
     }
-    else
-    {
-        mStagedFrameLock.unlock();
-    }
 
     clearDiscardedFrames();
 }
@@ -250,13 +244,13 @@ bool_t DecodedFrameGroup::stageFrame(DecoderFrame* frame)
     Spinlock::ScopeLock lock(mFramesLock);
     if (mFrames.contains(frame))
     {
-        Spinlock::ScopeLock lock(mStagedFrameLock);
         mFrames.remove(frame);
-        if (mStagedFrame != OMAF_NULL)
+        DecoderFrame* previous =
+            (DecoderFrame*) Atomic::exchangePointer((void_t* OMAF_VOLATILE*) &mStagedFrame, frame);
+        if (previous != OMAF_NULL)
         {
-            mFrameCache->releaseFrame(mStagedFrame);
+            mFrameCache->releaseFrame(previous);
         }
-        mStagedFrame = frame;
         return true;
     }
     else
@@ -268,10 +262,7 @@ bool_t DecodedFrameGroup::stageFrame(DecoderFrame* frame)
 
 DecoderFrame* DecodedFrameGroup::fetchStagedFrame()
 {
-    Spinlock::ScopeLock lock(mStagedFrameLock);
-    DecoderFrame* fetched = mStagedFrame;
-    mStagedFrame = OMAF_NULL;
-    return fetched;
+    return (DecoderFrame*) Atomic::exchangePointer((void_t* OMAF_VOLATILE*) &mStagedFrame, OMAF_NULL);
 }
 
 OMAF_NS_END
@@ -53,11 +53,12 @@ private:
 private:
     FrameCache* mFrameCache;
     Spinlock mFramesLock;
-    Spinlock mStagedFrameLock;
     FrameList mFrames;
     Spinlock mDiscardedFramesLock;
     FrameList mDiscardedFrames;
-    DecoderFrame* mStagedFrame;
+
+    // Single slot handoff from the decoder to the renderer, swapped atomically
+    DecoderFrame* OMAF_VOLATILE mStagedFrame;
     bool_t mDiscardOldFrames;
 };
 
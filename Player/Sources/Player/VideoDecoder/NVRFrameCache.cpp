@@ -22,6 +22,7 @@
 #include "Graphics/NVRRenderBackend.h"
 
 #if OMAF_VIDEO_DECODER_NULL
+#include "VideoDecoder/Null/NVRFrameCacheNull.h"
 #elif OMAF_PLATFORM_ANDROID
 #include "VideoDecoder/Android/NVRFrameCacheAndroid.h"
 #elif OMAF_PLATFORM_WINDOWS
@@ -42,7 +43,7 @@ OMAF_LOG_ZONE(FrameCache)
 FrameCache* FrameCache::createFrameCache()
 {
 #if OMAF_VIDEO_DECODER_NULL
-    return OMAF_NULL;
+    return OMAF_NEW_HEAP(FrameCacheNull);
 #elif OMAF_PLATFORM_UWP
     return OMAF_NEW_HEAP(FrameCacheWindows);
 #elif OMAF_PLATFORM_WINDOWS
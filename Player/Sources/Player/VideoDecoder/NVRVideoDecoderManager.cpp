@@ -39,7 +39,7 @@ VideoDecoderManager* VideoDecoderManager::getInstance()
     if (sInstance == OMAF_NULL)
     {
 #if OMAF_VIDEO_DECODER_NULL
-//    sInstance = VideoDecoderNull::createDecoder(format);
+        sInstance = OMAF_NEW_HEAP(VideoDecoderNull);
 #else
 #if OMAF_PLATFORM_ANDROID
         sInstance = OMAF_NEW_HEAP(MediaCodecDecoder);
@@ -148,7 +148,7 @@ void_t VideoDecoderManager::deactivateStream(streamid_t stream)
 
 // Android and Windows decoders don't store FrameCache frames internally between decode calls
 // so the FrameCache should be flushed first to avoid error on Android
-#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_WINDOWS
+#if OMAF_PLATFORM_ANDROID || OMAF_PLATFORM_WINDOWS || OMAF_VIDEO_DECODER_NULL
         mFrameCache->deactivateStream(stream);
         mDecoders.at(stream).decoderHW->flush();
 #else
@@ -0,0 +1,86 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "VideoDecoder/Null/NVRFrameCacheNull.h"
+
+#if OMAF_VIDEO_DECODER_NULL
+
+#include "Foundation/NVRLogger.h"
+#include "VideoDecoder/NVRVideoDecoderHW.h"
+
+OMAF_NS_BEGIN
+
+OMAF_LOG_ZONE(FrameCacheNull);
+
+FrameCacheNull::FrameCacheNull()
+{
+}
+
+FrameCacheNull::~FrameCacheNull()
+{
+    destroyInstance();
+}
+
+DecoderFrame* FrameCacheNull::createFrame(uint32_t width, uint32_t height)
+{
+    DecoderFrame* frame = OMAF_NEW_HEAP(DecoderFrame);
+    frame->width = width;
+    frame->height = height;
+    return frame;
+}
+
+void_t FrameCacheNull::destroyFrame(DecoderFrame* frame)
+{
+    OMAF_ASSERT(frame != OMAF_NULL, "frame == OMAF_NULL in FrameCacheNull::destroyFrame");
+    OMAF_DELETE_HEAP(frame);
+}
+
+void_t FrameCacheNull::uploadTexture(DecoderFrame* frame)
+{
+    OMAF_ASSERT(frame != OMAF_NULL, "Uploading null frame");
+    VideoFrame& videoFrame = mCurrentVideoFrames.at(frame->streamId);
+    OMAF_ASSERT(videoFrame.format != VideoPixelFormat::INVALID, "Uninitialized video frame");
+    videoFrame.pts = frame->pts;
+    videoFrame.duration = frame->duration;
+    videoFrame.colorInfo = frame->colorInfo;
+
+    frame->decoder->consumedFrame(frame);
+}
+
+void_t FrameCacheNull::createTexture(streamid_t stream, const DecoderConfig& config)
+{
+    VideoFrame& frame = mCurrentVideoFrames.at(stream);
+
+    if (frame.format != VideoPixelFormat::INVALID)
+    {
+        return;
+    }
+
+    // No textures are created, the frame only has to look valid to the renderers
+    frame.format = VideoPixelFormat::NV12;
+    frame.width = config.width;
+    frame.height = config.height;
+    frame.numTextures = 0;
+}
+
+void_t FrameCacheNull::destroyTexture(streamid_t stream)
+{
+    VideoFrame& frame = mCurrentVideoFrames.at(stream);
+    frame.format = VideoPixelFormat::INVALID;
+    frame.numTextures = 0;
+}
+
+OMAF_NS_END
+
+#endif
@@ -0,0 +1,43 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#if OMAF_VIDEO_DECODER_NULL
+
+#include "VideoDecoder/NVRFrameCache.h"
+
+OMAF_NS_BEGIN
+
+// Frame cache without textures, frames only carry timing information.
+class FrameCacheNull : public FrameCache
+{
+public:
+    FrameCacheNull();
+    virtual ~FrameCacheNull();
+
+    virtual void_t createTexture(streamid_t stream, const DecoderConfig& config);
+    virtual void_t destroyTexture(streamid_t stream);
+
+protected:
+    virtual void_t uploadTexture(DecoderFrame* frame);
+
+private:
+    virtual DecoderFrame* createFrame(uint32_t width, uint32_t height);
+    virtual void_t destroyFrame(DecoderFrame* frame);
+};
+
+OMAF_NS_END
+
+#endif
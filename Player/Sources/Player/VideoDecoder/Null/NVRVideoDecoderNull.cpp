@@ -0,0 +1,81 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "VideoDecoder/Null/NVRVideoDecoderNull.h"
+
+#if OMAF_VIDEO_DECODER_NULL
+
+#include "Foundation/NVRLogger.h"
+#include "VideoDecoder/Null/NVRVideoDecoderNullHW.h"
+
+OMAF_NS_BEGIN
+OMAF_LOG_ZONE(VideoDecoderNull)
+
+VideoDecoderNull::VideoDecoderNull()
+{
+    // Frames are available as soon as the packet is accepted, no need to buffer ahead
+    mInitialBufferingThreshold = 1;
+}
+
+VideoDecoderNull::~VideoDecoderNull()
+{
+    for (FreeDecoders::Iterator it = mFreeDecoders.begin(); it != mFreeDecoders.end(); ++it)
+    {
+        VideoDecoderNullHW* decoder = *it;
+        decoder->deinitialize();
+        decoder->destroyInstance();
+        OMAF_DELETE_HEAP(decoder);
+    }
+}
+
+VideoDecoderHW* VideoDecoderNull::reserveVideoDecoder(const DecoderConfig& config)
+{
+    VideoDecoderNullHW* decoder = OMAF_NULL;
+    Error::Enum initResult = Error::OK;
+    for (FreeDecoders::Iterator it = mFreeDecoders.begin(); it != mFreeDecoders.end(); ++it)
+    {
+        const DecoderConfig& existingConfig = (*it)->getConfig();
+        if (config.mimeType == existingConfig.mimeType && config.width == existingConfig.width &&
+            config.height == existingConfig.height)
+        {
+            decoder = *it;
+            mFreeDecoders.remove(it);
+            decoder->setStreamId(config.streamId);
+            break;
+        }
+    }
+    if (decoder == OMAF_NULL)
+    {
+        decoder = OMAF_NEW_HEAP(VideoDecoderNullHW)(*mFrameCache);
+        decoder->createInstance(config.mimeType);
+        initResult = decoder->initialize(config);
+    }
+    if (initResult != Error::OK)
+    {
+        OMAF_LOG_E("Failed to initialize null decoder for stream %d", config.streamId);
+        decoder->destroyInstance();
+        OMAF_DELETE_HEAP(decoder);
+        return OMAF_NULL;
+    }
+    return decoder;
+}
+
+void_t VideoDecoderNull::releaseVideoDecoder(VideoDecoderHW* decoder)
+{
+    mFreeDecoders.add((VideoDecoderNullHW*) decoder);
+}
+
+OMAF_NS_END
+
+#endif
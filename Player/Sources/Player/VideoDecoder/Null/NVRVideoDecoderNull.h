@@ -0,0 +1,44 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#if OMAF_VIDEO_DECODER_NULL
+
+#include "VideoDecoder/NVRVideoDecoderManager.h"
+
+OMAF_NS_BEGIN
+
+class VideoDecoderNullHW;
+
+// Decoder manager for headless builds. Packets are consumed without decoding so that the
+// download, parsing and tile switching paths can be exercised without a video decoder.
+class VideoDecoderNull : public VideoDecoderManager
+{
+public:
+    VideoDecoderNull();
+    ~VideoDecoderNull();
+
+protected:
+    virtual VideoDecoderHW* reserveVideoDecoder(const DecoderConfig& config);
+    virtual void_t releaseVideoDecoder(VideoDecoderHW* decoder);
+
+private:
+    typedef FixedArray<VideoDecoderNullHW*, MAX_STREAM_COUNT> FreeDecoders;
+    FreeDecoders mFreeDecoders;
+};
+
+OMAF_NS_END
+
+#endif
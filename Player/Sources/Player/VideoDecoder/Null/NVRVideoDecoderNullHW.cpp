@@ -0,0 +1,148 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#include "VideoDecoder/Null/NVRVideoDecoderNullHW.h"
+
+#if OMAF_VIDEO_DECODER_NULL
+
+#include "Foundation/NVRLogger.h"
+
+OMAF_NS_BEGIN
+OMAF_LOG_ZONE(VideoDecoderNullHW)
+
+VideoDecoderNullHW::VideoDecoderNullHW(FrameCache& frameCache)
+    : mState(DecoderHWState::INVALID)
+    , mInputEOS(false)
+    , mFrameCache(frameCache)
+{
+}
+
+VideoDecoderNullHW::~VideoDecoderNullHW()
+{
+    OMAF_ASSERT(mState == DecoderHWState::INVALID, "Shutdown not called");
+}
+
+Error::Enum VideoDecoderNullHW::createInstance(const MimeType& mimeType)
+{
+    OMAF_ASSERT(mState == DecoderHWState::INVALID, "Incorrect state");
+    mMimeType = mimeType;
+    mState = DecoderHWState::IDLE;
+    return Error::OK;
+}
+
+const DecoderConfig& VideoDecoderNullHW::getConfig() const
+{
+    return mDecoderConfig;
+}
+
+void_t VideoDecoderNullHW::setStreamId(streamid_t streamId)
+{
+    mDecoderConfig.streamId = streamId;
+}
+
+Error::Enum VideoDecoderNullHW::initialize(const DecoderConfig& config)
+{
+    OMAF_ASSERT(mState == DecoderHWState::IDLE, "Incorrect state");
+    mDecoderConfig = config;
+    mInputEOS = false;
+    mState = DecoderHWState::STARTED;
+    OMAF_LOG_D("Initialized null decoder for stream %d (%dx%d)", config.streamId, config.width, config.height);
+    return Error::OK;
+}
+
+void_t VideoDecoderNullHW::flush()
+{
+    mInputEOS = false;
+
+    if (mState == DecoderHWState::EOS)
+    {
+        mState = DecoderHWState::STARTED;
+    }
+}
+
+void_t VideoDecoderNullHW::deinitialize()
+{
+    flush();
+    mState = DecoderHWState::IDLE;
+}
+
+void_t VideoDecoderNullHW::destroyInstance()
+{
+    OMAF_ASSERT(mState == DecoderHWState::IDLE, "Incorrect state");
+    mState = DecoderHWState::INVALID;
+}
+
+void VideoDecoderNullHW::setInputEOS()
+{
+    mInputEOS = true;
+}
+
+bool_t VideoDecoderNullHW::isInputEOS() const
+{
+    return mInputEOS;
+}
+
+bool_t VideoDecoderNullHW::isEOS()
+{
+    // Nothing is ever left inside the decoder, so input EOS is output EOS
+    if (mState == DecoderHWState::STARTED && mInputEOS)
+    {
+        mState = DecoderHWState::EOS;
+    }
+    return mState == DecoderHWState::EOS;
+}
+
+DecodeResult::Enum VideoDecoderNullHW::decodeFrame(streamid_t stream, MP4VRMediaPacket* packet, bool_t seeking)
+{
+    OMAF_ASSERT(mInputEOS == false, "");
+
+    if (mState != DecoderHWState::STARTED)
+    {
+        return DecodeResult::NOT_READY;
+    }
+
+    DecoderFrame* frame = mFrameCache.getFreeFrame(stream);
+
+    if (frame == OMAF_NULL)
+    {
+        return DecodeResult::DECODER_FULL;
+    }
+
+    frame->streamId = stream;
+    frame->decoder = this;
+    frame->consumed = false;
+    frame->width = mDecoderConfig.width;
+    frame->height = mDecoderConfig.height;
+    frame->pts = packet->presentationTimeUs();
+    frame->dts = packet->decodingTimeUs();
+    frame->duration = packet->durationUs();
+    frame->colorInfo.matrixCoefficients = VideoMatrixCoefficients::ITU_R_BT_709;
+    frame->colorInfo.colorRange = VideoColorRange::LIMITED;
+    frame->colorInfo.colorPrimaries = VideoColorPrimaries::ITU_R_BT_709;
+    frame->colorInfo.transferCharacteristics = VideoTransferCharacteristics::ITU_R_BT_709;
+
+    mFrameCache.addDecodedFrame(frame);
+
+    return DecodeResult::PACKET_ACCEPTED;
+}
+
+void_t VideoDecoderNullHW::consumedFrame(DecoderFrame* frame)
+{
+    OMAF_ASSERT(frame != OMAF_NULL, "null frame in consumedFrame");
+    frame->consumed = true;
+}
+
+OMAF_NS_END
+
+#endif
@@ -0,0 +1,71 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+#pragma once
+
+#if OMAF_VIDEO_DECODER_NULL
+
+#include "VideoDecoder/NVRVideoDecoderHW.h"
+
+OMAF_NS_BEGIN
+
+// Pass-through decoder: every accepted packet produces an empty frame with the packet timing,
+// no bitstream data is touched.
+class VideoDecoderNullHW : public VideoDecoderHW
+{
+public:
+    VideoDecoderNullHW(FrameCache& frameCache);
+
+    virtual ~VideoDecoderNullHW();
+
+    virtual Error::Enum createInstance(const MimeType& mimeType);
+
+    const DecoderConfig& getConfig() const;
+
+    void_t setStreamId(streamid_t streamId);
+
+    virtual Error::Enum initialize(const DecoderConfig& config);
+
+    virtual void_t flush();
+
+    virtual void_t deinitialize();
+
+    virtual void_t destroyInstance();
+
+    virtual void setInputEOS();
+
+    virtual bool_t isInputEOS() const;
+
+    virtual bool_t isEOS();
+
+    virtual DecodeResult::Enum decodeFrame(streamid_t stream, MP4VRMediaPacket* packet, bool_t seeking);
+    virtual void_t consumedFrame(DecoderFrame* frame);
+
+private:
+    OMAF_NO_COPY(VideoDecoderNullHW);
+    OMAF_NO_ASSIGN(VideoDecoderNullHW);
+
+private:
+    DecoderHWState::Enum mState;
+    MimeType mMimeType;
+    DecoderConfig mDecoderConfig;
+
+    bool_t mInputEOS;
+
+    FrameCache& mFrameCache;
+};
+
+OMAF_NS_END
+
+#endif
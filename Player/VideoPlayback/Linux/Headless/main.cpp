@@ -0,0 +1,194 @@
+
+/**
+ * This file is part of Nokia OMAF implementation
+ *
+ * Copyright (c) 2018-2021 Nokia Corporation and/or its subsidiary(-ies). All rights reserved.
+ *
+ * Contact: omaf@nokia.com
+ *
+ * This software, including documentation, is protected by copyright controlled by Nokia Corporation and/ or its
+ * subsidiaries. All rights are reserved.
+ *
+ * Copying, including reproducing, storing, adapting or translating, any or all of this material requires the prior
+ * written consent of Nokia.
+ */
+
+// Headless trace-replay driver for the OMAF player.
+//
+// Usage: omaf_headless <content uri> <head motion trace> [storage path] [index cache directory]
+//
+// The index cache directory keeps the sample tables of local files between runs, see
+// IPlaybackControls::setIndexCacheDirectory.
+//
+// The trace is a text file with one sample per line: "timeMs yaw pitch roll", angles in degrees.
+// Lines starting with '#' are ignored. The player is created with the NIL graphics API and the
+// null video decoder, so no display or hardware decoder is needed. When the trace has been
+// replayed the segment download, segment parse and tile switch latencies are printed.
+
+#include <API/OMAFPlayer.h>
+#include <API/OMAFPlayerPlatformParameters.h>
+#include <Math/OMAFMathFunctions.h>
+#include <Math/OMAFMatrix44.h>
+#include <Math/OMAFQuaternion.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TraceSample
+    {
+        uint64_t timeMs;
+        float yaw;
+        float pitch;
+        float roll;
+    };
+
+    bool loadTrace(const char* aFilename, std::vector<TraceSample>& aSamples)
+    {
+        std::ifstream file(aFilename);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            std::istringstream stream(line);
+            TraceSample sample = {};
+            if (stream >> sample.timeMs >> sample.yaw >> sample.pitch >> sample.roll)
+            {
+                aSamples.push_back(sample);
+            }
+        }
+        return !aSamples.empty();
+    }
+
+    OMAF::RenderSurface createSurface(OMAF::EyePosition::Enum aEye)
+    {
+        OMAF::RenderSurface surface;
+        surface.handle = 0;
+        surface.viewport.x = surface.viewport.y = 0;
+        surface.viewport.width = 1024;
+        surface.viewport.height = 1024;
+        surface.eyePosition = aEye;
+        surface.eyeTransform = OMAF::Matrix44Identity;
+        // 90 degree field of view, same as the Windows sample
+        surface.projection = OMAF::makePerspectiveRH(OMAF::toRadians(90.0f), 1.0f, 0.1f, 100.0f);
+        return surface;
+    }
+
+    void printStatistics(OMAF::IPlaybackControls* aControls, OMAF::LatencyCategory::Enum aCategory, const char* aName)
+    {
+        OMAF::LatencyStatistics stats = aControls->getLatencyStatistics(aCategory);
+        if (stats.count == 0)
+        {
+            printf("%-16s no samples\n", aName);
+            return;
+        }
+        printf("%-16s count %6u  min %8.2f  avg %8.2f  median %8.2f  p95 %8.2f  max %8.2f (ms)\n", aName,
+               stats.count, stats.minUs / 1000.0, stats.averageUs / 1000.0, stats.medianUs / 1000.0,
+               stats.percentile95Us / 1000.0, stats.maxUs / 1000.0);
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s <content uri> <head motion trace> [storage path] [index cache directory]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<TraceSample> trace;
+    if (!loadTrace(argv[2], trace))
+    {
+        printf("Failed to read head motion trace %s\n", argv[2]);
+        return 1;
+    }
+
+    OMAF::PlatformParameters params;
+    params.storagePath = argc > 3 ? argv[3] : "./";
+    params.assetPath = params.storagePath;
+
+    OMAF::IOMAFPlayer* player = OMAF::IOMAFPlayer::create(OMAF::GraphicsAPI::NIL, &params);
+    if (player == NULL)
+    {
+        printf("Failed to create player\n");
+        return 1;
+    }
+    OMAF::IPlaybackControls* controls = player->getPlaybackControls();
+    OMAF::IRenderer* renderer = player->getRenderer();
+    player->getAudio()->initializeAudioWithDirectRouting();
+
+    if (argc > 4 && controls->setIndexCacheDirectory(argv[4]) != OMAF::Result::OK)
+    {
+        printf("Index cache directory %s does not exist\n", argv[4]);
+    }
+
+    if (controls->loadVideo(argv[1]) != OMAF::Result::OK)
+    {
+        printf("Failed to load %s\n", argv[1]);
+        OMAF::IOMAFPlayer::destroy(player);
+        return 1;
+    }
+    controls->play();
+
+    OMAF::RenderSurface left = createSurface(OMAF::EyePosition::LEFT);
+    OMAF::RenderSurface right = createSurface(OMAF::EyePosition::RIGHT);
+    const OMAF::RenderSurface* surfaces[] = {&left, &right};
+    OMAF::RenderingParameters renderingParameters;
+    renderingParameters.displayWaterMark = false;
+
+    // Render at ~60 Hz, picking the latest trace sample that is due
+    const std::chrono::milliseconds frameInterval(16);
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t index = 0;
+    while (index < trace.size())
+    {
+        OMAF::VideoPlaybackState::Enum state = controls->getVideoPlaybackState();
+        if (state == OMAF::VideoPlaybackState::END_OF_FILE || state == OMAF::VideoPlaybackState::IDLE)
+        {
+            break;
+        }
+
+        uint64_t elapsedMs = (uint64_t) std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        while (index + 1 < trace.size() && trace[index + 1].timeMs <= elapsedMs)
+        {
+            index++;
+        }
+        const TraceSample& sample = trace[index];
+
+        OMAF::HeadTransform head = {};
+        head.orientation =
+            OMAF::makeQuaternion(OMAF::toRadians(sample.pitch), OMAF::toRadians(sample.yaw),
+                                 OMAF::toRadians(sample.roll), OMAF::EulerAxisOrder::YXZ);
+        renderer->renderSurfaces(head, surfaces, 2, renderingParameters);
+
+        if (index + 1 == trace.size() && sample.timeMs <= elapsedMs)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(frameInterval);
+    }
+
+    controls->stop();
+
+    printStatistics(controls, OMAF::LatencyCategory::SEGMENT_DOWNLOAD, "segment download");
+    printStatistics(controls, OMAF::LatencyCategory::SEGMENT_PARSE, "segment parse");
+    printStatistics(controls, OMAF::LatencyCategory::TILE_SWITCH, "tile switch");
+
+    OMAF::IOMAFPlayer::destroy(player);
+    return 0;
+}
@@ -20,7 +20,8 @@ function usage() {
  	echo ''
  	echo 'Usage:'
  	echo 'Run script and optionally select which parts should be compiled.'
- 	echo 'NOTE: building player on linux is not supported'
+ 	echo 'NOTE: the player is built headless, without rendering or video decoding; it needs libdash cloned to a'
+ 	echo '      folder adjacent to the root of this project'
     echo ''
  	echo '"build-linux.sh"       Builds release binaries'
     echo '"build-linux.sh debug" Builds debug binaries'
@@ -30,8 +31,9 @@ function usage() {
  	echo "help|--help       prints this usage information"
  	echo "skipmp4           skip building mp4 libraries (must be built for creator / player)"
  	echo "skipcreator       skip building creator app"
+ 	echo "skipplayer        skip building player library"
  	echo ''
- 	echo 'Libraries and executables are built to Mp4/lib and Creator/bin directories.'
+ 	echo 'Libraries and executables are built to Mp4/lib, Player/Lib and Creator/bin directories.'
  	echo ''
     exit $([ -z $1 ] && echo 0 || echo 1)
 }
@@ -40,6 +42,7 @@ ORIGDIR=$PWD
 
 BUILDMP4=YES
 BUILDCREATOR=YES
+BUILDPLAYER=YES
 BUILDTYPE=release
 BUILDTYPEDIR=Release
 
@@ -59,6 +62,9 @@ case $1 in
     skipcreator)
     BUILDCREATOR=NO
     ;;
+    skipplayer)
+    BUILDPLAYER=NO
+    ;;
     *)
     echo 'ERROR: Invalid argument "$1"'
     usage $1
@@ -111,3 +117,35 @@ if [ "$BUILDCREATOR" == "YES" ]; then
     cp bin/* $DSTDIR
     cd $ORIGDIR
 fi
+
+if [ "$BUILDPLAYER" == "YES" ]; then
+    if [ ! -d "$ORIGDIR/../../libdash" ]; then
+        echo "Please clone libdash to a folder adjacent to the root of this project"
+        exit 1
+    fi
+
+    if [ ! -f ../Lib/Linux/$BUILDTYPEDIR/libdash.so ]; then
+        LIBDASHBUILDDIR=linux/$BUILDTYPE
+        DSTDIR=$ORIGDIR/../Lib/Linux/$BUILDTYPEDIR
+        cd $ORIGDIR/../../libdash/libdash
+        rm -fr $LIBDASHBUILDDIR
+        mkdir -p $LIBDASHBUILDDIR
+        cd $LIBDASHBUILDDIR
+        cmake . -G "Unix Makefiles" ../.. -DCMAKE_BUILD_TYPE=${BUILDTYPE^^}
+        make -j6
+        mkdir -p $DSTDIR
+        find . -name "libdash*.so" -exec cp {} $DSTDIR \;
+        cd $ORIGDIR
+    fi
+
+    # the api_install target copies the library and its dependencies to Player/Lib/Linux/$BUILDTYPEDIR
+    PLAYERBUILDDIR=linux-build-$BUILDTYPE
+    cd $ORIGDIR/../Player
+    rm -fr $PLAYERBUILDDIR
+    mkdir -p $PLAYERBUILDDIR
+    cd $PLAYERBUILDDIR
+    # the player checks for "Debug" and "Release"
+    cmake . -G "Unix Makefiles" .. -DCMAKE_BUILD_TYPE=$BUILDTYPEDIR
+    make -j6
+    cd $ORIGDIR
+fi